@@ -16,9 +16,14 @@
 */
 #include "ANTIC.h"
 #include "GTIA.h"
+#include "HotPlacement.h"
+#include "LogRing.h"
+#include "MemoryPlan.h"
 #include "display/DisplayFactory.h"
 #include <cstring>
 
+static const char *TAG = "ANTIC";
+
 // Mode line parameters: scanlines, bytes per line, characters/pixels
 static const struct {
   uint8_t scanlines;
@@ -43,18 +48,17 @@ static const struct {
     {1, 40, false},  // F: 320 pixels, 1 scanline, hires (GR.8)
 };
 
-ANTIC::ANTIC() : ram(nullptr), bitmap(nullptr), display(nullptr), gtia(nullptr) {
+ANTIC::ANTIC() : pages(nullptr), bitmap(nullptr), display(nullptr), gtia(nullptr) {
   cntRefreshs = 0;
   reset();
 }
 
-void ANTIC::init(uint8_t *ram, GTIA *gtia) {
-  this->ram = ram;
+void ANTIC::init(const uint8_t *const *pages, GTIA *gtia) {
+  this->pages = pages;
   this->gtia = gtia;
 
-  // Allocate bitmap for ATARI_WIDTH x ATARI_HEIGHT pixels (16-bit RGB565)
-  bitmap = new uint16_t[ATARI_WIDTH * ATARI_HEIGHT];
-  memset(bitmap, 0, ATARI_WIDTH * ATARI_HEIGHT * sizeof(uint16_t));
+  // Bitmap for ATARI_WIDTH x ATARI_HEIGHT pixels (16-bit RGB565)
+  bitmap = static_cast<uint16_t *>(MemoryPlan::get(MemoryPlan::Region::BITMAP));
 
   // Create display driver
   display = Display::create();
@@ -175,17 +179,17 @@ void ANTIC::write(uint8_t addr, uint8_t val) {
   }
 }
 
-uint8_t ANTIC::fetchDisplayListByte() {
+uint8_t HOT_CODE ANTIC::fetchDisplayListByte() {
   if (!(dmactl & DMACTL_DL)) {
     return 0;
   }
-  uint8_t byte = ram[displayListPC & 0xFFFF];
+  uint8_t byte = dmaRead(displayListPC);
   displayListPC++;
   dmaCycles++;
   return byte;
 }
 
-void ANTIC::setModeLineParams(uint8_t mode) {
+void HOT_CODE ANTIC::setModeLineParams(uint8_t mode) {
   uint8_t modeIdx = mode & 0x0F;
   scanLinesPerMode = modeParams[modeIdx].scanlines;
   bytesPerLine = modeParams[modeIdx].bytesPerLine;
@@ -193,7 +197,7 @@ void ANTIC::setModeLineParams(uint8_t mode) {
   rowInMode = 0;
 }
 
-void ANTIC::processDisplayList() {
+void HOT_CODE ANTIC::processDisplayList() {
   if (!(dmactl & DMACTL_DL)) {
     return;
   }
@@ -207,6 +211,7 @@ void ANTIC::processDisplayList() {
       if (nmien & NMI_DLI) {
         dliPending = true;
         nmist &= ~NMI_DLI;
+        RINGLOG(LOG_VERBOSE, TAG, "line %d: DLI", scanline);
       }
     }
 
@@ -256,16 +261,19 @@ void ANTIC::processDisplayList() {
   }
 }
 
-void ANTIC::drawBlankLine() {
+void HOT_CODE ANTIC::drawBlankLine() {
+  if (!lineVisible()) {
+    return;
+  }
   // Fill scanline with background color from GTIA
   uint16_t bgColor = palette.colorToRGB565(gtia->getBackgroundColor());
-  uint16_t *line = &bitmap[scanline * ATARI_WIDTH];
+  uint16_t *line = bitmapLine();
   for (int x = 0; x < ATARI_WIDTH; x++) {
     line[x] = bgColor;
   }
 }
 
-void ANTIC::drawCharacterMode2() {
+void HOT_CODE ANTIC::drawCharacterMode2() {
   // ANTIC Mode 2: 40 characters, 8 scanlines per char, 2 colors
   // This is BASIC GR.0 (standard text mode)
   const uint16_t *colors = palette.getAtariColors();
@@ -276,7 +284,7 @@ void ANTIC::drawCharacterMode2() {
   uint16_t fgRGB = colors[fgColor];
 
   uint16_t charBase = chbase << 8;
-  uint16_t *line = &bitmap[scanline * ATARI_WIDTH];
+  uint16_t *line = bitmapLine();
   uint8_t charRow = rowInMode;
 
   // Apply character control
@@ -289,11 +297,11 @@ void ANTIC::drawCharacterMode2() {
 
   int xpos = 0;
   for (int col = 0; col < 40 && xpos < ATARI_WIDTH; col++) {
-    uint8_t charCode = ram[(memScan + col) & 0xFFFF];
+    uint8_t charCode = dmaRead(memScan + col);
     bool charInvert = (charCode & 0x80) != 0;
     charCode &= 0x7F;
 
-    uint8_t charData = ram[(charBase + charCode * 8 + charRow) & 0xFFFF];
+    uint8_t charData = dmaRead(charBase + charCode * 8 + charRow);
 
     // Apply inversion
     if (invert ^ charInvert) {
@@ -312,7 +320,7 @@ void ANTIC::drawCharacterMode2() {
   }
 }
 
-void ANTIC::drawCharacterMode4() {
+void HOT_CODE ANTIC::drawCharacterMode4() {
   // ANTIC Mode 4: 40 characters, 8 scanlines, 4 colors
   const uint16_t *colors = palette.getAtariColors();
   uint8_t colorRegs[4] = {
@@ -322,13 +330,13 @@ void ANTIC::drawCharacterMode4() {
       gtia->getPlayfieldColor(2)};
 
   uint16_t charBase = chbase << 8;
-  uint16_t *line = &bitmap[scanline * ATARI_WIDTH];
+  uint16_t *line = bitmapLine();
   uint8_t charRow = rowInMode;
 
   int xpos = 0;
   for (int col = 0; col < 40 && xpos < ATARI_WIDTH; col++) {
-    uint8_t charCode = ram[(memScan + col) & 0xFFFF];
-    uint8_t charData = ram[(charBase + (charCode & 0x7F) * 8 + charRow) & 0xFFFF];
+    uint8_t charCode = dmaRead(memScan + col);
+    uint8_t charData = dmaRead(charBase + (charCode & 0x7F) * 8 + charRow);
 
     // Color selection based on high bits of character code
     uint8_t colorPair = (charCode >> 6) & 0x03;
@@ -343,18 +351,18 @@ void ANTIC::drawCharacterMode4() {
   }
 }
 
-void ANTIC::drawCharacterMode6() {
+void HOT_CODE ANTIC::drawCharacterMode6() {
   // ANTIC Mode 6: 20 characters, 8 scanlines, 5 colors
   const uint16_t *colors = palette.getAtariColors();
 
   uint16_t charBase = chbase << 8;
-  uint16_t *line = &bitmap[scanline * ATARI_WIDTH];
+  uint16_t *line = bitmapLine();
   uint8_t charRow = rowInMode;
 
   int xpos = 0;
   for (int col = 0; col < 20 && xpos < ATARI_WIDTH; col++) {
-    uint8_t charCode = ram[(memScan + col) & 0xFFFF];
-    uint8_t charData = ram[(charBase + (charCode & 0x3F) * 8 + charRow) & 0xFFFF];
+    uint8_t charCode = dmaRead(memScan + col);
+    uint8_t charData = dmaRead(charBase + (charCode & 0x3F) * 8 + charRow);
 
     // Color selection based on bits 6-7
     uint8_t colorSelect = (charCode >> 6) & 0x03;
@@ -386,7 +394,7 @@ void ANTIC::drawCharacterMode6() {
   }
 }
 
-void ANTIC::drawBitmapModeD() {
+void HOT_CODE ANTIC::drawBitmapModeD() {
   // ANTIC Mode D: 160x2, 4 colors (GR.7)
   const uint16_t *colors = palette.getAtariColors();
   uint8_t colorRegs[4] = {
@@ -395,11 +403,11 @@ void ANTIC::drawBitmapModeD() {
       gtia->getPlayfieldColor(1),
       gtia->getPlayfieldColor(2)};
 
-  uint16_t *line = &bitmap[scanline * ATARI_WIDTH];
+  uint16_t *line = bitmapLine();
 
   int xpos = 0;
   for (int byte = 0; byte < 40 && xpos < ATARI_WIDTH; byte++) {
-    uint8_t data = ram[(memScan + byte) & 0xFFFF];
+    uint8_t data = dmaRead(memScan + byte);
 
     // Each byte contains 4 pixels (2 bits each)
     for (int pixel = 0; pixel < 4 && xpos < ATARI_WIDTH; pixel++) {
@@ -412,7 +420,7 @@ void ANTIC::drawBitmapModeD() {
   }
 }
 
-void ANTIC::drawBitmapModeE() {
+void HOT_CODE ANTIC::drawBitmapModeE() {
   // ANTIC Mode E: 160x1, 4 colors (GR.15)
   const uint16_t *colors = palette.getAtariColors();
   uint8_t colorRegs[4] = {
@@ -421,11 +429,11 @@ void ANTIC::drawBitmapModeE() {
       gtia->getPlayfieldColor(1),
       gtia->getPlayfieldColor(2)};
 
-  uint16_t *line = &bitmap[scanline * ATARI_WIDTH];
+  uint16_t *line = bitmapLine();
 
   int xpos = 0;
   for (int byte = 0; byte < 40 && xpos < ATARI_WIDTH; byte++) {
-    uint8_t data = ram[(memScan + byte) & 0xFFFF];
+    uint8_t data = dmaRead(memScan + byte);
 
     // Each byte contains 4 pixels (2 bits each)
     for (int pixel = 0; pixel < 4 && xpos < ATARI_WIDTH; pixel++) {
@@ -438,17 +446,17 @@ void ANTIC::drawBitmapModeE() {
   }
 }
 
-void ANTIC::drawBitmapModeF() {
+void HOT_CODE ANTIC::drawBitmapModeF() {
   // ANTIC Mode F: 320x1, 2 colors (GR.8 hires)
   const uint16_t *colors = palette.getAtariColors();
   uint16_t bgRGB = colors[gtia->getBackgroundColor()];
   uint16_t fgRGB = colors[gtia->getPlayfieldColor(0) | (gtia->getPlayfieldColor(0) & 0x0F)];
 
-  uint16_t *line = &bitmap[scanline * ATARI_WIDTH];
+  uint16_t *line = bitmapLine();
 
   int xpos = 0;
   for (int byte = 0; byte < 40 && xpos < ATARI_WIDTH; byte++) {
-    uint8_t data = ram[(memScan + byte) & 0xFFFF];
+    uint8_t data = dmaRead(memScan + byte);
 
     // Each byte contains 8 pixels
     for (int bit = 7; bit >= 0 && xpos < ATARI_WIDTH; bit--) {
@@ -457,7 +465,10 @@ void ANTIC::drawBitmapModeF() {
   }
 }
 
-void ANTIC::drawModeLine() {
+void HOT_CODE ANTIC::drawModeLine() {
+  if (!lineVisible()) {
+    return;
+  }
   switch (currentMode) {
   case 0:
     drawBlankLine();
@@ -502,7 +513,7 @@ void ANTIC::drawModeLine() {
   }
 }
 
-void ANTIC::drawScanline() {
+void HOT_CODE ANTIC::drawScanline() {
   if (scanline < 8 || scanline >= VBLANK_START) {
     // Vertical blank area - draw blank
     drawBlankLine();
@@ -540,12 +551,12 @@ void ANTIC::drawScanline() {
   }
 }
 
-uint8_t ANTIC::nextScanline() {
+template <class Timing> uint8_t HOT_CODE ANTIC::nextScanline() {
   dmaCycles = 0;
 
   scanline++;
 
-  if (scanline >= SCANLINES_PAL) {
+  if (scanline >= Timing::SCANLINES) {
     // End of frame
     scanline = 0;
     displayListPC = dlist;
@@ -566,6 +577,9 @@ uint8_t ANTIC::nextScanline() {
   return dmaCycles;
 }
 
+template uint8_t ANTIC::nextScanline<PALTiming>();
+template uint8_t ANTIC::nextScanline<NTSCTiming>();
+
 void ANTIC::refresh() {
   if (display) {
     display->drawBitmap(bitmap);
@@ -576,7 +590,7 @@ void ANTIC::refresh() {
   cntRefreshs++;
 }
 
-bool ANTIC::checkDLI() {
+bool HOT_CODE ANTIC::checkDLI() {
   if (dliPending) {
     dliPending = false;
     return true;
@@ -584,7 +598,7 @@ bool ANTIC::checkDLI() {
   return false;
 }
 
-bool ANTIC::checkVBI() {
+bool HOT_CODE ANTIC::checkVBI() {
   if (vbiPending) {
     vbiPending = false;
     return true;
@@ -593,3 +607,63 @@ bool ANTIC::checkVBI() {
 }
 
 void ANTIC::clearNMI(uint8_t mask) { nmist |= mask; }
+
+void ANTIC::saveState(SnapshotWriter &w) const {
+  w.put(dmactl);
+  w.put(chactl);
+  w.put(dlist);
+  w.put(hscrol);
+  w.put(vscrol);
+  w.put(pmbase);
+  w.put(chbase);
+  w.put(nmien);
+  w.put(nmist);
+  w.put(scanline);
+  w.put(displayListPC);
+  w.put(memScan);
+  w.put(modeLineCount);
+  w.put(currentMode);
+  w.put(inDisplayList);
+  w.put(dliPending);
+  w.put(vbiPending);
+  w.put(wsyncHalt);
+  w.put(rowInMode);
+  w.put(scanLinesPerMode);
+  w.put(isCharMode);
+  w.put(bytesPerLine);
+  w.put(pixelsPerByte);
+  w.put(hscrolEnabled);
+  w.put(vscrolEnabled);
+  w.put(vscrolLines);
+  w.put(dmaCycles);
+}
+
+void ANTIC::loadState(SnapshotReader &r) {
+  r.get(dmactl);
+  r.get(chactl);
+  r.get(dlist);
+  r.get(hscrol);
+  r.get(vscrol);
+  r.get(pmbase);
+  r.get(chbase);
+  r.get(nmien);
+  r.get(nmist);
+  r.get(scanline);
+  r.get(displayListPC);
+  r.get(memScan);
+  r.get(modeLineCount);
+  r.get(currentMode);
+  r.get(inDisplayList);
+  r.get(dliPending);
+  r.get(vbiPending);
+  r.get(wsyncHalt);
+  r.get(rowInMode);
+  r.get(scanLinesPerMode);
+  r.get(isCharMode);
+  r.get(bytesPerLine);
+  r.get(pixelsPerByte);
+  r.get(hscrolEnabled);
+  r.get(vscrolEnabled);
+  r.get(vscrolLines);
+  r.get(dmaCycles);
+}
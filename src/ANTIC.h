@@ -17,6 +17,8 @@
 #ifndef ANTIC_H
 #define ANTIC_H
 
+#include "Snapshot.h"
+#include "VideoTiming.h"
 #include "display/AtariDisplayDriver.h"
 #include <atomic>
 #include <cstdint>
@@ -101,9 +103,10 @@ constexpr uint8_t MODE_VSCROL = 0x20;   // Enable vertical scroll
 // Screen dimensions
 constexpr uint16_t ATARI_WIDTH = 320;   // Standard playfield width in pixels
 constexpr uint16_t ATARI_HEIGHT = 192;  // Standard playfield height in scanlines
-constexpr uint16_t SCANLINES_PAL = 312;
-constexpr uint16_t SCANLINES_NTSC = 262;
-constexpr uint16_t VBLANK_START = 248;
+constexpr uint16_t VBLANK_START = 248;  // PAL and NTSC
+// First bitmap line: the standard display list starts with 3 x 8 blank
+// lines at scanline 8, scanlines outside the bitmap are not drawn
+constexpr uint16_t FIRST_VISIBLE_LINE = 32;
 
 /**
  * @brief ANTIC - Alphanumeric Television Interface Controller
@@ -120,7 +123,13 @@ constexpr uint16_t VBLANK_START = 248;
  */
 class ANTIC {
 private:
-  uint8_t *ram;
+  const uint8_t *const *pages; // Page table of the CPU address space
+
+  // DMA read, the I/O area is not visible to ANTIC
+  inline uint8_t dmaRead(uint16_t addr) {
+    const uint8_t *page = pages[addr >> 8];
+    return page ? page[addr & 0xFF] : 0xFF;
+  }
   uint16_t *bitmap;            // Output bitmap (ATARI_WIDTH x ATARI_HEIGHT)
   DisplayDriver *display;      // Display driver (ST7789V etc.)
   AtariPalette palette;        // Atari 256-color palette
@@ -161,6 +170,12 @@ private:
   uint8_t vscrolLines;         // Lines scrolled vertically
 
   // Drawing functions
+  bool lineVisible() const {
+    return static_cast<uint16_t>(scanline - FIRST_VISIBLE_LINE) < ATARI_HEIGHT;
+  }
+  uint16_t *bitmapLine() {
+    return &bitmap[(scanline - FIRST_VISIBLE_LINE) * ATARI_WIDTH];
+  }
   void drawBlankLine();
   void drawModeLine();
   void drawCharacterMode2();   // ANTIC mode 2 (BASIC GR.0)
@@ -190,7 +205,7 @@ public:
   uint8_t dmaCycles;
 
   ANTIC();
-  void init(uint8_t *ram, GTIA *gtia);
+  void init(const uint8_t *const *pages, GTIA *gtia);
   void reset();
 
   // Register access
@@ -198,7 +213,9 @@ public:
   void write(uint8_t addr, uint8_t val);
 
   // Frame rendering
-  uint8_t nextScanline();      // Advance to next scanline, return DMA cycles
+  // Advance to next scanline (frame of Timing, see VideoTiming.h), return
+  // DMA cycles
+  template <class Timing> uint8_t nextScanline();
   void drawScanline();         // Draw current scanline
   void refresh();              // Refresh display (send bitmap to LCD)
 
@@ -207,6 +224,10 @@ public:
   bool checkVBI();             // Check for VBI
   void clearNMI(uint8_t mask);
 
+  // Snapshot support
+  void saveState(SnapshotWriter &w) const;
+  void loadState(SnapshotReader &r);
+
   // WSYNC support
   bool isWSYNCHalted() const { return wsyncHalt; }
   void releaseWSYNC() { wsyncHalt = false; }
@@ -15,39 +15,57 @@
  http://www.gnu.org/licenses/.
 */
 #include "Atari800Emu.h"
+#include "LogRing.h"
+#include "MemoryPlan.h"
 #include "board/BoardFactory.h"
 #include "joystick/JoystickFactory.h"
 #include "keyboard/KeyboardFactory.h"
 #include "platform/PlatformFactory.h"
 #include "platform/PlatformManager.h"
-#include "roms/atarixl_os.h"
-#include "roms/atari_basic.h"
 #include <cstring>
 
 static const char *TAG = "Atari800Emu";
 
-// Memory size for Atari 800 XL (64KB)
-constexpr uint32_t RAM_SIZE = 64 * 1024;
-
 Atari800Emu::Atari800Emu() : ram(nullptr), board(nullptr) {
   cntSecondsForBatteryCheck = 0;
+  profilingTimer = 0;
 }
 
 Atari800Emu::~Atari800Emu() {
-  if (ram) {
-    delete[] ram;
-    ram = nullptr;
-  }
-}
-
-void Atari800Emu::intervalTimerScanKeyboardFunc() {
-  sys.scanKeyboard();
+  // ram belongs to the memory plan
+  ram = nullptr;
 }
 
 void Atari800Emu::intervalTimerProfilingBatteryCheckFunc() {
+  governor.update();
+  sys.profile.poll();
+
   // Update profiling info
   if (showperfvalues.load()) {
     numofcyclespersecond.store(sys.numofcyclespersecond.load());
+    uint32_t rawSize = sys.bootCache.rawSize.load();
+    if (rawSize > 0) {
+      snapshotPercent.store(sys.bootCache.compSize.load() * 100 / rawSize);
+    }
+    snapshotCompressUS.store(sys.bootCache.compressUS.load());
+    snapshotWriteUS.store(sys.bootCache.writeUS.load());
+    snapshotRawWriteUS.store(sys.bootCache.rawWriteUS.load());
+    frameIntervalP99US.store(sys.pacer.intervalP99US.load());
+    droppedFrames.store(sys.pacer.droppedFrames.load());
+    governorPolicies.store(governor.policies.load());
+    cpuLoadPercent.store(sys.pacer.loadPercent.load());
+    sleepPercent.store(sys.pacer.sleepPercent.load());
+    spinPercent.store(sys.pacer.spinPercent.load());
+    refreshSkippedPerSecond.store(governor.refreshSkippedPerSecond.load());
+    refreshUSPerSecond.store(governor.refreshUSPerSecond.load());
+    audioSamplesPerSecond.store(governor.audioSamplesPerSecond.load());
+    TimerStats timer;
+    if (PlatformManager::getInstance().getTimerStats(profilingTimer, timer) &&
+        (timer.ticks > 0)) {
+      timerLateAvgUS.store(timer.lateSumUS / timer.ticks);
+      timerLateMaxUS.store(timer.lateMaxUS);
+      timerSkipped.store(timer.skipped);
+    }
   }
 
   // Battery check every 60 seconds
@@ -71,6 +89,7 @@ void Atari800Emu::cpuCode(void *parameter) {
 void Atari800Emu::setup() {
   // Initialize platform first
   PlatformManager::initialize(PlatformNS::create());
+  LogRing::start();
 
   PlatformManager::getInstance().log(LOG_INFO, TAG, "Atari 800 XL Emulator starting...");
 
@@ -83,17 +102,48 @@ void Atari800Emu::setup() {
   }
   PlatformManager::getInstance().log(LOG_INFO, TAG, "Board initialized");
 
-  // Allocate RAM
-  PlatformManager::getInstance().log(LOG_INFO, TAG, "Allocating RAM...");
-  ram = new uint8_t[RAM_SIZE];
-  memset(ram, 0, RAM_SIZE);
-  PlatformManager::getInstance().log(LOG_INFO, TAG, "RAM allocated");
-
-  // Initialize system with ROMs (use getters to get initialized ROM data)
+  // Reserve emulator memory (hot regions in internal SRAM)
+  PlatformManager::getInstance().log(LOG_INFO, TAG, "Allocating memory...");
+  MemoryPlan::init();
+  ram = static_cast<uint8_t *>(MemoryPlan::get(MemoryPlan::Region::RAM));
+  MemoryPlan::report();
+  MemoryPlan::reportObject("sys", &sys, sizeof(sys));
+
+  // Load ROMs (files in Config::PATH, compiled-in test ROMs as fallback)
+  PlatformManager::getInstance().log(LOG_INFO, TAG, "Loading ROMs...");
+  RomDescriptor osRom;
+  RomDescriptor basicRom;
+  romLoader.load(RomKind::OS, osRom);
+  romLoader.load(RomKind::BASIC, basicRom);
+
+  // Initialize system with ROMs
   PlatformManager::getInstance().log(LOG_INFO, TAG, "Initializing system...");
-  sys.init(ram, getAtariOSRom(), getAtariBasicRom());
+  sys.init(ram, osRom, basicRom);
   PlatformManager::getInstance().log(LOG_INFO, TAG, "System initialized");
 
+  // Directory index (built and updated in the background)
+  dirIndex.start();
+  sys.hdevice.setDirIndex(&dirIndex);
+
+  // File reads of the emulated devices are done by a separate task
+  fileIO.start();
+  sys.cartridge.setFileIO(&fileIO);
+  sys.bootCache.setFileIO(&fileIO);
+
+  // Runtime configuration (Config::CONFIGFILE), checked for changes by the
+  // profiling/battery timer
+  sys.profile.setFileIO(&fileIO);
+  sys.profile.load();
+
+  // Cartridge inserted at power on, selects the settings of the title
+  std::string cartridge = sys.profile.getCartridge();
+  if (!cartridge.empty()) {
+    sys.insertCartridge(Atari800Sys::findCartridge(cartridge));
+  }
+
+  // Battery-aware policies (applied by the profiling/battery timer)
+  governor.init(&sys, board);
+
   // Create keyboard driver
   PlatformManager::getInstance().log(LOG_INFO, TAG, "Creating keyboard...");
   sys.keyboard = Keyboard::create();
@@ -116,17 +166,11 @@ void Atari800Emu::setup() {
   PlatformManager::getInstance().startTask(
       [this](void *param) { this->cpuCode(param); },
       1,  // Core 1
-      5   // Priority
-  );
-
-  // Start keyboard scanner timer (every 8ms)
-  PlatformManager::getInstance().startIntervalTimer(
-      [this]() { this->intervalTimerScanKeyboardFunc(); },
-      8000  // 8ms
-  );
+      5,  // Priority
+      "cpu");
 
   // Start profiling/battery timer (every 1 second)
-  PlatformManager::getInstance().startIntervalTimer(
+  profilingTimer = PlatformManager::getInstance().startIntervalTimer(
       [this]() { this->intervalTimerProfilingBatteryCheckFunc(); },
       1000000  // 1 second
   );
@@ -135,8 +179,26 @@ void Atari800Emu::setup() {
 }
 
 void Atari800Emu::loop() {
-  // Main loop - refresh display
-  sys.antic.refresh();
+  // Main loop - refresh display (unless the governor skips a static frame)
+  if (governor.shouldRefresh(sys.antic.getBitmap16(),
+                             ATARI_WIDTH * ATARI_HEIGHT,
+                             sys.gtia.getBackgroundColor())) {
+#ifdef USE_LATENCY_TRACE
+    uint32_t tracedFrame = sys.latencyTrace.takeDisplayRequest();
+#endif
+    int64_t start = PlatformManager::getInstance().getTimeUS();
+    sys.antic.refresh();
+    governor.refreshDone(PlatformManager::getInstance().getTimeUS() - start);
+#ifdef USE_LATENCY_TRACE
+    sys.latencyTrace.framePushed(tracedFrame);
+#endif
+  }
+
+  // SDL events must be taken by the main thread, the drivers are polled
+  // by the CPU task at the end of each frame
+  if (sys.keyboard) {
+    sys.keyboard->syncAndCreateAttachWinSDL();
+  }
 
   // Feed watchdog
   PlatformManager::getInstance().feedWDT();
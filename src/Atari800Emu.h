@@ -18,7 +18,11 @@
 #define ATARI800EMU_H
 
 #include "Atari800Sys.h"
+#include "PerfGovernor.h"
 #include "board/BoardDriver.h"
+#include "fs/AsyncFileIO.h"
+#include "fs/DirIndex.h"
+#include "roms/RomLoader.h"
 #include <atomic>
 
 /**
@@ -34,9 +38,13 @@ class Atari800Emu {
 private:
   uint8_t *ram;
   BoardDriver *board;
+  RomLoader romLoader;
+  DirIndex dirIndex;
+  AsyncFileIO fileIO;
+  PerfGovernor governor;
   uint16_t cntSecondsForBatteryCheck;
+  uint32_t profilingTimer; // id for Platform::getTimerStats
 
-  void intervalTimerScanKeyboardFunc();
   void intervalTimerProfilingBatteryCheckFunc();
   void cpuCode(void *parameter);
 
@@ -45,6 +53,27 @@ public:
   std::atomic<bool> showperfvalues = false;
   std::atomic<uint8_t> cntRefreshs = 0;
   std::atomic<uint32_t> numofcyclespersecond = 0;
+  // size of the last boot snapshot in percent of the uncompressed state
+  std::atomic<uint8_t> snapshotPercent = 0;
+  std::atomic<uint32_t> snapshotCompressUS = 0;
+  std::atomic<uint32_t> snapshotWriteUS = 0;
+  std::atomic<uint32_t> snapshotRawWriteUS = 0;
+  // frame intervals of the last pacing window
+  std::atomic<uint32_t> frameIntervalP99US = 0;
+  std::atomic<uint32_t> droppedFrames = 0;
+  // performance governor (see PerfGovernor.h): active policies and effects
+  std::atomic<uint8_t> governorPolicies = 0;
+  std::atomic<uint8_t> cpuLoadPercent = 0;
+  std::atomic<uint8_t> sleepPercent = 0;
+  std::atomic<uint8_t> spinPercent = 0;
+  std::atomic<uint32_t> refreshSkippedPerSecond = 0;
+  std::atomic<uint32_t> refreshUSPerSecond = 0;
+  std::atomic<uint32_t> audioSamplesPerSecond = 0;
+  // delays of this profiling timer behind its schedule (if the platform
+  // measures them)
+  std::atomic<uint32_t> timerLateAvgUS = 0;
+  std::atomic<uint32_t> timerLateMaxUS = 0;
+  std::atomic<uint32_t> timerSkipped = 0;
 
   Atari800Emu();
   ~Atari800Emu();
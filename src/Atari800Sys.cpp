@@ -15,15 +15,29 @@
  http://www.gnu.org/licenses/.
 */
 #include "Atari800Sys.h"
+#include "HotPlacement.h"
+#include "LogRing.h"
+#include "fs/FileFactory.h"
 #include "platform/PlatformManager.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
-// Cycles per scanline (PAL: 114 cycles at 1.77MHz)
+static const char *TAG = "Atari800Sys";
+
+// Cycles per scanline (PAL: 114 cycles at 1.77MHz, NTSC: 1.79MHz)
 constexpr int32_t CYCLES_PER_SCANLINE = 114;
-constexpr int32_t SCANLINES_PER_FRAME = 312;  // PAL
+
+// Extensions tried for a cartridge name given without one
+static const char *const CARTEXTENSIONS[] = {".car", ".rom", ".car.gz",
+                                             ".rom.gz", ".zip"};
 
 Atari800Sys::Atari800Sys()
     : ram(nullptr), osRom(nullptr), basicRom(nullptr), charRom(nullptr),
-      joystick(nullptr), keyboard(nullptr) {
+      titleCrc(0), joystick(nullptr), titleFrameSkip(0),
+      titleSkipStatic(false), titleAudioStep(1), keyboard(nullptr) {
+  memset(extCmd, 0, sizeof(extCmd));
+  extCmdPending = false;
   osRomEnabled = true;
   basicRomEnabled = true;
   selfTestEnabled = false;
@@ -33,26 +47,34 @@ Atari800Sys::Atari800Sys()
   cyclesPerScanline = CYCLES_PER_SCANLINE;
   numofcyclespersecond = 0;
   perf = false;
+#ifdef USE_OPCODE_PROFILE
+  memset(opcodeCount, 0, sizeof(opcodeCount));
+  profileFrames = 0;
+#endif
 }
 
 Atari800Sys::~Atari800Sys() {
   // RAM is managed externally
 }
 
-void Atari800Sys::init(uint8_t *ram, const uint8_t *osRom, const uint8_t *basicRom) {
+void Atari800Sys::init(uint8_t *ram, const RomDescriptor &osRom,
+                       const RomDescriptor &basicRom) {
   this->ram = ram;
-  this->osRom = osRom;
-  this->basicRom = basicRom;
+  osRomDesc = osRom;
+  basicRomDesc = basicRom;
+  this->osRom = osRom.data;
+  this->basicRom = basicRom.data;
 
   // Character ROM is built into OS ROM at offset $E000 (relative to $C000)
   // In the actual OS ROM it's at $E000-$E3FF
-  this->charRom = osRom + 0x2000;  // $E000 - $C000 = $2000
+  this->charRom = this->osRom + 0x2000;  // $E000 - $C000 = $2000
 
   // Initialize chips
-  antic.init(ram, &gtia);
+  antic.init(readPage, &gtia);
   pokey.init();
   gtia.reset();
   pia.reset();
+  hdevice.init(this);
 
   reset();
 }
@@ -80,13 +102,17 @@ void Atari800Sys::reset() {
   // Reset chips
   antic.reset();
   gtia.reset();
+  gtia.setPAL(settings.pal);
   pokey.reset();
   pia.reset();
+  hdevice.closeAll();
 
   // Enable ROMs
   osRomEnabled = true;
   basicRomEnabled = true;
   selfTestEnabled = false;
+  cartridge.reset();
+  mapMemory();
 
   // Read reset vector from OS ROM
   pc = osRom[0x3FFC - 0x0000] | (osRom[0x3FFD - 0x0000] << 8);
@@ -97,76 +123,248 @@ void Atari800Sys::reset() {
 
 void Atari800Sys::updateBanking() {
   uint8_t portb = pia.getPortB();
-  osRomEnabled = (portb & PORTB_OS_ROM) == 0;
-  basicRomEnabled = (portb & PORTB_BASIC) == 0;
-  selfTestEnabled = (portb & PORTB_SELFTEST) == 0;
+  bool os = (portb & PORTB_OS_ROM) == 0;
+  bool basic = (portb & PORTB_BASIC) == 0;
+  bool selftest = (portb & PORTB_SELFTEST) == 0;
+  if ((os == osRomEnabled) && (basic == basicRomEnabled) &&
+      (selftest == selfTestEnabled)) {
+    return;
+  }
+  osRomEnabled = os;
+  basicRomEnabled = basic;
+  selfTestEnabled = selftest;
+  mapMemory();
 }
 
-uint8_t Atari800Sys::getMem(uint16_t addr) {
-  // RAM area ($0000-$BFFF with holes for ROM)
-  if (addr < 0xA000) {
-    // Check for self-test ROM area ($5000-$57FF)
-    if (selfTestEnabled && addr >= 0x5000 && addr < 0x5800) {
-      return osRom[addr - 0x5000 + 0x1000];  // Self-test at $D000 in OS ROM
+void Atari800Sys::mapMemory() {
+  // RAM is always writable, reads may be redirected to ROM
+  for (uint16_t p = 0; p < 0x100; p++) {
+    readPage[p] = ram + (p << 8);
+    writePage[p] = ram + (p << 8);
+  }
+
+  // Self-test ROM ($5000-$57FF), located at $D000 in OS ROM
+  if (selfTestEnabled && osRom) {
+    for (uint16_t p = 0x50; p < 0x58; p++) {
+      readPage[p] = osRom + 0x1000 + ((p - 0x50) << 8);
     }
-    return ram[addr];
   }
 
-  // BASIC ROM area ($A000-$BFFF)
-  if (addr < 0xC000) {
-    if (basicRomEnabled && basicRom) {
-      return basicRom[addr - 0xA000];
+  // OS ROM ($C000-$CFFF, $D800-$FFFF)
+  if (osRomEnabled && osRom) {
+    for (uint16_t p = 0xc0; p < 0x100; p++) {
+      readPage[p] = osRom + ((p - 0xc0) << 8);
     }
-    return ram[addr];
   }
 
   // Hardware I/O area ($D000-$D7FF)
-  if (addr >= 0xD000 && addr < 0xD800) {
-    return readIO(addr);
+  for (uint16_t p = 0xd0; p < 0xd8; p++) {
+    readPage[p] = nullptr;
+    writePage[p] = nullptr;
   }
 
-  // OS ROM area ($C000-$CFFF, $D800-$FFFF)
-  if (osRomEnabled && osRom) {
-    if (addr >= 0xC000 && addr < 0xD000) {
-      return osRom[addr - 0xC000];
+  // BASIC ROM and cartridge ($8000-$BFFF)
+  mapCartridge();
+}
+
+void Atari800Sys::mapCartridge() {
+  const uint8_t *window = cartridge.getWindow8000();
+  for (uint16_t p = 0x80; p < 0xa0; p++) {
+    if (window) {
+      readPage[p] = window + ((p - 0x80) << 8);
+      writePage[p] = romWritePage;
+    } else {
+      readPage[p] = ram + (p << 8);
+      writePage[p] = ram + (p << 8);
     }
-    if (addr >= 0xD800) {
-      return osRom[addr - 0xC000];
+  }
+
+  // A cartridge at $A000 has priority over BASIC
+  window = cartridge.getWindowA000();
+  for (uint16_t p = 0xa0; p < 0xc0; p++) {
+    if (window) {
+      readPage[p] = window + ((p - 0xa0) << 8);
+      writePage[p] = romWritePage;
+    } else {
+      readPage[p] = (basicRomEnabled && basicRom) ? basicRom + ((p - 0xa0) << 8)
+                                                  : ram + (p << 8);
+      writePage[p] = ram + (p << 8);
     }
   }
+}
 
-  // Fall back to RAM
-  return ram[addr];
+size_t Atari800Sys::getWriteSpans(uint16_t addr, uint16_t len,
+                                  std::vector<ByteSpan> &spans) {
+  spans.clear();
+  uint32_t a = addr;
+  uint32_t end = std::min<uint32_t>(addr + len, 0x10000);
+  while (a < end) {
+    uint8_t *page = writePage[a >> 8];
+    if (page == nullptr) {
+      break;
+    }
+    uint32_t n = std::min<uint32_t>(0x100 - (a & 0xff), end - a);
+    uint8_t *p = page + (a & 0xff);
+    if (!spans.empty() && (spans.back().data + spans.back().size == p)) {
+      spans.back().size += n;
+    } else {
+      spans.push_back({p, n});
+    }
+    a += n;
+  }
+  return a - addr;
 }
 
-void Atari800Sys::setMem(uint16_t addr, uint8_t val) {
-  // RAM always writable (except for ROM-shadowed areas)
-  if (addr < 0xA000) {
-    ram[addr] = val;
-    return;
+uint32_t Atari800Sys::machineConfig() const {
+  return (settings.pal ? (1 << 16) : 0) | (MEM_64K >> 10);
+}
+
+void Atari800Sys::applySettings(const ProfileSettings &s) {
+  if ((s.machine == ProfileSettings::Machine::A800) &&
+      (settings.machine != ProfileSettings::Machine::A800)) {
+    PlatformManager::getInstance().log(
+        LOG_WARN, TAG, "machine 800 not supported (XL OS and banking), "
+                       "using 800xl");
+  }
+  // the scanline loop switches the timing at the end of the frame
+  gtia.setPAL(s.pal);
+  if (s.sioAccel && !settings.sioAccel) {
+    PlatformManager::getInstance().log(
+        LOG_WARN, TAG, "sioAccel ignored: no SIO devices are emulated");
+  }
+  if ((s.runAhead > 0) && (settings.runAhead == 0)) {
+    PlatformManager::getInstance().log(LOG_WARN, TAG,
+                                       "runAhead not supported, ignored");
+  }
+  titleFrameSkip.store(s.frameSkip);
+  titleSkipStatic.store(s.skipStatic);
+  titleAudioStep.store(s.audioStep);
+  if (s != settings) {
+    PlatformManager::getInstance().log(
+        LOG_INFO, TAG,
+        "title %08x: %s, frameSkip %s%u, audio 1/%u", (unsigned)titleCrc,
+        s.pal ? "PAL" : "NTSC", s.skipStatic ? "static " : "", (unsigned)s.frameSkip,
+        (unsigned)s.audioStep);
   }
+  settings = s;
+}
 
-  // BASIC ROM area - write to RAM
-  if (addr < 0xC000) {
-    ram[addr] = val;
-    return;
+bool Atari800Sys::insertCartridge(const std::string &path) {
+  bool ok = cartridge.insert(path);
+  titleCrc = ok ? BootCache::hashImage(path) : 0;
+  applySettings(profile.select(titleCrc));
+  coldStart();
+  return ok;
+}
+
+void Atari800Sys::removeCartridge() {
+  cartridge.remove();
+  titleCrc = 0;
+  applySettings(profile.select(0));
+  coldStart();
+}
+
+void Atari800Sys::coldStart() {
+  bootCache.cancel();
+  reset();
+  if (titleCrc != 0) {
+    bootCache.start(*this, BootCache::makeKey(titleCrc, osRomDesc,
+                                              basicRomDesc, machineConfig()));
+  }
+}
+
+void Atari800Sys::saveState(SnapshotWriter &w) {
+  w.put(SNAPSHOT_VERSION);
+  w.putBytes(ram, MEM_64K);
+  w.put(a);
+  w.put(x);
+  w.put(y);
+  w.put(sp);
+  w.put(pc);
+  w.put(cflag);
+  w.put(zflag);
+  w.put(dflag);
+  w.put(bflag);
+  w.put(vflag);
+  w.put(nflag);
+  w.put(iflag);
+  w.put(osRomEnabled);
+  w.put(basicRomEnabled);
+  w.put(selfTestEnabled);
+  w.put(nmiActive);
+  w.put(lastIRQ);
+  antic.saveState(w);
+  gtia.saveState(w);
+  pokey.saveState(w);
+  pia.saveState(w);
+  cartridge.saveState(w);
+}
+
+bool Atari800Sys::loadState(SnapshotReader &r) {
+  uint8_t version = 0;
+  r.get(version);
+  if (version != SNAPSHOT_VERSION) {
+    return false;
+  }
+  hdevice.closeAll();
+  r.getBytes(ram, MEM_64K);
+  r.get(a);
+  r.get(x);
+  r.get(y);
+  r.get(sp);
+  r.get(pc);
+  r.get(cflag);
+  r.get(zflag);
+  r.get(dflag);
+  r.get(bflag);
+  r.get(vflag);
+  r.get(nflag);
+  r.get(iflag);
+  r.get(osRomEnabled);
+  r.get(basicRomEnabled);
+  r.get(selfTestEnabled);
+  r.get(nmiActive);
+  r.get(lastIRQ);
+  antic.loadState(r);
+  gtia.loadState(r);
+  pokey.loadState(r);
+  pia.loadState(r);
+  cartridge.loadState(r);
+  mapMemory();
+  cpuhalted = false;
+  numofcycles = 0;
+  cyclesThisScanline = 0;
+  return r.isOk() && r.atEnd();
+}
+
+uint8_t HOT_CODE Atari800Sys::getMem(uint16_t addr) {
+  const uint8_t *page = readPage[addr >> 8];
+  if (page) {
+    return page[addr & 0xff];
   }
 
   // Hardware I/O area ($D000-$D7FF)
-  if (addr >= 0xD000 && addr < 0xD800) {
-    writeIO(addr, val);
+  return readIO(addr);
+}
+
+void HOT_CODE Atari800Sys::setMem(uint16_t addr, uint8_t val) {
+  uint8_t *page = writePage[addr >> 8];
+  if (page) {
+    page[addr & 0xff] = val;
     return;
   }
 
-  // OS ROM area - write to underlying RAM (if accessible)
-  if (addr >= 0xD800) {
-    ram[addr] = val;
-  }
+  // Hardware I/O area ($D000-$D7FF)
+  writeIO(addr, val);
 }
 
-uint8_t Atari800Sys::readIO(uint16_t addr) {
+uint8_t HOT_CODE Atari800Sys::readIO(uint16_t addr) {
   uint8_t reg = addr & 0xFF;
 
+#ifdef USE_LATENCY_TRACE
+  latencyTrace.ioRead(addr, traceCycle());
+#endif
+
   // GTIA: $D000-$D0FF (mirrored every 32 bytes)
   if (addr >= 0xD000 && addr < 0xD100) {
     return gtia.read(reg & 0x1F);
@@ -187,13 +385,30 @@ uint8_t Atari800Sys::readIO(uint16_t addr) {
     return antic.read(reg & 0x0F);
   }
 
+  // Cartridge control: $D500-$D5FF
+  if (addr >= 0xD500 && addr < 0xD600) {
+    if (cartridge.access(reg, false, 0)) {
+      mapCartridge();
+    }
+    return 0xFF;
+  }
+
+  // H: device handler: $D600-$D6FF
+  if (addr >= HDEVICE_PAGE && addr < HDEVICE_PAGE + 0x100 &&
+      hdevice.isAvailable()) {
+    return hdevice.readPatch(reg);
+  }
+
   // Unused/cartridge area
   return 0xFF;
 }
 
-void Atari800Sys::writeIO(uint16_t addr, uint8_t val) {
+void HOT_CODE Atari800Sys::writeIO(uint16_t addr, uint8_t val) {
   uint8_t reg = addr & 0xFF;
 
+  RINGLOG(LOG_VERBOSE, TAG, "line %d: write %04x=%02x", antic.getScanline(),
+          addr, val);
+
   // GTIA: $D000-$D0FF
   if (addr >= 0xD000 && addr < 0xD100) {
     gtia.write(reg & 0x1F, val);
@@ -219,9 +434,17 @@ void Atari800Sys::writeIO(uint16_t addr, uint8_t val) {
     antic.write(reg & 0x0F, val);
     return;
   }
+
+  // Cartridge control: $D500-$D5FF
+  if (addr >= 0xD500 && addr < 0xD600) {
+    if (cartridge.access(reg, true, val)) {
+      mapCartridge();
+    }
+    return;
+  }
 }
 
-void Atari800Sys::checkInterrupts() {
+void HOT_CODE Atari800Sys::checkInterrupts() {
   // Check for NMI (from ANTIC)
   if (antic.checkVBI() || antic.checkDLI()) {
     handleNMI();
@@ -288,6 +511,16 @@ bool Atari800Sys::handleIRQ() {
 }
 
 void Atari800Sys::cmd6502brk() {
+  // H: device entry stub: call host handler, continue with the RTS
+  // following the BRK
+  if (hdevice.isTrap(pc - 1)) {
+    y = hdevice.trap(pc - 1, a, x);
+    nflag = (y & 0x80) != 0;
+    zflag = (y == 0);
+    numofcycles = 7;
+    return;
+  }
+
   // BRK instruction - software interrupt
   pc++;  // Skip padding byte
 
@@ -312,28 +545,197 @@ void Atari800Sys::logDebugInfo() {
   // Debug logging if enabled
 }
 
-void Atari800Sys::scanKeyboard() {
+void Atari800Sys::pollInput() {
+  uint8_t values[InputRouter::NUMDEVICES] = {0xff, 0xff};
+  // Key events are queued by the driver and taken by the CPU task
   if (keyboard) {
-    // Keyboard scanning handled by external keyboard driver
-    // Key codes sent to POKEY via setKeyCode()
+    keyboard->scanKeyboard();
+    // joystick routing is done here, other commands are executed at the
+    // end of the frame
+    uint8_t *cmd = keyboard->getExtCmdData();
+    if (cmd && !inputRouter.handleExtCmd(static_cast<ExtCmd>(cmd[0])) &&
+        takeExtCmd(cmd)) {
+      extCmdPending = true;
+    }
+    values[InputRouter::KBJOYSTICK] = keyboard->getKBJoyValue();
   }
-
-  // Update joystick
   if (joystick) {
-    uint8_t joyVal = joystick->getValue();
-    // Decode C64-style joystick bits (active-low: 0=pressed)
-    bool up = (joyVal & 0x01) == 0;
-    bool down = (joyVal & 0x02) == 0;
-    bool left = (joyVal & 0x04) == 0;
-    bool right = (joyVal & 0x08) == 0;
-    bool fire = (joyVal & 0x10) == 0;
-    pia.setJoystick1(up, down, left, right);
-    gtia.setTrigger(0, fire);
+    values[InputRouter::JOYSTICK] = joystick->getValue();
+#if defined(USE_LATENCY_TRACE) && !defined(USE_LATENCY_SCRIPT)
+    latencyTrace.joystickPolled(values[InputRouter::JOYSTICK]);
+#endif
+  }
+  uint32_t state = inputRouter.pack(values);
+  if (joystick) {
+    // paddle triggers share the left/right lines of joystick port 1
+    for (uint8_t num = 0; num < InputLatch::NUMPADDLES; num++) {
+      inputLatch.setPaddle(num, joystick->getPaddle(num));
+      if (joystick->getPaddleTrigger(num)) {
+        state &= ~(0x04u << num);
+      }
+    }
+  }
+  inputLatch.publish(state);
+}
+
+bool Atari800Sys::takeExtCmd(const uint8_t *cmd) {
+  switch (static_cast<ExtCmd>(cmd[0])) {
+  case ExtCmd::RESET:
+  case ExtCmd::SETVOLUME:
+  case ExtCmd::INCVOLUME:
+  case ExtCmd::DECVOLUME:
+  case ExtCmd::LOAD:
+  case ExtCmd::SAVE:
+  case ExtCmd::LIST:
+    extCmd[0] = cmd[0];
+    extCmd[1] = cmd[1];
+    return true;
+  case ExtCmd::ATTACHCART:
+  case ExtCmd::DETACHCART: {
+    // image name from buffer[3], terminated
+    const char *name = reinterpret_cast<const char *>(cmd + 3);
+    size_t len = strnlen(name, EXTCMDSIZE - 4);
+    extCmd[0] = cmd[0];
+    memcpy(extCmd + 3, name, len);
+    extCmd[3 + len] = '\0';
+    return true;
+  }
+  default:
+    // C64 leftovers (text screen, OSD, registers), not applicable
+    return false;
+  }
+}
+
+void Atari800Sys::executeExtCmd() {
+  ExtCmd cmd = static_cast<ExtCmd>(extCmd[0]);
+  uint8_t volume = pokey.getEmuVolume();
+  switch (cmd) {
+  case ExtCmd::RESET:
+    coldStart();
+    break;
+  case ExtCmd::SETVOLUME:
+    pokey.setEmuVolume(extCmd[1]);
+    break;
+  case ExtCmd::INCVOLUME:
+    pokey.setEmuVolume((volume > 255 - extCmd[1]) ? 255 : volume + extCmd[1]);
+    break;
+  case ExtCmd::DECVOLUME:
+    pokey.setEmuVolume((volume < extCmd[1]) ? 0 : volume - extCmd[1]);
+    break;
+  case ExtCmd::ATTACHCART:
+    insertCartridge(findCartridge(reinterpret_cast<const char *>(extCmd + 3)));
+    break;
+  case ExtCmd::DETACHCART:
+    removeCartridge();
+    break;
+  default:
+    // programs are loaded and saved by the Atari itself through H:
+    PlatformManager::getInstance().log(
+        LOG_INFO, TAG, "command %d not supported, use the H: device",
+        extCmd[0]);
+    break;
+  }
+}
+
+std::string Atari800Sys::findCartridge(const std::string &name) {
+  std::string path = std::string(Config::PATH) + name;
+  if (name.find('.') != std::string::npos) {
+    return path;
+  }
+  std::unique_ptr<FileDriver> file = FileSys::create();
+  if (file->init()) {
+    for (const char *ext : CARTEXTENSIONS) {
+      if (file->open(path + ext, "rb")) {
+        file->close();
+        return path + ext;
+      }
+    }
+  }
+  return path;
+}
+
+void Atari800Sys::latchInput() {
+  uint32_t state = inputLatch.latch();
+#ifdef USE_LATENCY_TRACE
+#ifdef USE_LATENCY_SCRIPT
+  uint8_t scripted = LatencyTrace::scriptJoystick(latencyTrace.getFrame());
+  latencyTrace.joystickPolled(scripted);
+  state = InputRouter::press(state, 0, scripted);
+#endif
+  latencyTrace.joystickLatched(InputRouter::getPortValue(state, 0),
+                               traceCycle());
+#endif
+  // The XL has two ports, TRIG2 and TRIG3 are not joystick triggers
+  pia.setSticks(InputRouter::getSticks(state));
+  gtia.setTriggers(InputRouter::getTriggers(state), 0x03);
+  for (uint8_t num = 0; num < InputLatch::NUMPADDLES; num++) {
+    pokey.setPaddle(num, inputLatch.latchPaddle(num));
+  }
+}
+
+void Atari800Sys::processKeyEvent(const AtariKeyEvent &ev) {
+  switch (ev.type) {
+  case AtariKeyEvent::Type::KEY:
+    pokey.setKeyCode(ev.code, ev.pressed);
+#ifdef USE_LATENCY_TRACE
+    if (ev.pressed) {
+      latencyTrace.applied(LatencyTrace::Source::KEYBOARD,
+                           LatencyTrace::Register::KBCODE, ev.time,
+                           traceCycle());
+    }
+#endif
+    break;
+  case AtariKeyEvent::Type::BREAK:
+    pokey.setBreakKey(ev.pressed);
+    break;
+  case AtariKeyEvent::Type::CONSOLE:
+    // GTIA expects the bit number
+    gtia.setConsoleKey(__builtin_ctz(ev.code), ev.pressed);
+#ifdef USE_LATENCY_TRACE
+    if (ev.pressed) {
+      latencyTrace.applied(LatencyTrace::Source::KEYBOARD,
+                           LatencyTrace::Register::CONSOL, ev.time,
+                           traceCycle());
+    }
+#endif
+    break;
+  }
+}
+
+#ifdef USE_OPCODE_PROFILE
+void Atari800Sys::reportOpcodeProfile() {
+  // "opprofile op=count ...", 16 opcodes per line, unused opcodes omitted
+  char line[16 * 14 + 16];
+  for (uint16_t first = 0; first < 256; first += 16) {
+    int len = snprintf(line, sizeof(line), "opprofile");
+    for (uint16_t op = first; op < first + 16; op++) {
+      if (opcodeCount[op]) {
+        len += snprintf(line + len, sizeof(line) - len, " %02x=%u", op,
+                        (unsigned)opcodeCount[op]);
+      }
+    }
+    if (len > 9) {
+      PlatformManager::getInstance().log(LOG_INFO, TAG, "%s", line);
+    }
   }
+  memset(opcodeCount, 0, sizeof(opcodeCount));
+  profileFrames = 0;
 }
+#endif
 
 void Atari800Sys::run() {
-  int64_t lastMeasuredTime = PlatformManager::getInstance().getTimeUS();
+  while (!cpuhalted) {
+    if (settings.pal) {
+      runFrames<PALTiming>();
+    } else {
+      runFrames<NTSCTiming>();
+    }
+  }
+}
+
+template <class Timing> void HOT_CODE Atari800Sys::runFrames() {
+  // restarts the schedule
+  pacer.setFrameRate(Timing::FRAMERATE);
   uint32_t totalCycles = 0;
 
   while (!cpuhalted) {
@@ -351,7 +753,13 @@ void Atari800Sys::run() {
       // Execute one instruction
       numofcycles = 0;
       logDebugInfo();
+#ifdef USE_OPCODE_PROFILE
+      uint8_t opcode = getMem(pc++);
+      opcodeCount[opcode]++;
+      execute(opcode);
+#else
       execute(getMem(pc++));
+#endif
       cyclesThisScanline += numofcycles;
       totalCycles += numofcycles;
 
@@ -366,10 +774,22 @@ void Atari800Sys::run() {
     antic.drawScanline();
 
     // Generate audio samples for this scanline
-    pokey.fillBuffer(antic.getScanline());
+    pokey.fillBuffer<Timing>(antic.getScanline());
+
+    // Keyboard: next queued event, POKEY scans one key per scanline
+    if (keyboard && pokey.readyForKeyEvent()) {
+      AtariKeyEvent ev;
+      if (keyboard->pollAtariKeyEvent(ev)) {
+        processKeyEvent(ev);
+      }
+    }
+    pokey.scanKeyboard();
+
+    // Paddles: POT counters advance once per scanline
+    pokey.scanPots();
 
     // Advance to next scanline
-    antic.nextScanline();
+    antic.nextScanline<Timing>();
 
     // End of frame handling
     if (antic.getScanline() == 0) {
@@ -379,21 +799,64 @@ void Atari800Sys::run() {
       // Reset NMI latch
       nmiActive = false;
 
-      // Frame timing
-      int64_t nominalFrameTime = lastMeasuredTime + (1000000 / 50);  // 50 Hz PAL
-      int64_t now = PlatformManager::getInstance().getTimeUS();
+#ifdef USE_LATENCY_TRACE
+      // Complete traced events, compares the finished frame
+      latencyTrace.frameEnd(antic.getBitmap(),
+                            ATARI_WIDTH * ATARI_HEIGHT * sizeof(uint16_t));
+#ifdef USE_LATENCY_SCRIPT
+      AtariKeyEvent ev;
+      if (LatencyTrace::scriptKey(latencyTrace.getFrame(), ev)) {
+        processKeyEvent(ev);
+      }
+#endif
+#endif
+
+      // Joystick state for this frame, before the VBI reads it
+      pollInput();
+      latchInput();
+
+      // (Re)install H: device after OS initialization or warm start
+      hdevice.installHandler();
+
+      // Settings changed in the configuration file
+      if (profile.takeChanged()) {
+        applySettings(profile.select(titleCrc));
+      }
+
+      // Command taken by pollInput (reset, volume, cartridge)
+      if (extCmdPending) {
+        executeExtCmd();
+        extCmdPending = false;
+      }
 
-      if (nominalFrameTime > now) {
-        PlatformManager::getInstance().waitUS(nominalFrameTime - now);
+      // Record the boot snapshot once the title code is running
+      if (bootCache.isRecording()) {
+        bootCache.frame(*this, cartridge.isInserted() && (pc >= 0x8000) &&
+                                   (pc < 0xc000));
       }
 
-      lastMeasuredTime = PlatformManager::getInstance().getTimeUS();
+      // Frame timing (50 Hz PAL, 60 Hz NTSC)
+      bool published = pacer.wait();
+
+#ifdef USE_OPCODE_PROFILE
+      if (++profileFrames >= PROFILEFRAMES) {
+        reportOpcodeProfile();
+      }
+#endif
 
       // Update profiling
       if (perf) {
-        numofcyclespersecond = totalCycles * 50;
+        numofcyclespersecond = totalCycles * Timing::FRAMERATE;
+        if (published) {
+          pacer.log();
+        }
       }
       totalCycles = 0;
+
+      // Video standard changed by the settings
+      if (settings.pal != Timing::PAL) {
+        return;
+      }
     }
   }
 }
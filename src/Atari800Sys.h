@@ -18,14 +18,26 @@
 #define ATARI800SYS_H
 
 #include "ANTIC.h"
+#include "BootCache.h"
 #include "CPU6502.h"
+#include "Cartridge.h"
+#include "ConfigProfile.h"
+#include "FramePacer.h"
 #include "GTIA.h"
+#include "HDevice.h"
+#include "InputLatch.h"
+#include "InputRouter.h"
+#include "LatencyTrace.h"
 #include "PIA.h"
 #include "POKEY.h"
+#include "Snapshot.h"
 #include "keyboard/KeyboardDriver.h"
+#include "roms/RomLoader.h"
 #include "joystick/JoystickDriver.h"
 #include <atomic>
 #include <cstdint>
+#include <string>
+#include <vector>
 
 // Atari 800 XL/XE Memory Map
 // $0000-$3FFF: RAM (16KB base)
@@ -38,7 +50,8 @@
 // $D200-$D2FF: POKEY registers (mirrored)
 // $D300-$D3FF: PIA registers (mirrored)
 // $D400-$D4FF: ANTIC registers (mirrored)
-// $D500-$D7FF: (reserved/cart control)
+// $D500-$D5FF: Cartridge control (bank switching)
+// $D600-$D6FF: H: device handler (emulator patch page)
 // $D800-$FFFF: OS ROM / floating point / character set
 
 // Memory size options
@@ -65,14 +78,49 @@ private:
   const uint8_t *osRom;            // OS ROM (16KB)
   const uint8_t *basicRom;         // BASIC ROM (8KB)
   const uint8_t *charRom;          // Character ROM (built into OS)
+  RomDescriptor osRomDesc;
+  RomDescriptor basicRomDesc;
 
   // Banking state (XL/XE)
   bool osRomEnabled;               // OS ROM visible ($C000-$FFFF)
   bool basicRomEnabled;            // BASIC ROM visible ($A000-$BFFF)
   bool selfTestEnabled;            // Self-test ROM visible ($5000-$57FF)
 
+  // Page tables (256 byte pages), nullptr: I/O area ($D000-$D7FF)
+  const uint8_t *readPage[256];
+  uint8_t *writePage[256];
+  uint8_t romWritePage[256];       // Sink for writes to cartridge ROM
+
+  void mapMemory();
+  void mapCartridge();
+
+  // Runtime settings of the running title (see ConfigProfile)
+  uint32_t titleCrc;
+  ProfileSettings settings;
+  void applySettings(const ProfileSettings &s);
+
+  // Scanline loop for one video standard (see VideoTiming.h), returns when
+  // the standard changes
+  template <class Timing> void runFrames();
+
+  // Machine configuration as part of the boot cache key (PAL, 64K RAM)
+  uint32_t machineConfig() const;
+
   // Input devices
   JoystickDriver *joystick;
+  InputLatch inputLatch;
+  InputRouter inputRouter;
+  void processKeyEvent(const AtariKeyEvent &ev);
+  void latchInput();
+
+  // External commands other than the joystick routing are copied from the
+  // keyboard driver by pollInput and executed after the input is latched.
+  // Layout as the driver buffer (see ExtCmd.h).
+  static const uint8_t EXTCMDSIZE = 64;
+  uint8_t extCmd[EXTCMDSIZE];
+  bool extCmdPending;
+  bool takeExtCmd(const uint8_t *cmd);
+  void executeExtCmd();
 
   // Internal state
   bool nmiActive;                  // NMI being processed
@@ -85,6 +133,27 @@ private:
   // Debug
   inline void logDebugInfo() __attribute__((always_inline));
 
+#ifdef USE_OPCODE_PROFILE
+  // Executed instructions per opcode, logged every PROFILEFRAMES frames as
+  // input for tools/hotopcodes.py
+  static const uint16_t PROFILEFRAMES = 500;
+  uint32_t opcodeCount[256];
+  uint16_t profileFrames;
+  void reportOpcodeProfile();
+#endif
+
+#ifdef USE_LATENCY_TRACE
+  // Emulated cycles since power on, as seen by the latency trace
+  uint64_t traceCycle() const {
+    uint16_t scanlines =
+        settings.pal ? PALTiming::SCANLINES : NTSCTiming::SCANLINES;
+    return (static_cast<uint64_t>(latencyTrace.getFrame()) * scanlines +
+            antic.getScanline()) *
+               cyclesPerScanline +
+           cyclesThisScanline;
+  }
+#endif
+
 public:
   // Hardware chips
   ANTIC antic;
@@ -92,9 +161,35 @@ public:
   POKEY pokey;
   PIA pia;
 
+  // Host filesystem device
+  HDevice hdevice;
+
+  // Cartridge ($8000-$BFFF, controlled by $D500-$D5FF)
+  Cartridge cartridge;
+
+  // Post-boot snapshots of inserted titles
+  BootCache bootCache;
+
+  // Runtime configuration with per-title overrides
+  ConfigProfile profile;
+
+  // Display and audio settings of the running title, applied by the
+  // performance governor
+  std::atomic<uint8_t> titleFrameSkip;
+  std::atomic<bool> titleSkipStatic;
+  std::atomic<uint8_t> titleAudioStep;
+
+#ifdef USE_LATENCY_TRACE
+  // Input latency instrumentation
+  LatencyTrace latencyTrace;
+#endif
+
   // Keyboard
   KeyboardDriver *keyboard;
 
+  // Frame timing
+  FramePacer pacer;
+
   // Profiling
   std::atomic<uint32_t> numofcyclespersecond;
   std::atomic<bool> perf;
@@ -103,7 +198,8 @@ public:
   ~Atari800Sys();
 
   // Initialization
-  void init(uint8_t *ram, const uint8_t *osRom, const uint8_t *basicRom);
+  void init(uint8_t *ram, const RomDescriptor &osRom,
+            const RomDescriptor &basicRom);
   void reset();
 
   // CPU6502 interface implementations
@@ -125,6 +221,22 @@ public:
   // Banking control (XL/XE)
   void updateBanking();
 
+  // Cartridge handling, both functions perform a cold start (or restore
+  // the boot snapshot of the cartridge)
+  bool insertCartridge(const std::string &path);
+  void removeCartridge();
+
+  // Reset with the inserted title booted from its snapshot, if there is one
+  void coldStart();
+
+  // Path of the image name in Config::PATH, for a name without extension
+  // the first existing of .car, .rom, .car.gz, .rom.gz and .zip
+  static std::string findCartridge(const std::string &name);
+
+  // Complete machine state (RAM, CPU, chips, banking), see Snapshot.h
+  void saveState(SnapshotWriter &w);
+  bool loadState(SnapshotReader &r);
+
   // Interrupt helpers
   void checkInterrupts();
   bool handleNMI();
@@ -135,8 +247,26 @@ public:
   uint16_t getPC() const { return pc; }
   uint8_t *getRam() { return ram; }
 
-  // Keyboard scanning
-  void scanKeyboard();
+  /**
+   * @brief Describes the host memory written by CPU writes to len bytes at
+   * addr (RAM or the ROM write sink) as spans, see FileDriver::readv.
+   * Stops at the I/O area and at the end of the address space.
+   *
+   * @return Number of bytes covered by the spans.
+   */
+  size_t getWriteSpans(uint16_t addr, uint16_t len,
+                       std::vector<ByteSpan> &spans);
+  const RomDescriptor &getOSRom() const { return osRomDesc; }
+  const RomDescriptor &getBasicRom() const { return basicRomDesc; }
+
+  /**
+   * @brief Polls the input drivers and publishes their state.
+   *
+   * Is called by the CPU task at the end of each frame, right before the
+   * state is latched, so neither a timer nor the display refresh is
+   * involved. External commands are executed at the end of the same frame.
+   */
+  void pollInput();
 };
 
 #endif // ATARI800SYS_H
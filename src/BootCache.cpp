@@ -0,0 +1,207 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "BootCache.h"
+#include "Atari800Sys.h"
+#include "Config.h"
+#include "Crc32.h"
+#include "Snapshot.h"
+#include "SnapshotCodec.h"
+#include "fs/FileFactory.h"
+#include "platform/PlatformManager.h"
+#include <cstdio>
+#include <cstring>
+#include <memory>
+
+static const char *TAG = "BootCache";
+
+static const char SNAPMAGIC[4] = {'A', 'B', 'C', '2'};
+static const uint32_t SNAPHEADERSIZE = 20;
+// upper bound of the machine state (64K RAM and the chips, about 66K)
+static const uint32_t MAXRAWSIZE = 128 * 1024;
+
+BootCache::BootCache()
+    : fileIO(nullptr), state(State::IDLE), key(0), frames(0), rawSize(0),
+      compSize(0), compressUS(0), writeUS(0), rawWriteUS(0) {}
+
+std::string BootCache::fileName(uint32_t key) {
+  // hidden file, not listed by the directory index
+  char name[24];
+  snprintf(name, sizeof(name), ".boot-%08x.snp", (unsigned)key);
+  return std::string(Config::PATH) + name;
+}
+
+uint32_t BootCache::hashImage(const std::string &path) {
+  std::unique_ptr<FileDriver> file = FileSys::create();
+  if (!file->init() || !file->open(path, "rb")) {
+    return 0;
+  }
+  uint8_t buf[512];
+  uint32_t crc = 0;
+  size_t n;
+  while ((n = file->read(buf, sizeof(buf))) > 0) {
+    crc = Crc32::update(crc, buf, n);
+  }
+  file->close();
+  return crc;
+}
+
+uint32_t BootCache::makeKey(uint32_t imageCrc, const RomDescriptor &osRom,
+                            const RomDescriptor &basicRom,
+                            uint32_t machineConfig) {
+  uint32_t parts[5] = {imageCrc, osRom.crc32, basicRom.crc32, machineConfig,
+                       SNAPSHOT_VERSION};
+  return Crc32::update(0, parts, sizeof(parts));
+}
+
+bool BootCache::start(Atari800Sys &sys, uint32_t key) {
+  this->key = key;
+  state = State::IDLE;
+  std::unique_ptr<FileDriver> file = FileSys::create();
+  if (!file->init()) {
+    return false;
+  }
+  if (file->open(fileName(key), "rb")) {
+    uint8_t header[SNAPHEADERSIZE];
+    uint32_t hdr[4];
+    std::vector<uint8_t> comp;
+    std::vector<uint8_t> raw;
+    bool ok = (file->read(header, SNAPHEADERSIZE) == SNAPHEADERSIZE) &&
+              (memcmp(header, SNAPMAGIC, 4) == 0);
+    if (ok) {
+      // key, raw size, raw CRC, compressed size; the sizes are checked
+      // before anything is allocated for them
+      memcpy(hdr, header + 4, sizeof(hdr));
+      ok = (hdr[0] == key) && (hdr[1] <= MAXRAWSIZE) &&
+           (hdr[3] <= file->size() - SNAPHEADERSIZE);
+    }
+    if (ok) {
+      comp.resize(hdr[3]);
+      ok = (file->read(comp.data(), comp.size()) == comp.size()) &&
+           SnapshotCodec::decompress(comp.data(), comp.size(), raw,
+                                     hdr[1]) &&
+           (Crc32::update(0, raw.data(), raw.size()) == hdr[2]);
+    }
+    file->close();
+    if (ok) {
+      SnapshotReader r(raw.data(), raw.size());
+      if (sys.loadState(r)) {
+        PlatformManager::getInstance().log(LOG_INFO, TAG,
+                                           "restored snapshot %08x",
+                                           (unsigned)key);
+        return true;
+      }
+      sys.reset();
+    }
+    PlatformManager::getInstance().log(LOG_WARN, TAG,
+                                       "snapshot %08x invalid",
+                                       (unsigned)key);
+  }
+  state = State::WAITSTART;
+  frames = 0;
+  return false;
+}
+
+void BootCache::frame(Atari800Sys &sys, bool titleRunning) {
+  switch (state) {
+  case State::WAITSTART:
+    if (titleRunning) {
+      state = State::SETTLING;
+      frames = 0;
+    } else if (++frames >= MAXWAITFRAMES) {
+      PlatformManager::getInstance().log(LOG_INFO, TAG,
+                                         "title did not start, no snapshot");
+      state = State::IDLE;
+    }
+    break;
+  case State::SETTLING:
+    if (++frames >= STABLEFRAMES) {
+      save(sys);
+      state = State::IDLE;
+    }
+    break;
+  default:
+    break;
+  }
+}
+
+void BootCache::save(Atari800Sys &sys) {
+  Platform &platform = PlatformManager::getInstance();
+  auto raw = std::make_shared<std::vector<uint8_t>>();
+  raw->reserve(MEM_64K + 1024);
+  SnapshotWriter w(*raw);
+  sys.saveState(w);
+
+  auto data = std::make_shared<std::vector<uint8_t>>();
+  data->reserve(raw->size() / 2);
+  data->resize(SNAPHEADERSIZE);
+  int64_t t0 = platform.getTimeUS();
+  SnapshotCodec::compress(raw->data(), raw->size(), *data);
+  compressUS = platform.getTimeUS() - t0;
+  rawSize = raw->size();
+  compSize = data->size();
+  uint32_t hdr[4] = {key, static_cast<uint32_t>(raw->size()),
+                     Crc32::update(0, raw->data(), raw->size()),
+                     static_cast<uint32_t>(data->size() - SNAPHEADERSIZE)};
+  memcpy(data->data(), SNAPMAGIC, 4);
+  memcpy(data->data() + 4, hdr, sizeof(hdr));
+  platform.log(LOG_INFO, TAG, "snapshot %08x: %d -> %d bytes in %d us",
+               (unsigned)key, (int)raw->size(), (int)data->size(),
+               (int)compressUS.load());
+  if (!sys.perf) {
+    raw.reset();
+  }
+
+  // the file is written by the I/O task, the emulation continues
+  std::string path = fileName(key);
+  auto writeFile = [](const std::string &path,
+                      const std::vector<uint8_t> &buf) {
+    std::unique_ptr<FileDriver> file = FileSys::create();
+    if (!file->open(path, "wb")) {
+      return false;
+    }
+    bool ok = file->write(buf.data(), buf.size()) == buf.size();
+    file->close();
+    return ok;
+  };
+  auto job = [this, data, raw, path, writeFile]() {
+    Platform &platform = PlatformManager::getInstance();
+    int64_t t0 = platform.getTimeUS();
+    bool ok = writeFile(path, *data);
+    writeUS = platform.getTimeUS() - t0;
+    if (ok && raw) {
+      // the uncompressed copy is only written for the timing comparison
+      std::string rawPath = std::string(Config::PATH) + ".boot-bench.raw";
+      t0 = platform.getTimeUS();
+      writeFile(rawPath, *raw);
+      rawWriteUS = platform.getTimeUS() - t0;
+      FileSys::create()->remove(rawPath);
+      platform.log(LOG_INFO, TAG, "write: %d us, uncompressed: %d us",
+                   (int)writeUS.load(), (int)rawWriteUS.load());
+    }
+    return ok;
+  };
+  if (fileIO) {
+    fileIO->call(job, [](AsyncFileIO::Request &req) {
+      if (!req.ok) {
+        PlatformManager::getInstance().log(LOG_WARN, TAG,
+                                           "cannot write snapshot");
+      }
+    });
+  } else if (!job()) {
+    platform.log(LOG_WARN, TAG, "cannot write snapshot");
+  }
+}
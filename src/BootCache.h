@@ -0,0 +1,107 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef BOOTCACHE_H
+#define BOOTCACHE_H
+
+#include "fs/AsyncFileIO.h"
+#include "roms/RomLoader.h"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Atari800Sys;
+
+/**
+ * @brief Per-title cache of the machine state after booting
+ *
+ * When a title is started the first time, the state of the machine is
+ * recorded STABLEFRAMES frames after the title code started to run and
+ * stored compressed in Config::PATH. Later starts of the same title
+ * restore this state instead of booting.
+ *
+ * The key of a snapshot covers the CRC-32 of the image, the OS and BASIC
+ * ROMs and the machine configuration, so snapshots become invalid when
+ * one of them changes.
+ */
+class BootCache {
+private:
+  static const uint16_t STABLEFRAMES = 100;
+  static const uint16_t MAXWAITFRAMES = 1500;
+
+  enum class State : uint8_t { IDLE, WAITSTART, SETTLING };
+
+  AsyncFileIO *fileIO;
+  State state;
+  uint32_t key;
+  uint16_t frames;
+
+  static std::string fileName(uint32_t key);
+  void save(Atari800Sys &sys);
+
+public:
+  // Statistics of the last snapshot, for the performance display.
+  // rawWriteUS is only measured if Atari800Sys::perf is set: the
+  // uncompressed snapshot is then written to a scratch file for comparison
+  // and deleted again.
+  std::atomic<uint32_t> rawSize;
+  std::atomic<uint32_t> compSize;
+  std::atomic<uint32_t> compressUS;
+  std::atomic<uint32_t> writeUS;
+  std::atomic<uint32_t> rawWriteUS;
+
+  BootCache();
+
+  void setFileIO(AsyncFileIO *fileIO) { this->fileIO = fileIO; }
+
+  /**
+   * @brief CRC-32 of the file at path, 0 if it cannot be read.
+   */
+  static uint32_t hashImage(const std::string &path);
+
+  /**
+   * @brief Combines image, ROMs and machine configuration into a key.
+   */
+  static uint32_t makeKey(uint32_t imageCrc, const RomDescriptor &osRom,
+                          const RomDescriptor &basicRom,
+                          uint32_t machineConfig);
+
+  /**
+   * @brief Restores the snapshot stored for key.
+   *
+   * If there is none, a snapshot is recorded during this run.
+   *
+   * @return true if the machine state was restored.
+   */
+  bool start(Atari800Sys &sys, uint32_t key);
+
+  /**
+   * @brief Stops recording, e.g. when the title is removed.
+   */
+  void cancel() { state = State::IDLE; }
+
+  bool isRecording() const { return state != State::IDLE; }
+
+  /**
+   * @brief Called at the end of each frame while recording.
+   *
+   * @param titleRunning true if the CPU currently executes title code.
+   */
+  void frame(Atari800Sys &sys, bool titleRunning);
+};
+
+#endif // BOOTCACHE_H
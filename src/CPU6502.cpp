@@ -15,43 +15,44 @@
  http://www.gnu.org/licenses/.
 */
 #include "CPU6502.h"
+#include "HotPlacement.h"
 
-void CPU6502::modeZeropage() {
+void HOT_CODE CPU6502::modeZeropage() {
   zl = getMem(pc++);
   z = zl;
 }
 
-void CPU6502::modeZeropageX() {
+void HOT_CODE CPU6502::modeZeropageX() {
   zl = getMem(pc++);
   zl += x;
   z = zl;
 }
 
-void CPU6502::modeZeropageY() {
+void HOT_CODE CPU6502::modeZeropageY() {
   zl = getMem(pc++);
   zl += y;
   z = zl;
 }
 
-void CPU6502::modeAbsolute() {
+void HOT_CODE CPU6502::modeAbsolute() {
   zl = getMem(pc++);
   zh = getMem(pc++);
   z = (zl + (zh << 8));
 }
 
-void CPU6502::modeAbsoluteX() {
+void HOT_CODE CPU6502::modeAbsoluteX() {
   zl = getMem(pc++);
   zh = getMem(pc++);
   z = (x + zl + (zh << 8));
 }
 
-void CPU6502::modeAbsoluteY() {
+void HOT_CODE CPU6502::modeAbsoluteY() {
   zl = getMem(pc++);
   zh = getMem(pc++);
   z = (y + zl + (zh << 8));
 }
 
-void CPU6502::modeIndirectX() {
+void HOT_CODE CPU6502::modeIndirectX() {
   uint8_t ql = getMem(pc++);
   ql += x;
   zl = getMem(ql++);
@@ -59,25 +60,25 @@ void CPU6502::modeIndirectX() {
   z = (zl + (zh << 8));
 }
 
-void CPU6502::modeIndirectY() {
+void HOT_CODE CPU6502::modeIndirectY() {
   uint16_t q = getMem(pc++);
   zl = getMem(q++);
   zh = getMem(q);
   z = (y + (zl | (zh << 8)));
 }
 
-void CPU6502::setNZ(uint8_t r) {
+void HOT_CODE CPU6502::setNZ(uint8_t r) {
   zflag = !r;
   nflag = r & 0x80;
 }
 
-void CPU6502::atestandsetNZ() { setNZ(a); }
+void HOT_CODE CPU6502::atestandsetNZ() { setNZ(a); }
 
-void CPU6502::xtestandsetNZ() { setNZ(x); }
+void HOT_CODE CPU6502::xtestandsetNZ() { setNZ(x); }
 
-void CPU6502::ytestandsetNZ() { setNZ(y); }
+void HOT_CODE CPU6502::ytestandsetNZ() { setNZ(y); }
 
-void CPU6502::branchbase(bool flag) {
+void HOT_CODE CPU6502::branchbase(bool flag) {
   int8_t r = getMem(pc++);
   if (flag) {
     uint16_t oldPC = pc;
@@ -90,7 +91,7 @@ void CPU6502::branchbase(bool flag) {
   numofcycles += 2;
 }
 
-void CPU6502::adcbase(uint8_t r) {
+void HOT_CODE CPU6502::adcbase(uint8_t r) {
   if (!dflag) {
     uint16_t a1 = a + r;
     if (cflag) {
@@ -124,7 +125,7 @@ void CPU6502::adcbase(uint8_t r) {
   }
 }
 
-void CPU6502::sbcbase(uint8_t r1) {
+void HOT_CODE CPU6502::sbcbase(uint8_t r1) {
   if (!dflag) {
     adcbase(~r1);
   } else {
@@ -150,21 +151,21 @@ void CPU6502::sbcbase(uint8_t r1) {
   }
 }
 
-void CPU6502::incbase() {
+void HOT_CODE CPU6502::incbase() {
   uint8_t r = getMem(z);
   r++;
   setMem(z, r);
   setNZ(r);
 }
 
-void CPU6502::decbase() {
+void HOT_CODE CPU6502::decbase() {
   uint8_t r = getMem(z);
   r--;
   setMem(z, r);
   setNZ(r);
 }
 
-void CPU6502::cmpbase(uint8_t r1, uint8_t r2) {
+void HOT_CODE CPU6502::cmpbase(uint8_t r1, uint8_t r2) {
   int16_t r = r1 - r2;
   cflag = true;
   if (r < 0) {
@@ -174,7 +175,7 @@ void CPU6502::cmpbase(uint8_t r1, uint8_t r2) {
   setNZ(r);
 }
 
-uint8_t CPU6502::aslbase0(uint8_t r) {
+uint8_t HOT_CODE CPU6502::aslbase0(uint8_t r) {
   uint16_t r1 = r << 1;
   cflag = false;
   if (r1 & 0x100) {
@@ -185,26 +186,26 @@ uint8_t CPU6502::aslbase0(uint8_t r) {
   return r1;
 }
 
-void CPU6502::aslbase() {
+void HOT_CODE CPU6502::aslbase() {
   uint8_t r = getMem(z);
   r = aslbase0(r);
   setMem(z, r);
 }
 
-uint8_t CPU6502::lsrbase0(uint8_t r) {
+uint8_t HOT_CODE CPU6502::lsrbase0(uint8_t r) {
   cflag = r & 0x01;
   r >>= 1;
   setNZ(r);
   return r;
 }
 
-void CPU6502::lsrbase() {
+void HOT_CODE CPU6502::lsrbase() {
   uint8_t r = getMem(z);
   r = lsrbase0(r);
   setMem(z, r);
 }
 
-uint8_t CPU6502::rolbase0(uint8_t r) {
+uint8_t HOT_CODE CPU6502::rolbase0(uint8_t r) {
   uint16_t r1 = r << 1;
   if (cflag) {
     r1 |= 1;
@@ -218,13 +219,13 @@ uint8_t CPU6502::rolbase0(uint8_t r) {
   return r1;
 }
 
-void CPU6502::rolbase() {
+void HOT_CODE CPU6502::rolbase() {
   uint8_t r = getMem(z);
   r = rolbase0(r);
   setMem(z, r);
 }
 
-uint8_t CPU6502::rorbase0(uint8_t r) {
+uint8_t HOT_CODE CPU6502::rorbase0(uint8_t r) {
   uint16_t r1 = r;
   if (cflag) {
     r1 |= 0x100;
@@ -235,13 +236,13 @@ uint8_t CPU6502::rorbase0(uint8_t r) {
   return r1;
 }
 
-void CPU6502::rorbase() {
+void HOT_CODE CPU6502::rorbase() {
   uint8_t r = getMem(z);
   r = rorbase0(r);
   setMem(z, r);
 }
 
-void CPU6502::bitBase() {
+void HOT_CODE CPU6502::bitBase() {
   uint8_t r = getMem(z);
   nflag = r & 128;
   vflag = r & 64;
@@ -249,7 +250,7 @@ void CPU6502::bitBase() {
   zflag = r == 0;
 }
 
-void CPU6502::srfromflags() {
+void HOT_CODE CPU6502::srfromflags() {
   sr = 32;
   if (cflag) {
     sr |= 1;
@@ -274,7 +275,7 @@ void CPU6502::srfromflags() {
   }
 }
 
-void CPU6502::flagsfromsr() {
+void HOT_CODE CPU6502::flagsfromsr() {
   cflag = sr & 1;
   zflag = sr & 2;
   iflag = sr & 4;
@@ -284,26 +285,26 @@ void CPU6502::flagsfromsr() {
   nflag = sr & 128;
 }
 
-void CPU6502::pushtostack(uint8_t r) {
+void HOT_CODE CPU6502::pushtostack(uint8_t r) {
   uint16_t z1 = sp + 0x100;
   setMem(z1, r);
   sp--;
 }
 
-uint8_t CPU6502::pullfromstack() {
+uint8_t HOT_CODE CPU6502::pullfromstack() {
   sp++;
   uint16_t z1 = sp + 0x100;
   return getMem(z1);
 }
 
-void CPU6502::cmd6502halt() { cpuhalted = true; }
+void HOT_OP(cmd6502halt) CPU6502::cmd6502halt() { cpuhalted = true; }
 
-void CPU6502::cmd6502brk() {
+void HOT_OP(cmd6502brk) CPU6502::cmd6502brk() {
   pc++;
   setPCToIntVec(getMem(0xfffe) + (getMem(0xffff) << 8), true);
 }
 
-void CPU6502::cmd6502oraIndirectX() {
+void HOT_OP(cmd6502oraIndirectX) CPU6502::cmd6502oraIndirectX() {
   modeIndirectX();
   uint8_t r = getMem(z);
   a |= r;
@@ -311,7 +312,7 @@ void CPU6502::cmd6502oraIndirectX() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502oraZeropage() {
+void HOT_OP(cmd6502oraZeropage) CPU6502::cmd6502oraZeropage() {
   modeZeropage();
   uint8_t r = getMem(z);
   a |= r;
@@ -319,35 +320,35 @@ void CPU6502::cmd6502oraZeropage() {
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502aslZeropage() {
+void HOT_OP(cmd6502aslZeropage) CPU6502::cmd6502aslZeropage() {
   modeZeropage();
   aslbase();
   numofcycles += 5;
 }
 
-void CPU6502::php() {
+void HOT_CODE CPU6502::php() {
   srfromflags();
   pushtostack(sr);
 }
 
-void CPU6502::cmd6502php() {
+void HOT_OP(cmd6502php) CPU6502::cmd6502php() {
   bflag = true;
   php();
 }
 
-void CPU6502::cmd6502oraImmediate() {
+void HOT_OP(cmd6502oraImmediate) CPU6502::cmd6502oraImmediate() {
   uint8_t r = getMem(pc++);
   a |= r;
   atestandsetNZ();
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502aslA() {
+void HOT_OP(cmd6502aslA) CPU6502::cmd6502aslA() {
   a = aslbase0(a);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502oraAbsolute() {
+void HOT_OP(cmd6502oraAbsolute) CPU6502::cmd6502oraAbsolute() {
   modeAbsolute();
   uint8_t r = getMem(z);
   a |= r;
@@ -355,15 +356,15 @@ void CPU6502::cmd6502oraAbsolute() {
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502aslAbsolute() {
+void HOT_OP(cmd6502aslAbsolute) CPU6502::cmd6502aslAbsolute() {
   modeAbsolute();
   aslbase();
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502bpl() { branchbase(!nflag); }
+void HOT_OP(cmd6502bpl) CPU6502::cmd6502bpl() { branchbase(!nflag); }
 
-void CPU6502::cmd6502oraIndirectY() {
+void HOT_OP(cmd6502oraIndirectY) CPU6502::cmd6502oraIndirectY() {
   uint16_t zold = z;
   modeIndirectY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -376,7 +377,7 @@ void CPU6502::cmd6502oraIndirectY() {
   }
 }
 
-void CPU6502::cmd6502oraZeropageX() {
+void HOT_OP(cmd6502oraZeropageX) CPU6502::cmd6502oraZeropageX() {
   modeZeropageX();
   uint8_t r = getMem(z);
   a |= r;
@@ -384,18 +385,18 @@ void CPU6502::cmd6502oraZeropageX() {
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502aslZeropageX() {
+void HOT_OP(cmd6502aslZeropageX) CPU6502::cmd6502aslZeropageX() {
   modeZeropageX();
   aslbase();
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502clc() {
+void HOT_OP(cmd6502clc) CPU6502::cmd6502clc() {
   cflag = false;
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502oraAbsoluteY() {
+void HOT_OP(cmd6502oraAbsoluteY) CPU6502::cmd6502oraAbsoluteY() {
   uint16_t zold = z;
   modeAbsoluteY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -408,7 +409,7 @@ void CPU6502::cmd6502oraAbsoluteY() {
   }
 }
 
-void CPU6502::cmd6502oraAbsoluteX() {
+void HOT_OP(cmd6502oraAbsoluteX) CPU6502::cmd6502oraAbsoluteX() {
   uint16_t zold = z;
   modeAbsoluteX();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -421,13 +422,13 @@ void CPU6502::cmd6502oraAbsoluteX() {
   }
 }
 
-void CPU6502::cmd6502aslAbsoluteX() {
+void HOT_OP(cmd6502aslAbsoluteX) CPU6502::cmd6502aslAbsoluteX() {
   modeAbsoluteX();
   aslbase();
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502jsr() {
+void HOT_OP(cmd6502jsr) CPU6502::cmd6502jsr() {
   uint8_t ql = getMem(pc++);
   // push actual address to 6502 stack
   uint8_t pcl = pc & 0xFF;
@@ -441,7 +442,7 @@ void CPU6502::cmd6502jsr() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502andIndirectX() {
+void HOT_OP(cmd6502andIndirectX) CPU6502::cmd6502andIndirectX() {
   modeIndirectX();
   uint8_t r = getMem(z);
   a &= r;
@@ -449,13 +450,13 @@ void CPU6502::cmd6502andIndirectX() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502bitZeropage() {
+void HOT_OP(cmd6502bitZeropage) CPU6502::cmd6502bitZeropage() {
   modeZeropage();
   bitBase();
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502andZeropage() {
+void HOT_OP(cmd6502andZeropage) CPU6502::cmd6502andZeropage() {
   modeZeropage();
   uint8_t r = getMem(z);
   a &= r;
@@ -463,30 +464,30 @@ void CPU6502::cmd6502andZeropage() {
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502rolZeropage() {
+void HOT_OP(cmd6502rolZeropage) CPU6502::cmd6502rolZeropage() {
   modeZeropage();
   rolbase();
   numofcycles += 5;
 }
 
-void CPU6502::plp() {
+void HOT_CODE CPU6502::plp() {
   sr = pullfromstack();
   flagsfromsr();
 }
 
-void CPU6502::cmd6502plp() {
+void HOT_OP(cmd6502plp) CPU6502::cmd6502plp() {
   plp();
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502andImmediate() {
+void HOT_OP(cmd6502andImmediate) CPU6502::cmd6502andImmediate() {
   uint8_t r = getMem(pc++);
   a &= r;
   atestandsetNZ();
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502ancImmediate() {
+void HOT_OP(cmd6502ancImmediate) CPU6502::cmd6502ancImmediate() {
   uint8_t r = getMem(pc++);
   a &= r;
   atestandsetNZ();
@@ -494,18 +495,18 @@ void CPU6502::cmd6502ancImmediate() {
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502rolA() {
+void HOT_OP(cmd6502rolA) CPU6502::cmd6502rolA() {
   a = rolbase0(a);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502bitAbsolute() {
+void HOT_OP(cmd6502bitAbsolute) CPU6502::cmd6502bitAbsolute() {
   modeAbsolute();
   bitBase();
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502andAbsolute() {
+void HOT_OP(cmd6502andAbsolute) CPU6502::cmd6502andAbsolute() {
   modeAbsolute();
   uint8_t r = getMem(z);
   a &= r;
@@ -513,15 +514,15 @@ void CPU6502::cmd6502andAbsolute() {
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502rolAbsolute() {
+void HOT_OP(cmd6502rolAbsolute) CPU6502::cmd6502rolAbsolute() {
   modeAbsolute();
   rolbase();
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502bmi() { branchbase(nflag); }
+void HOT_OP(cmd6502bmi) CPU6502::cmd6502bmi() { branchbase(nflag); }
 
-void CPU6502::cmd6502andIndirectY() {
+void HOT_OP(cmd6502andIndirectY) CPU6502::cmd6502andIndirectY() {
   uint16_t zold = z;
   modeIndirectY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -534,7 +535,7 @@ void CPU6502::cmd6502andIndirectY() {
   }
 }
 
-void CPU6502::cmd6502andZeropageX() {
+void HOT_OP(cmd6502andZeropageX) CPU6502::cmd6502andZeropageX() {
   modeZeropageX();
   uint8_t r = getMem(z);
   a &= r;
@@ -542,18 +543,18 @@ void CPU6502::cmd6502andZeropageX() {
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502rolZeropageX() {
+void HOT_OP(cmd6502rolZeropageX) CPU6502::cmd6502rolZeropageX() {
   modeZeropageX();
   rolbase();
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502sec() {
+void HOT_OP(cmd6502sec) CPU6502::cmd6502sec() {
   cflag = true;
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502andAbsoluteY() {
+void HOT_OP(cmd6502andAbsoluteY) CPU6502::cmd6502andAbsoluteY() {
   uint16_t zold = z;
   modeAbsoluteY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -566,7 +567,7 @@ void CPU6502::cmd6502andAbsoluteY() {
   }
 }
 
-void CPU6502::cmd6502andAbsoluteX() {
+void HOT_OP(cmd6502andAbsoluteX) CPU6502::cmd6502andAbsoluteX() {
   uint16_t zold = z;
   modeAbsoluteX();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -579,13 +580,13 @@ void CPU6502::cmd6502andAbsoluteX() {
   }
 }
 
-void CPU6502::cmd6502rolAbsoluteX() {
+void HOT_OP(cmd6502rolAbsoluteX) CPU6502::cmd6502rolAbsoluteX() {
   modeAbsoluteX();
   rolbase();
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502rti() {
+void HOT_OP(cmd6502rti) CPU6502::cmd6502rti() {
   // get status register from stack
   plp();
   // get return address from stack
@@ -595,7 +596,7 @@ void CPU6502::cmd6502rti() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502eorIndirectX() {
+void HOT_OP(cmd6502eorIndirectX) CPU6502::cmd6502eorIndirectX() {
   modeIndirectX();
   uint8_t r = getMem(z);
   a ^= r;
@@ -603,7 +604,7 @@ void CPU6502::cmd6502eorIndirectX() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502eorZeropage() {
+void HOT_OP(cmd6502eorZeropage) CPU6502::cmd6502eorZeropage() {
   modeZeropage();
   uint8_t r = getMem(z);
   a ^= r;
@@ -611,36 +612,36 @@ void CPU6502::cmd6502eorZeropage() {
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502lsrZeropage() {
+void HOT_OP(cmd6502lsrZeropage) CPU6502::cmd6502lsrZeropage() {
   modeZeropage();
   lsrbase();
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502pha() {
+void HOT_OP(cmd6502pha) CPU6502::cmd6502pha() {
   pushtostack(a);
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502eorImmediate() {
+void HOT_OP(cmd6502eorImmediate) CPU6502::cmd6502eorImmediate() {
   uint8_t r = getMem(pc++);
   a ^= r;
   atestandsetNZ();
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502lsrA() {
+void HOT_OP(cmd6502lsrA) CPU6502::cmd6502lsrA() {
   a = lsrbase0(a);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502jmpAbsolute() {
+void HOT_OP(cmd6502jmpAbsolute) CPU6502::cmd6502jmpAbsolute() {
   modeAbsolute();
   pc = z;
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502eorAbsolute() {
+void HOT_OP(cmd6502eorAbsolute) CPU6502::cmd6502eorAbsolute() {
   modeAbsolute();
   uint8_t r = getMem(z);
   a ^= r;
@@ -648,15 +649,15 @@ void CPU6502::cmd6502eorAbsolute() {
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502lsrAbsolute() {
+void HOT_OP(cmd6502lsrAbsolute) CPU6502::cmd6502lsrAbsolute() {
   modeAbsolute();
   lsrbase();
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502bvc() { branchbase(!vflag); }
+void HOT_OP(cmd6502bvc) CPU6502::cmd6502bvc() { branchbase(!vflag); }
 
-void CPU6502::cmd6502eorIndirectY() {
+void HOT_OP(cmd6502eorIndirectY) CPU6502::cmd6502eorIndirectY() {
   uint16_t zold = z;
   modeIndirectY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -669,7 +670,7 @@ void CPU6502::cmd6502eorIndirectY() {
   }
 }
 
-void CPU6502::cmd6502eorZeropageX() {
+void HOT_OP(cmd6502eorZeropageX) CPU6502::cmd6502eorZeropageX() {
   modeZeropageX();
   uint8_t r = getMem(z);
   a ^= r;
@@ -677,18 +678,18 @@ void CPU6502::cmd6502eorZeropageX() {
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502lsrZeropageX() {
+void HOT_OP(cmd6502lsrZeropageX) CPU6502::cmd6502lsrZeropageX() {
   modeZeropageX();
   lsrbase();
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502cli() {
+void HOT_OP(cmd6502cli) CPU6502::cmd6502cli() {
   iflag = false;
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502eorAbsoluteY() {
+void HOT_OP(cmd6502eorAbsoluteY) CPU6502::cmd6502eorAbsoluteY() {
   uint16_t zold = z;
   modeAbsoluteY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -701,7 +702,7 @@ void CPU6502::cmd6502eorAbsoluteY() {
   }
 }
 
-void CPU6502::cmd6502eorAbsoluteX() {
+void HOT_OP(cmd6502eorAbsoluteX) CPU6502::cmd6502eorAbsoluteX() {
   uint16_t zold = z;
   modeAbsoluteX();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -714,57 +715,57 @@ void CPU6502::cmd6502eorAbsoluteX() {
   }
 }
 
-void CPU6502::cmd6502lsrAbsoluteX() {
+void HOT_OP(cmd6502lsrAbsoluteX) CPU6502::cmd6502lsrAbsoluteX() {
   modeAbsoluteX();
   lsrbase();
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502rts() {
+void HOT_OP(cmd6502rts) CPU6502::cmd6502rts() {
   uint8_t pcl = pullfromstack();
   uint8_t pch = pullfromstack();
   pc = (pcl + 1 + (pch << 8));
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502adcIndirectX() {
+void HOT_OP(cmd6502adcIndirectX) CPU6502::cmd6502adcIndirectX() {
   modeIndirectX();
   uint8_t r = getMem(z);
   adcbase(r);
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502adcZeropage() {
+void HOT_OP(cmd6502adcZeropage) CPU6502::cmd6502adcZeropage() {
   modeZeropage();
   uint8_t r = getMem(z);
   adcbase(r);
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502rorZeropage() {
+void HOT_OP(cmd6502rorZeropage) CPU6502::cmd6502rorZeropage() {
   modeZeropage();
   rorbase();
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502pla() {
+void HOT_OP(cmd6502pla) CPU6502::cmd6502pla() {
   a = pullfromstack();
   atestandsetNZ();
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502adcImmediate() {
+void HOT_OP(cmd6502adcImmediate) CPU6502::cmd6502adcImmediate() {
   uint8_t r = getMem(pc++);
   adcbase(r);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502rorA() {
+void HOT_OP(cmd6502rorA) CPU6502::cmd6502rorA() {
   a = rorbase0(a);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502jmpIndirect() {
+void HOT_OP(cmd6502jmpIndirect) CPU6502::cmd6502jmpIndirect() {
   modeAbsolute();
   uint8_t r1 = getMem(z);
   zl++;
@@ -774,22 +775,22 @@ void CPU6502::cmd6502jmpIndirect() {
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502adcAbsolute() {
+void HOT_OP(cmd6502adcAbsolute) CPU6502::cmd6502adcAbsolute() {
   modeAbsolute();
   uint8_t r = getMem(z);
   adcbase(r);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502rorAbsolute() {
+void HOT_OP(cmd6502rorAbsolute) CPU6502::cmd6502rorAbsolute() {
   modeAbsolute();
   rorbase();
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502bvs() { branchbase(vflag); }
+void HOT_OP(cmd6502bvs) CPU6502::cmd6502bvs() { branchbase(vflag); }
 
-void CPU6502::cmd6502adcIndirectY() {
+void HOT_OP(cmd6502adcIndirectY) CPU6502::cmd6502adcIndirectY() {
   uint16_t zold = z;
   modeIndirectY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -801,25 +802,25 @@ void CPU6502::cmd6502adcIndirectY() {
   }
 }
 
-void CPU6502::cmd6502adcZeropageX() {
+void HOT_OP(cmd6502adcZeropageX) CPU6502::cmd6502adcZeropageX() {
   modeZeropageX();
   uint8_t r = getMem(z);
   adcbase(r);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502rorZeropageX() {
+void HOT_OP(cmd6502rorZeropageX) CPU6502::cmd6502rorZeropageX() {
   modeZeropageX();
   rorbase();
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502sei() {
+void HOT_OP(cmd6502sei) CPU6502::cmd6502sei() {
   iflag = true;
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502adcAbsoluteY() {
+void HOT_OP(cmd6502adcAbsoluteY) CPU6502::cmd6502adcAbsoluteY() {
   uint16_t zold = z;
   modeAbsoluteY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -831,7 +832,7 @@ void CPU6502::cmd6502adcAbsoluteY() {
   }
 }
 
-void CPU6502::cmd6502adcAbsoluteX() {
+void HOT_OP(cmd6502adcAbsoluteX) CPU6502::cmd6502adcAbsoluteX() {
   uint16_t zold = z;
   modeAbsoluteX();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -843,129 +844,129 @@ void CPU6502::cmd6502adcAbsoluteX() {
   }
 }
 
-void CPU6502::cmd6502rorAbsoluteX() {
+void HOT_OP(cmd6502rorAbsoluteX) CPU6502::cmd6502rorAbsoluteX() {
   modeAbsoluteX();
   rorbase();
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502staIndirectX() {
+void HOT_OP(cmd6502staIndirectX) CPU6502::cmd6502staIndirectX() {
   modeIndirectX();
   setMem(z, a);
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502styZeropage() {
+void HOT_OP(cmd6502styZeropage) CPU6502::cmd6502styZeropage() {
   modeZeropage();
   setMem(z, y);
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502staZeropage() {
+void HOT_OP(cmd6502staZeropage) CPU6502::cmd6502staZeropage() {
   modeZeropage();
   setMem(z, a);
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502stxZeropage() {
+void HOT_OP(cmd6502stxZeropage) CPU6502::cmd6502stxZeropage() {
   modeZeropage();
   setMem(z, x);
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502dey() {
+void HOT_OP(cmd6502dey) CPU6502::cmd6502dey() {
   y--;
   setNZ(y);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502txa() {
+void HOT_OP(cmd6502txa) CPU6502::cmd6502txa() {
   a = x;
   atestandsetNZ();
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502styAbsolute() {
+void HOT_OP(cmd6502styAbsolute) CPU6502::cmd6502styAbsolute() {
   modeAbsolute();
   setMem(z, y);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502staAbsolute() {
+void HOT_OP(cmd6502staAbsolute) CPU6502::cmd6502staAbsolute() {
   modeAbsolute();
   setMem(z, a);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502stxAbsolute() {
+void HOT_OP(cmd6502stxAbsolute) CPU6502::cmd6502stxAbsolute() {
   modeAbsolute();
   setMem(z, x);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502bcc() { branchbase(!cflag); }
+void HOT_OP(cmd6502bcc) CPU6502::cmd6502bcc() { branchbase(!cflag); }
 
-void CPU6502::cmd6502staIndirectY() {
+void HOT_OP(cmd6502staIndirectY) CPU6502::cmd6502staIndirectY() {
   modeIndirectY();
   setMem(z, a);
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502styZeropageX() {
+void HOT_OP(cmd6502styZeropageX) CPU6502::cmd6502styZeropageX() {
   modeZeropageX();
   setMem(z, y);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502staZeropageX() {
+void HOT_OP(cmd6502staZeropageX) CPU6502::cmd6502staZeropageX() {
   modeZeropageX();
   setMem(z, a);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502stxZeropageY() {
+void HOT_OP(cmd6502stxZeropageY) CPU6502::cmd6502stxZeropageY() {
   modeZeropageY();
   setMem(z, x);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502tya() {
+void HOT_OP(cmd6502tya) CPU6502::cmd6502tya() {
   a = y;
   atestandsetNZ();
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502staAbsoluteY() {
+void HOT_OP(cmd6502staAbsoluteY) CPU6502::cmd6502staAbsoluteY() {
   modeAbsoluteY();
   setMem(z, a);
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502txs() {
+void HOT_OP(cmd6502txs) CPU6502::cmd6502txs() {
   sp = x;
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502staAbsoluteX() {
+void HOT_OP(cmd6502staAbsoluteX) CPU6502::cmd6502staAbsoluteX() {
   modeAbsoluteX();
   setMem(z, a);
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502ldyImmediate() {
+void HOT_OP(cmd6502ldyImmediate) CPU6502::cmd6502ldyImmediate() {
   y = getMem(pc++);
   ytestandsetNZ();
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502ldaIndirectX() {
+void HOT_OP(cmd6502ldaIndirectX) CPU6502::cmd6502ldaIndirectX() {
   modeIndirectX();
   a = getMem(z);
   atestandsetNZ();
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502laxIndirectX() {
+void HOT_OP(cmd6502laxIndirectX) CPU6502::cmd6502laxIndirectX() {
   modeIndirectX();
   a = getMem(z);
   x = a;
@@ -973,27 +974,27 @@ void CPU6502::cmd6502laxIndirectX() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502ldxImmediate() {
+void HOT_OP(cmd6502ldxImmediate) CPU6502::cmd6502ldxImmediate() {
   x = getMem(pc++);
   xtestandsetNZ();
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502ldyZeropage() {
+void HOT_OP(cmd6502ldyZeropage) CPU6502::cmd6502ldyZeropage() {
   modeZeropage();
   y = getMem(z);
   ytestandsetNZ();
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502ldaZeropage() {
+void HOT_OP(cmd6502ldaZeropage) CPU6502::cmd6502ldaZeropage() {
   modeZeropage();
   a = getMem(z);
   atestandsetNZ();
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502laxZeropage() {
+void HOT_OP(cmd6502laxZeropage) CPU6502::cmd6502laxZeropage() {
   modeZeropage();
   a = getMem(z);
   x = a;
@@ -1001,53 +1002,53 @@ void CPU6502::cmd6502laxZeropage() {
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502lxaImmediate() {
+void HOT_OP(cmd6502lxaImmediate) CPU6502::cmd6502lxaImmediate() {
   a = getMem(pc++);
   x = a;
   atestandsetNZ();
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502ldxZeropage() {
+void HOT_OP(cmd6502ldxZeropage) CPU6502::cmd6502ldxZeropage() {
   modeZeropage();
   x = getMem(z);
   xtestandsetNZ();
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502tay() {
+void HOT_OP(cmd6502tay) CPU6502::cmd6502tay() {
   y = a;
   ytestandsetNZ();
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502ldaImmediate() {
+void HOT_OP(cmd6502ldaImmediate) CPU6502::cmd6502ldaImmediate() {
   a = getMem(pc++);
   atestandsetNZ();
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502tax() {
+void HOT_OP(cmd6502tax) CPU6502::cmd6502tax() {
   x = a;
   xtestandsetNZ();
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502ldyAbsolute() {
+void HOT_OP(cmd6502ldyAbsolute) CPU6502::cmd6502ldyAbsolute() {
   modeAbsolute();
   y = getMem(z);
   ytestandsetNZ();
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502ldaAbsolute() {
+void HOT_OP(cmd6502ldaAbsolute) CPU6502::cmd6502ldaAbsolute() {
   modeAbsolute();
   a = getMem(z);
   atestandsetNZ();
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502laxAbsolute() {
+void HOT_OP(cmd6502laxAbsolute) CPU6502::cmd6502laxAbsolute() {
   modeAbsolute();
   a = getMem(z);
   x = a;
@@ -1055,16 +1056,16 @@ void CPU6502::cmd6502laxAbsolute() {
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502ldxAbsolute() {
+void HOT_OP(cmd6502ldxAbsolute) CPU6502::cmd6502ldxAbsolute() {
   modeAbsolute();
   x = getMem(z);
   xtestandsetNZ();
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502bcs() { branchbase(cflag); }
+void HOT_OP(cmd6502bcs) CPU6502::cmd6502bcs() { branchbase(cflag); }
 
-void CPU6502::cmd6502ldaIndirectY() {
+void HOT_OP(cmd6502ldaIndirectY) CPU6502::cmd6502ldaIndirectY() {
   uint16_t zold = z;
   modeIndirectY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -1076,7 +1077,7 @@ void CPU6502::cmd6502ldaIndirectY() {
   }
 }
 
-void CPU6502::cmd6502laxIndirectY() {
+void HOT_OP(cmd6502laxIndirectY) CPU6502::cmd6502laxIndirectY() {
   modeIndirectY();
   a = getMem(z);
   x = a;
@@ -1084,21 +1085,21 @@ void CPU6502::cmd6502laxIndirectY() {
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502ldyZeropageX() {
+void HOT_OP(cmd6502ldyZeropageX) CPU6502::cmd6502ldyZeropageX() {
   modeZeropageX();
   y = getMem(z);
   ytestandsetNZ();
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502ldaZeropageX() {
+void HOT_OP(cmd6502ldaZeropageX) CPU6502::cmd6502ldaZeropageX() {
   modeZeropageX();
   a = getMem(z);
   atestandsetNZ();
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502laxZeropageY() {
+void HOT_OP(cmd6502laxZeropageY) CPU6502::cmd6502laxZeropageY() {
   modeZeropageX();
   a = getMem(z);
   x = a;
@@ -1106,19 +1107,19 @@ void CPU6502::cmd6502laxZeropageY() {
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502ldxZeropageY() {
+void HOT_OP(cmd6502ldxZeropageY) CPU6502::cmd6502ldxZeropageY() {
   modeZeropageY();
   x = getMem(z);
   xtestandsetNZ();
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502clv() {
+void HOT_OP(cmd6502clv) CPU6502::cmd6502clv() {
   vflag = false;
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502ldaAbsoluteY() {
+void HOT_OP(cmd6502ldaAbsoluteY) CPU6502::cmd6502ldaAbsoluteY() {
   uint16_t zold = z;
   modeAbsoluteY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -1130,7 +1131,7 @@ void CPU6502::cmd6502ldaAbsoluteY() {
   }
 }
 
-void CPU6502::cmd6502laxAbsoluteY() {
+void HOT_OP(cmd6502laxAbsoluteY) CPU6502::cmd6502laxAbsoluteY() {
   uint16_t zold = z;
   modeAbsoluteY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -1143,13 +1144,13 @@ void CPU6502::cmd6502laxAbsoluteY() {
   }
 }
 
-void CPU6502::cmd6502tsx() {
+void HOT_OP(cmd6502tsx) CPU6502::cmd6502tsx() {
   x = sp;
   xtestandsetNZ();
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502ldyAbsoluteX() {
+void HOT_OP(cmd6502ldyAbsoluteX) CPU6502::cmd6502ldyAbsoluteX() {
   uint16_t zold = z;
   modeAbsoluteX();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -1161,7 +1162,7 @@ void CPU6502::cmd6502ldyAbsoluteX() {
   }
 }
 
-void CPU6502::cmd6502ldaAbsoluteX() {
+void HOT_OP(cmd6502ldaAbsoluteX) CPU6502::cmd6502ldaAbsoluteX() {
   uint16_t zold = z;
   modeAbsoluteX();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -1173,7 +1174,7 @@ void CPU6502::cmd6502ldaAbsoluteX() {
   }
 }
 
-void CPU6502::cmd6502ldxAbsoluteY() {
+void HOT_OP(cmd6502ldxAbsoluteY) CPU6502::cmd6502ldxAbsoluteY() {
   uint16_t zold = z;
   modeAbsoluteY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -1185,80 +1186,80 @@ void CPU6502::cmd6502ldxAbsoluteY() {
   }
 }
 
-void CPU6502::cmd6502cpyImmediate() {
+void HOT_OP(cmd6502cpyImmediate) CPU6502::cmd6502cpyImmediate() {
   uint8_t r = getMem(pc++);
   cmpbase(y, r);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502cmpIndirectX() {
+void HOT_OP(cmd6502cmpIndirectX) CPU6502::cmd6502cmpIndirectX() {
   modeIndirectX();
   uint8_t r = getMem(z);
   cmpbase(a, r);
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502cpyZeropage() {
+void HOT_OP(cmd6502cpyZeropage) CPU6502::cmd6502cpyZeropage() {
   modeZeropage();
   uint8_t r = getMem(z);
   cmpbase(y, r);
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502cmpZeropage() {
+void HOT_OP(cmd6502cmpZeropage) CPU6502::cmd6502cmpZeropage() {
   modeZeropage();
   uint8_t r = getMem(z);
   cmpbase(a, r);
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502decZeropage() {
+void HOT_OP(cmd6502decZeropage) CPU6502::cmd6502decZeropage() {
   modeZeropage();
   decbase();
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502iny() {
+void HOT_OP(cmd6502iny) CPU6502::cmd6502iny() {
   y++;
   setNZ(y);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502cmpImmediate() {
+void HOT_OP(cmd6502cmpImmediate) CPU6502::cmd6502cmpImmediate() {
   uint8_t r = getMem(pc++);
   cmpbase(a, r);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502dex() {
+void HOT_OP(cmd6502dex) CPU6502::cmd6502dex() {
   x--;
   setNZ(x);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502cpyAbsolute() {
+void HOT_OP(cmd6502cpyAbsolute) CPU6502::cmd6502cpyAbsolute() {
   modeAbsolute();
   uint8_t r = getMem(z);
   cmpbase(y, r);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502cmpAbsolute() {
+void HOT_OP(cmd6502cmpAbsolute) CPU6502::cmd6502cmpAbsolute() {
   modeAbsolute();
   uint8_t r = getMem(z);
   cmpbase(a, r);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502decAbsolute() {
+void HOT_OP(cmd6502decAbsolute) CPU6502::cmd6502decAbsolute() {
   modeAbsolute();
   decbase();
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502bne() { branchbase(!zflag); }
+void HOT_OP(cmd6502bne) CPU6502::cmd6502bne() { branchbase(!zflag); }
 
-void CPU6502::cmd6502cmpIndirectY() {
+void HOT_OP(cmd6502cmpIndirectY) CPU6502::cmd6502cmpIndirectY() {
   uint16_t zold = z;
   modeIndirectY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -1270,25 +1271,25 @@ void CPU6502::cmd6502cmpIndirectY() {
   }
 }
 
-void CPU6502::cmd6502cmpZeropageX() {
+void HOT_OP(cmd6502cmpZeropageX) CPU6502::cmd6502cmpZeropageX() {
   modeZeropageX();
   uint8_t r = getMem(z);
   cmpbase(a, r);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502decZeropageX() {
+void HOT_OP(cmd6502decZeropageX) CPU6502::cmd6502decZeropageX() {
   modeZeropageX();
   decbase();
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502cld() {
+void HOT_OP(cmd6502cld) CPU6502::cmd6502cld() {
   dflag = false;
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502cmpAbsoluteY() {
+void HOT_OP(cmd6502cmpAbsoluteY) CPU6502::cmd6502cmpAbsoluteY() {
   uint16_t zold = z;
   modeAbsoluteY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -1300,7 +1301,7 @@ void CPU6502::cmd6502cmpAbsoluteY() {
   }
 }
 
-void CPU6502::cmd6502cmpAbsoluteX() {
+void HOT_OP(cmd6502cmpAbsoluteX) CPU6502::cmd6502cmpAbsoluteX() {
   uint16_t zold = z;
   modeAbsoluteX();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -1312,82 +1313,82 @@ void CPU6502::cmd6502cmpAbsoluteX() {
   }
 }
 
-void CPU6502::cmd6502decAbsoluteX() {
+void HOT_OP(cmd6502decAbsoluteX) CPU6502::cmd6502decAbsoluteX() {
   modeAbsoluteX();
   decbase();
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502cpxImmediate() {
+void HOT_OP(cmd6502cpxImmediate) CPU6502::cmd6502cpxImmediate() {
   uint8_t r = getMem(pc++);
   cmpbase(x, r);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502sbcIndirectX() {
+void HOT_OP(cmd6502sbcIndirectX) CPU6502::cmd6502sbcIndirectX() {
   modeIndirectX();
   uint8_t r = getMem(z);
   sbcbase(r);
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502cpxZeropage() {
+void HOT_OP(cmd6502cpxZeropage) CPU6502::cmd6502cpxZeropage() {
   modeZeropage();
   uint8_t r = getMem(z);
   cmpbase(x, r);
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502sbcZeropage() {
+void HOT_OP(cmd6502sbcZeropage) CPU6502::cmd6502sbcZeropage() {
   modeZeropage();
   uint8_t r = getMem(z);
   sbcbase(r);
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502incZeropage() {
+void HOT_OP(cmd6502incZeropage) CPU6502::cmd6502incZeropage() {
   modeZeropage();
   incbase();
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502inx() {
+void HOT_OP(cmd6502inx) CPU6502::cmd6502inx() {
   x++;
   setNZ(x);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502sbcImmediate() {
+void HOT_OP(cmd6502sbcImmediate) CPU6502::cmd6502sbcImmediate() {
   uint8_t r = getMem(pc++);
   sbcbase(r);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502nop() { numofcycles += 2; }
+void HOT_OP(cmd6502nop) CPU6502::cmd6502nop() { numofcycles += 2; }
 
-void CPU6502::cmd6502cpxAbsolute() {
+void HOT_OP(cmd6502cpxAbsolute) CPU6502::cmd6502cpxAbsolute() {
   modeAbsolute();
   uint8_t r = getMem(z);
   cmpbase(x, r);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502sbcAbsolute() {
+void HOT_OP(cmd6502sbcAbsolute) CPU6502::cmd6502sbcAbsolute() {
   modeAbsolute();
   uint8_t r = getMem(z);
   sbcbase(r);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502incAbsolute() {
+void HOT_OP(cmd6502incAbsolute) CPU6502::cmd6502incAbsolute() {
   modeAbsolute();
   incbase();
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502beq() { branchbase(zflag); }
+void HOT_OP(cmd6502beq) CPU6502::cmd6502beq() { branchbase(zflag); }
 
-void CPU6502::cmd6502sbcIndirectY() {
+void HOT_OP(cmd6502sbcIndirectY) CPU6502::cmd6502sbcIndirectY() {
   uint16_t zold = z;
   modeIndirectY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -1399,25 +1400,25 @@ void CPU6502::cmd6502sbcIndirectY() {
   }
 }
 
-void CPU6502::cmd6502sbcZeropageX() {
+void HOT_OP(cmd6502sbcZeropageX) CPU6502::cmd6502sbcZeropageX() {
   modeZeropageX();
   uint8_t r = getMem(z);
   sbcbase(r);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502incZeropageX() {
+void HOT_OP(cmd6502incZeropageX) CPU6502::cmd6502incZeropageX() {
   modeZeropageX();
   incbase();
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502sed() {
+void HOT_OP(cmd6502sed) CPU6502::cmd6502sed() {
   dflag = true;
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502sbcAbsoluteY() {
+void HOT_OP(cmd6502sbcAbsoluteY) CPU6502::cmd6502sbcAbsoluteY() {
   uint16_t zold = z;
   modeAbsoluteY();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -1429,7 +1430,7 @@ void CPU6502::cmd6502sbcAbsoluteY() {
   }
 }
 
-void CPU6502::cmd6502sbcAbsoluteX() {
+void HOT_OP(cmd6502sbcAbsoluteX) CPU6502::cmd6502sbcAbsoluteX() {
   uint16_t zold = z;
   modeAbsoluteX();
   bool pageCrossed = ((zold & 0xFF00) != (z & 0xFF00));
@@ -1441,158 +1442,158 @@ void CPU6502::cmd6502sbcAbsoluteX() {
   }
 }
 
-void CPU6502::cmd6502incAbsoluteX() {
+void HOT_OP(cmd6502incAbsoluteX) CPU6502::cmd6502incAbsoluteX() {
   modeAbsoluteX();
   incbase();
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502nopImmediate() {
+void HOT_OP(cmd6502nopImmediate) CPU6502::cmd6502nopImmediate() {
   getMem(pc++);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502nopZeropage() {
+void HOT_OP(cmd6502nopZeropage) CPU6502::cmd6502nopZeropage() {
   modeZeropage();
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502nopZeropageX() {
+void HOT_OP(cmd6502nopZeropageX) CPU6502::cmd6502nopZeropageX() {
   modeZeropageX();
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502nop1a() { numofcycles += 2; }
+void HOT_OP(cmd6502nop1a) CPU6502::cmd6502nop1a() { numofcycles += 2; }
 
-void CPU6502::cmd6502nop3a() { numofcycles += 2; }
+void HOT_OP(cmd6502nop3a) CPU6502::cmd6502nop3a() { numofcycles += 2; }
 
-void CPU6502::cmd6502nop5a() { numofcycles += 2; }
+void HOT_OP(cmd6502nop5a) CPU6502::cmd6502nop5a() { numofcycles += 2; }
 
-void CPU6502::cmd6502nop7a() { numofcycles += 2; }
+void HOT_OP(cmd6502nop7a) CPU6502::cmd6502nop7a() { numofcycles += 2; }
 
-void CPU6502::cmd6502nopda() { numofcycles += 2; }
+void HOT_OP(cmd6502nopda) CPU6502::cmd6502nopda() { numofcycles += 2; }
 
-void CPU6502::cmd6502nopfa() { numofcycles += 2; }
+void HOT_OP(cmd6502nopfa) CPU6502::cmd6502nopfa() { numofcycles += 2; }
 
-void CPU6502::cmd6502alrImmediate() {
+void HOT_OP(cmd6502alrImmediate) CPU6502::cmd6502alrImmediate() {
   uint8_t r = getMem(pc++);
   a &= r;
   a = lsrbase0(a);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502saxZeropage() {
+void HOT_OP(cmd6502saxZeropage) CPU6502::cmd6502saxZeropage() {
   modeZeropage();
   setMem(z, a & x);
   numofcycles += 3;
 }
 
-void CPU6502::cmd6502saxZeropageY() {
+void HOT_OP(cmd6502saxZeropageY) CPU6502::cmd6502saxZeropageY() {
   modeZeropageY();
   setMem(z, a & x);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502saxAbsolute() {
+void HOT_OP(cmd6502saxAbsolute) CPU6502::cmd6502saxAbsolute() {
   modeAbsolute();
   setMem(z, a & x);
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502saxIndirectX() {
+void HOT_OP(cmd6502saxIndirectX) CPU6502::cmd6502saxIndirectX() {
   modeIndirectX();
   setMem(z, a & x);
   numofcycles += 6;
 }
 
-uint8_t CPU6502::isbincbase() {
+uint8_t HOT_CODE CPU6502::isbincbase() {
   uint8_t r = getMem(z);
   r++;
   setMem(z, r);
   return r;
 }
 
-void CPU6502::cmd6502isbZeropage() {
+void HOT_OP(cmd6502isbZeropage) CPU6502::cmd6502isbZeropage() {
   modeZeropage();
   uint8_t r = isbincbase();
   sbcbase(r);
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502isbZeropageX() {
+void HOT_OP(cmd6502isbZeropageX) CPU6502::cmd6502isbZeropageX() {
   modeZeropageX();
   uint8_t r = isbincbase();
   sbcbase(r);
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502isbIndirectX() {
+void HOT_OP(cmd6502isbIndirectX) CPU6502::cmd6502isbIndirectX() {
   modeIndirectX();
   uint8_t r = isbincbase();
   sbcbase(r);
   numofcycles += 8;
 }
 
-void CPU6502::cmd6502isbIndirectY() {
+void HOT_OP(cmd6502isbIndirectY) CPU6502::cmd6502isbIndirectY() {
   modeIndirectY();
   uint8_t r = isbincbase();
   sbcbase(r);
   numofcycles += 8;
 }
 
-void CPU6502::cmd6502isbAbsolute() {
+void HOT_OP(cmd6502isbAbsolute) CPU6502::cmd6502isbAbsolute() {
   modeAbsolute();
   uint8_t r = isbincbase();
   sbcbase(r);
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502isbAbsoluteX() {
+void HOT_OP(cmd6502isbAbsoluteX) CPU6502::cmd6502isbAbsoluteX() {
   modeAbsoluteX();
   uint8_t r = isbincbase();
   sbcbase(r);
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502isbAbsoluteY() {
+void HOT_OP(cmd6502isbAbsoluteY) CPU6502::cmd6502isbAbsoluteY() {
   modeAbsoluteY();
   uint8_t r = isbincbase();
   sbcbase(r);
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502skwAbsolute() {
+void HOT_OP(cmd6502skwAbsolute) CPU6502::cmd6502skwAbsolute() {
   modeAbsolute();
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502skwAbsoluteX() {
+void HOT_OP(cmd6502skwAbsoluteX) CPU6502::cmd6502skwAbsoluteX() {
   modeAbsoluteX();
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502shaZeropageY() {
+void HOT_OP(cmd6502shaZeropageY) CPU6502::cmd6502shaZeropageY() {
   modeZeropageY();
   uint8_t r = a & x & zh;
   setMem(z, r);
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502shaAbsoluteY() {
+void HOT_OP(cmd6502shaAbsoluteY) CPU6502::cmd6502shaAbsoluteY() {
   modeAbsoluteY();
   uint8_t r = a & x & zh;
   setMem(z, r);
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502shxAbsoluteY() {
+void HOT_OP(cmd6502shxAbsoluteY) CPU6502::cmd6502shxAbsoluteY() {
   modeAbsoluteY();
   uint8_t r = x & zh;
   setMem(z, r);
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502rraZeropage() {
+void HOT_OP(cmd6502rraZeropage) CPU6502::cmd6502rraZeropage() {
   modeZeropage();
   rorbase();
   uint8_t r = getMem(z);
@@ -1600,7 +1601,7 @@ void CPU6502::cmd6502rraZeropage() {
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502rraZeropageX() {
+void HOT_OP(cmd6502rraZeropageX) CPU6502::cmd6502rraZeropageX() {
   modeZeropageX();
   rorbase();
   uint8_t r = getMem(z);
@@ -1608,7 +1609,7 @@ void CPU6502::cmd6502rraZeropageX() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502rraIndirectX() {
+void HOT_OP(cmd6502rraIndirectX) CPU6502::cmd6502rraIndirectX() {
   modeIndirectX();
   rorbase();
   uint8_t r = getMem(z);
@@ -1616,7 +1617,7 @@ void CPU6502::cmd6502rraIndirectX() {
   numofcycles += 8;
 }
 
-void CPU6502::cmd6502rraIndirectY() {
+void HOT_OP(cmd6502rraIndirectY) CPU6502::cmd6502rraIndirectY() {
   modeIndirectY();
   rorbase();
   uint8_t r = getMem(z);
@@ -1624,7 +1625,7 @@ void CPU6502::cmd6502rraIndirectY() {
   numofcycles += 8;
 }
 
-void CPU6502::cmd6502rraAbsolute() {
+void HOT_OP(cmd6502rraAbsolute) CPU6502::cmd6502rraAbsolute() {
   modeAbsolute();
   rorbase();
   uint8_t r = getMem(z);
@@ -1632,7 +1633,7 @@ void CPU6502::cmd6502rraAbsolute() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502rraAbsoluteX() {
+void HOT_OP(cmd6502rraAbsoluteX) CPU6502::cmd6502rraAbsoluteX() {
   modeAbsoluteX();
   rorbase();
   uint8_t r = getMem(z);
@@ -1640,7 +1641,7 @@ void CPU6502::cmd6502rraAbsoluteX() {
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502rraAbsoluteY() {
+void HOT_OP(cmd6502rraAbsoluteY) CPU6502::cmd6502rraAbsoluteY() {
   modeAbsoluteY();
   rorbase();
   uint8_t r = getMem(z);
@@ -1648,7 +1649,7 @@ void CPU6502::cmd6502rraAbsoluteY() {
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502asoZeropage() {
+void HOT_OP(cmd6502asoZeropage) CPU6502::cmd6502asoZeropage() {
   modeZeropage();
   aslbase();
   uint8_t r = getMem(z);
@@ -1657,7 +1658,7 @@ void CPU6502::cmd6502asoZeropage() {
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502asoZeropageX() {
+void HOT_OP(cmd6502asoZeropageX) CPU6502::cmd6502asoZeropageX() {
   modeZeropageX();
   aslbase();
   uint8_t r = getMem(z);
@@ -1666,7 +1667,7 @@ void CPU6502::cmd6502asoZeropageX() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502asoIndirectX() {
+void HOT_OP(cmd6502asoIndirectX) CPU6502::cmd6502asoIndirectX() {
   modeIndirectX();
   aslbase();
   uint8_t r = getMem(z);
@@ -1675,7 +1676,7 @@ void CPU6502::cmd6502asoIndirectX() {
   numofcycles += 8;
 }
 
-void CPU6502::cmd6502asoIndirectY() {
+void HOT_OP(cmd6502asoIndirectY) CPU6502::cmd6502asoIndirectY() {
   modeIndirectY();
   aslbase();
   uint8_t r = getMem(z);
@@ -1684,7 +1685,7 @@ void CPU6502::cmd6502asoIndirectY() {
   numofcycles += 8;
 }
 
-void CPU6502::cmd6502asoAbsolute() {
+void HOT_OP(cmd6502asoAbsolute) CPU6502::cmd6502asoAbsolute() {
   modeAbsolute();
   aslbase();
   uint8_t r = getMem(z);
@@ -1693,7 +1694,7 @@ void CPU6502::cmd6502asoAbsolute() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502asoAbsoluteX() {
+void HOT_OP(cmd6502asoAbsoluteX) CPU6502::cmd6502asoAbsoluteX() {
   modeAbsoluteX();
   aslbase();
   uint8_t r = getMem(z);
@@ -1702,7 +1703,7 @@ void CPU6502::cmd6502asoAbsoluteX() {
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502asoAbsoluteY() {
+void HOT_OP(cmd6502asoAbsoluteY) CPU6502::cmd6502asoAbsoluteY() {
   modeAbsoluteY();
   aslbase();
   uint8_t r = getMem(z);
@@ -1711,7 +1712,7 @@ void CPU6502::cmd6502asoAbsoluteY() {
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502sreZeropage() {
+void HOT_OP(cmd6502sreZeropage) CPU6502::cmd6502sreZeropage() {
   modeZeropage();
   lsrbase();
   uint8_t r = getMem(z);
@@ -1720,7 +1721,7 @@ void CPU6502::cmd6502sreZeropage() {
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502sreZeropageX() {
+void HOT_OP(cmd6502sreZeropageX) CPU6502::cmd6502sreZeropageX() {
   modeZeropageX();
   lsrbase();
   uint8_t r = getMem(z);
@@ -1729,7 +1730,7 @@ void CPU6502::cmd6502sreZeropageX() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502sreIndirectX() {
+void HOT_OP(cmd6502sreIndirectX) CPU6502::cmd6502sreIndirectX() {
   modeIndirectX();
   lsrbase();
   uint8_t r = getMem(z);
@@ -1738,7 +1739,7 @@ void CPU6502::cmd6502sreIndirectX() {
   numofcycles += 8;
 }
 
-void CPU6502::cmd6502sreIndirectY() {
+void HOT_OP(cmd6502sreIndirectY) CPU6502::cmd6502sreIndirectY() {
   modeIndirectY();
   lsrbase();
   uint8_t r = getMem(z);
@@ -1747,7 +1748,7 @@ void CPU6502::cmd6502sreIndirectY() {
   numofcycles += 8;
 }
 
-void CPU6502::cmd6502sreAbsolute() {
+void HOT_OP(cmd6502sreAbsolute) CPU6502::cmd6502sreAbsolute() {
   modeAbsolute();
   lsrbase();
   uint8_t r = getMem(z);
@@ -1756,7 +1757,7 @@ void CPU6502::cmd6502sreAbsolute() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502sreAbsoluteX() {
+void HOT_OP(cmd6502sreAbsoluteX) CPU6502::cmd6502sreAbsoluteX() {
   modeAbsoluteX();
   lsrbase();
   uint8_t r = getMem(z);
@@ -1765,7 +1766,7 @@ void CPU6502::cmd6502sreAbsoluteX() {
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502sreAbsoluteY() {
+void HOT_OP(cmd6502sreAbsoluteY) CPU6502::cmd6502sreAbsoluteY() {
   modeAbsoluteY();
   lsrbase();
   uint8_t r = getMem(z);
@@ -1774,7 +1775,7 @@ void CPU6502::cmd6502sreAbsoluteY() {
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502dcpZeropage() {
+void HOT_OP(cmd6502dcpZeropage) CPU6502::cmd6502dcpZeropage() {
   modeZeropage();
   decbase();
   uint8_t r = getMem(z);
@@ -1782,7 +1783,7 @@ void CPU6502::cmd6502dcpZeropage() {
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502dcpZeropageX() {
+void HOT_OP(cmd6502dcpZeropageX) CPU6502::cmd6502dcpZeropageX() {
   modeZeropageX();
   decbase();
   uint8_t r = getMem(z);
@@ -1790,7 +1791,7 @@ void CPU6502::cmd6502dcpZeropageX() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502dcpIndirectX() {
+void HOT_OP(cmd6502dcpIndirectX) CPU6502::cmd6502dcpIndirectX() {
   modeIndirectX();
   decbase();
   uint8_t r = getMem(z);
@@ -1798,7 +1799,7 @@ void CPU6502::cmd6502dcpIndirectX() {
   numofcycles += 8;
 }
 
-void CPU6502::cmd6502dcpIndirectY() {
+void HOT_OP(cmd6502dcpIndirectY) CPU6502::cmd6502dcpIndirectY() {
   modeIndirectY();
   decbase();
   uint8_t r = getMem(z);
@@ -1806,7 +1807,7 @@ void CPU6502::cmd6502dcpIndirectY() {
   numofcycles += 8;
 }
 
-void CPU6502::cmd6502dcpAbsolute() {
+void HOT_OP(cmd6502dcpAbsolute) CPU6502::cmd6502dcpAbsolute() {
   modeAbsolute();
   decbase();
   uint8_t r = getMem(z);
@@ -1814,7 +1815,7 @@ void CPU6502::cmd6502dcpAbsolute() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502dcpAbsoluteX() {
+void HOT_OP(cmd6502dcpAbsoluteX) CPU6502::cmd6502dcpAbsoluteX() {
   modeAbsoluteX();
   decbase();
   uint8_t r = getMem(z);
@@ -1822,7 +1823,7 @@ void CPU6502::cmd6502dcpAbsoluteX() {
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502dcpAbsoluteY() {
+void HOT_OP(cmd6502dcpAbsoluteY) CPU6502::cmd6502dcpAbsoluteY() {
   modeAbsoluteY();
   decbase();
   uint8_t r = getMem(z);
@@ -1830,21 +1831,21 @@ void CPU6502::cmd6502dcpAbsoluteY() {
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502xaaImmediate() {
+void HOT_OP(cmd6502xaaImmediate) CPU6502::cmd6502xaaImmediate() {
   uint8_t r = getMem(pc++);
   a = (a | 0xfe) & x & r;
   atestandsetNZ();
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502sbxImmediate() {
+void HOT_OP(cmd6502sbxImmediate) CPU6502::cmd6502sbxImmediate() {
   uint8_t r = getMem(pc++);
   x = (a & x) - r;
   cmpbase(a & x, r);
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502lasAbsolute() {
+void HOT_OP(cmd6502lasAbsolute) CPU6502::cmd6502lasAbsolute() {
   x = sp;
   a = x;
   modeAbsoluteY();
@@ -1856,7 +1857,7 @@ void CPU6502::cmd6502lasAbsolute() {
   numofcycles += 4;
 }
 
-void CPU6502::cmd6502rlaZeropage() {
+void HOT_OP(cmd6502rlaZeropage) CPU6502::cmd6502rlaZeropage() {
   modeZeropage();
   rolbase();
   uint8_t r = getMem(z);
@@ -1865,7 +1866,7 @@ void CPU6502::cmd6502rlaZeropage() {
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502rlaZeropageX() {
+void HOT_OP(cmd6502rlaZeropageX) CPU6502::cmd6502rlaZeropageX() {
   modeZeropageX();
   rolbase();
   uint8_t r = getMem(z);
@@ -1874,7 +1875,7 @@ void CPU6502::cmd6502rlaZeropageX() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502rlaIndirectX() {
+void HOT_OP(cmd6502rlaIndirectX) CPU6502::cmd6502rlaIndirectX() {
   modeIndirectX();
   rolbase();
   uint8_t r = getMem(z);
@@ -1883,7 +1884,7 @@ void CPU6502::cmd6502rlaIndirectX() {
   numofcycles += 8;
 }
 
-void CPU6502::cmd6502rlaIndirectY() {
+void HOT_OP(cmd6502rlaIndirectY) CPU6502::cmd6502rlaIndirectY() {
   modeIndirectY();
   rolbase();
   uint8_t r = getMem(z);
@@ -1892,7 +1893,7 @@ void CPU6502::cmd6502rlaIndirectY() {
   numofcycles += 8;
 }
 
-void CPU6502::cmd6502rlaAbsolute() {
+void HOT_OP(cmd6502rlaAbsolute) CPU6502::cmd6502rlaAbsolute() {
   modeAbsolute();
   rolbase();
   uint8_t r = getMem(z);
@@ -1901,7 +1902,7 @@ void CPU6502::cmd6502rlaAbsolute() {
   numofcycles += 6;
 }
 
-void CPU6502::cmd6502rlaAbsoluteX() {
+void HOT_OP(cmd6502rlaAbsoluteX) CPU6502::cmd6502rlaAbsoluteX() {
   modeAbsoluteX();
   rolbase();
   uint8_t r = getMem(z);
@@ -1910,7 +1911,7 @@ void CPU6502::cmd6502rlaAbsoluteX() {
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502rlaAbsoluteY() {
+void HOT_OP(cmd6502rlaAbsoluteY) CPU6502::cmd6502rlaAbsoluteY() {
   modeAbsoluteY();
   rolbase();
   uint8_t r = getMem(z);
@@ -1919,7 +1920,7 @@ void CPU6502::cmd6502rlaAbsoluteY() {
   numofcycles += 7;
 }
 
-void CPU6502::cmd6502tas() {
+void HOT_OP(cmd6502tas) CPU6502::cmd6502tas() {
   uint8_t r = a & x;
   sp = r;
   modeAbsoluteY();
@@ -1928,7 +1929,7 @@ void CPU6502::cmd6502tas() {
   numofcycles += 5;
 }
 
-void CPU6502::cmd6502arr() {
+void HOT_OP(cmd6502arr) CPU6502::cmd6502arr() {
   uint8_t r = getMem(pc++);
   bool oricflag = cflag;
   a &= r;
@@ -1944,14 +1945,14 @@ void CPU6502::cmd6502arr() {
   numofcycles += 2;
 }
 
-void CPU6502::cmd6502shy() {
+void HOT_OP(cmd6502shy) CPU6502::cmd6502shy() {
   modeAbsoluteX();
   uint8_t r = y & (zh + 1);
   setMem(z, r);
   numofcycles += 5;
 }
 
-void CPU6502::execute(uint8_t idx) { (this->*cmdarr6502[idx])(); }
+void HOT_CODE CPU6502::execute(uint8_t idx) { (this->*cmdarr6502[idx])(); }
 
 void CPU6502::setPCToIntVec(uint16_t intvect, bool intfrombrk) {
   // push actual address to 6502 stack
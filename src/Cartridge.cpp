@@ -0,0 +1,367 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "Cartridge.h"
+#include "MemoryPlan.h"
+#include "fs/FileFactory.h"
+#include "platform/PlatformManager.h"
+#include <cstring>
+
+static const char *TAG = "Cartridge";
+
+static const uint32_t CARHEADERSIZE = 16;
+
+Cartridge::Cartridge()
+    : dataOffset(0), numUnits(0), mapper(CartMapper::NONE), bank(0),
+      enabled(false), cache(nullptr), ownCache(false), numSlots(0),
+      useCounter(0),
+      window8000(nullptr), windowA000(nullptr), fileIO(nullptr),
+      prefetchBuf(nullptr), prefetchUnit(-1) {}
+
+Cartridge::~Cartridge() { remove(); }
+
+CartMapper Cartridge::mapperFromCARType(uint32_t type, uint16_t &units) {
+  switch (type) {
+  case 1:
+    units = 1;
+    return CartMapper::STD8;
+  case 2:
+    units = 2;
+    return CartMapper::STD16;
+  case 12:
+    units = 4;
+    return CartMapper::XEGS;
+  case 13:
+    units = 8;
+    return CartMapper::XEGS;
+  case 14:
+    units = 16;
+    return CartMapper::XEGS;
+  case 23:
+  case 24:
+  case 25:
+    units = 32 << (type - 23);
+    return CartMapper::XEGS;
+  case 26:
+  case 27:
+  case 28:
+  case 29:
+  case 30:
+  case 31:
+  case 32:
+    units = 2 << (type - 26);
+    return CartMapper::MEGA;
+  case 33:
+  case 34:
+  case 35:
+  case 36:
+  case 37:
+  case 38:
+    units = 4 << (type - 33);
+    return CartMapper::SWXEGS;
+  case 41:
+    units = 16;
+    return CartMapper::ATMAX128;
+  case 42:
+    units = 128;
+    return CartMapper::ATMAX1024;
+  default:
+    return CartMapper::NONE;
+  }
+}
+
+CartMapper Cartridge::mapperFromSize(uint32_t size) {
+  switch (size) {
+  case 8 * 1024:
+    return CartMapper::STD8;
+  case 16 * 1024:
+    return CartMapper::STD16;
+  case 32 * 1024:
+  case 64 * 1024:
+  case 128 * 1024:
+  case 256 * 1024:
+  case 512 * 1024:
+  case 1024 * 1024:
+    return CartMapper::XEGS;
+  default:
+    return CartMapper::NONE;
+  }
+}
+
+bool Cartridge::insert(const std::string &path) {
+  remove();
+  file = FileSys::createFor(path);
+  if (!file->init() || !file->open(path, "rb")) {
+    PlatformManager::getInstance().log(LOG_ERROR, TAG, "cannot open %s",
+                                       path.c_str());
+    return false;
+  }
+  int64_t size = file->size();
+  uint8_t header[CARHEADERSIZE];
+  uint16_t units = 0;
+  CartMapper m = CartMapper::NONE;
+  if ((size > CARHEADERSIZE) &&
+      (file->read(header, CARHEADERSIZE) == CARHEADERSIZE) &&
+      (memcmp(header, "CART", 4) == 0)) {
+    uint32_t type = (header[4] << 24) | (header[5] << 16) | (header[6] << 8) |
+                    header[7];
+    m = mapperFromCARType(type, units);
+    if ((m == CartMapper::NONE) ||
+        (size - CARHEADERSIZE != static_cast<int64_t>(units) * CART_UNIT_SIZE)) {
+      PlatformManager::getInstance().log(
+          LOG_ERROR, TAG, "unsupported cartridge type %d", (int)type);
+      file->close();
+      return false;
+    }
+    dataOffset = CARHEADERSIZE;
+  } else {
+    m = mapperFromSize(static_cast<uint32_t>(size));
+    if (m == CartMapper::NONE) {
+      PlatformManager::getInstance().log(LOG_ERROR, TAG,
+                                         "unsupported cartridge size %d",
+                                         (int)size);
+      file->close();
+      return false;
+    }
+    units = static_cast<uint16_t>(size / CART_UNIT_SIZE);
+    dataOffset = 0;
+  }
+
+  numUnits = units;
+  numSlots = (units < CACHESLOTS) ? units : CACHESLOTS;
+  cache = static_cast<uint8_t *>(
+      MemoryPlan::get(MemoryPlan::Region::CARTCACHE));
+  ownCache = !cache;
+  if (ownCache) {
+    cache = new uint8_t[numSlots * CART_UNIT_SIZE];
+  }
+  for (uint8_t i = 0; i < CACHESLOTS; i++) {
+    slotUnit[i] = -1;
+    slotLastUse[i] = 0;
+  }
+  useCounter = 0;
+  mapper = m;
+
+  // small images are kept completely in the cache
+  if (numUnits <= CACHESLOTS) {
+    for (uint16_t u = 0; u < numUnits; u++) {
+      getUnit(u);
+    }
+    file->close();
+  } else if (fileIO) {
+    prefetchBuf = ownCache ? new uint8_t[CART_UNIT_SIZE]
+                           : cache + CACHESLOTS * CART_UNIT_SIZE;
+  }
+  PlatformManager::getInstance().log(LOG_INFO, TAG,
+                                     "inserted %s (%dK, mapper %d)",
+                                     path.c_str(), numUnits * 8, (int)mapper);
+  reset();
+  return true;
+}
+
+void Cartridge::remove() {
+  if (prefetchTicket) {
+    fileIO->wait(prefetchTicket);
+    prefetchTicket.reset();
+  }
+  prefetchUnit = -1;
+  if (ownCache) {
+    delete[] prefetchBuf;
+    delete[] cache;
+  }
+  prefetchBuf = nullptr;
+  if (file) {
+    file->close();
+  }
+  cache = nullptr;
+  ownCache = false;
+  numSlots = 0;
+  numUnits = 0;
+  mapper = CartMapper::NONE;
+  enabled = false;
+  window8000 = nullptr;
+  windowA000 = nullptr;
+}
+
+void Cartridge::reset() {
+  enabled = isInserted();
+  bank = (mapper == CartMapper::ATMAX1024) ? 0x7f : 0;
+  updateWindows();
+}
+
+const uint8_t *Cartridge::getUnit(uint16_t unit) {
+  useCounter++;
+  uint8_t victim = 0;
+  uint32_t oldest = UINT32_MAX;
+  for (uint8_t i = 0; i < numSlots; i++) {
+    uint8_t *slot = cache + i * CART_UNIT_SIZE;
+    if (slotUnit[i] == unit) {
+      slotLastUse[i] = useCounter;
+      return slot;
+    }
+    // slots visible in a window must not be replaced
+    if ((slot == window8000) || (slot == windowA000)) {
+      continue;
+    }
+    if (slotLastUse[i] < oldest) {
+      oldest = slotLastUse[i];
+      victim = i;
+    }
+  }
+  uint8_t *slot = cache + victim * CART_UNIT_SIZE;
+  if (!readUnit(unit, slot)) {
+    PlatformManager::getInstance().log(LOG_ERROR, TAG,
+                                       "cannot read bank %d", unit);
+    memset(slot, 0xff, CART_UNIT_SIZE);
+  }
+  slotUnit[victim] = unit;
+  slotLastUse[victim] = useCounter;
+  return slot;
+}
+
+bool Cartridge::readUnit(uint16_t unit, uint8_t *dest) {
+  uint32_t offset = dataOffset + unit * CART_UNIT_SIZE;
+  if (!prefetchBuf) {
+    return file->seek(offset, SEEK_SET) &&
+           (file->read(dest, CART_UNIT_SIZE) == CART_UNIT_SIZE);
+  }
+  if (prefetchUnit == unit) {
+    // read ahead already issued, usually completed by now
+    fileIO->wait(prefetchTicket);
+    prefetchUnit = -1;
+    if (prefetchTicket->ok) {
+      memcpy(dest, prefetchBuf, CART_UNIT_SIZE);
+      return true;
+    }
+  }
+  AsyncFileIO::Ticket ticket =
+      fileIO->read(file.get(), offset, dest, CART_UNIT_SIZE);
+  fileIO->wait(ticket);
+  return ticket->ok;
+}
+
+void Cartridge::prefetch(uint16_t unit) {
+  if (!prefetchBuf || (prefetchUnit == unit) ||
+      (prefetchTicket && !AsyncFileIO::isDone(prefetchTicket))) {
+    return;
+  }
+  for (uint8_t i = 0; i < numSlots; i++) {
+    if (slotUnit[i] == unit) {
+      return;
+    }
+  }
+  prefetchUnit = unit;
+  prefetchTicket = fileIO->read(file.get(), dataOffset + unit * CART_UNIT_SIZE,
+                                prefetchBuf, CART_UNIT_SIZE);
+}
+
+void Cartridge::updateWindows() {
+  int32_t unit8000 = -1;
+  int32_t unitA000 = -1;
+  if (enabled) {
+    switch (mapper) {
+    case CartMapper::STD8:
+      unitA000 = 0;
+      break;
+    case CartMapper::STD16:
+      unit8000 = 0;
+      unitA000 = 1;
+      break;
+    case CartMapper::XEGS:
+    case CartMapper::SWXEGS:
+      unit8000 = bank % numUnits;
+      unitA000 = numUnits - 1;
+      break;
+    case CartMapper::MEGA:
+      unit8000 = (2 * bank) % numUnits;
+      unitA000 = unit8000 + 1;
+      break;
+    case CartMapper::ATMAX128:
+    case CartMapper::ATMAX1024:
+      unitA000 = bank % numUnits;
+      break;
+    default:
+      break;
+    }
+  }
+  // fetch one window after the other, the window still visible keeps its
+  // slot
+  window8000 = (unit8000 >= 0) ? getUnit(unit8000) : nullptr;
+  windowA000 = (unitA000 >= 0) ? getUnit(unitA000) : nullptr;
+
+  // bank switching code often walks through the banks in order
+  int32_t switched = ((mapper == CartMapper::ATMAX128) ||
+                      (mapper == CartMapper::ATMAX1024))
+                         ? unitA000
+                         : unit8000;
+  if (switched >= 0) {
+    uint16_t step = (mapper == CartMapper::MEGA) ? 2 : 1;
+    prefetch((switched + step) % numUnits);
+  }
+}
+
+bool Cartridge::access(uint8_t reg, bool write, uint8_t val) {
+  uint8_t newbank = bank;
+  bool newenabled = enabled;
+  switch (mapper) {
+  case CartMapper::XEGS:
+    if (!write) {
+      return false;
+    }
+    newbank = val;
+    break;
+  case CartMapper::SWXEGS:
+  case CartMapper::MEGA:
+    if (!write) {
+      return false;
+    }
+    newbank = val & 0x7f;
+    newenabled = (val & 0x80) == 0;
+    break;
+  case CartMapper::ATMAX128:
+    if (reg >= 0x20) {
+      return false;
+    }
+    newenabled = (reg & 0x10) == 0;
+    newbank = newenabled ? (reg & 0x0f) : bank;
+    break;
+  case CartMapper::ATMAX1024:
+    newenabled = (reg & 0x80) == 0;
+    newbank = newenabled ? (reg & 0x7f) : bank;
+    break;
+  default:
+    return false;
+  }
+  if ((newbank == bank) && (newenabled == enabled)) {
+    return false;
+  }
+  bank = newbank;
+  enabled = newenabled;
+  updateWindows();
+  return true;
+}
+
+void Cartridge::saveState(SnapshotWriter &w) const {
+  w.put(bank);
+  w.put(enabled);
+}
+
+void Cartridge::loadState(SnapshotReader &r) {
+  r.get(bank);
+  r.get(enabled);
+  enabled = enabled && isInserted();
+  updateWindows();
+}
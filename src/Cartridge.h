@@ -0,0 +1,152 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef CARTRIDGE_H
+#define CARTRIDGE_H
+
+#include "Snapshot.h"
+#include "fs/AsyncFileIO.h"
+#include "fs/FileDriver.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+// Cartridge memory is handled in units of 8K, 16K banks occupy two units
+constexpr uint32_t CART_UNIT_SIZE = 8 * 1024;
+
+/**
+ * @brief Cartridge mappers
+ */
+enum class CartMapper : uint8_t {
+  NONE,
+  STD8,      // 8K at $A000
+  STD16,     // 16K at $8000
+  XEGS,      // switchable 8K at $8000, last 8K fixed at $A000
+  SWXEGS,    // XEGS, bit 7 disables the cartridge
+  MEGA,      // switchable 16K at $8000, bit 7 disables the cartridge
+  ATMAX128,  // 16 x 8K at $A000, selected by access to $D500-$D50F
+  ATMAX1024  // 128 x 8K at $A000, selected by access to $D500-$D57F
+};
+
+/**
+ * @brief Cartridge with bank switching
+ *
+ * Loads CAR images (16 byte header, type taken from the header) and raw
+ * ROM/BIN images (type derived from the size). The cartridge exposes two
+ * 8K windows ($8000-$9FFF and $A000-$BFFF) as pointers which Atari800Sys
+ * maps into its page table. Accesses to $D500-$D5FF are forwarded to
+ * access(), which switches banks by replacing the window pointers.
+ *
+ * Images which fit into the bank cache are loaded completely on insert.
+ * Larger images are read from the file on demand, the least recently used
+ * unmapped cache slot is replaced. If an AsyncFileIO service is set, all
+ * file accesses of large images go through it and the unit following the
+ * switchable bank is read ahead while the CPU runs.
+ */
+class Cartridge {
+private:
+  static const uint8_t CACHESLOTS = 8;
+
+public:
+  // bank cache and read-ahead buffer, see MemoryPlan
+  static const uint32_t CACHESIZE = (CACHESLOTS + 1) * CART_UNIT_SIZE;
+
+private:
+
+  std::unique_ptr<FileDriver> file;
+  uint32_t dataOffset;
+  uint16_t numUnits;
+  CartMapper mapper;
+  uint8_t bank;
+  bool enabled;
+
+  uint8_t *cache;
+  bool ownCache; // false if the cache is the CARTCACHE region
+  uint8_t numSlots;
+  int16_t slotUnit[CACHESLOTS];
+  uint32_t slotLastUse[CACHESLOTS];
+  uint32_t useCounter;
+
+  const uint8_t *window8000;
+  const uint8_t *windowA000;
+
+  // read-ahead of the next bank
+  AsyncFileIO *fileIO;
+  uint8_t *prefetchBuf;
+  int32_t prefetchUnit;
+  AsyncFileIO::Ticket prefetchTicket;
+
+  static CartMapper mapperFromCARType(uint32_t type, uint16_t &units);
+  static CartMapper mapperFromSize(uint32_t size);
+  const uint8_t *getUnit(uint16_t unit);
+  bool readUnit(uint16_t unit, uint8_t *dest);
+  void prefetch(uint16_t unit);
+  void updateWindows();
+
+public:
+  Cartridge();
+  ~Cartridge();
+
+  /**
+   * @brief Inserts the cartridge image with the given path.
+   *
+   * @return true if the image was recognized and could be read.
+   */
+  bool insert(const std::string &path);
+  void remove();
+
+  /**
+   * @brief Sets the I/O service used for bank reads of large images.
+   */
+  void setFileIO(AsyncFileIO *fileIO) { this->fileIO = fileIO; }
+
+  /**
+   * @brief Sets the power-up bank configuration.
+   */
+  void reset();
+
+  bool isInserted() const { return mapper != CartMapper::NONE; }
+  CartMapper getMapper() const { return mapper; }
+
+  /**
+   * @brief Returns the memory visible at $8000-$9FFF or nullptr if the
+   * cartridge does not occupy this area.
+   */
+  const uint8_t *getWindow8000() const { return window8000; }
+
+  /**
+   * @brief Returns the memory visible at $A000-$BFFF or nullptr if the
+   * cartridge does not occupy this area.
+   */
+  const uint8_t *getWindowA000() const { return windowA000; }
+
+  /**
+   * @brief Handles a read or write access to the cartridge control area
+   * $D500-$D5FF.
+   *
+   * @param reg Low byte of the address.
+   * @param write true for write accesses.
+   * @param val Value written.
+   * @return true if the visible cartridge memory changed.
+   */
+  bool access(uint8_t reg, bool write, uint8_t val);
+
+  // Snapshot support (bank configuration only, not the image)
+  void saveState(SnapshotWriter &w) const;
+  void loadState(SnapshotReader &r);
+};
+
+#endif // CARTRIDGE_H
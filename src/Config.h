@@ -32,10 +32,22 @@
 #define USE_SDLJOYSTICK
 #define USE_SDLSOUND
 #define WINDOWS_BUSYWAIT
+// Linux: run the tasks with SCHED_FIFO (needs CAP_SYS_NICE or an rtprio
+// limit), otherwise the task priority is mapped to a nice value
+// #define LINUX_SCHED_FIFO
 
 #elif defined(ESP_PLATFORM)
 
 // keyboard type (ble, web) is determined in the Makefile
+
+// CPU, memory access and scanline rendering in IRAM (see HotPlacement.h).
+// Off until the IRAM budget of the S3 build has been checked together with
+// the internal SRAM needed by MemoryPlan (64K RAM and the bitmap) and
+// HotOpcodes.h has been generated from a profile
+// #define USE_HOT_PLACEMENT
+
+// analog joystick: USE_ARDUINOJOYSTICK samples on demand (one-shot ADC),
+// USE_ADCJOYSTICK samples continuously by DMA
 #if defined(BOARD_T_HMI)
 #define USE_ST7789V
 #define USE_SDCARD
@@ -58,6 +70,30 @@
 // global defines
 #define AUDIO_SAMPLE_RATE 44100
 
+// video standard unless set by the configuration file (see VideoTiming.h)
+// #define DEFAULT_NTSC
+
+// instrumentation: log input latency distributions (see LatencyTrace.h)
+// #define USE_LATENCY_TRACE
+// feed the latency trace with a fixed input pattern instead of the drivers
+// #define USE_LATENCY_SCRIPT
+#ifdef USE_LATENCY_SCRIPT
+#define USE_LATENCY_TRACE
+#endif
+
+// instrumentation: log executed instructions per opcode, the log is the
+// input of tools/hotopcodes.py (generates HotOpcodes.h)
+// #define USE_OPCODE_PROFILE
+
+// instrumentation: trace I/O writes and DLIs through the log ring (see
+// LogRing.h), messages above this level are compiled out (default LOG_INFO)
+// #define LOGRING_LEVEL LOG_VERBOSE
+
+// performance governor: use a fixed set of policies instead of selecting
+// them by battery voltage and load (see PerfGovernor.h), e.g. 0x03 to skip
+// static frames and sleep between frames
+// #define GOVERNOR_POLICIES 0x03
+
 #if defined(PLATFORM_LINUX) || defined(_WIN32)
 
 #define HAS_DEFAULT_VOLUME
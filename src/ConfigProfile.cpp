@@ -0,0 +1,429 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "ConfigProfile.h"
+#include "Config.h"
+#include "Crc32.h"
+#include "fs/FileFactory.h"
+#include "platform/PlatformManager.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+
+static const char *TAG = "ConfigProfile";
+
+namespace {
+
+/**
+ * @brief Minimal JSON reader (objects are read member by member, nested
+ * values are skipped and can be read later from their start position)
+ */
+class JsonReader {
+public:
+  enum class Type : uint8_t { STRING, NUMBER, BOOL, NUL, OBJECT, ARRAY };
+
+  struct Value {
+    Type type;
+    std::string str;
+    double num;
+    bool b;
+    size_t start; // OBJECT, ARRAY: position of the opening bracket
+  };
+
+private:
+  // nesting limit of skipped values (the settings use 3 levels), deeper
+  // files are rejected as syntax error instead of exhausting the stack
+  static const uint8_t MAXDEPTH = 8;
+
+  const std::string &text;
+  size_t pos;
+  uint8_t depth;
+
+  void skipWs() {
+    while ((pos < text.size()) && isspace((unsigned char)text[pos])) {
+      pos++;
+    }
+  }
+
+  bool consume(char c) {
+    skipWs();
+    if ((pos < text.size()) && (text[pos] == c)) {
+      pos++;
+      return true;
+    }
+    return false;
+  }
+
+  bool literal(const char *word) {
+    size_t len = strlen(word);
+    if (text.compare(pos, len, word) != 0) {
+      return false;
+    }
+    pos += len;
+    return true;
+  }
+
+  bool readString(std::string &s) {
+    if (!consume('"')) {
+      return false;
+    }
+    s.clear();
+    while (pos < text.size()) {
+      char c = text[pos++];
+      if (c == '"') {
+        return true;
+      }
+      if (c == '\\') {
+        if (pos >= text.size()) {
+          return false;
+        }
+        c = text[pos++];
+        switch (c) {
+        case 'n':
+          c = '\n';
+          break;
+        case 't':
+          c = '\t';
+          break;
+        case 'u':
+          // not needed for the settings, keep a placeholder
+          if (pos + 4 > text.size()) {
+            return false;
+          }
+          pos += 4;
+          c = '?';
+          break;
+        default:
+          break;
+        }
+      }
+      s += c;
+    }
+    return false;
+  }
+
+  // skips the members or elements of an object or array
+  bool skipContainer(char close) {
+    if (consume(close)) {
+      return true;
+    }
+    if (depth >= MAXDEPTH) {
+      return false;
+    }
+    depth++;
+    do {
+      if (close == '}') {
+        std::string key;
+        if (!readString(key) || !consume(':')) {
+          return false;
+        }
+      }
+      Value v;
+      if (!readValue(v)) {
+        return false;
+      }
+    } while (consume(','));
+    depth--;
+    return consume(close);
+  }
+
+public:
+  JsonReader(const std::string &text, size_t pos)
+      : text(text), pos(pos), depth(0) {}
+
+  size_t getPos() const { return pos; }
+
+  bool atEnd() {
+    skipWs();
+    return pos == text.size();
+  }
+
+  bool readValue(Value &v) {
+    skipWs();
+    if (pos >= text.size()) {
+      return false;
+    }
+    char c = text[pos];
+    v.start = pos;
+    if (c == '"') {
+      v.type = Type::STRING;
+      return readString(v.str);
+    }
+    if (c == '{') {
+      v.type = Type::OBJECT;
+      pos++;
+      return skipContainer('}');
+    }
+    if (c == '[') {
+      v.type = Type::ARRAY;
+      pos++;
+      return skipContainer(']');
+    }
+    if (literal("true") || literal("false")) {
+      v.type = Type::BOOL;
+      v.b = (c == 't');
+      return true;
+    }
+    if (literal("null")) {
+      v.type = Type::NUL;
+      return true;
+    }
+    const char *start = text.c_str() + pos;
+    char *end;
+    v.num = strtod(start, &end);
+    if (end == start) {
+      return false;
+    }
+    v.type = Type::NUMBER;
+    pos += end - start;
+    return true;
+  }
+
+  /**
+   * @brief Reads the object at the current position, fn(key, value) is
+   * called for each member.
+   */
+  template <typename F> bool readObject(F fn) {
+    if (!consume('{')) {
+      return false;
+    }
+    if (consume('}')) {
+      return true;
+    }
+    do {
+      std::string key;
+      Value v;
+      if (!readString(key) || !consume(':') || !readValue(v)) {
+        return false;
+      }
+      fn(key, v);
+    } while (consume(','));
+    return consume('}');
+  }
+};
+
+typedef JsonReader::Type Type;
+typedef JsonReader::Value Value;
+
+bool isCount(const Value &v, uint8_t max) {
+  return (v.type == Type::NUMBER) && (v.num >= 0) && (v.num <= max) &&
+         (v.num == (int)v.num);
+}
+
+// applies one member of the file to s, false if the value is invalid
+bool applySetting(ProfileSettings &s, const std::string &key, const Value &v,
+                  uint8_t maxFrameSkip, uint8_t maxRunAhead) {
+  if (key == "machine") {
+    if ((v.type == Type::STRING) && (v.str == "800xl")) {
+      s.machine = ProfileSettings::Machine::XL;
+    } else if ((v.type == Type::STRING) && (v.str == "800")) {
+      s.machine = ProfileSettings::Machine::A800;
+    } else {
+      return false;
+    }
+  } else if (key == "video") {
+    if ((v.type != Type::STRING) || ((v.str != "pal") && (v.str != "ntsc"))) {
+      return false;
+    }
+    s.pal = (v.str == "pal");
+  } else if (key == "frameSkip") {
+    if ((v.type == Type::STRING) && (v.str == "static")) {
+      s.frameSkip = 0;
+      s.skipStatic = true;
+    } else if (isCount(v, maxFrameSkip)) {
+      s.frameSkip = v.num;
+      s.skipStatic = false;
+    } else {
+      return false;
+    }
+  } else if (key == "audioRate") {
+    if ((v.type != Type::NUMBER) || !(v.num >= 1) ||
+        (v.num > AUDIO_SAMPLE_RATE)) {
+      return false;
+    }
+    // the nearest supported step (1, 2 or 4) at or above the rate
+    uint32_t step = AUDIO_SAMPLE_RATE / (uint32_t)v.num;
+    s.audioStep = (step >= 4) ? 4 : (step >= 2) ? 2 : 1;
+  } else if (key == "sioAccel") {
+    if (v.type != Type::BOOL) {
+      return false;
+    }
+    s.sioAccel = v.b;
+  } else if (key == "runAhead") {
+    if (!isCount(v, maxRunAhead)) {
+      return false;
+    }
+    s.runAhead = v.num;
+  } else if (key != "name") {
+    PlatformManager::getInstance().log(LOG_WARN, TAG, "unknown setting %s",
+                                       key.c_str());
+  }
+  return true;
+}
+
+} // namespace
+
+ConfigProfile::ConfigProfile()
+    : fileIO(nullptr), secondsToReload(RELOADSECONDS), reloadPending(false),
+      fileCrc(0), changed(false) {}
+
+bool ConfigProfile::parse(const std::string &text, ProfileSettings &newDefaults,
+                          std::vector<Title> &newTitles,
+                          std::string &newCartridge) {
+  // the titles are read after the defaults, which may follow them
+  std::vector<std::pair<std::string, size_t>> titleObjects;
+  bool titlesValid = true;
+  JsonReader reader(text, 0);
+  bool ok = reader.readObject([&](const std::string &key, const Value &v) {
+    if (key == "cartridge") {
+      if (v.type == Type::STRING) {
+        newCartridge = v.str;
+      } else {
+        PlatformManager::getInstance().log(LOG_WARN, TAG,
+                                           "invalid value of %s", key.c_str());
+      }
+      return;
+    }
+    if (key != "titles") {
+      if (!applySetting(newDefaults, key, v, MAXFRAMESKIP, MAXRUNAHEAD)) {
+        PlatformManager::getInstance().log(LOG_WARN, TAG,
+                                           "invalid value of %s", key.c_str());
+      }
+      return;
+    }
+    if (v.type != Type::OBJECT) {
+      titlesValid = false;
+      return;
+    }
+    JsonReader titleReader(text, v.start);
+    titlesValid = titleReader.readObject(
+        [&](const std::string &name, const Value &t) {
+          if (t.type == Type::OBJECT) {
+            titleObjects.emplace_back(name, t.start);
+          } else {
+            titlesValid = false;
+          }
+        });
+  });
+  if (!ok || !reader.atEnd()) {
+    PlatformManager::getInstance().log(LOG_WARN, TAG,
+                                       "syntax error near offset %u",
+                                       (unsigned)reader.getPos());
+    return false;
+  }
+  if (!titlesValid) {
+    PlatformManager::getInstance().log(LOG_WARN, TAG,
+                                       "titles must map image CRCs to objects");
+    return false;
+  }
+
+  for (const auto &title : titleObjects) {
+    char *end;
+    uint32_t crc = strtoul(title.first.c_str(), &end, 16);
+    if ((title.first.size() != 8) || (*end != '\0') || (crc == 0)) {
+      PlatformManager::getInstance().log(LOG_WARN, TAG, "invalid title key %s",
+                                         title.first.c_str());
+      continue;
+    }
+    Title t{crc, newDefaults};
+    JsonReader titleReader(text, title.second);
+    titleReader.readObject([&](const std::string &key, const Value &v) {
+      if (!applySetting(t.settings, key, v, MAXFRAMESKIP, MAXRUNAHEAD)) {
+        PlatformManager::getInstance().log(LOG_WARN, TAG,
+                                           "%08x: invalid value of %s",
+                                           (unsigned)crc, key.c_str());
+      }
+    });
+    newTitles.push_back(t);
+  }
+  return true;
+}
+
+bool ConfigProfile::reload() {
+  std::string text;
+  std::unique_ptr<FileDriver> file = FileSys::create();
+  std::string path = std::string(Config::PATH) + Config::CONFIGFILE;
+  if (file->init() && file->open(path, "rb")) {
+    int64_t size = file->size();
+    if ((size > 0) && (size <= (int64_t)MAXFILESIZE)) {
+      text.resize(size);
+      text.resize(file->read(&text[0], size));
+    } else if (size > (int64_t)MAXFILESIZE) {
+      PlatformManager::getInstance().log(LOG_WARN, TAG, "%s too large",
+                                         path.c_str());
+    }
+    file->close();
+  }
+
+  // an unchanged file is not parsed again, a removed file restores the
+  // built-in defaults
+  uint32_t crc = Crc32::update(0, text.data(), text.size());
+  bool ok = true;
+  if (crc != fileCrc) {
+    fileCrc = crc;
+    ProfileSettings newDefaults;
+    std::vector<Title> newTitles;
+    std::string newCartridge;
+    if (text.empty() || parse(text, newDefaults, newTitles, newCartridge)) {
+      std::lock_guard<std::mutex> lock(mutex);
+      defaults = newDefaults;
+      titles.swap(newTitles);
+      cartridge.swap(newCartridge);
+      changed.store(true);
+      PlatformManager::getInstance().log(LOG_INFO, TAG,
+                                         "%s: %u title overrides",
+                                         path.c_str(), (unsigned)titles.size());
+    } else {
+      ok = false;
+    }
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  reloadPending = false;
+  return ok;
+}
+
+void ConfigProfile::poll() {
+  if (!fileIO || (--secondsToReload > 0)) {
+    return;
+  }
+  secondsToReload = RELOADSECONDS;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (reloadPending) {
+      return;
+    }
+    reloadPending = true;
+  }
+  fileIO->call([this]() { return reload(); });
+}
+
+ProfileSettings ConfigProfile::select(uint32_t imageCrc) {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (imageCrc != 0) {
+    for (const Title &t : titles) {
+      if (t.crc == imageCrc) {
+        return t.settings;
+      }
+    }
+  }
+  return defaults;
+}
+
+std::string ConfigProfile::getCartridge() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return cartridge;
+}
@@ -0,0 +1,138 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef CONFIGPROFILE_H
+#define CONFIGPROFILE_H
+
+#include "Config.h"
+#include "fs/AsyncFileIO.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Emulation settings of a title
+ */
+struct ProfileSettings {
+  enum class Machine : uint8_t { XL, A800 };
+
+  Machine machine = Machine::XL; // "800xl" ("800" is not supported yet)
+  // "video": "pal" or "ntsc"
+#ifdef DEFAULT_NTSC
+  bool pal = false;
+#else
+  bool pal = true;
+#endif
+  uint8_t frameSkip = 0;         // display refreshes skipped after each one
+  bool skipStatic = false;       // "frameSkip": "static"
+  uint8_t audioStep = 1;         // AUDIO_SAMPLE_RATE / "audioRate"
+  bool sioAccel = false;         // "sioAccel"
+  uint8_t runAhead = 0;          // "runAhead" (frames)
+
+  bool operator==(const ProfileSettings &o) const {
+    return (machine == o.machine) && (pal == o.pal) &&
+           (frameSkip == o.frameSkip) && (skipStatic == o.skipStatic) &&
+           (audioStep == o.audioStep) && (sioAccel == o.sioAccel) &&
+           (runAhead == o.runAhead);
+  }
+  bool operator!=(const ProfileSettings &o) const { return !(*this == o); }
+};
+
+/**
+ * @brief Runtime configuration read from Config::CONFIGFILE
+ *
+ * The file is a JSON object with the default settings and per-title
+ * overrides, keyed by the CRC-32 of the image (as BootCache::hashImage,
+ * 8 hex digits):
+ *
+ *   {
+ *     "machine": "800xl", "video": "pal", "frameSkip": 0,
+ *     "audioRate": 44100, "sioAccel": false, "runAhead": 0,
+ *     "cartridge": "star_raiders.car",
+ *     "titles": {
+ *       "1a2b3c4d": {"audioRate": 22050, "frameSkip": "static"}
+ *     }
+ *   }
+ *
+ * Missing keys keep their defaults. "cartridge" names an image in
+ * Config::PATH that is inserted at power on (see
+ * Atari800Sys::findCartridge). poll() checks the file every
+ * RELOADSECONDS on the I/O task; after a changed file has been parsed,
+ * takeChanged() returns true once and the owner selects the settings of
+ * the running title again. A file with errors is reported and ignored,
+ * the previous settings stay active.
+ */
+class ConfigProfile {
+private:
+  static const uint8_t RELOADSECONDS = 5;
+  static const size_t MAXFILESIZE = 16 * 1024;
+  static const uint8_t MAXFRAMESKIP = 4;
+  static const uint8_t MAXRUNAHEAD = 4;
+
+  struct Title {
+    uint32_t crc;
+    ProfileSettings settings;
+  };
+
+  AsyncFileIO *fileIO;
+  uint8_t secondsToReload;
+  bool reloadPending; // I/O task and timer, guarded by mutex
+  uint32_t fileCrc;   // I/O task
+
+  std::mutex mutex;
+  ProfileSettings defaults;
+  std::vector<Title> titles;
+  std::string cartridge;
+  std::atomic<bool> changed;
+
+  bool reload();
+  bool parse(const std::string &text, ProfileSettings &newDefaults,
+             std::vector<Title> &newTitles, std::string &newCartridge);
+
+public:
+  ConfigProfile();
+
+  void setFileIO(AsyncFileIO *fileIO) { this->fileIO = fileIO; }
+
+  /**
+   * @brief Reads the file (synchronously, before the emulation starts).
+   */
+  void load() { reload(); }
+
+  /**
+   * @brief Schedules a check of the file, called once per second.
+   */
+  void poll();
+
+  /**
+   * @brief Returns true once after the settings have changed.
+   */
+  bool takeChanged() { return changed.exchange(false); }
+
+  /**
+   * @brief Settings of the title with the given image CRC (0: no title).
+   */
+  ProfileSettings select(uint32_t imageCrc);
+
+  /**
+   * @brief Image to insert at power on, empty if none.
+   */
+  std::string getCartridge();
+};
+
+#endif // CONFIGPROFILE_H
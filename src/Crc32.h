@@ -0,0 +1,56 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <cstddef>
+#include <cstdint>
+
+struct Crc32Table {
+  uint32_t entry[256];
+  constexpr Crc32Table() : entry() {
+    for (uint32_t i = 0; i < 256; i++) {
+      uint32_t c = i;
+      for (uint8_t k = 0; k < 8; k++) {
+        c = (c & 1) ? (0xedb88320 ^ (c >> 1)) : (c >> 1);
+      }
+      entry[i] = c;
+    }
+  }
+};
+
+inline constexpr Crc32Table crc32Table{};
+
+/**
+ * @brief CRC-32 (IEEE 802.3, as used by zip/gzip and ROM databases)
+ *
+ * Usage: crc = Crc32::update(0, data, len), further blocks can be added by
+ * passing the previous result.
+ */
+class Crc32 {
+public:
+  static uint32_t update(uint32_t crc, const void *data, size_t len) {
+    const uint8_t *p = static_cast<const uint8_t *>(data);
+    crc = ~crc;
+    while (len--) {
+      crc = crc32Table.entry[(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    }
+    return ~crc;
+  }
+};
+
+#endif // CRC32_H
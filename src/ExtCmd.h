@@ -250,21 +250,21 @@ enum class ExtCmd {
   WRITETEXT = 36,
 
   /**
-   * @brief Attach a d64 file to the floppy drive emulation.
+   * @brief Inserts a cartridge image (car or rom file, also compressed)
+   * stored in the configured directory.
    *
-   * The name of the d64 file is stored starting at buffer position 4 (from
-   * buffer[3]).
-   * This command sends back a notification of type NotificationStruct1.
+   * The name of the image is stored starting at buffer position 4 (from
+   * buffer[3]). For a name without extension .car, .rom, .car.gz, .rom.gz
+   * and .zip are tried. The emulator performs a cold start.
    */
-  ATTACHD64 = 37,
+  ATTACHCART = 37,
 
   /**
-   * @brief Detach a d64 file from the floppy drive emulation.
+   * @brief Removes the cartridge, the emulator performs a cold start.
    *
    * No parameters needed.
-   * This command sends back a notification of type NotificationStruct1.
    */
-  DETACHD64 = 38,
+  DETACHCART = 38,
 
   /**
    * @brief Writes an OSD to the C64 screen.
@@ -0,0 +1,146 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "FramePacer.h"
+#include "platform/PlatformManager.h"
+#include <cstdio>
+#include <cstring>
+
+static const char *TAG = "FramePacer";
+
+FramePacer::FramePacer()
+    : frameUS(1000000 / 50), deadline(0), lastFrame(0), frames(0),
+      maxIntervalUS(0), busyUS(0), sleepUS(0), spinUS(0), powerSave(false),
+      intervalP50US(0), intervalP99US(0), intervalMaxUS(0), droppedFrames(0),
+      loadPercent(0), sleepPercent(0), spinPercent(0) {
+  memset(histogram, 0, sizeof(histogram));
+  for (uint8_t i = 0; i < NUMBUCKETS; i++) {
+    intervalHistogram[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void FramePacer::setFrameRate(uint32_t hz) {
+  frameUS = 1000000 / hz;
+  reset();
+}
+
+void FramePacer::reset() {
+  lastFrame = PlatformManager::getInstance().getTimeUS();
+  deadline = lastFrame + frameUS;
+}
+
+bool FramePacer::wait() {
+  Platform &platform = PlatformManager::getInstance();
+  int64_t now = platform.getTimeUS();
+  busyUS += now - lastFrame;
+  int64_t remaining = deadline - now;
+  if (remaining < -static_cast<int64_t>(MAXLAGFRAMES * frameUS)) {
+    // too far behind to catch up: restart the schedule
+    droppedFrames.fetch_add(-remaining / frameUS, std::memory_order_relaxed);
+    deadline = now;
+  } else if (remaining > 0) {
+    if (powerSave.load(std::memory_order_relaxed)) {
+      platform.waitMS((remaining + 999) / 1000);
+    } else if (remaining > SPINUS) {
+      platform.waitMS((remaining - SPINUS) / 1000);
+    }
+    int64_t woken = platform.getTimeUS();
+    sleepUS += woken - now;
+    while (platform.getTimeUS() < deadline) {
+    }
+    now = platform.getTimeUS();
+    spinUS += now - woken;
+  }
+  deadline += frameUS;
+  record(now - lastFrame);
+  lastFrame = now;
+  if (++frames < WINDOWFRAMES) {
+    return false;
+  }
+  publish();
+  return true;
+}
+
+void FramePacer::record(uint32_t intervalUS) {
+  // offset of the interval from the lower edge of the first bucket
+  int32_t offset = static_cast<int32_t>(intervalUS) -
+                   static_cast<int32_t>(frameUS) +
+                   static_cast<int32_t>(CENTERBUCKET * BUCKETUS + BUCKETUS / 2);
+  int32_t bucket = (offset < 0) ? 0 : offset / static_cast<int32_t>(BUCKETUS);
+  if (bucket >= NUMBUCKETS) {
+    bucket = NUMBUCKETS - 1;
+  }
+  histogram[bucket]++;
+  if (intervalUS > maxIntervalUS) {
+    maxIntervalUS = intervalUS;
+  }
+}
+
+void FramePacer::publish() {
+  // percentiles are given as the center of their bucket
+  uint32_t p50 = 0;
+  uint32_t p99 = 0;
+  uint32_t sum = 0;
+  for (uint8_t i = 0; i < NUMBUCKETS; i++) {
+    uint32_t center =
+        frameUS + (static_cast<int32_t>(i) - CENTERBUCKET) *
+                      static_cast<int32_t>(BUCKETUS);
+    if ((sum < frames / 2) && (sum + histogram[i] >= frames / 2)) {
+      p50 = center;
+    }
+    if ((sum < frames * 99 / 100) && (sum + histogram[i] >= frames * 99 / 100)) {
+      p99 = center;
+    }
+    sum += histogram[i];
+    intervalHistogram[i].store(histogram[i], std::memory_order_relaxed);
+  }
+  intervalP50US.store(p50, std::memory_order_relaxed);
+  intervalP99US.store(p99, std::memory_order_relaxed);
+  intervalMaxUS.store(maxIntervalUS, std::memory_order_relaxed);
+  uint32_t total = busyUS + sleepUS + spinUS;
+  if (total > 0) {
+    loadPercent.store(busyUS * 100ULL / total, std::memory_order_relaxed);
+    sleepPercent.store(sleepUS * 100ULL / total, std::memory_order_relaxed);
+    spinPercent.store(spinUS * 100ULL / total, std::memory_order_relaxed);
+  }
+  memset(histogram, 0, sizeof(histogram));
+  frames = 0;
+  maxIntervalUS = 0;
+  busyUS = 0;
+  sleepUS = 0;
+  spinUS = 0;
+}
+
+void FramePacer::log() {
+  char line[NUMBUCKETS * 4 + 1];
+  char *p = line;
+  for (uint8_t i = 0; i < NUMBUCKETS; i++) {
+    uint16_t n = intervalHistogram[i].load(std::memory_order_relaxed);
+    p += snprintf(p, line + sizeof(line) - p, " %u", n);
+  }
+  PlatformManager::getInstance().log(
+      LOG_INFO, TAG,
+      "frame interval p50=%u p99=%u max=%u [us], dropped=%u, "
+      "load/sleep/spin=%u/%u/%u%%",
+      (unsigned)intervalP50US.load(), (unsigned)intervalP99US.load(),
+      (unsigned)intervalMaxUS.load(), (unsigned)droppedFrames.load(),
+      (unsigned)loadPercent.load(), (unsigned)sleepPercent.load(),
+      (unsigned)spinPercent.load());
+  PlatformManager::getInstance().log(
+      LOG_INFO, TAG, "histogram (%u us buckets from %d us):%s",
+      (unsigned)BUCKETUS,
+      (int)frameUS - (int)(CENTERBUCKET * BUCKETUS), line);
+}
@@ -0,0 +1,120 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Paces emulated frames to the host clock
+ *
+ * Frame deadlines are absolute: the next deadline is the previous one plus
+ * the frame period, so the time spent after a deadline does not add up to
+ * a drift. The pacer sleeps (waitMS) until shortly before the deadline and
+ * spins for the remaining SPINUS microseconds. A late frame moves no
+ * deadline, the following frames start without waiting until the schedule
+ * is caught up. If the emulation is more than MAXLAGFRAMES behind (e.g.
+ * after loading a file), the schedule is restarted and the frames in
+ * between are counted as dropped.
+ *
+ * In power save mode the pacer sleeps up to the deadline without spinning
+ * (frames may start up to one tick late, the schedule is kept).
+ *
+ * The intervals between the frames are collected in a histogram which is
+ * published every WINDOWFRAMES frames together with the shares of
+ * emulation, sleeping and spinning. wait() is called by the CPU task,
+ * the published values may be read from any thread.
+ */
+class FramePacer {
+public:
+  static const uint32_t BUCKETUS = 250;
+  // bucket CENTERBUCKET holds the nominal period (+-BUCKETUS/2), the first
+  // and the last bucket collect all shorter and longer intervals
+  static const uint8_t NUMBUCKETS = 33;
+  static const uint8_t CENTERBUCKET = NUMBUCKETS / 2;
+  static const uint16_t WINDOWFRAMES = 250;
+
+private:
+#ifdef ESP_PLATFORM
+  // vTaskDelay may return up to one tick early
+  static const uint32_t SPINUS = 1500;
+#else
+  static const uint32_t SPINUS = 500;
+#endif
+  static const uint8_t MAXLAGFRAMES = 5;
+
+  uint32_t frameUS;
+  int64_t deadline;
+  int64_t lastFrame;
+  uint16_t histogram[NUMBUCKETS];
+  uint16_t frames;
+  uint32_t maxIntervalUS;
+  uint32_t busyUS;
+  uint32_t sleepUS;
+  uint32_t spinUS;
+  std::atomic<bool> powerSave;
+
+  void record(uint32_t intervalUS);
+  void publish();
+
+public:
+  // histogram and statistics of the last complete window
+  std::atomic<uint16_t> intervalHistogram[NUMBUCKETS];
+  std::atomic<uint32_t> intervalP50US;
+  std::atomic<uint32_t> intervalP99US;
+  std::atomic<uint32_t> intervalMaxUS;
+  // frames dropped since start
+  std::atomic<uint32_t> droppedFrames;
+  // shares of the last window in percent
+  std::atomic<uint8_t> loadPercent;
+  std::atomic<uint8_t> sleepPercent;
+  std::atomic<uint8_t> spinPercent;
+
+  FramePacer();
+
+  /**
+   * @brief Sets the frame period and restarts the schedule.
+   */
+  void setFrameRate(uint32_t hz);
+
+  /**
+   * @brief Sleeps instead of spinning, may be called from any thread.
+   */
+  void setPowerSave(bool enable) {
+    powerSave.store(enable, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Restarts the schedule, e.g. after the emulation was paused.
+   */
+  void reset();
+
+  /**
+   * @brief Waits for the deadline of the current frame.
+   *
+   * @return true if a window was published by this call.
+   */
+  bool wait();
+
+  /**
+   * @brief Logs the published histogram.
+   */
+  void log();
+};
+
+#endif // FRAMEPACER_H
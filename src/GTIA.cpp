@@ -15,6 +15,7 @@
  http://www.gnu.org/licenses/.
 */
 #include "GTIA.h"
+#include "HotPlacement.h"
 #include <cstring>
 
 GTIA::GTIA() { reset(); }
@@ -60,7 +61,7 @@ void GTIA::reset() {
   isPAL = true;  // Default to PAL
 }
 
-uint8_t GTIA::read(uint8_t addr) {
+uint8_t HOT_CODE GTIA::read(uint8_t addr) {
   addr &= 0x1F;
 
   switch (addr) {
@@ -131,7 +132,7 @@ uint8_t GTIA::read(uint8_t addr) {
   }
 }
 
-void GTIA::write(uint8_t addr, uint8_t val) {
+void HOT_CODE GTIA::write(uint8_t addr, uint8_t val) {
   addr &= 0x1F;
 
   switch (addr) {
@@ -289,10 +290,12 @@ void GTIA::clearCollisions() {
   memset(p2pl, 0, sizeof(p2pl));
 }
 
-void GTIA::setTrigger(uint8_t index, bool pressed) {
-  if (index < 4) {
-    // Active-low: 0 = pressed, 1 = not pressed
-    trig[index] = pressed ? 0 : 1;
+void GTIA::setTriggers(uint8_t state, uint8_t mask) {
+  // Bit n of state is TRIGn (active-low), only the triggers in mask change
+  for (uint8_t i = 0; i < 4; i++) {
+    if (mask & (1 << i)) {
+      trig[i] = (state >> i) & 0x01;
+    }
   }
 }
 
@@ -307,3 +310,47 @@ void GTIA::setConsoleKey(uint8_t key, bool pressed) {
     }
   }
 }
+
+void GTIA::saveState(SnapshotWriter &w) const {
+  w.put(hposp);
+  w.put(hposm);
+  w.put(sizep);
+  w.put(sizem);
+  w.put(grafp);
+  w.put(grafm);
+  w.put(colpm);
+  w.put(colpf);
+  w.put(colbk);
+  w.put(prior);
+  w.put(vdelay);
+  w.put(gractl);
+  w.put(m2pf);
+  w.put(p2pf);
+  w.put(m2pl);
+  w.put(p2pl);
+  w.put(trig);
+  w.put(consol);
+  w.put(isPAL);
+}
+
+void GTIA::loadState(SnapshotReader &r) {
+  r.get(hposp);
+  r.get(hposm);
+  r.get(sizep);
+  r.get(sizem);
+  r.get(grafp);
+  r.get(grafm);
+  r.get(colpm);
+  r.get(colpf);
+  r.get(colbk);
+  r.get(prior);
+  r.get(vdelay);
+  r.get(gractl);
+  r.get(m2pf);
+  r.get(p2pf);
+  r.get(m2pl);
+  r.get(p2pl);
+  r.get(trig);
+  r.get(consol);
+  r.get(isPAL);
+}
@@ -17,6 +17,7 @@
 #ifndef GTIA_H
 #define GTIA_H
 
+#include "Snapshot.h"
 #include <cstdint>
 
 // GTIA register addresses (offset from base $D000)
@@ -200,11 +201,15 @@ public:
   void clearCollisions();
 
   // Input handling
-  void setTrigger(uint8_t index, bool pressed);
+  void setTriggers(uint8_t state, uint8_t mask);
   void setConsoleKey(uint8_t key, bool pressed);
 
   // Configuration
   void setPAL(bool pal) { isPAL = pal; }
+
+  // Snapshot support
+  void saveState(SnapshotWriter &w) const;
+  void loadState(SnapshotReader &r);
 };
 
 #endif // GTIA_H
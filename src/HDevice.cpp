@@ -0,0 +1,395 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "HDevice.h"
+#include "Atari800Sys.h"
+#include "Config.h"
+#include "fs/FileFactory.h"
+#include "platform/PlatformManager.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+
+static const char *TAG = "HDevice";
+
+// ZIOCB offsets
+static const uint8_t ICCOMZ = 0x02;
+static const uint8_t ICBALZ = 0x04;
+static const uint8_t ICBLLZ = 0x08;
+static const uint8_t ICAX1Z = 0x0a;
+
+// CIO commands using the burst path
+static const uint8_t CMD_GETCHARS = 0x07;
+static const uint8_t CMD_PUTCHARS = 0x0b;
+
+// OPEN modes (ICAX1)
+static const uint8_t OPEN_READ = 0x04;
+static const uint8_t OPEN_DIR = 0x02;
+static const uint8_t OPEN_WRITE = 0x08;
+static const uint8_t OPEN_APPEND = 0x01;
+
+static const uint8_t ATASCII_EOL = 0x9b;
+static const uint8_t MAXNAMELEN = 64;
+
+// Matches name against an Atari DOS style pattern ('*' and '?' wildcards),
+// case insensitive. "*.*" also matches names without extension.
+static bool matchPattern(const char *pattern, const char *name) {
+  if (*pattern == 0) {
+    return *name == 0;
+  }
+  if (*pattern == '*') {
+    if ((pattern[1] == '.') && (pattern[2] == '*') && (pattern[3] == 0)) {
+      return true;
+    }
+    for (const char *n = name;; n++) {
+      if (matchPattern(pattern + 1, n)) {
+        return true;
+      }
+      if (*n == 0) {
+        return false;
+      }
+    }
+  }
+  if ((*name == 0) || ((*pattern != '?') &&
+                       (toupper(static_cast<unsigned char>(*pattern)) !=
+                        toupper(static_cast<unsigned char>(*name))))) {
+    return false;
+  }
+  return matchPattern(pattern + 1, name + 1);
+}
+
+HDevice::HDevice() : sys(nullptr), dirIndex(nullptr), available(false) {
+  memset(patch, 0, sizeof(patch));
+}
+
+void HDevice::init(Atari800Sys *sys) {
+  this->sys = sys;
+  for (Channel &ch : channel) {
+    ch.file = FileSys::create();
+    ch.readable = false;
+    ch.writable = false;
+    ch.isDir = false;
+    ch.dirPos = 0;
+  }
+  available = channel[0].file->init();
+  if (!available) {
+    PlatformManager::getInstance().log(LOG_INFO, TAG,
+                                       "no filesystem, H: not available");
+    return;
+  }
+
+  // handler table: OPEN-1, CLOSE-1, GET-1, PUT-1, STATUS-1, SPECIAL-1,
+  // JMP INIT
+  for (uint8_t i = 0; i < 6; i++) {
+    uint16_t entry = HDEVICE_PAGE + HDEVICE_STUBS + 2 * i - 1;
+    patch[2 * i] = entry & 0xff;
+    patch[2 * i + 1] = entry >> 8;
+  }
+  uint16_t initentry = HDEVICE_PAGE + HDEVICE_STUBS +
+                       2 * static_cast<uint8_t>(HFunc::INIT);
+  patch[12] = 0x4c;
+  patch[13] = initentry & 0xff;
+  patch[14] = initentry >> 8;
+
+  // entry stubs: BRK, RTS
+  for (uint8_t i = 0; i <= static_cast<uint8_t>(HFunc::INIT); i++) {
+    patch[HDEVICE_STUBS + 2 * i] = 0x00;
+    patch[HDEVICE_STUBS + 2 * i + 1] = 0x60;
+  }
+}
+
+uint16_t HDevice::getWord(uint16_t addr) {
+  return sys->getMem(addr) | (sys->getMem(addr + 1) << 8);
+}
+
+void HDevice::setWord(uint16_t addr, uint16_t val) {
+  sys->setMem(addr, val & 0xff);
+  sys->setMem(addr + 1, val >> 8);
+}
+
+bool HDevice::getFilename(std::string &name) {
+  name.clear();
+  uint16_t addr = getWord(ZIOCB + ICBALZ);
+  // skip device specification ("H:" or "Hn:")
+  uint8_t i = 0;
+  while ((i < 3) && (sys->getMem(addr + i) != ':')) {
+    i++;
+  }
+  if (i == 3) {
+    return false;
+  }
+  addr += i + 1;
+  for (i = 0; i < MAXNAMELEN; i++) {
+    uint8_t c = sys->getMem(addr + i);
+    if ((c == ATASCII_EOL) || (c == ' ') || (c == 0)) {
+      break;
+    }
+    // names are restricted to Config::PATH
+    if ((c == '/') || (c == '\\') || (c < 0x20) || (c > 0x7e)) {
+      return false;
+    }
+    name += static_cast<char>(c);
+  }
+  return !name.empty() && (name.find("..") == std::string::npos);
+}
+
+uint8_t HDevice::open(Channel &ch, uint8_t aux1) {
+  std::string name;
+  if (!getFilename(name)) {
+    return CIO_BADNAME;
+  }
+  if (aux1 & OPEN_DIR) {
+    return openDir(ch, name);
+  }
+  const char *mode;
+  if ((aux1 & OPEN_READ) && (aux1 & OPEN_WRITE)) {
+    mode = "r+b";
+  } else if (aux1 & OPEN_WRITE) {
+    mode = (aux1 & OPEN_APPEND) ? "ab" : "wb";
+  } else if (aux1 & OPEN_READ) {
+    mode = "rb";
+  } else {
+    return CIO_NOTIMPL;
+  }
+  // compressed files can be read like plain ones
+  bool plain = (strcmp(mode, "rb") != 0);
+  std::string path = std::string(Config::PATH) + name;
+  ch.file = plain ? FileSys::create() : FileSys::createFor(path);
+  bool ok = ch.file->open(path, mode);
+  if (!ok && (mode[0] != 'w')) {
+    // Atari file names are upper case, host file names often are not
+    for (char &c : name) {
+      c = tolower(static_cast<unsigned char>(c));
+    }
+    path = std::string(Config::PATH) + name;
+    ch.file = plain ? FileSys::create() : FileSys::createFor(path);
+    ok = ch.file->open(path, mode);
+  }
+  if (!ok) {
+    return (mode[0] == 'w') ? CIO_DEVERROR : CIO_NOTFOUND;
+  }
+  ch.readable = (aux1 & OPEN_READ) != 0;
+  ch.writable = (aux1 & OPEN_WRITE) != 0;
+  return CIO_SUCCESS;
+}
+
+uint8_t HDevice::openDir(Channel &ch, const std::string &pattern) {
+  if ((dirIndex == nullptr) || !dirIndex->isReady()) {
+    return CIO_NOTIMPL;
+  }
+  // DOS 2 style listing: name (8), extension (3), size in sectors
+  ch.dirText.clear();
+  ch.dirPos = 0;
+  char line[20];
+  for (const DirIndex::Entry &e : dirIndex->find("")) {
+    if ((e.type == FileType::DIR) ||
+        !matchPattern(pattern.c_str(), e.name.c_str())) {
+      continue;
+    }
+    std::string base = e.name;
+    std::string ext;
+    size_t dot = base.find_last_of('.');
+    if (dot != std::string::npos) {
+      ext = base.substr(dot + 1, 3);
+      base = base.substr(0, dot);
+    }
+    base = base.substr(0, 8);
+    for (char &c : base) {
+      c = toupper(static_cast<unsigned char>(c));
+    }
+    for (char &c : ext) {
+      c = toupper(static_cast<unsigned char>(c));
+    }
+    uint32_t sectors = std::min<uint32_t>((e.size + 124) / 125, 999);
+    snprintf(line, sizeof(line), "  %-8s%-3s %03u", base.c_str(),
+             ext.c_str(), (unsigned)sectors);
+    ch.dirText += line;
+    ch.dirText += static_cast<char>(ATASCII_EOL);
+  }
+  ch.dirText += "999 FREE SECTORS";
+  ch.dirText += static_cast<char>(ATASCII_EOL);
+  ch.isDir = true;
+  ch.readable = true;
+  return CIO_SUCCESS;
+}
+
+size_t HDevice::readBytes(Channel &ch, uint8_t *buf, size_t count) {
+  if (!ch.isDir) {
+    return ch.file->read(buf, count);
+  }
+  size_t n = std::min(count, ch.dirText.size() - ch.dirPos);
+  memcpy(buf, ch.dirText.data() + ch.dirPos, n);
+  ch.dirPos += n;
+  return n;
+}
+
+size_t HDevice::readSpans(Channel &ch, const std::vector<ByteSpan> &spans) {
+  if (!ch.isDir) {
+    return ch.file->readv(spans.data(), spans.size());
+  }
+  size_t total = 0;
+  for (const ByteSpan &span : spans) {
+    size_t n = readBytes(ch, span.data, span.size);
+    total += n;
+    if (n < span.size) {
+      break;
+    }
+  }
+  return total;
+}
+
+void HDevice::closeChannel(Channel &ch) {
+  if (ch.file) {
+    ch.file->close();
+  }
+  ch.readable = false;
+  ch.writable = false;
+  ch.isDir = false;
+  ch.dirText.clear();
+  ch.dirPos = 0;
+}
+
+uint8_t HDevice::get(Channel &ch, uint8_t &a) {
+  if (!ch.readable) {
+    return ch.writable ? CIO_WRITEONLY : CIO_NOTOPEN;
+  }
+  uint16_t len = getWord(ZIOCB + ICBLLZ);
+  if ((sys->getMem(ZIOCB + ICCOMZ) == CMD_GETCHARS) && (len > 1)) {
+    // transfer all but the last byte of the buffer in one go, CIO stores
+    // the last byte and finishes its buffer bookkeeping
+    uint16_t buf = getWord(ZIOCB + ICBALZ);
+    uint16_t n = len - 1;
+    // read directly into the emulated memory as far as it is not I/O
+    size_t direct = sys->getWriteSpans(buf, n, spans);
+    size_t got = readSpans(ch, spans);
+    if ((got == direct) && (got < n)) {
+      uint8_t tmp[256];
+      while (got < n) {
+        size_t chunk = std::min<size_t>(sizeof(tmp), n - got);
+        size_t r = readBytes(ch, tmp, chunk);
+        for (size_t i = 0; i < r; i++) {
+          sys->setMem(buf + got + i, tmp[i]);
+        }
+        got += r;
+        if (r < chunk) {
+          break;
+        }
+      }
+    }
+    setWord(ZIOCB + ICBALZ, buf + got);
+    setWord(ZIOCB + ICBLLZ, len - got);
+    if (got < n) {
+      return CIO_EOF;
+    }
+  }
+  uint8_t val;
+  if (readBytes(ch, &val, 1) != 1) {
+    return CIO_EOF;
+  }
+  a = val;
+  return CIO_SUCCESS;
+}
+
+uint8_t HDevice::put(Channel &ch, uint8_t &a) {
+  if (!ch.writable) {
+    return ch.readable ? CIO_READONLY : CIO_NOTOPEN;
+  }
+  if (ch.file->write(&a, 1) != 1) {
+    return CIO_DEVERROR;
+  }
+  uint16_t len = getWord(ZIOCB + ICBLLZ);
+  if ((sys->getMem(ZIOCB + ICCOMZ) == CMD_PUTCHARS) && (len > 1)) {
+    // A contains the byte at ICBALZ, write the rest of the buffer and leave
+    // one byte for CIO's buffer bookkeeping
+    uint16_t buf = getWord(ZIOCB + ICBALZ);
+    uint16_t n = len - 1;
+    uint8_t tmp[256];
+    size_t done = 0;
+    while (done < n) {
+      size_t chunk = std::min<size_t>(sizeof(tmp), n - done);
+      for (size_t i = 0; i < chunk; i++) {
+        tmp[i] = sys->getMem(buf + 1 + done + i);
+      }
+      if (ch.file->write(tmp, chunk) != chunk) {
+        return CIO_DEVERROR;
+      }
+      done += chunk;
+    }
+    setWord(ZIOCB + ICBALZ, buf + n);
+    setWord(ZIOCB + ICBLLZ, 1);
+  }
+  return CIO_SUCCESS;
+}
+
+uint8_t HDevice::trap(uint16_t addr, uint8_t &a, uint8_t x) {
+  HFunc func = static_cast<HFunc>(((addr & 0xff) - HDEVICE_STUBS) >> 1);
+  Channel &ch = channel[(x >> 4) & (NUMIOCBS - 1)];
+  switch (func) {
+  case HFunc::OPEN:
+    closeChannel(ch);
+    return open(ch, sys->getMem(ZIOCB + ICAX1Z));
+  case HFunc::CLOSE:
+    closeChannel(ch);
+    return CIO_SUCCESS;
+  case HFunc::GET:
+    return get(ch, a);
+  case HFunc::PUT:
+    return put(ch, a);
+  case HFunc::STATUS: {
+    if (ch.readable || ch.writable) {
+      return CIO_SUCCESS;
+    }
+    // implicit open by CIO: report whether the file exists
+    uint8_t status = open(ch, OPEN_READ);
+    closeChannel(ch);
+    return status;
+  }
+  case HFunc::SPECIAL:
+    return CIO_NOTIMPL;
+  default:
+    return CIO_SUCCESS;
+  }
+}
+
+void HDevice::installHandler() {
+  // the OS always sets up P: as first entry, otherwise HATABS is not valid
+  if (!available || (sys->getMem(HATABS) != 'P')) {
+    return;
+  }
+  uint16_t freeentry = 0;
+  for (uint8_t i = 0; i < HATABS_ENTRIES; i++) {
+    uint16_t entry = HATABS + 3 * i;
+    uint8_t dev = sys->getMem(entry);
+    if (dev == 'H') {
+      return;
+    }
+    if ((dev == 0) && (freeentry == 0)) {
+      freeentry = entry;
+    }
+  }
+  if (freeentry == 0) {
+    return;
+  }
+  sys->setMem(freeentry, 'H');
+  setWord(freeentry + 1, HDEVICE_PAGE);
+}
+
+void HDevice::closeAll() {
+  for (Channel &ch : channel) {
+    closeChannel(ch);
+  }
+}
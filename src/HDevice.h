@@ -0,0 +1,142 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef HDEVICE_H
+#define HDEVICE_H
+
+#include "fs/DirIndex.h"
+#include "fs/FileDriver.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Atari800Sys;
+
+// The H: handler lives in the unused I/O page $D600-$D6FF. Reads from this
+// page return the handler table and the entry stubs, each stub consists of
+// a BRK (trapped by Atari800Sys) followed by an RTS.
+constexpr uint16_t HDEVICE_PAGE = 0xD600;
+constexpr uint16_t HDEVICE_STUBS = 0x10;
+
+// OS locations used by the handler
+constexpr uint16_t HATABS = 0x031A;    // Handler address table
+constexpr uint8_t HATABS_ENTRIES = 12; // 3 bytes per entry
+constexpr uint16_t ZIOCB = 0x0020;     // Zero page IOCB
+
+// CIO status codes
+constexpr uint8_t CIO_SUCCESS = 0x01;
+constexpr uint8_t CIO_EOF = 0x88;
+constexpr uint8_t CIO_NOTIMPL = 0x92;
+constexpr uint8_t CIO_WRITEONLY = 0x83;
+constexpr uint8_t CIO_NOTOPEN = 0x85;
+constexpr uint8_t CIO_READONLY = 0x87;
+constexpr uint8_t CIO_DEVERROR = 0x90;
+constexpr uint8_t CIO_BADNAME = 0xA5;
+constexpr uint8_t CIO_NOTFOUND = 0xAA;
+
+/**
+ * @brief H: host filesystem device
+ *
+ * Implements a CIO device handler which maps OPEN, CLOSE, GET, PUT and
+ * STATUS onto the FileDriver in Config::PATH. The 6502 side of the handler
+ * is a patch page (see HDEVICE_PAGE) which is installed into HATABS by the
+ * emulator once the OS has initialized the table.
+ *
+ * GET CHARACTERS and PUT CHARACTERS are serviced with one host call for the
+ * whole buffer: the handler reads the current transfer state from ZIOCB,
+ * moves all but the last byte directly from/to emulated RAM and leaves
+ * the last byte for CIO, so that CIO's own bookkeeping stays consistent.
+ */
+class HDevice {
+private:
+  static const uint8_t NUMIOCBS = 8;
+
+  enum class HFunc : uint8_t { OPEN, CLOSE, GET, PUT, STATUS, SPECIAL, INIT };
+
+  struct Channel {
+    std::unique_ptr<FileDriver> file;
+    bool readable;
+    bool writable;
+    bool isDir;
+    std::string dirText;
+    size_t dirPos;
+  };
+
+  Atari800Sys *sys;
+  DirIndex *dirIndex;
+  Channel channel[NUMIOCBS];
+  uint8_t patch[256];
+  bool available;
+  std::vector<ByteSpan> spans; // destination of bulk GET transfers
+
+  uint16_t getWord(uint16_t addr);
+  void setWord(uint16_t addr, uint16_t val);
+  bool getFilename(std::string &name);
+  uint8_t open(Channel &ch, uint8_t aux1);
+  uint8_t openDir(Channel &ch, const std::string &pattern);
+  size_t readBytes(Channel &ch, uint8_t *buf, size_t count);
+  size_t readSpans(Channel &ch, const std::vector<ByteSpan> &spans);
+  void closeChannel(Channel &ch);
+  uint8_t get(Channel &ch, uint8_t &a);
+  uint8_t put(Channel &ch, uint8_t &a);
+
+public:
+  HDevice();
+  void init(Atari800Sys *sys);
+  bool isAvailable() const { return available; }
+
+  /**
+   * @brief Sets the directory index used for directory listings (OPEN with
+   * ICAX1 = 6). Without an index, directory listings are not available.
+   */
+  void setDirIndex(DirIndex *dirIndex) { this->dirIndex = dirIndex; }
+
+  /**
+   * @brief Returns a byte of the handler patch page.
+   */
+  uint8_t readPatch(uint8_t offset) const { return patch[offset]; }
+
+  /**
+   * @brief Checks whether a BRK at the given address is an H: entry stub.
+   *
+   * @param addr Address of the BRK instruction.
+   */
+  bool isTrap(uint16_t addr) const {
+    return available && ((addr & 0xff00) == HDEVICE_PAGE) &&
+           ((addr & 0xff) >= HDEVICE_STUBS) &&
+           ((addr & 0xff) < HDEVICE_STUBS + 2 * 7) && ((addr & 1) == 0);
+  }
+
+  /**
+   * @brief Executes the handler function belonging to the stub at addr.
+   *
+   * @param addr Address of the BRK instruction.
+   * @param a Accumulator, contains the byte to put, receives the byte read.
+   * @param x IOCB index (channel * 16).
+   * @return CIO status to be returned in register Y.
+   */
+  uint8_t trap(uint16_t addr, uint8_t &a, uint8_t x);
+
+  /**
+   * @brief Registers the H: device in HATABS if the OS has set up the table
+   * and there is no H: entry yet.
+   */
+  void installHandler();
+
+  void closeAll();
+};
+
+#endif // HDEVICE_H
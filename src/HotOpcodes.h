@@ -0,0 +1,251 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef HOTOPCODES_H
+#define HOTOPCODES_H
+
+// generated by tools/hotopcodes.py, do not edit
+// no profile: the documented opcodes are hot
+
+#define HOTOP_cmd6502brk HOT_CODE
+#define HOTOP_cmd6502oraIndirectX HOT_CODE
+#define HOTOP_cmd6502halt
+#define HOTOP_cmd6502asoIndirectX
+#define HOTOP_cmd6502nopZeropage
+#define HOTOP_cmd6502oraZeropage HOT_CODE
+#define HOTOP_cmd6502aslZeropage HOT_CODE
+#define HOTOP_cmd6502asoZeropage
+#define HOTOP_cmd6502php HOT_CODE
+#define HOTOP_cmd6502oraImmediate HOT_CODE
+#define HOTOP_cmd6502aslA HOT_CODE
+#define HOTOP_cmd6502ancImmediate
+#define HOTOP_cmd6502skwAbsolute
+#define HOTOP_cmd6502oraAbsolute HOT_CODE
+#define HOTOP_cmd6502aslAbsolute HOT_CODE
+#define HOTOP_cmd6502asoAbsolute
+#define HOTOP_cmd6502bpl HOT_CODE
+#define HOTOP_cmd6502oraIndirectY HOT_CODE
+#define HOTOP_cmd6502asoIndirectY
+#define HOTOP_cmd6502nopZeropageX
+#define HOTOP_cmd6502oraZeropageX HOT_CODE
+#define HOTOP_cmd6502aslZeropageX HOT_CODE
+#define HOTOP_cmd6502asoZeropageX
+#define HOTOP_cmd6502clc HOT_CODE
+#define HOTOP_cmd6502oraAbsoluteY HOT_CODE
+#define HOTOP_cmd6502nop1a
+#define HOTOP_cmd6502asoAbsoluteY
+#define HOTOP_cmd6502skwAbsoluteX
+#define HOTOP_cmd6502oraAbsoluteX HOT_CODE
+#define HOTOP_cmd6502aslAbsoluteX HOT_CODE
+#define HOTOP_cmd6502asoAbsoluteX
+#define HOTOP_cmd6502jsr HOT_CODE
+#define HOTOP_cmd6502andIndirectX HOT_CODE
+#define HOTOP_cmd6502rlaIndirectX
+#define HOTOP_cmd6502bitZeropage HOT_CODE
+#define HOTOP_cmd6502andZeropage HOT_CODE
+#define HOTOP_cmd6502rolZeropage HOT_CODE
+#define HOTOP_cmd6502rlaZeropage
+#define HOTOP_cmd6502plp HOT_CODE
+#define HOTOP_cmd6502andImmediate HOT_CODE
+#define HOTOP_cmd6502rolA HOT_CODE
+#define HOTOP_cmd6502bitAbsolute HOT_CODE
+#define HOTOP_cmd6502andAbsolute HOT_CODE
+#define HOTOP_cmd6502rolAbsolute HOT_CODE
+#define HOTOP_cmd6502rlaAbsolute
+#define HOTOP_cmd6502bmi HOT_CODE
+#define HOTOP_cmd6502andIndirectY HOT_CODE
+#define HOTOP_cmd6502rlaIndirectY
+#define HOTOP_cmd6502andZeropageX HOT_CODE
+#define HOTOP_cmd6502rolZeropageX HOT_CODE
+#define HOTOP_cmd6502rlaZeropageX
+#define HOTOP_cmd6502sec HOT_CODE
+#define HOTOP_cmd6502andAbsoluteY HOT_CODE
+#define HOTOP_cmd6502nop3a
+#define HOTOP_cmd6502rlaAbsoluteY
+#define HOTOP_cmd6502andAbsoluteX HOT_CODE
+#define HOTOP_cmd6502rolAbsoluteX HOT_CODE
+#define HOTOP_cmd6502rlaAbsoluteX
+#define HOTOP_cmd6502rti HOT_CODE
+#define HOTOP_cmd6502eorIndirectX HOT_CODE
+#define HOTOP_cmd6502sreIndirectX
+#define HOTOP_cmd6502eorZeropage HOT_CODE
+#define HOTOP_cmd6502lsrZeropage HOT_CODE
+#define HOTOP_cmd6502sreZeropage
+#define HOTOP_cmd6502pha HOT_CODE
+#define HOTOP_cmd6502eorImmediate HOT_CODE
+#define HOTOP_cmd6502lsrA HOT_CODE
+#define HOTOP_cmd6502alrImmediate
+#define HOTOP_cmd6502jmpAbsolute HOT_CODE
+#define HOTOP_cmd6502eorAbsolute HOT_CODE
+#define HOTOP_cmd6502lsrAbsolute HOT_CODE
+#define HOTOP_cmd6502sreAbsolute
+#define HOTOP_cmd6502bvc HOT_CODE
+#define HOTOP_cmd6502eorIndirectY HOT_CODE
+#define HOTOP_cmd6502sreIndirectY
+#define HOTOP_cmd6502eorZeropageX HOT_CODE
+#define HOTOP_cmd6502lsrZeropageX HOT_CODE
+#define HOTOP_cmd6502sreZeropageX
+#define HOTOP_cmd6502cli HOT_CODE
+#define HOTOP_cmd6502eorAbsoluteY HOT_CODE
+#define HOTOP_cmd6502nop5a
+#define HOTOP_cmd6502sreAbsoluteY
+#define HOTOP_cmd6502eorAbsoluteX HOT_CODE
+#define HOTOP_cmd6502lsrAbsoluteX HOT_CODE
+#define HOTOP_cmd6502sreAbsoluteX
+#define HOTOP_cmd6502rts HOT_CODE
+#define HOTOP_cmd6502adcIndirectX HOT_CODE
+#define HOTOP_cmd6502rraIndirectX
+#define HOTOP_cmd6502adcZeropage HOT_CODE
+#define HOTOP_cmd6502rorZeropage HOT_CODE
+#define HOTOP_cmd6502rraZeropage
+#define HOTOP_cmd6502pla HOT_CODE
+#define HOTOP_cmd6502adcImmediate HOT_CODE
+#define HOTOP_cmd6502rorA HOT_CODE
+#define HOTOP_cmd6502arr
+#define HOTOP_cmd6502jmpIndirect HOT_CODE
+#define HOTOP_cmd6502adcAbsolute HOT_CODE
+#define HOTOP_cmd6502rorAbsolute HOT_CODE
+#define HOTOP_cmd6502rraAbsolute
+#define HOTOP_cmd6502bvs HOT_CODE
+#define HOTOP_cmd6502adcIndirectY HOT_CODE
+#define HOTOP_cmd6502rraIndirectY
+#define HOTOP_cmd6502adcZeropageX HOT_CODE
+#define HOTOP_cmd6502rorZeropageX HOT_CODE
+#define HOTOP_cmd6502rraZeropageX
+#define HOTOP_cmd6502sei HOT_CODE
+#define HOTOP_cmd6502adcAbsoluteY HOT_CODE
+#define HOTOP_cmd6502nop7a
+#define HOTOP_cmd6502rraAbsoluteY
+#define HOTOP_cmd6502adcAbsoluteX HOT_CODE
+#define HOTOP_cmd6502rorAbsoluteX HOT_CODE
+#define HOTOP_cmd6502rraAbsoluteX
+#define HOTOP_cmd6502nopImmediate
+#define HOTOP_cmd6502staIndirectX HOT_CODE
+#define HOTOP_cmd6502saxIndirectX
+#define HOTOP_cmd6502styZeropage HOT_CODE
+#define HOTOP_cmd6502staZeropage HOT_CODE
+#define HOTOP_cmd6502stxZeropage HOT_CODE
+#define HOTOP_cmd6502saxZeropage
+#define HOTOP_cmd6502dey HOT_CODE
+#define HOTOP_cmd6502txa HOT_CODE
+#define HOTOP_cmd6502xaaImmediate
+#define HOTOP_cmd6502styAbsolute HOT_CODE
+#define HOTOP_cmd6502staAbsolute HOT_CODE
+#define HOTOP_cmd6502stxAbsolute HOT_CODE
+#define HOTOP_cmd6502saxAbsolute
+#define HOTOP_cmd6502bcc HOT_CODE
+#define HOTOP_cmd6502staIndirectY HOT_CODE
+#define HOTOP_cmd6502shaZeropageY
+#define HOTOP_cmd6502styZeropageX HOT_CODE
+#define HOTOP_cmd6502staZeropageX HOT_CODE
+#define HOTOP_cmd6502stxZeropageY HOT_CODE
+#define HOTOP_cmd6502saxZeropageY
+#define HOTOP_cmd6502tya HOT_CODE
+#define HOTOP_cmd6502staAbsoluteY HOT_CODE
+#define HOTOP_cmd6502txs HOT_CODE
+#define HOTOP_cmd6502tas
+#define HOTOP_cmd6502shy
+#define HOTOP_cmd6502staAbsoluteX HOT_CODE
+#define HOTOP_cmd6502shxAbsoluteY
+#define HOTOP_cmd6502shaAbsoluteY
+#define HOTOP_cmd6502ldyImmediate HOT_CODE
+#define HOTOP_cmd6502ldaIndirectX HOT_CODE
+#define HOTOP_cmd6502ldxImmediate HOT_CODE
+#define HOTOP_cmd6502laxIndirectX
+#define HOTOP_cmd6502ldyZeropage HOT_CODE
+#define HOTOP_cmd6502ldaZeropage HOT_CODE
+#define HOTOP_cmd6502ldxZeropage HOT_CODE
+#define HOTOP_cmd6502laxZeropage
+#define HOTOP_cmd6502tay HOT_CODE
+#define HOTOP_cmd6502ldaImmediate HOT_CODE
+#define HOTOP_cmd6502tax HOT_CODE
+#define HOTOP_cmd6502lxaImmediate
+#define HOTOP_cmd6502ldyAbsolute HOT_CODE
+#define HOTOP_cmd6502ldaAbsolute HOT_CODE
+#define HOTOP_cmd6502ldxAbsolute HOT_CODE
+#define HOTOP_cmd6502laxAbsolute
+#define HOTOP_cmd6502bcs HOT_CODE
+#define HOTOP_cmd6502ldaIndirectY HOT_CODE
+#define HOTOP_cmd6502laxIndirectY
+#define HOTOP_cmd6502ldyZeropageX HOT_CODE
+#define HOTOP_cmd6502ldaZeropageX HOT_CODE
+#define HOTOP_cmd6502ldxZeropageY HOT_CODE
+#define HOTOP_cmd6502laxZeropageY
+#define HOTOP_cmd6502clv HOT_CODE
+#define HOTOP_cmd6502ldaAbsoluteY HOT_CODE
+#define HOTOP_cmd6502tsx HOT_CODE
+#define HOTOP_cmd6502lasAbsolute
+#define HOTOP_cmd6502ldyAbsoluteX HOT_CODE
+#define HOTOP_cmd6502ldaAbsoluteX HOT_CODE
+#define HOTOP_cmd6502ldxAbsoluteY HOT_CODE
+#define HOTOP_cmd6502laxAbsoluteY
+#define HOTOP_cmd6502cpyImmediate HOT_CODE
+#define HOTOP_cmd6502cmpIndirectX HOT_CODE
+#define HOTOP_cmd6502dcpIndirectX
+#define HOTOP_cmd6502cpyZeropage HOT_CODE
+#define HOTOP_cmd6502cmpZeropage HOT_CODE
+#define HOTOP_cmd6502decZeropage HOT_CODE
+#define HOTOP_cmd6502dcpZeropage
+#define HOTOP_cmd6502iny HOT_CODE
+#define HOTOP_cmd6502cmpImmediate HOT_CODE
+#define HOTOP_cmd6502dex HOT_CODE
+#define HOTOP_cmd6502sbxImmediate
+#define HOTOP_cmd6502cpyAbsolute HOT_CODE
+#define HOTOP_cmd6502cmpAbsolute HOT_CODE
+#define HOTOP_cmd6502decAbsolute HOT_CODE
+#define HOTOP_cmd6502dcpAbsolute
+#define HOTOP_cmd6502bne HOT_CODE
+#define HOTOP_cmd6502cmpIndirectY HOT_CODE
+#define HOTOP_cmd6502dcpIndirectY
+#define HOTOP_cmd6502cmpZeropageX HOT_CODE
+#define HOTOP_cmd6502decZeropageX HOT_CODE
+#define HOTOP_cmd6502dcpZeropageX
+#define HOTOP_cmd6502cld HOT_CODE
+#define HOTOP_cmd6502cmpAbsoluteY HOT_CODE
+#define HOTOP_cmd6502nopda
+#define HOTOP_cmd6502dcpAbsoluteY
+#define HOTOP_cmd6502cmpAbsoluteX HOT_CODE
+#define HOTOP_cmd6502decAbsoluteX HOT_CODE
+#define HOTOP_cmd6502dcpAbsoluteX
+#define HOTOP_cmd6502cpxImmediate HOT_CODE
+#define HOTOP_cmd6502sbcIndirectX HOT_CODE
+#define HOTOP_cmd6502isbIndirectX
+#define HOTOP_cmd6502cpxZeropage HOT_CODE
+#define HOTOP_cmd6502sbcZeropage HOT_CODE
+#define HOTOP_cmd6502incZeropage HOT_CODE
+#define HOTOP_cmd6502isbZeropage
+#define HOTOP_cmd6502inx HOT_CODE
+#define HOTOP_cmd6502sbcImmediate HOT_CODE
+#define HOTOP_cmd6502nop HOT_CODE
+#define HOTOP_cmd6502cpxAbsolute HOT_CODE
+#define HOTOP_cmd6502sbcAbsolute HOT_CODE
+#define HOTOP_cmd6502incAbsolute HOT_CODE
+#define HOTOP_cmd6502isbAbsolute
+#define HOTOP_cmd6502beq HOT_CODE
+#define HOTOP_cmd6502sbcIndirectY HOT_CODE
+#define HOTOP_cmd6502isbIndirectY
+#define HOTOP_cmd6502sbcZeropageX HOT_CODE
+#define HOTOP_cmd6502incZeropageX HOT_CODE
+#define HOTOP_cmd6502isbZeropageX
+#define HOTOP_cmd6502sed HOT_CODE
+#define HOTOP_cmd6502sbcAbsoluteY HOT_CODE
+#define HOTOP_cmd6502nopfa
+#define HOTOP_cmd6502isbAbsoluteY
+#define HOTOP_cmd6502sbcAbsoluteX HOT_CODE
+#define HOTOP_cmd6502incAbsoluteX HOT_CODE
+#define HOTOP_cmd6502isbAbsoluteX
+
+#endif // HOTOPCODES_H
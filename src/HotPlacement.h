@@ -0,0 +1,44 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef HOTPLACEMENT_H
+#define HOTPLACEMENT_H
+
+#include "Config.h"
+
+/*
+ * Placement of the code run per instruction or scanline (ESP32 with
+ * USE_HOT_PLACEMENT):
+ * HOT_CODE: function in IRAM, not affected by instruction cache misses
+ *           (e.g. while the flash is busy with file or Wi-Fi activity)
+ * HOT_DATA: constant table in DRAM instead of flash
+ * HOT_OP(handler): opcode handler, hot if marked so in HotOpcodes.h
+ *           (generated by tools/hotopcodes.py from an opcode profile, see
+ *           USE_OPCODE_PROFILE)
+ */
+#if defined(ESP_PLATFORM) && defined(USE_HOT_PLACEMENT)
+#include <esp_attr.h>
+#define HOT_CODE IRAM_ATTR
+#define HOT_DATA DRAM_ATTR
+#else
+#define HOT_CODE
+#define HOT_DATA
+#endif
+
+#include "HotOpcodes.h"
+#define HOT_OP(handler) HOTOP_##handler
+
+#endif // HOTPLACEMENT_H
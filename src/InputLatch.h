@@ -0,0 +1,65 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef INPUTLATCH_H
+#define INPUTLATCH_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Input state handed from the input drivers to the emulation
+ *
+ * Atari800Sys::pollInput publishes the joystick ports as one packed word
+ * (see InputRouter), latchInput takes it right after at the end of each
+ * frame, so a latched state is always consistent. The positions of paddles
+ * 0 and 1 are published in a second word. The words are atomic, so the
+ * drivers may also be polled by another thread.
+ */
+class InputLatch {
+private:
+  // paddles at the left end (POT_MAX)
+  static const uint16_t PADDLESRELEASED = 0xe4e4;
+
+  uint16_t backPaddles;       // publishing side only
+  std::atomic<uint32_t> ports;
+  std::atomic<uint16_t> paddles;
+
+public:
+  static const uint8_t NUMPADDLES = 2;
+
+  InputLatch()
+      : backPaddles(PADDLESRELEASED), ports(0xffffffff),
+        paddles(PADDLESRELEASED) {}
+
+  void setPaddle(uint8_t num, uint8_t value) {
+    uint8_t shift = num * 8;
+    backPaddles = (backPaddles & ~(0xff << shift)) | (value << shift);
+  }
+
+  void publish(uint32_t state) {
+    paddles.store(backPaddles, std::memory_order_relaxed);
+    ports.store(state, std::memory_order_release);
+  }
+
+  uint32_t latch() const { return ports.load(std::memory_order_acquire); }
+
+  uint8_t latchPaddle(uint8_t num) const {
+    return (paddles.load(std::memory_order_relaxed) >> (num * 8)) & 0xff;
+  }
+};
+
+#endif // INPUTLATCH_H
@@ -0,0 +1,70 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "InputRouter.h"
+#include "platform/PlatformManager.h"
+
+static const char *TAG = "InputRouter";
+
+InputRouter::InputRouter() {
+  portOf[JOYSTICK] = 0;
+  portOf[KBJOYSTICK] = NOPORT;
+}
+
+void InputRouter::route(Device device, uint8_t port) {
+  if (device >= NUMDEVICES) {
+    return;
+  }
+  portOf[device] = (port < NUMPORTS) ? port : NOPORT;
+  PlatformManager::getInstance().log(
+      LOG_INFO, TAG, "device %d -> port %d (0: none)", device,
+      (portOf[device] == NOPORT) ? 0 : portOf[device] + 1);
+}
+
+bool InputRouter::handleExtCmd(ExtCmd cmd) {
+  switch (cmd) {
+  case ExtCmd::JOYSTICKMODE1:
+    route(JOYSTICK, 0);
+    return true;
+  case ExtCmd::JOYSTICKMODE2:
+    route(JOYSTICK, 1);
+    return true;
+  case ExtCmd::JOYSTICKMODEOFF:
+    route(JOYSTICK, NOPORT);
+    return true;
+  case ExtCmd::KBJOYSTICKMODE1:
+    route(KBJOYSTICK, 0);
+    return true;
+  case ExtCmd::KBJOYSTICKMODE2:
+    route(KBJOYSTICK, 1);
+    return true;
+  case ExtCmd::KBJOYSTICKMODEOFF:
+    route(KBJOYSTICK, NOPORT);
+    return true;
+  default:
+    return false;
+  }
+}
+
+uint32_t InputRouter::pack(const uint8_t values[NUMDEVICES]) const {
+  uint32_t state = RELEASED;
+  for (uint8_t device = 0; device < NUMDEVICES; device++) {
+    if (portOf[device] != NOPORT) {
+      state = press(state, portOf[device], values[device]);
+    }
+  }
+  return state;
+}
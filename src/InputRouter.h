@@ -0,0 +1,89 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef INPUTROUTER_H
+#define INPUTROUTER_H
+
+#include "ExtCmd.h"
+#include <cstdint>
+
+/**
+ * @brief Routes input devices to the joystick ports of the Atari
+ *
+ * Each device is plugged into one of the ports 0-1 (ports 1-2 of the
+ * 800XL) or into none. Devices sharing a port are combined, a direction is
+ * active if any of them pushes it.
+ *
+ * The result is one packed state word:
+ * - bits 0-7: directions of ports 0-1, one nibble each (active low, bit 0
+ *   up, 1 down, 2 left, 3 right), the PORTA input
+ * - bits 16-17: triggers of ports 0-1 (active low)
+ * - other bits: 1
+ */
+class InputRouter {
+public:
+  static const uint8_t NUMPORTS = 2;
+  static const uint8_t NOPORT = 0xff;
+  static const uint32_t RELEASED = 0xffffffff;
+
+  enum Device : uint8_t {
+    JOYSTICK,   // joystick driver (SDL keys, analog ADC)
+    KBJOYSTICK, // virtual joystick of the keyboard driver (web, BLE)
+    NUMDEVICES
+  };
+
+private:
+  uint8_t portOf[NUMDEVICES];
+
+public:
+  InputRouter();
+
+  void route(Device device, uint8_t port);
+  uint8_t getPort(Device device) const { return portOf[device]; }
+
+  /**
+   * @brief Applies a JOYSTICKMODE or KBJOYSTICKMODE command.
+   *
+   * @return false if cmd is no routing command.
+   */
+  bool handleExtCmd(ExtCmd cmd);
+
+  /**
+   * @brief Combines the device values (layout of JoystickDriver::getValue())
+   * into a packed state word.
+   */
+  uint32_t pack(const uint8_t values[NUMDEVICES]) const;
+
+  // value of a port in the layout of JoystickDriver::getValue()
+  static uint8_t getPortValue(uint32_t state, uint8_t port) {
+    return 0xe0 | ((state >> (port * 4)) & 0x0f) |
+           (((state >> (16 + port)) & 0x01) << 4);
+  }
+
+  // state with the value of a port pressed in addition (active low)
+  static uint32_t press(uint32_t state, uint8_t port, uint8_t value) {
+    uint32_t released = (~value & 0x0f) << (port * 4);
+    if (!(value & 0x10)) {
+      released |= 1u << (16 + port);
+    }
+    return state & ~released;
+  }
+
+  static uint8_t getSticks(uint32_t state) { return state & 0xff; }
+  static uint8_t getTriggers(uint32_t state) { return (state >> 16) & 0x03; }
+};
+
+#endif // INPUTROUTER_H
@@ -0,0 +1,185 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "LatencyTrace.h"
+#ifdef USE_LATENCY_TRACE
+#include "Crc32.h"
+#include "platform/PlatformManager.h"
+#include "keyboard/AtariKeycodes.h"
+#include <algorithm>
+#include <cstring>
+
+static const char *TAG = "LatencyTrace";
+
+static const char *SOURCENAMES[] = {"keyboard", "joystick"};
+
+void LatencyTrace::Samples::add(uint32_t v) {
+  value[next] = v;
+  next = (next + 1) % MAXSAMPLES;
+  if (count < MAXSAMPLES) {
+    count++;
+  }
+}
+
+void LatencyTrace::Samples::report(const char *source, const char *name) {
+  if (count == 0) {
+    return;
+  }
+  uint32_t sorted[MAXSAMPLES];
+  memcpy(sorted, value, count * sizeof(uint32_t));
+  std::sort(sorted, sorted + count);
+  PlatformManager::getInstance().log(
+      LOG_INFO, TAG, "%s %s: n=%d min=%u p50=%u p90=%u max=%u", source, name,
+      count, (unsigned)sorted[0], (unsigned)sorted[count / 2],
+      (unsigned)sorted[count * 9 / 10], (unsigned)sorted[count - 1]);
+}
+
+LatencyTrace::LatencyTrace()
+    : waitingRead(0), frame(0), lastCrc(0), latchedJoystick(0xff),
+      displayRequest(0), displayedFrame(0), displayedUS(0),
+      polledJoystick(0xff), joystickArrivalUS(0) {
+  memset(pending, 0, sizeof(pending));
+  memset(stats, 0, sizeof(stats));
+}
+
+uint32_t LatencyTrace::now() {
+  return static_cast<uint32_t>(PlatformManager::getInstance().getTimeUS());
+}
+
+void LatencyTrace::applied(Source src, Register reg, uint32_t arrivalUS,
+                           uint64_t cycle) {
+  Pending &p = pending[static_cast<uint8_t>(src)];
+  if (p.stage != Stage::IDLE) {
+    stats[static_cast<uint8_t>(src)].skipped++;
+    return;
+  }
+  p.stage = Stage::APPLIED;
+  p.reg = reg;
+  p.arrivalUS = arrivalUS;
+  p.appliedCycle = cycle;
+  p.appliedFrame = frame;
+  waitingRead |= 1 << static_cast<uint8_t>(reg);
+}
+
+void LatencyTrace::joystickPolled(uint8_t value) {
+  if (value != polledJoystick) {
+    polledJoystick = value;
+    joystickArrivalUS.store(now(), std::memory_order_release);
+  }
+}
+
+void LatencyTrace::joystickLatched(uint8_t value, uint64_t cycle) {
+  uint8_t changed = value ^ latchedJoystick;
+  latchedJoystick = value;
+  if (changed) {
+    applied(Source::JOYSTICK, (changed & 0x0f) ? Register::PORTA : Register::TRIG,
+            joystickArrivalUS.load(std::memory_order_acquire), cycle);
+  }
+}
+
+bool LatencyTrace::scriptKey(uint32_t frame, AtariKeyEvent &ev) {
+  uint32_t step = frame % 100;
+  if ((step != 0) && (step != 10)) {
+    return false;
+  }
+  ev.type = AtariKeyEvent::Type::KEY;
+  ev.code = ATARI_KEY_A;
+  ev.pressed = step == 0;
+  ev.time = now();
+  return true;
+}
+
+uint8_t LatencyTrace::scriptJoystick(uint32_t frame) {
+  uint32_t step = frame % 100;
+  return ((step >= 50) && (step < 60)) ? 0xf7 : 0xff;
+}
+
+void LatencyTrace::read(Register reg, uint64_t cycle) {
+  uint8_t bit = 1 << static_cast<uint8_t>(reg);
+  if (!(waitingRead & bit)) {
+    return;
+  }
+  waitingRead &= ~bit;
+  uint32_t t = now();
+  for (uint8_t i = 0; i < NUMSOURCES; i++) {
+    Pending &p = pending[i];
+    if ((p.stage == Stage::APPLIED) && (p.reg == reg)) {
+      p.stage = Stage::READ;
+      p.readUS = t;
+      stats[i].applyToReadCycles.add(cycle - p.appliedCycle);
+      stats[i].arrivalToReadUS.add(t - p.arrivalUS);
+    }
+  }
+}
+
+void LatencyTrace::frameEnd(const uint8_t *bitmap, size_t len) {
+  frame++;
+  uint32_t crc = Crc32::update(0, bitmap, len);
+  bool changed = crc != lastCrc;
+  lastCrc = crc;
+
+  uint32_t shown = displayedFrame.load(std::memory_order_acquire);
+  bool request = false;
+  for (uint8_t i = 0; i < NUMSOURCES; i++) {
+    Pending &p = pending[i];
+    if ((p.stage == Stage::READ) && changed) {
+      p.stage = Stage::CHANGED;
+      p.changedFrame = frame;
+      request = true;
+    } else if ((p.stage == Stage::CHANGED) && (shown >= p.changedFrame)) {
+      uint32_t t = displayedUS.load(std::memory_order_acquire);
+      stats[i].readToDisplayUS.add(t - p.readUS);
+      stats[i].arrivalToDisplayUS.add(t - p.arrivalUS);
+      p.stage = Stage::IDLE;
+    } else if ((p.stage != Stage::IDLE) &&
+               (frame - p.appliedFrame > TIMEOUTFRAMES)) {
+      if (p.stage == Stage::APPLIED) {
+        waitingRead &= ~(1 << static_cast<uint8_t>(p.reg));
+      }
+      stats[i].timeouts++;
+      p.stage = Stage::IDLE;
+    }
+  }
+  if (request) {
+    displayRequest.store(frame, std::memory_order_release);
+  }
+  if (frame % REPORTFRAMES == 0) {
+    report();
+  }
+}
+
+void LatencyTrace::framePushed(uint32_t request) {
+  if (request) {
+    displayedUS.store(now(), std::memory_order_release);
+    displayedFrame.store(request, std::memory_order_release);
+  }
+}
+
+void LatencyTrace::report() {
+  for (uint8_t i = 0; i < NUMSOURCES; i++) {
+    Stats &s = stats[i];
+    s.applyToReadCycles.report(SOURCENAMES[i], "apply->read [cycles]");
+    s.arrivalToReadUS.report(SOURCENAMES[i], "arrival->read [us]");
+    s.readToDisplayUS.report(SOURCENAMES[i], "read->display [us]");
+    s.arrivalToDisplayUS.report(SOURCENAMES[i], "arrival->display [us]");
+    if (s.skipped || s.timeouts) {
+      PlatformManager::getInstance().log(
+          LOG_INFO, TAG, "%s: %u skipped, %u timeouts", SOURCENAMES[i],
+          (unsigned)s.skipped, (unsigned)s.timeouts);
+    }
+  }
+}
+#endif
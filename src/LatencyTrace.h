@@ -0,0 +1,177 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef LATENCYTRACE_H
+#define LATENCYTRACE_H
+
+#include "Config.h"
+#ifdef USE_LATENCY_TRACE
+#include "keyboard/AtariKeyQueue.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Measures the latency of input events (instrumentation mode)
+ *
+ * An input event passes four points:
+ * - arrival in the keyboard or joystick driver (host time)
+ * - applied to the emulated chip (emulated cycle)
+ * - first read of the changed register by the guest (PORTA, TRIG, KBCODE,
+ *   CONSOL; emulated cycle and host time)
+ * - the next frame with changed pixels is pushed to the display (host time)
+ *
+ * One event per source is traced at a time, events arriving meanwhile are
+ * counted as skipped. Events without a visible effect are given up after
+ * TIMEOUTFRAMES. The distributions are logged every REPORTFRAMES
+ * frames. All methods are called by the CPU task unless noted otherwise.
+ */
+class LatencyTrace {
+public:
+  enum class Source : uint8_t { KEYBOARD, JOYSTICK };
+  enum class Register : uint8_t { KBCODE, CONSOL, PORTA, TRIG };
+
+private:
+  static const uint8_t NUMSOURCES = 2;
+  static const uint16_t MAXSAMPLES = 256;
+  static const uint16_t REPORTFRAMES = 500;
+  static const uint8_t TIMEOUTFRAMES = 50;
+
+  enum class Stage : uint8_t { IDLE, APPLIED, READ, CHANGED };
+
+  struct Pending {
+    Stage stage;
+    Register reg;
+    uint32_t arrivalUS;
+    uint64_t appliedCycle;
+    uint32_t appliedFrame;
+    uint32_t readUS;
+    uint32_t changedFrame;
+  };
+
+  // ring of the last MAXSAMPLES values
+  struct Samples {
+    uint32_t value[MAXSAMPLES];
+    uint16_t count;
+    uint16_t next;
+    void add(uint32_t v);
+    void report(const char *source, const char *name);
+  };
+
+  struct Stats {
+    Samples applyToReadCycles;
+    Samples arrivalToReadUS;
+    Samples readToDisplayUS;
+    Samples arrivalToDisplayUS;
+    uint32_t skipped;  // event arrived while another one was traced
+    uint32_t timeouts; // not read or no visible change within TIMEOUTFRAMES
+  };
+
+  Pending pending[NUMSOURCES];
+  Stats stats[NUMSOURCES];
+  uint8_t waitingRead; // bit per register with a pending read
+  uint32_t frame;
+  uint32_t lastCrc;
+  uint8_t latchedJoystick;
+
+  // handshake with the main loop: number of a changed frame (0: none)
+  std::atomic<uint32_t> displayRequest;
+  std::atomic<uint32_t> displayedFrame;
+  std::atomic<uint32_t> displayedUS;
+
+  // pollInput: last polled joystick value and arrival of its change
+  uint8_t polledJoystick;
+  std::atomic<uint32_t> joystickArrivalUS;
+
+  void read(Register reg, uint64_t cycle);
+  void report();
+
+public:
+  LatencyTrace();
+
+  static uint32_t now();
+
+  uint32_t getFrame() const { return frame; }
+
+  /**
+   * @brief An input event was applied to the emulated chips.
+   */
+  void applied(Source src, Register reg, uint32_t arrivalUS, uint64_t cycle);
+
+  /**
+   * @brief Called by pollInput with the joystick value of port 1.
+   */
+  void joystickPolled(uint8_t value);
+
+  /**
+   * @brief Called when the joystick value of port 1 is latched.
+   */
+  void joystickLatched(uint8_t value, uint64_t cycle);
+
+  /**
+   * @brief Fixed input pattern for USE_LATENCY_SCRIPT: every 100 frames key
+   * A is pressed for 10 frames, 50 frames later joystick right is pushed
+   * for 10 frames.
+   *
+   * @return true if a key event is due in this frame.
+   */
+  static bool scriptKey(uint32_t frame, AtariKeyEvent &ev);
+  static uint8_t scriptJoystick(uint32_t frame);
+
+  /**
+   * @brief Called for each read of the I/O area.
+   */
+  inline void ioRead(uint16_t addr, uint64_t cycle) {
+    if (!waitingRead) {
+      return;
+    }
+    uint8_t page = addr >> 8;
+    if ((page == 0xd2) && ((addr & 0x0f) == 0x09)) {
+      read(Register::KBCODE, cycle);
+    } else if ((page == 0xd3) && ((addr & 0x03) == 0)) {
+      read(Register::PORTA, cycle);
+    } else if (page == 0xd0) {
+      uint8_t reg = addr & 0x1f;
+      if ((reg >= 0x10) && (reg <= 0x13)) {
+        read(Register::TRIG, cycle);
+      } else if (reg == 0x1f) {
+        read(Register::CONSOL, cycle);
+      }
+    }
+  }
+
+  /**
+   * @brief Called at the end of each emulated frame.
+   */
+  void frameEnd(const uint8_t *bitmap, size_t len);
+
+  /**
+   * @brief Called by the main loop before a frame is pushed to the display.
+   *
+   * @return number of the changed frame to be pushed, 0 if none.
+   */
+  uint32_t takeDisplayRequest() {
+    return displayRequest.exchange(0, std::memory_order_acq_rel);
+  }
+
+  /**
+   * @brief Called by the main loop after a frame was pushed to the display.
+   */
+  void framePushed(uint32_t request);
+};
+#endif
+
+#endif // LATENCYTRACE_H
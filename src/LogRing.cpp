@@ -0,0 +1,195 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "LogRing.h"
+#include "platform/PlatformManager.h"
+#include <cstddef>
+#include <cstdio>
+
+static const char *TAG = "LogRing";
+
+LogRing::Ring LogRing::rings[MAXRINGS];
+std::atomic<uint8_t> LogRing::numRings(0);
+std::atomic<uint32_t> LogRing::droppedNoRing(0);
+
+LogRing::Ring *LogRing::claimRing() {
+  uint8_t n = numRings.load(std::memory_order_relaxed);
+  while (n < MAXRINGS) {
+    if (numRings.compare_exchange_weak(n, n + 1, std::memory_order_acq_rel)) {
+      return &rings[n];
+    }
+  }
+  return nullptr;
+}
+
+uint32_t LogRing::now() {
+  return static_cast<uint32_t>(PlatformManager::getInstance().getTimeUS());
+}
+
+void LogRing::push(LogLevel level, const char *tag, const char *format,
+                   const uint64_t *args, uint8_t numArgs) {
+  static thread_local Ring *ring = claimRing();
+  if (!ring) {
+    droppedNoRing.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  uint32_t head = ring->head.load(std::memory_order_relaxed);
+  if (head - ring->tail.load(std::memory_order_acquire) >= RINGSIZE) {
+    ring->dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  Entry &e = ring->entries[head % RINGSIZE];
+  e.tag = tag;
+  e.format = format;
+  e.timeUS = now();
+  e.level = level;
+  e.numArgs = numArgs;
+  memcpy(e.args, args, numArgs * sizeof(uint64_t));
+  ring->head.store(head + 1, std::memory_order_release);
+}
+
+void LogRing::start() {
+  PlatformManager::getInstance().startTask([](void *) { consumerTask(); }, 0,
+                                           1, "log");
+}
+
+void LogRing::consumerTask() {
+  uint32_t reportedDropped = 0;
+  while (true) {
+    if (drain()) {
+      continue;
+    }
+    uint32_t dropped = droppedNoRing.load(std::memory_order_relaxed);
+    uint8_t n = numRings.load(std::memory_order_acquire);
+    for (uint8_t i = 0; i < n; i++) {
+      dropped += rings[i].dropped.load(std::memory_order_relaxed);
+    }
+    if (dropped != reportedDropped) {
+      PlatformManager::getInstance().log(LOG_WARN, TAG, "%u messages dropped",
+                                         (unsigned)(dropped - reportedDropped));
+      reportedDropped = dropped;
+    }
+    PlatformManager::getInstance().waitMS(POLLMS);
+  }
+}
+
+bool LogRing::drain() {
+  char buf[256];
+  bool any = false;
+  uint8_t n = numRings.load(std::memory_order_acquire);
+  for (uint8_t i = 0; i < n; i++) {
+    Ring &ring = rings[i];
+    uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+    uint32_t head = ring.head.load(std::memory_order_acquire);
+    while (tail != head) {
+      const Entry &e = ring.entries[tail % RINGSIZE];
+      format(e, buf, sizeof(buf));
+      PlatformManager::getInstance().log(static_cast<LogLevel>(e.level), e.tag,
+                                         "%10u %s", (unsigned)e.timeUS, buf);
+      tail++;
+      ring.tail.store(tail, std::memory_order_release);
+      any = true;
+    }
+  }
+  return any;
+}
+
+void LogRing::format(const Entry &e, char *buf, size_t size) {
+  // each conversion is formatted by snprintf with the argument converted to
+  // the type given by the conversion
+  size_t pos = 0;
+  uint8_t arg = 0;
+  const char *f = e.format;
+  while (*f && (pos + 1 < size)) {
+    if (*f != '%') {
+      buf[pos++] = *f++;
+      continue;
+    }
+    const char *start = f++;
+    while (*f && strchr("-+ #0123456789.", *f)) {
+      f++;
+    }
+    char len[3] = {0, 0, 0};
+    while (*f && strchr("hlzjt", *f)) {
+      if (len[1] == 0) {
+        len[len[0] ? 1 : 0] = *f;
+      }
+      f++;
+    }
+    char conv = *f;
+    if (!conv) {
+      break;
+    }
+    f++;
+    char spec[32];
+    size_t speclen = f - start;
+    if (speclen >= sizeof(spec)) {
+      break;
+    }
+    memcpy(spec, start, speclen);
+    spec[speclen] = 0;
+    char *out = buf + pos;
+    size_t room = size - pos;
+    int written = 0;
+    if (conv == '%') {
+      written = snprintf(out, room, "%%");
+    } else if (arg >= e.numArgs) {
+      written = snprintf(out, room, "<?>");
+    } else {
+      uint64_t v = e.args[arg++];
+      bool isLong = (len[0] == 'l') && (len[1] == 0);
+      bool isLongLong = ((len[0] == 'l') && (len[1] == 'l')) || (len[0] == 'j');
+      bool isSize = (len[0] == 'z') || (len[0] == 't');
+      if (strchr("di", conv)) {
+        if (isLongLong) {
+          written = snprintf(out, room, spec, static_cast<long long>(v));
+        } else if (isLong) {
+          written = snprintf(out, room, spec, static_cast<long>(v));
+        } else if (isSize) {
+          written = snprintf(out, room, spec, static_cast<ptrdiff_t>(v));
+        } else {
+          written = snprintf(out, room, spec, static_cast<int>(v));
+        }
+      } else if (strchr("ouxXc", conv)) {
+        if (isLongLong) {
+          written =
+              snprintf(out, room, spec, static_cast<unsigned long long>(v));
+        } else if (isLong) {
+          written = snprintf(out, room, spec, static_cast<unsigned long>(v));
+        } else if (isSize) {
+          written = snprintf(out, room, spec, static_cast<size_t>(v));
+        } else {
+          written = snprintf(out, room, spec, static_cast<unsigned>(v));
+        }
+      } else if (strchr("fFeEgGaA", conv)) {
+        double d;
+        memcpy(&d, &v, sizeof(d));
+        written = snprintf(out, room, spec, d);
+      } else if (conv == 's') {
+        const char *s = reinterpret_cast<const char *>(static_cast<uintptr_t>(v));
+        written = snprintf(out, room, spec, s ? s : "(null)");
+      } else if (conv == 'p') {
+        written = snprintf(out, room, spec,
+                           reinterpret_cast<void *>(static_cast<uintptr_t>(v)));
+      }
+    }
+    if (written < 0) {
+      break;
+    }
+    pos += (static_cast<size_t>(written) < room) ? written : room - 1;
+  }
+  buf[pos] = 0;
+}
@@ -0,0 +1,128 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef LOGRING_H
+#define LOGRING_H
+
+#include "Config.h"
+#include "platform/Platform.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// messages with a level above LOGRING_LEVEL are removed at compile time
+#ifndef LOGRING_LEVEL
+#define LOGRING_LEVEL LOG_INFO
+#endif
+
+/**
+ * @brief Logs from the emulation without formatting or locking
+ *
+ * Example: RINGLOG(LOG_VERBOSE, TAG, "write %04x=%02x", addr, val);
+ * Format and tag must be string literals, arguments must be integers,
+ * floating point values, pointers (%p) or string literals (%s). Width and
+ * precision given as '*' are not supported.
+ */
+#define RINGLOG(level, tag, ...)                                               \
+  do {                                                                         \
+    if constexpr ((level) <= LOGRING_LEVEL) {                                  \
+      LogRing::write((level), (tag), __VA_ARGS__);                             \
+    }                                                                          \
+  } while (0)
+
+/**
+ * @brief Binary log ring
+ *
+ * Each thread writing a message claims one of MAXRINGS rings on its first
+ * message. The writer stores the format pointer and the raw arguments
+ * (single producer, single consumer, no allocation). The task started by
+ * start() formats the entries and passes them to Platform::log. Messages
+ * are dropped and counted if a ring is full or no ring is left.
+ */
+class LogRing {
+public:
+  static const uint8_t MAXARGS = 4;
+  static const uint8_t MAXRINGS = 4;
+#ifdef ESP_PLATFORM
+  static const uint16_t RINGSIZE = 64;
+#else
+  static const uint16_t RINGSIZE = 1024;
+#endif
+
+private:
+  static const uint8_t POLLMS = 20;
+
+  struct Entry {
+    const char *tag;
+    const char *format;
+    uint32_t timeUS;
+    uint8_t level;
+    uint8_t numArgs;
+    uint64_t args[MAXARGS];
+  };
+
+  struct Ring {
+    Entry entries[RINGSIZE];
+    std::atomic<uint32_t> head; // written by the producer
+    std::atomic<uint32_t> tail; // written by the consumer
+    std::atomic<uint32_t> dropped;
+  };
+
+  static Ring rings[MAXRINGS];
+  static std::atomic<uint8_t> numRings;
+  static std::atomic<uint32_t> droppedNoRing;
+
+  static Ring *claimRing();
+  static uint32_t now();
+  static void consumerTask();
+  static bool drain();
+  static void format(const Entry &e, char *buf, size_t size);
+
+  template <typename T> static uint64_t toRaw(T v) {
+    if constexpr (std::is_floating_point<T>::value) {
+      double d = v;
+      uint64_t raw;
+      memcpy(&raw, &d, sizeof(raw));
+      return raw;
+    } else if constexpr (std::is_pointer<T>::value) {
+      return reinterpret_cast<uintptr_t>(v);
+    } else if constexpr (std::is_signed<T>::value) {
+      return static_cast<uint64_t>(static_cast<int64_t>(v));
+    } else {
+      return static_cast<uint64_t>(v);
+    }
+  }
+
+  static void push(LogLevel level, const char *tag, const char *format,
+                   const uint64_t *args, uint8_t numArgs);
+
+public:
+  /**
+   * @brief Starts the task formatting the messages.
+   */
+  static void start();
+
+  template <typename... Args>
+  static void write(LogLevel level, const char *tag, const char *format,
+                    Args... args) {
+    static_assert(sizeof...(Args) <= MAXARGS, "too many log arguments");
+    const uint64_t raw[MAXARGS + 1] = {toRaw(args)...};
+    push(level, tag, format, raw, sizeof...(Args));
+  }
+};
+
+#endif // LOGRING_H
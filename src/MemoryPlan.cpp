@@ -0,0 +1,159 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "MemoryPlan.h"
+#include "ANTIC.h"
+#include "Atari800Sys.h"
+#include "Cartridge.h"
+#include "platform/PlatformManager.h"
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+#include <esp_memory_utils.h>
+#endif
+
+static const char *TAG = "MemoryPlan";
+
+static const uint8_t NUMREGIONS =
+    static_cast<uint8_t>(MemoryPlan::Region::NUMREGIONS);
+
+// same order as MemoryPlan::Region
+const MemoryPlan::RegionInfo MemoryPlan::REGIONS[] = {
+    {"ram", MEM_64K, Placement::HOT, false},
+    {"bitmap", ATARI_WIDTH * ATARI_HEIGHT * sizeof(uint16_t), Placement::HOT,
+     false},
+    {"cartcache", Cartridge::CACHESIZE, Placement::COLD, true},
+};
+
+void *MemoryPlan::base[NUMREGIONS];
+
+bool MemoryPlan::hasPSRAM() {
+#ifdef ESP_PLATFORM
+  return heap_caps_get_total_size(MALLOC_CAP_SPIRAM) > 0;
+#else
+  return true;
+#endif
+}
+
+void *MemoryPlan::allocate(size_t size, Placement placement, bool fallback) {
+#ifdef ESP_PLATFORM
+  uint32_t caps = (placement == Placement::HOT)
+                      ? (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+                      : (MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+  void *p = heap_caps_aligned_alloc(ALIGNMENT, size, caps);
+  if (!p && fallback) {
+    p = heap_caps_aligned_alloc(ALIGNMENT, size, MALLOC_CAP_8BIT);
+  }
+  return p;
+#else
+  (void)placement;
+  (void)fallback;
+  return malloc(size);
+#endif
+}
+
+const char *MemoryPlan::location(const void *p) {
+#ifdef ESP_PLATFORM
+  if (esp_ptr_external_ram(p)) {
+    return "psram";
+  }
+  return esp_ptr_internal(p) ? "sram" : "other";
+#else
+  (void)p;
+  return "heap";
+#endif
+}
+
+void MemoryPlan::init() {
+  const Placement placements[] = {Placement::HOT, Placement::COLD};
+  for (Placement placement : placements) {
+    if ((placement == Placement::COLD) && !hasPSRAM()) {
+      continue;
+    }
+    size_t total = 0;
+    for (uint8_t i = 0; i < NUMREGIONS; i++) {
+      if ((REGIONS[i].placement == placement) && !REGIONS[i].onFirstUse) {
+        total += aligned(REGIONS[i].size);
+      }
+    }
+    if (total == 0) {
+      continue;
+    }
+    uint8_t *arena = static_cast<uint8_t *>(allocate(total, placement, false));
+    for (uint8_t i = 0; i < NUMREGIONS; i++) {
+      if ((REGIONS[i].placement != placement) || REGIONS[i].onFirstUse) {
+        continue;
+      }
+      if (arena) {
+        base[i] = arena;
+        arena += aligned(REGIONS[i].size);
+      } else {
+        base[i] = allocate(REGIONS[i].size, placement,
+                           placement == Placement::HOT);
+        if (!base[i] && (placement == Placement::HOT)) {
+          throw std::runtime_error("cannot allocate emulator memory");
+        }
+      }
+      if (base[i]) {
+        memset(base[i], 0, REGIONS[i].size);
+      }
+    }
+  }
+}
+
+void *MemoryPlan::get(Region region) {
+  uint8_t i = static_cast<uint8_t>(region);
+  if (!base[i] && REGIONS[i].onFirstUse &&
+      ((REGIONS[i].placement == Placement::HOT) || hasPSRAM())) {
+    base[i] = allocate(REGIONS[i].size, REGIONS[i].placement, false);
+    if (base[i]) {
+      memset(base[i], 0, REGIONS[i].size);
+      reportObject(REGIONS[i].name, base[i], REGIONS[i].size);
+    }
+  }
+  return base[i];
+}
+
+size_t MemoryPlan::size(Region region) {
+  return REGIONS[static_cast<uint8_t>(region)].size;
+}
+
+void MemoryPlan::report() {
+  for (uint8_t i = 0; i < NUMREGIONS; i++) {
+    if (base[i]) {
+      reportObject(REGIONS[i].name, base[i], REGIONS[i].size);
+    } else {
+      PlatformManager::getInstance().log(
+          LOG_INFO, TAG, "%-10s %7u bytes %s", REGIONS[i].name,
+          (unsigned)REGIONS[i].size,
+          REGIONS[i].onFirstUse ? "on first use" : "on demand");
+    }
+  }
+#ifdef ESP_PLATFORM
+  PlatformManager::getInstance().log(
+      LOG_INFO, TAG, "free: sram %u (largest block %u), psram %u",
+      (unsigned)heap_caps_get_free_size(MALLOC_CAP_INTERNAL),
+      (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_INTERNAL),
+      (unsigned)heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
+#endif
+}
+
+void MemoryPlan::reportObject(const char *name, const void *p, size_t size) {
+  PlatformManager::getInstance().log(LOG_INFO, TAG, "%-10s %7u bytes at %p (%s)",
+                                     name, (unsigned)size, p, location(p));
+}
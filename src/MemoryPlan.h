@@ -0,0 +1,89 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef MEMORYPLAN_H
+#define MEMORYPLAN_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Placement of the large emulator buffers
+ *
+ * The regions are reserved once at startup, one arena per placement:
+ * - HOT regions (accessed every cycle or scanline) are placed in internal
+ *   SRAM. If the arena cannot be allocated in one block, each region is
+ *   allocated separately, in any memory as last resort.
+ * - COLD regions (accessed on bank switches or file operations) are placed
+ *   in PSRAM. Without PSRAM no memory is reserved for them and get()
+ *   returns nullptr, the owner then allocates on demand.
+ * Regions only needed by an optional device (the cartridge cache) are
+ * reserved by the first get() instead and kept afterwards.
+ *
+ * On Linux and Windows both arenas come from the heap. Objects with static
+ * storage (e.g. Atari800Sys with CPU registers and page tables) are placed
+ * by the linker and can be added to the startup report by reportObject().
+ */
+class MemoryPlan {
+public:
+  enum class Region : uint8_t { RAM, BITMAP, CARTCACHE, NUMREGIONS };
+
+private:
+  enum class Placement : uint8_t { HOT, COLD };
+
+  struct RegionInfo {
+    const char *name;
+    size_t size;
+    Placement placement;
+    bool onFirstUse; // reserved by get(), not by init()
+  };
+
+  static const size_t ALIGNMENT = 16;
+  static const RegionInfo REGIONS[];
+  static void *base[static_cast<uint8_t>(Region::NUMREGIONS)];
+
+  static size_t aligned(size_t size) {
+    return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  }
+  static bool hasPSRAM();
+  static void *allocate(size_t size, Placement placement, bool fallback);
+  static const char *location(const void *p);
+
+public:
+  /**
+   * @brief Reserves the regions needed from the start, called once before
+   * the emulator is initialized. Throws std::runtime_error if a hot region
+   * cannot be allocated.
+   */
+  static void init();
+
+  /**
+   * @brief Returns the memory of a region (zeroed when reserved), nullptr
+   * if a cold region cannot be reserved.
+   */
+  static void *get(Region region);
+
+  static size_t size(Region region);
+
+  /**
+   * @brief Logs address, size and memory type of each region.
+   */
+  static void report();
+
+  static void reportObject(const char *name, const void *p, size_t size);
+};
+
+#endif // MEMORYPLAN_H
@@ -28,8 +28,7 @@ void PIA::reset() {
   ddrb = 0x00;
   pbctl = 0x00;
 
-  joy1 = 0;  // No joystick input
-  joy2 = 0;
+  sticks = 0xFF;  // No joystick input
 }
 
 uint8_t PIA::read(uint8_t addr) {
@@ -39,12 +38,8 @@ uint8_t PIA::read(uint8_t addr) {
   case PORTA:
     if (pactl & PIA_DDR) {
       // Read data register
-      // Combine joystick input with port settings
-      // Joystick inputs are active-low
-      uint8_t joy1Bits = joy1 ? ((~joy1) & 0x0F) : 0x0F;
-      uint8_t joy2Bits = joy2 ? ((~joy2) & 0x0F) << 4 : 0xF0;
-      // Inputs come from joysticks, outputs from porta
-      return (joy1Bits & ~ddra) | (joy2Bits & ~ddra) | (porta & ddra);
+      // Inputs come from joysticks 1 and 2 (active-low), outputs from porta
+      return (sticks & ~ddra) | (porta & ddra);
     } else {
       // Read DDR
       return ddra;
@@ -105,18 +100,22 @@ void PIA::write(uint8_t addr, uint8_t val) {
   }
 }
 
-void PIA::setJoystick1(bool up, bool down, bool left, bool right) {
-  joy1 = 0;
-  if (up)    joy1 |= 0x01;
-  if (down)  joy1 |= 0x02;
-  if (left)  joy1 |= 0x04;
-  if (right) joy1 |= 0x08;
+void PIA::saveState(SnapshotWriter &w) const {
+  w.put(porta);
+  w.put(ddra);
+  w.put(pactl);
+  w.put(portb);
+  w.put(ddrb);
+  w.put(pbctl);
+  w.put(sticks);
 }
 
-void PIA::setJoystick2(bool up, bool down, bool left, bool right) {
-  joy2 = 0;
-  if (up)    joy2 |= 0x01;
-  if (down)  joy2 |= 0x02;
-  if (left)  joy2 |= 0x04;
-  if (right) joy2 |= 0x08;
+void PIA::loadState(SnapshotReader &r) {
+  r.get(porta);
+  r.get(ddra);
+  r.get(pactl);
+  r.get(portb);
+  r.get(ddrb);
+  r.get(pbctl);
+  r.get(sticks);
 }
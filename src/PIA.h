@@ -17,6 +17,7 @@
 #ifndef PIA_H
 #define PIA_H
 
+#include "Snapshot.h"
 #include <cstdint>
 
 // PIA register addresses (offset from base $D300)
@@ -73,9 +74,9 @@ private:
   uint8_t ddrb;         // Data direction register
   uint8_t pbctl;        // Control register
 
-  // Joystick state (directly written by emulator)
-  uint8_t joy1;         // Joystick 1 direction bits (active-high internally)
-  uint8_t joy2;         // Joystick 2 direction bits (active-high internally)
+  // Joystick directions (written by the emulator once per frame), active
+  // low: the PORTA inputs (joysticks 1 and 2)
+  uint8_t sticks;
 
 public:
   PIA();
@@ -86,14 +87,17 @@ public:
   void write(uint8_t addr, uint8_t val);
 
   // Joystick interface (called by emulator)
-  void setJoystick1(bool up, bool down, bool left, bool right);
-  void setJoystick2(bool up, bool down, bool left, bool right);
+  void setSticks(uint8_t state) { sticks = state; }
 
   // Memory control (for XL/XE banking)
   uint8_t getPortB() const { return portb; }
   bool isOSROMEnabled() const { return (portb & PORTB_OS_ROM) == 0; }
   bool isBASICEnabled() const { return (portb & PORTB_BASIC) == 0; }
   bool isSelfTestEnabled() const { return (portb & PORTB_SELFTEST) == 0; }
+
+  // Snapshot support
+  void saveState(SnapshotWriter &w) const;
+  void loadState(SnapshotReader &r);
 };
 
 #endif // PIA_H
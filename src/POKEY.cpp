@@ -15,6 +15,7 @@
  http://www.gnu.org/licenses/.
 */
 #include "POKEY.h"
+#include "keyboard/AtariKeycodes.h"
 #include "sound/SoundFactory.h"
 #include <cstring>
 
@@ -43,7 +44,13 @@ void POKEYChannel::setControl(uint8_t ctrl) {
   audc = ctrl;
 }
 
-POKEY::POKEY() : sound(nullptr), actSampleIdx(0) {
+POKEY::POKEY()
+    : sound(nullptr), actSampleIdx(0), sampleStep(1), holdLeft(0),
+      heldSample(0), requestedStep(1), keyMatrix(0), keyModifiers(0),
+      synthesizedSamples(0) {
+  for (int i = 0; i < 8; i++) {
+    potInput[i] = POT_MAX;
+  }
   emuVolume = 1.0f;
   emuVolumeScaled = 128;
   reset();
@@ -78,6 +85,7 @@ void POKEY::reset() {
   poly9 = 0x1FF;
   poly17 = 0x1FFFF;
   polyStep = 0;
+  clockFrac = 0;
 
   irqen = 0;
   irqst = 0xFF;  // All interrupts inactive (active-low)
@@ -86,16 +94,22 @@ void POKEY::reset() {
   keyPressed = false;
   skctl = 0;
   skstat = 0xFF;
+  scanKey = 0;
+  debounceKey = NOKEY;
+  keyEventLines = 0;
 
   for (int i = 0; i < 8; i++) {
-    pot[i] = 228;  // Middle position
+    pot[i] = POT_MAX;
   }
   allpot = 0;
+  potCounter = POT_MAX;
+  potScanning = false;
 
   serout = 0;
   serin = 0;
   random = 0xFF;
   actSampleIdx = 0;
+  holdLeft = 0;
 
   memset(samples, 0, sizeof(samples));
 }
@@ -167,14 +181,19 @@ void POKEY::updateChannelPeriods() {
   }
 }
 
-int16_t POKEY::generateSample() {
+int16_t POKEY::generateSample(uint8_t step, uint32_t clocks16) {
   int32_t output = 0;
 
-  // Update polynomials (roughly once per sample)
-  polyStep++;
+  // Machine clock cycles covered by this sample (16.16 fixed point)
+  clocks16 += clockFrac;
+  clockFrac = clocks16 & 0xffff;
+  const uint32_t clocks = clocks16 >> 16;
+
+  // Update polynomials (roughly once per 40 samples)
+  polyStep += step;
   if (polyStep >= 40) {  // ~44kHz / 40 = ~1.1kHz polynomial update rate
     updatePolynomials();
-    polyStep = 0;
+    polyStep -= 40;
   }
 
   // Process each channel
@@ -193,12 +212,18 @@ int16_t POKEY::generateSample() {
     // Skip silent channels
     if (c.getVolume() == 0) continue;
 
-    // Update divider
-    if (c.divider > 0) {
-      c.divider--;
+    // Update divider by the clock cycles of this sample, a short period
+    // can expire several times
+    uint32_t ticks = clocks;
+    if (ticks > c.divider) {
+      ticks -= c.divider + 1;
+      const uint32_t len = c.period + 1;
+      if ((ticks / len) % 2 == 0) {
+        c.output = !c.output;
+      }
+      c.divider = c.period - ticks % len;
     } else {
-      c.divider = c.period;
-      c.output = !c.output;
+      c.divider -= ticks;
     }
 
     // Generate output based on distortion mode
@@ -267,7 +292,7 @@ uint8_t POKEY::read(uint8_t addr) {
   case POT5_R:
   case POT6_R:
   case POT7_R:
-    return pot[addr];
+    return (potCounter < pot[addr]) ? potCounter : pot[addr];
 
   case ALLPOT_R:
     return allpot;
@@ -387,36 +412,87 @@ void POKEY::write(uint8_t addr, uint8_t val) {
   }
 }
 
-void POKEY::fillBuffer(uint16_t scanline) {
-  // Calculate target samples for this scanline (PAL: 312 lines)
-  uint16_t targetSampleIdx = (uint16_t)(((uint32_t)(scanline + 1) * NUMSAMPLESPERFRAME) / 312);
-  if (targetSampleIdx > NUMSAMPLESPERFRAME) {
-    targetSampleIdx = NUMSAMPLESPERFRAME;
+template <class Timing> void POKEY::fillBuffer(uint16_t scanline) {
+  constexpr uint16_t samplesPerFrame = AUDIO_SAMPLE_RATE / Timing::FRAMERATE;
+  static_assert(samplesPerFrame <= MAXSAMPLESPERFRAME, "audio buffer");
+  // Machine clock cycles per output sample (16.16 fixed point)
+  constexpr uint32_t clocksPerSample =
+      (uint32_t)(((uint64_t)Timing::CPUCLOCK << 16) / AUDIO_SAMPLE_RATE);
+
+  // Calculate target samples for this scanline
+  uint16_t targetSampleIdx = (uint16_t)(((uint32_t)(scanline + 1) * samplesPerFrame) / Timing::SCANLINES);
+  if (targetSampleIdx > samplesPerFrame) {
+    targetSampleIdx = samplesPerFrame;
   }
 
   while (actSampleIdx < targetSampleIdx) {
-    samples[actSampleIdx++] = generateSample();
+    if (holdLeft == 0) {
+      heldSample = generateSample(sampleStep, clocksPerSample * sampleStep);
+      holdLeft = sampleStep;
+      synthesizedSamples.fetch_add(1, std::memory_order_relaxed);
+    }
+    samples[actSampleIdx++] = heldSample;
+    holdLeft--;
   }
 }
 
+template void POKEY::fillBuffer<PALTiming>(uint16_t scanline);
+template void POKEY::fillBuffer<NTSCTiming>(uint16_t scanline);
+
 void POKEY::playAudio() {
   if (sound) {
     sound->playAudio(samples, actSampleIdx * sizeof(int16_t));
   }
   actSampleIdx = 0;
+  sampleStep = requestedStep.load(std::memory_order_relaxed);
 }
 
 void POKEY::setKeyCode(uint8_t code, bool pressed) {
+  uint64_t bit = 1ULL << (code & 0x3f);
   if (pressed) {
-    kbcode = code;
-    keyPressed = true;
-    skstat &= ~SKSTAT_KEYDOWN;  // Active-low: key is down
-
-    // Trigger keyboard interrupt if enabled
-    if (irqen & IRQ_KEYPRESS) {
-      irqst &= ~IRQ_KEYPRESS;
+    if (keyMatrix & bit) {
+      return;  // host key repeat
+    }
+    keyMatrix |= bit;
+    keyModifiers = code & (ATARI_MOD_SHIFT | ATARI_MOD_CONTROL);
+  } else {
+    keyMatrix &= ~bit;
+    if (keyMatrix == 0) {
+      keyModifiers = 0;
     }
+  }
+  if (keyModifiers & ATARI_MOD_SHIFT) {
+    skstat &= ~SKSTAT_SHIFT;
   } else {
+    skstat |= SKSTAT_SHIFT;
+  }
+  // the change must be seen by the scan before the next one is applied
+  keyEventLines = KEYEVENTLINES;
+}
+
+void POKEY::scanKeyboard() {
+  if (keyEventLines > 0) {
+    keyEventLines--;
+  }
+  if (!(skctl & SKCTL_KEYSCAN)) {
+    return;
+  }
+  uint8_t key = scanKey;
+  scanKey = (scanKey + 1) & 0x3f;
+  if (keyMatrix & (1ULL << key)) {
+    if (!(skctl & SKCTL_DEBOUNCE) || (debounceKey == key)) {
+      if (!keyPressed || ((kbcode & 0x3f) != key)) {
+        kbcode = key | keyModifiers;
+        keyPressed = true;
+        skstat &= ~SKSTAT_KEYDOWN;  // Active-low: key is down
+        if (irqen & IRQ_KEYPRESS) {
+          irqst &= ~IRQ_KEYPRESS;
+        }
+      }
+    }
+    debounceKey = key;
+  } else if (key == debounceKey) {
+    debounceKey = NOKEY;
     keyPressed = false;
     skstat |= SKSTAT_KEYDOWN;  // Active-low: no key down
   }
@@ -430,16 +506,35 @@ void POKEY::setBreakKey(bool pressed) {
 
 void POKEY::setPaddle(uint8_t num, uint8_t value) {
   if (num < 8) {
-    pot[num] = value;
+    potInput[num] = (value < POT_MAX) ? value : POT_MAX;
   }
 }
 
 void POKEY::startPotScan() {
-  // Start POT scan - all POTs start at 0 and count up
-  allpot = 0xFF;
-  // In a full implementation, this would start a timer
-  // For simplicity, we immediately complete the scan
-  allpot = 0x00;
+  // All POTs start at 0 and count up, each one stops at its position
+  potCounter = 0;
+  allpot = 0;
+  for (int i = 0; i < 8; i++) {
+    pot[i] = potInput[i];
+    if (pot[i] > 0) {
+      allpot |= 1 << i;
+    }
+  }
+  potScanning = allpot != 0;
+}
+
+void POKEY::scanPots() {
+  if (!potScanning) {
+    return;
+  }
+  uint16_t counter = potCounter + ((skctl & SKCTL_FASTPOT) ? FASTPOTSTEP : 1);
+  potCounter = (counter < POT_MAX) ? counter : POT_MAX;
+  for (int i = 0; i < 8; i++) {
+    if (potCounter >= pot[i]) {
+      allpot &= ~(1 << i);
+    }
+  }
+  potScanning = allpot != 0;
 }
 
 bool POKEY::checkIRQ() {
@@ -477,3 +572,81 @@ void POKEY::setEmuVolume(uint8_t volume) {
   emuVolumeScaled = volume;
   emuVolume = volume / 128.0f;
 }
+
+void POKEY::saveState(SnapshotWriter &w) const {
+  w.put(actSampleIdx);
+  w.put(audctl);
+  w.put(poly9Mode);
+  w.put(ch1_179mhz);
+  w.put(ch3_179mhz);
+  w.put(ch12_joined);
+  w.put(ch34_joined);
+  w.put(ch1_highpass);
+  w.put(ch2_highpass);
+  w.put(clock15khz);
+  w.put(poly4);
+  w.put(poly5);
+  w.put(poly9);
+  w.put(poly17);
+  w.put(polyStep);
+  w.put(irqen);
+  w.put(irqst);
+  w.put(kbcode);
+  w.put(keyPressed);
+  w.put(skctl);
+  w.put(skstat);
+  w.put(pot);
+  w.put(allpot);
+  w.put(potCounter);
+  w.put(potScanning);
+  w.put(serout);
+  w.put(serin);
+  w.put(random);
+  for (const POKEYChannel &ch : channel) {
+    w.put(ch.audf);
+    w.put(ch.audc);
+    w.put(ch.divider);
+    w.put(ch.period);
+    w.put(ch.output);
+    w.put(ch.lastOutput);
+  }
+}
+
+void POKEY::loadState(SnapshotReader &r) {
+  r.get(actSampleIdx);
+  r.get(audctl);
+  r.get(poly9Mode);
+  r.get(ch1_179mhz);
+  r.get(ch3_179mhz);
+  r.get(ch12_joined);
+  r.get(ch34_joined);
+  r.get(ch1_highpass);
+  r.get(ch2_highpass);
+  r.get(clock15khz);
+  r.get(poly4);
+  r.get(poly5);
+  r.get(poly9);
+  r.get(poly17);
+  r.get(polyStep);
+  r.get(irqen);
+  r.get(irqst);
+  r.get(kbcode);
+  r.get(keyPressed);
+  r.get(skctl);
+  r.get(skstat);
+  r.get(pot);
+  r.get(allpot);
+  r.get(potCounter);
+  r.get(potScanning);
+  r.get(serout);
+  r.get(serin);
+  r.get(random);
+  for (POKEYChannel &ch : channel) {
+    r.get(ch.audf);
+    r.get(ch.audc);
+    r.get(ch.divider);
+    r.get(ch.period);
+    r.get(ch.output);
+    r.get(ch.lastOutput);
+  }
+}
@@ -18,7 +18,10 @@
 #define POKEY_H
 
 #include "Config.h"
+#include "Snapshot.h"
+#include "VideoTiming.h"
 #include "sound/SoundDriver.h"
+#include <atomic>
 #include <cstdint>
 
 // POKEY register addresses (offset from base $D200)
@@ -77,10 +80,18 @@ constexpr uint8_t IRQ_BREAK = 0x80;        // Break key pressed
 // SKSTAT bits (active-low)
 constexpr uint8_t SKSTAT_SERIN = 0x10;     // Serial input shift register busy
 constexpr uint8_t SKSTAT_KEYDOWN = 0x04;   // Any key pressed
-constexpr uint8_t SKSTAT_LASTKEY = 0x08;   // Last key still pressed
+constexpr uint8_t SKSTAT_SHIFT = 0x08;     // Shift key pressed
 
-// POKEY base clock frequency (NTSC)
-constexpr uint32_t POKEY_FREQ = 1789790;
+// SKCTL bits
+constexpr uint8_t SKCTL_DEBOUNCE = 0x01;   // Keyboard debounce enable
+constexpr uint8_t SKCTL_KEYSCAN = 0x02;    // Keyboard scan enable
+constexpr uint8_t SKCTL_FASTPOT = 0x04;    // Fast pot scan
+
+// Paddles: highest POT count, also read for an unconnected paddle
+constexpr uint8_t POT_MAX = 228;
+
+// Channel periods are counted in cycles of the machine clock
+// (Timing::CPUCLOCK), which differs slightly between PAL and NTSC
 constexpr uint32_t POKEY_DIV_64 = 28;      // 64 kHz divisor (~63.9 kHz)
 constexpr uint32_t POKEY_DIV_15 = 114;     // 15 kHz divisor (~15.7 kHz)
 
@@ -119,11 +130,20 @@ public:
  */
 class POKEY {
 private:
-  static const uint16_t NUMSAMPLESPERFRAME = AUDIO_SAMPLE_RATE / 50;
-  int16_t samples[NUMSAMPLESPERFRAME];
+  // buffer of the longest frame (PAL)
+  static const uint16_t MAXSAMPLESPERFRAME =
+      AUDIO_SAMPLE_RATE / PALTiming::FRAMERATE;
+  int16_t samples[MAXSAMPLESPERFRAME];
   SoundDriver *sound;
   uint16_t actSampleIdx;
 
+  // Reduced synthesis rate (host setting, not saved): one sample is
+  // synthesized per sampleStep output samples and held
+  uint8_t sampleStep;
+  uint8_t holdLeft;
+  int16_t heldSample;
+  std::atomic<uint8_t> requestedStep;
+
   // Audio channels
   POKEYChannel channel[4];
 
@@ -144,6 +164,7 @@ private:
   uint32_t poly9;         // 9-bit polynomial counter
   uint32_t poly17;        // 17-bit polynomial counter
   uint32_t polyStep;      // Counter for polynomial updates
+  uint16_t clockFrac;     // Fraction of a clock cycle left from last sample
 
   // Timer/interrupt related
   uint8_t irqen;          // IRQ enable register
@@ -155,9 +176,25 @@ private:
   uint8_t skctl;          // Serial control
   uint8_t skstat;         // Serial status
 
-  // Paddle (POT) inputs
-  uint8_t pot[8];         // Paddle values
-  uint8_t allpot;         // All paddle scan status
+  // Keyboard scan: one of the 64 keys is checked per scanline, with
+  // debounce a key is reported when it is found again one scan later
+  static const uint8_t NOKEY = 0xff;
+  static const uint8_t KEYEVENTLINES = 128;  // two full scans
+  uint64_t keyMatrix;     // Keys held down (host state, not reset)
+  uint8_t keyModifiers;   // ATARI_MOD_SHIFT / ATARI_MOD_CONTROL
+  uint8_t scanKey;        // Key checked next
+  uint8_t debounceKey;    // Key found during the last scan
+  uint8_t keyEventLines;  // Scanlines until the next event is accepted
+
+  // Paddle (POT) inputs: POTGO latches the paddle positions and resets the
+  // counter, which advances once per scanline (by FASTPOTSTEP with fast
+  // scan). A pot reads the counter until it reaches the latched position.
+  static const uint8_t FASTPOTSTEP = 114;  // one count per cycle
+  uint8_t pot[8];         // Latched paddle positions
+  uint8_t allpot;         // All paddle scan status (1: still counting)
+  uint8_t potCounter;     // Scan counter (0 - POT_MAX)
+  bool potScanning;       // Any pot still counting
+  uint8_t potInput[8];    // Paddle positions (host state, not reset)
 
   // Serial I/O
   uint8_t serout;         // Serial output register
@@ -168,7 +205,7 @@ private:
 
   void updatePolynomials();
   void updateChannelPeriods();
-  int16_t generateSample();
+  int16_t generateSample(uint8_t step, uint32_t clocks16);
 
 public:
   // Volume control
@@ -184,16 +221,31 @@ public:
   void write(uint8_t addr, uint8_t val);
 
   // Audio generation (called each scanline)
-  void fillBuffer(uint16_t scanline);
+  // Samples up to the end of scanline (frame of Timing, see VideoTiming.h)
+  template <class Timing> void fillBuffer(uint16_t scanline);
   void playAudio();
 
+  /**
+   * @brief Synthesizes only every step-th sample (1, 2 or 4), taken over at
+   * the next frame. May be called from any thread.
+   */
+  void setSampleStep(uint8_t step) {
+    requestedStep.store(step, std::memory_order_relaxed);
+  }
+
+  // samples synthesized since start (output samples / sampleStep)
+  std::atomic<uint32_t> synthesizedSamples;
+
   // Keyboard interface
   void setKeyCode(uint8_t code, bool pressed);
   void setBreakKey(bool pressed);
+  void scanKeyboard();  // called each scanline
+  bool readyForKeyEvent() const { return keyEventLines == 0; }
 
   // Paddle interface
   void setPaddle(uint8_t num, uint8_t value);
   void startPotScan();
+  void scanPots();  // called each scanline
 
   // IRQ interface
   bool checkIRQ();
@@ -207,6 +259,10 @@ public:
   // Volume control
   uint8_t getEmuVolume() const;
   void setEmuVolume(uint8_t volume);
+
+  // Snapshot support
+  void saveState(SnapshotWriter &w) const;
+  void loadState(SnapshotReader &r);
 };
 
 #endif // POKEY_H
@@ -0,0 +1,158 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "PerfGovernor.h"
+#include "Atari800Sys.h"
+#include "board/BoardDriver.h"
+#include "platform/PlatformManager.h"
+
+static const char *TAG = "PerfGovernor";
+
+PerfGovernor::PerfGovernor()
+    : sys(nullptr), board(nullptr), level(Level::NORMAL), secondsToVoltage(0),
+      lastSamples(0), lastHash(0), lastRefreshUS(0), framesSkipped(0),
+      skippedRefreshes(0),
+      refreshUS(0), policies(0), batteryMV(0), refreshSkippedPerSecond(0),
+      refreshUSPerSecond(0), audioSamplesPerSecond(0) {}
+
+void PerfGovernor::init(Atari800Sys *sys, BoardDriver *board) {
+  this->sys = sys;
+  this->board = board;
+}
+
+PerfGovernor::Level PerfGovernor::selectLevel(uint16_t mv) const {
+  if (mv == 0) {
+    // no battery (or not measurable)
+    return Level::NORMAL;
+  }
+  // a level is left upwards only HYSTERESISMV above its threshold
+  const uint16_t thresholds[] = {SAVEMV, LOWMV, CRITICALMV};
+  uint8_t newLevel = 0;
+  for (uint16_t threshold : thresholds) {
+    uint16_t limit = (newLevel < static_cast<uint8_t>(level))
+                         ? threshold + HYSTERESISMV
+                         : threshold;
+    if (mv >= limit) {
+      break;
+    }
+    newLevel++;
+  }
+  return static_cast<Level>(newLevel);
+}
+
+uint8_t PerfGovernor::selectPolicies() {
+  // settings of the running title
+  uint8_t title = sys->titleSkipStatic.load() ? SKIP_STATIC : 0;
+  uint8_t audioStep = sys->titleAudioStep.load();
+  title |= (audioStep >= 4) ? AUDIO_QUARTER : (audioStep >= 2) ? AUDIO_HALF : 0;
+#ifdef GOVERNOR_POLICIES
+  return GOVERNOR_POLICIES | title;
+#else
+  // the battery policies are added to those of the title, the lower audio
+  // rate wins (see apply)
+  uint8_t p = title;
+  switch (level) {
+  case Level::NORMAL:
+    break;
+  case Level::SAVE:
+    p |= SKIP_STATIC | SLEEP_WAIT;
+    break;
+  case Level::LOW:
+    p |= SKIP_STATIC | SLEEP_WAIT | AUDIO_HALF;
+    break;
+  case Level::CRITICAL:
+    p |= SKIP_STATIC | SLEEP_WAIT | AUDIO_QUARTER;
+    break;
+  }
+  if (sys->pacer.loadPercent.load() >= HIGHLOAD) {
+    p &= ~SLEEP_WAIT;
+  }
+  return p;
+#endif
+}
+
+void PerfGovernor::apply(uint8_t newPolicies) {
+  bool sleepWait = newPolicies & SLEEP_WAIT;
+  sys->pacer.setPowerSave(sleepWait);
+  PlatformManager::getInstance().setPowerSave(sleepWait);
+  sys->pokey.setSampleStep((newPolicies & AUDIO_QUARTER) ? 4
+                           : (newPolicies & AUDIO_HALF)  ? 2
+                                                         : 1);
+  PlatformManager::getInstance().log(
+      LOG_INFO, TAG,
+      "policies %02x -> %02x (battery %umV, load %u%%): skipped refreshes/s "
+      "%u, refresh us/s %u, sleep %u%%, spin %u%%, samples/s %u",
+      policies.load(), newPolicies, (unsigned)batteryMV.load(),
+      (unsigned)sys->pacer.loadPercent.load(),
+      (unsigned)refreshSkippedPerSecond.load(),
+      (unsigned)refreshUSPerSecond.load(),
+      (unsigned)sys->pacer.sleepPercent.load(),
+      (unsigned)sys->pacer.spinPercent.load(),
+      (unsigned)audioSamplesPerSecond.load());
+  policies.store(newPolicies);
+}
+
+void PerfGovernor::update() {
+  if (!sys) {
+    return;
+  }
+  if (secondsToVoltage == 0) {
+    secondsToVoltage = VOLTAGEINTERVAL;
+    batteryMV.store(board ? board->getBatteryVoltage() : 0);
+    level = selectLevel(batteryMV.load());
+  }
+  secondsToVoltage--;
+
+  refreshSkippedPerSecond.store(skippedRefreshes.exchange(0));
+  refreshUSPerSecond.store(refreshUS.exchange(0));
+  uint32_t samples = sys->pokey.synthesizedSamples.load();
+  audioSamplesPerSecond.store(samples - lastSamples);
+  lastSamples = samples;
+
+  uint8_t newPolicies = selectPolicies();
+  if (newPolicies != policies.load()) {
+    apply(newPolicies);
+  }
+}
+
+bool PerfGovernor::shouldRefresh(const uint16_t *bitmap, size_t pixels,
+                                 uint8_t border) {
+  int64_t now = PlatformManager::getInstance().getTimeUS();
+  if (framesSkipped < sys->titleFrameSkip.load(std::memory_order_relaxed)) {
+    framesSkipped++;
+    skippedRefreshes.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  framesSkipped = 0;
+  if (!(policies.load(std::memory_order_relaxed) & SKIP_STATIC)) {
+    lastRefreshUS = now;
+    return true;
+  }
+  // FNV-1a over 32 bit words (a CRC over the bitmap would take longer than
+  // the refresh of small displays)
+  const uint32_t *words = reinterpret_cast<const uint32_t *>(bitmap);
+  uint32_t hash = 2166136261u ^ border;
+  for (size_t i = 0; i < pixels / 2; i++) {
+    hash = (hash ^ words[i]) * 16777619u;
+  }
+  if ((hash == lastHash) && (now - lastRefreshUS < MAXSKIPUS)) {
+    skippedRefreshes.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  lastHash = hash;
+  lastRefreshUS = now;
+  return true;
+}
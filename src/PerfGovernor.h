@@ -0,0 +1,116 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef PERFGOVERNOR_H
+#define PERFGOVERNOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+class Atari800Sys;
+class BoardDriver;
+
+/**
+ * @brief Trades emulation quality for battery life
+ *
+ * Once per second (update()) the governor selects a set of policies from
+ * the battery voltage (read every VOLTAGEINTERVAL seconds) and the load of
+ * the CPU task measured by the frame pacer:
+ * - SKIP_STATIC: the display is only refreshed if the bitmap or the border
+ *   changed (at least once per second)
+ * - SLEEP_WAIT: the frame pacer sleeps instead of spinning and the system
+ *   may enter light sleep between frames (not used above HIGHLOAD percent,
+ *   a late wakeup would delay the frame)
+ * - AUDIO_HALF / AUDIO_QUARTER: POKEY synthesizes every 2nd / 4th sample
+ *
+ * The effect of each policy is published as perf values: skipped refreshes
+ * and refresh time per second, sleep and spin share of the frame time,
+ * synthesized samples per second. Policy changes are logged together with
+ * these values. Without battery (voltage 0) or above SAVEMV no policy is
+ * active. GOVERNOR_POLICIES (Config.h) forces a fixed set of policies.
+ *
+ * The settings of the running title (frameSkip, audioRate, see
+ * ConfigProfile) are added to the selected policies; a frameSkip of n
+ * skips n refreshes after each one.
+ */
+class PerfGovernor {
+public:
+  static const uint8_t SKIP_STATIC = 0x01;
+  static const uint8_t SLEEP_WAIT = 0x02;
+  static const uint8_t AUDIO_HALF = 0x04;
+  static const uint8_t AUDIO_QUARTER = 0x08;
+
+private:
+  static const uint16_t SAVEMV = 3700;
+  static const uint16_t LOWMV = 3500;
+  static const uint16_t CRITICALMV = 3300;
+  static const uint16_t HYSTERESISMV = 50;
+  static const uint8_t HIGHLOAD = 90;
+  static const uint8_t VOLTAGEINTERVAL = 10;
+  static const uint32_t MAXSKIPUS = 1000000;
+
+  enum class Level : uint8_t { NORMAL, SAVE, LOW, CRITICAL };
+
+  Atari800Sys *sys;
+  BoardDriver *board;
+  Level level;
+  uint8_t secondsToVoltage;
+  uint32_t lastSamples;
+
+  // main loop
+  uint32_t lastHash;
+  int64_t lastRefreshUS;
+  uint8_t framesSkipped;
+  std::atomic<uint32_t> skippedRefreshes;
+  std::atomic<uint32_t> refreshUS;
+
+  Level selectLevel(uint16_t mv) const;
+  uint8_t selectPolicies();
+  void apply(uint8_t newPolicies);
+
+public:
+  // active policies and the values published by update()
+  std::atomic<uint8_t> policies;
+  std::atomic<uint16_t> batteryMV;
+  std::atomic<uint32_t> refreshSkippedPerSecond;
+  std::atomic<uint32_t> refreshUSPerSecond;
+  std::atomic<uint32_t> audioSamplesPerSecond;
+
+  PerfGovernor();
+
+  void init(Atari800Sys *sys, BoardDriver *board);
+
+  /**
+   * @brief Selects and applies the policies, called once per second.
+   */
+  void update();
+
+  /**
+   * @brief Returns false if the refresh of an unchanged frame can be
+   * skipped. Called by the main loop before each refresh.
+   */
+  bool shouldRefresh(const uint16_t *bitmap, size_t pixels, uint8_t border);
+
+  /**
+   * @brief Records the duration of a refresh.
+   */
+  void refreshDone(uint32_t us) {
+    refreshUS.fetch_add(us, std::memory_order_relaxed);
+  }
+};
+
+#endif // PERFGOVERNOR_H
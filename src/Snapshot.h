@@ -0,0 +1,90 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Increment whenever the layout written by the saveState methods changes
+constexpr uint8_t SNAPSHOT_VERSION = 4;
+
+/**
+ * @brief Appends the state of the emulated machine to a byte buffer
+ *
+ * Each component writes its members in a fixed order with put(), the
+ * matching loadState method reads them in the same order.
+ */
+class SnapshotWriter {
+private:
+  std::vector<uint8_t> &data;
+
+public:
+  explicit SnapshotWriter(std::vector<uint8_t> &data) : data(data) {}
+
+  void putBytes(const void *src, size_t len) {
+    const uint8_t *p = static_cast<const uint8_t *>(src);
+    data.insert(data.end(), p, p + len);
+  }
+
+  template <typename T> void put(const T &val) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "only plain values can be stored");
+    putBytes(&val, sizeof(T));
+  }
+};
+
+/**
+ * @brief Reads a state written by SnapshotWriter
+ *
+ * Reading beyond the end of the buffer fails and leaves the destination
+ * unchanged, isOk() then returns false.
+ */
+class SnapshotReader {
+private:
+  const uint8_t *data;
+  size_t len;
+  size_t pos;
+  bool ok;
+
+public:
+  SnapshotReader(const uint8_t *data, size_t len)
+      : data(data), len(len), pos(0), ok(true) {}
+
+  bool getBytes(void *dst, size_t n) {
+    if (!ok || (pos + n > len)) {
+      ok = false;
+      return false;
+    }
+    memcpy(dst, data + pos, n);
+    pos += n;
+    return true;
+  }
+
+  template <typename T> void get(T &val) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "only plain values can be loaded");
+    getBytes(&val, sizeof(T));
+  }
+
+  bool isOk() const { return ok; }
+  bool atEnd() const { return pos == len; }
+};
+
+#endif // SNAPSHOT_H
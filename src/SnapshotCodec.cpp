@@ -0,0 +1,171 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "SnapshotCodec.h"
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+static inline uint32_t load32(const uint8_t *p) {
+  uint32_t w;
+  memcpy(&w, p, 4);
+  return w;
+}
+
+// Number of equal bytes at a and b (at most max), compared word by word
+static inline uint32_t matchLength(const uint8_t *a, const uint8_t *b,
+                                   uint32_t max) {
+  uint32_t len = 0;
+  while (len + 4 <= max) {
+    uint32_t diff = load32(a + len) ^ load32(b + len);
+    if (diff) {
+      // little endian: the lowest set bit marks the first differing byte
+      return len + (__builtin_ctz(diff) >> 3);
+    }
+    len += 4;
+  }
+  while ((len < max) && (a[len] == b[len])) {
+    len++;
+  }
+  return len;
+}
+
+void SnapshotCodec::flushLiterals(const uint8_t *src, size_t start,
+                                  size_t end, std::vector<uint8_t> &dst) {
+  while (start < end) {
+    size_t n = std::min<size_t>(end - start, 64);
+    dst.push_back(n - 1);
+    dst.insert(dst.end(), src + start, src + start + n);
+    start += n;
+  }
+}
+
+void SnapshotCodec::compress(const uint8_t *src, size_t len,
+                             std::vector<uint8_t> &dst) {
+  // positions + 1, 0: empty
+  std::unique_ptr<uint32_t[]> table(new uint32_t[1 << HASHBITS]());
+  size_t i = 0;
+  size_t lit = 0;
+  while (i + MINMATCH <= len) {
+    uint32_t w = load32(src + i);
+
+    // zero runs (unused memory)
+    if (w == 0) {
+      size_t zlen = 4;
+      while ((i + zlen + 4 <= len) && (load32(src + i + zlen) == 0) &&
+             (zlen < 0xffff - 4)) {
+        zlen += 4;
+      }
+      while ((i + zlen < len) && (src[i + zlen] == 0) && (zlen < 0xffff)) {
+        zlen++;
+      }
+      flushLiterals(src, lit, i, dst);
+      if (zlen <= 65) {
+        dst.push_back(0x40 + zlen - MINZERORUN);
+      } else {
+        dst.push_back(0x7f);
+        dst.push_back(zlen & 0xff);
+        dst.push_back(zlen >> 8);
+      }
+      i += zlen;
+      lit = i;
+      continue;
+    }
+
+    uint32_t h = (w * 2654435761u) >> (32 - HASHBITS);
+    uint32_t cand = table[h];
+    table[h] = i + 1;
+    if ((cand != 0) && (i - (cand - 1) <= WINDOWSIZE) &&
+        (load32(src + cand - 1) == w)) {
+      size_t from = cand - 1;
+      uint32_t max = std::min<size_t>(MAXMATCH, len - i);
+      uint32_t mlen = MINMATCH + matchLength(src + from + MINMATCH,
+                                             src + i + MINMATCH,
+                                             max - MINMATCH);
+      uint32_t offset = i - from - 1;
+      flushLiterals(src, lit, i, dst);
+      if (mlen < 10) {
+        dst.push_back(0x80 | ((mlen - 3) << 4) | (offset >> 8));
+        dst.push_back(offset & 0xff);
+      } else {
+        dst.push_back(0x80 | (7 << 4) | (offset >> 8));
+        dst.push_back(offset & 0xff);
+        dst.push_back(mlen - 10);
+      }
+      i += mlen;
+      lit = i;
+      continue;
+    }
+    i++;
+  }
+  flushLiterals(src, lit, len, dst);
+}
+
+bool SnapshotCodec::decompress(const uint8_t *src, size_t len,
+                               std::vector<uint8_t> &dst, size_t rawSize) {
+  dst.resize(rawSize);
+  uint8_t *out = dst.data();
+  size_t o = 0;
+  size_t i = 0;
+  while (i < len) {
+    uint8_t c = src[i++];
+    if (c < 0x40) {
+      size_t n = c + 1;
+      if ((i + n > len) || (o + n > rawSize)) {
+        return false;
+      }
+      memcpy(out + o, src + i, n);
+      i += n;
+      o += n;
+    } else if (c < 0x80) {
+      size_t n;
+      if (c == 0x7f) {
+        if (i + 2 > len) {
+          return false;
+        }
+        n = src[i] | (src[i + 1] << 8);
+        i += 2;
+      } else {
+        n = c - 0x40 + MINZERORUN;
+      }
+      if (o + n > rawSize) {
+        return false;
+      }
+      memset(out + o, 0, n);
+      o += n;
+    } else {
+      if (i >= len) {
+        return false;
+      }
+      size_t offset = (((c & 0x0f) << 8) | src[i++]) + 1;
+      size_t n = ((c >> 4) & 0x07) + 3;
+      if (n == 10) {
+        if (i >= len) {
+          return false;
+        }
+        n += src[i++];
+      }
+      if ((offset > o) || (o + n > rawSize)) {
+        return false;
+      }
+      // byte by byte, source and destination may overlap
+      for (size_t k = 0; k < n; k++, o++) {
+        out[o] = out[o - offset];
+      }
+    }
+  }
+  return o == rawSize;
+}
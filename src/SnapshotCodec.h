@@ -0,0 +1,67 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef SNAPSHOTCODEC_H
+#define SNAPSHOTCODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Compressor for machine snapshots
+ *
+ * Atari RAM mostly consists of zero runs and repeated patterns (screen
+ * memory, tables, unused areas). The format combines three token types,
+ * each introduced by a control byte:
+ * - 0x00-0x3f: 1-64 literal bytes follow
+ * - 0x40-0x7e: run of 3-65 zero bytes, 0x7f: run of zeros, length in the
+ *   next two bytes (little endian)
+ * - 0x80-0xff: copy of earlier output, bits 4-6: length - 3 (7: length
+ *   10 + next byte), bits 0-3 and the next byte: offset - 1 (up to 4K)
+ *
+ * Matches are found through a hash table of 4-byte words (16K), candidates
+ * are compared a word at a time. Decompression needs no memory besides the
+ * output.
+ */
+class SnapshotCodec {
+private:
+  static const uint32_t WINDOWSIZE = 4096;
+  static const uint8_t HASHBITS = 12;
+  static const uint32_t MINMATCH = 4;
+  static const uint32_t MAXMATCH = 10 + 255;
+  static const uint32_t MINZERORUN = 3;
+
+  static void flushLiterals(const uint8_t *src, size_t start, size_t end,
+                            std::vector<uint8_t> &dst);
+
+public:
+  /**
+   * @brief Appends the compressed form of src to dst.
+   */
+  static void compress(const uint8_t *src, size_t len,
+                       std::vector<uint8_t> &dst);
+
+  /**
+   * @brief Decompresses src into dst, which receives exactly rawSize bytes.
+   *
+   * @return false if the data is corrupt.
+   */
+  static bool decompress(const uint8_t *src, size_t len,
+                         std::vector<uint8_t> &dst, size_t rawSize);
+};
+
+#endif // SNAPSHOTCODEC_H
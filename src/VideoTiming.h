@@ -0,0 +1,47 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef VIDEOTIMING_H
+#define VIDEOTIMING_H
+
+#include <cstdint>
+
+/*
+ * Timing of the video standards. The scanline loop (Atari800Sys::run),
+ * ANTIC::nextScanline and POKEY::fillBuffer are instantiated for each of
+ * them, the standard is selected once per frame (at reset or when the
+ * settings change), not per scanline.
+ *
+ * The frame rates are the nominal ones, the emulation is paced to them
+ * and the audio buffer of a frame holds AUDIO_SAMPLE_RATE / FRAMERATE
+ * samples. CPUCLOCK is the clock of the real machine (114 cycles per
+ * scanline in both standards), POKEY counts its channel periods in it.
+ */
+struct PALTiming {
+  static constexpr bool PAL = true;
+  static constexpr uint16_t SCANLINES = 312;
+  static constexpr uint8_t FRAMERATE = 50;
+  static constexpr uint32_t CPUCLOCK = 1773447;
+};
+
+struct NTSCTiming {
+  static constexpr bool PAL = false;
+  static constexpr uint16_t SCANLINES = 262;
+  static constexpr uint8_t FRAMERATE = 60;
+  static constexpr uint32_t CPUCLOCK = 1789773;
+};
+
+#endif // VIDEOTIMING_H
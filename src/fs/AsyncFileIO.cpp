@@ -0,0 +1,143 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "AsyncFileIO.h"
+#include "../platform/PlatformManager.h"
+#include <cstdio>
+
+AsyncFileIO::AsyncFileIO() : running(false) {}
+
+void AsyncFileIO::start() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running) {
+      return;
+    }
+    running = true;
+  }
+  PlatformManager::getInstance().startTask(
+      [this](void *) { this->ioTask(); }, 0, 2, "fileio");
+}
+
+void AsyncFileIO::execute(Request &req) {
+  req.result = 0;
+  req.ok = false;
+  switch (req.op) {
+  case Op::READ:
+    if ((req.offset < 0) || req.file->seek(req.offset, SEEK_SET)) {
+      req.result = req.file->read(req.buffer, req.count);
+      req.ok = (req.result == req.count);
+    }
+    break;
+  case Op::WRITE:
+    if ((req.offset < 0) || req.file->seek(req.offset, SEEK_SET)) {
+      req.result = req.file->write(req.buffer, req.count);
+      req.ok = (req.result == req.count);
+    }
+    break;
+  case Op::CALL:
+    req.ok = req.call();
+    break;
+  }
+  if (req.done) {
+    req.done(req);
+  }
+}
+
+AsyncFileIO::Ticket AsyncFileIO::submit(Ticket req) {
+  req->completed.store(false);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running) {
+      queue.push_back(req);
+      queued.notify_one();
+      return req;
+    }
+  }
+  execute(*req);
+  req->completed.store(true, std::memory_order_release);
+  return req;
+}
+
+AsyncFileIO::Ticket AsyncFileIO::read(FileDriver *file, int64_t offset,
+                                      void *buffer, size_t count,
+                                      Callback done) {
+  Ticket req = std::make_shared<Request>();
+  req->op = Op::READ;
+  req->file = file;
+  req->offset = offset;
+  req->buffer = buffer;
+  req->count = count;
+  req->done = done;
+  return submit(req);
+}
+
+AsyncFileIO::Ticket AsyncFileIO::write(FileDriver *file, int64_t offset,
+                                       const void *buffer, size_t count,
+                                       Callback done) {
+  Ticket req = std::make_shared<Request>();
+  req->op = Op::WRITE;
+  req->file = file;
+  req->offset = offset;
+  req->buffer = const_cast<void *>(buffer);
+  req->count = count;
+  req->done = done;
+  return submit(req);
+}
+
+AsyncFileIO::Ticket AsyncFileIO::call(std::function<bool()> fn,
+                                      Callback done) {
+  Ticket req = std::make_shared<Request>();
+  req->op = Op::CALL;
+  req->file = nullptr;
+  req->offset = -1;
+  req->buffer = nullptr;
+  req->count = 0;
+  req->call = fn;
+  req->done = done;
+  return submit(req);
+}
+
+void AsyncFileIO::wait(const Ticket &ticket) {
+  if (isDone(ticket)) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(mutex);
+  finished.wait(lock, [&ticket] { return isDone(ticket); });
+}
+
+size_t AsyncFileIO::pending() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return queue.size();
+}
+
+void AsyncFileIO::ioTask() {
+  while (true) {
+    Ticket req;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      queued.wait(lock, [this] { return !queue.empty(); });
+      req = queue.front();
+      queue.pop_front();
+    }
+    execute(*req);
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      req->completed.store(true, std::memory_order_release);
+    }
+    finished.notify_all();
+  }
+}
@@ -0,0 +1,114 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef ASYNCFILEIO_H
+#define ASYNCFILEIO_H
+
+#include "FileDriver.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+/**
+ * @brief Queue of file operations executed by a dedicated I/O task
+ *
+ * Requests are processed in order. The caller either polls the returned
+ * ticket (isDone), blocks on it (wait) or passes a completion callback,
+ * which is called on the I/O task. A FileDriver used with this service
+ * must not be accessed directly while requests on it are pending.
+ *
+ * Before start() has been called, requests are executed immediately by the
+ * calling task.
+ */
+class AsyncFileIO {
+public:
+  enum class Op : uint8_t { READ, WRITE, CALL };
+
+  struct Request {
+    Op op;
+    FileDriver *file;
+    int64_t offset; // -1: current file position
+    void *buffer;
+    size_t count;
+    std::function<bool()> call;
+    std::function<void(Request &)> done;
+    size_t result;
+    bool ok;
+    std::atomic<bool> completed;
+  };
+
+  typedef std::shared_ptr<Request> Ticket;
+  typedef std::function<void(Request &)> Callback;
+
+private:
+  std::mutex mutex;
+  std::condition_variable queued;
+  std::condition_variable finished;
+  std::deque<Ticket> queue;
+  bool running;
+
+  Ticket submit(Ticket req);
+  void execute(Request &req);
+  void ioTask();
+
+public:
+  AsyncFileIO();
+
+  /**
+   * @brief Starts the I/O task.
+   */
+  void start();
+
+  /**
+   * @brief Reads count bytes at offset into buffer, which must stay valid
+   * until the request has completed.
+   */
+  Ticket read(FileDriver *file, int64_t offset, void *buffer, size_t count,
+              Callback done = nullptr);
+
+  /**
+   * @brief Writes count bytes from buffer at offset, buffer must stay valid
+   * until the request has completed.
+   */
+  Ticket write(FileDriver *file, int64_t offset, const void *buffer,
+               size_t count, Callback done = nullptr);
+
+  /**
+   * @brief Executes fn (e.g. open, size, close) on the I/O task, the
+   * result of fn is stored in Request::ok.
+   */
+  Ticket call(std::function<bool()> fn, Callback done = nullptr);
+
+  static bool isDone(const Ticket &ticket) {
+    return ticket->completed.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Blocks until the request has completed.
+   */
+  void wait(const Ticket &ticket);
+
+  /**
+   * @brief Number of requests not yet started.
+   */
+  size_t pending();
+};
+
+#endif // ASYNCFILEIO_H
@@ -0,0 +1,465 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "CompressedFile.h"
+#include "../Crc32.h"
+#include "../platform/PlatformManager.h"
+#include "DirIndex.h"
+#include "FileFactory.h"
+#include <algorithm>
+#include <cstring>
+#include <strings.h>
+#ifdef ESP_PLATFORM
+#include <esp_heap_caps.h>
+#endif
+
+static const char *TAG = "CompressedFile";
+
+// gzip header flags
+static const uint8_t GZ_FHCRC = 0x02;
+static const uint8_t GZ_FEXTRA = 0x04;
+static const uint8_t GZ_FNAME = 0x08;
+static const uint8_t GZ_FCOMMENT = 0x10;
+
+// zip record sizes
+static const uint32_t ZIP_LOCALHEADER = 30;
+static const uint32_t ZIP_CENTRALHEADER = 46;
+static const uint32_t ZIP_EOCD = 22;
+static const uint32_t ZIP_MAXCOMMENT = 1024;
+
+static uint16_t le16(const uint8_t *p) { return p[0] | (p[1] << 8); }
+
+static uint32_t le32(const uint8_t *p) {
+  return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+static bool endsWith(const std::string &s, const char *suffix) {
+  size_t n = strlen(suffix);
+  return (s.size() >= n) && (strcasecmp(s.c_str() + s.size() - n, suffix) == 0);
+}
+
+static std::string baseName(const std::string &path) {
+  size_t slash = path.find_last_of('/');
+  return (slash == std::string::npos) ? path : path.substr(slash + 1);
+}
+
+CompressedFile::CompressedFile()
+    : inner(FileSys::create()), opened(false), deflated(false),
+      dataOffset(0), usize(0), expectedCrc(0), pos(0), streamPos(0),
+      streamCrc(0), crcValid(false), restartInterval(0), cache(nullptr),
+      numBlocks(0), useCounter(0) {}
+
+CompressedFile::~CompressedFile() { close(); }
+
+bool CompressedFile::isCompressed(const std::string &path) {
+  std::string archive = path.substr(0, path.find('#'));
+  return endsWith(path, ".gz") || endsWith(archive, ".zip");
+}
+
+bool CompressedFile::init() { return inner->init(); }
+
+size_t CompressedFile::memoryBudget() {
+#ifdef ESP_PLATFORM
+  // other files and the emulator need PSRAM too
+  return heap_caps_get_free_size(MALLOC_CAP_SPIRAM) / 4;
+#else
+  return SIZE_MAX;
+#endif
+}
+
+void CompressedFile::planRestarts(size_t budget) {
+  restartInterval = 0;
+  restarts.clear();
+  uint32_t cached = numBlocks * BLOCKSIZE;
+  if (!deflated || (usize <= cached) || (usize <= RESTARTINTERVAL) ||
+      (budget <= cached)) {
+    return;
+  }
+  size_t count = std::min<size_t>(MAXRESTARTS, (usize - 1) / RESTARTINTERVAL);
+  count = std::min(count, (budget - cached) / sizeof(RestartPoint));
+  if (count == 0) {
+    return;
+  }
+  // evenly spaced, on block boundaries
+  uint32_t interval = (usize + count) / (count + 1);
+  restartInterval = std::max(
+      RESTARTINTERVAL, (interval + BLOCKSIZE - 1) / BLOCKSIZE * BLOCKSIZE);
+  restarts.resize((usize - 1) / restartInterval);
+}
+
+bool CompressedFile::openGzip(const std::string &path) {
+  uint8_t header[10];
+  if (!inner->seek(0, SEEK_SET) || (inner->read(header, 10) != 10) ||
+      (header[2] != 8)) {
+    return false;
+  }
+  uint32_t offset = 10;
+  uint8_t flags = header[3];
+  if (flags & GZ_FEXTRA) {
+    uint8_t xlen[2];
+    if (inner->read(xlen, 2) != 2) {
+      return false;
+    }
+    offset += 2 + le16(xlen);
+  }
+  entryName = baseName(path.substr(0, path.size() - 3));
+  for (uint8_t field : {GZ_FNAME, GZ_FCOMMENT}) {
+    if (!(flags & field)) {
+      continue;
+    }
+    std::string s;
+    uint8_t c;
+    if (!inner->seek(offset, SEEK_SET)) {
+      return false;
+    }
+    do {
+      if (inner->read(&c, 1) != 1) {
+        return false;
+      }
+      offset++;
+      if (c) {
+        s += static_cast<char>(c);
+      }
+    } while (c);
+    if ((field == GZ_FNAME) && !s.empty()) {
+      entryName = baseName(s);
+    }
+  }
+  if (flags & GZ_FHCRC) {
+    offset += 2;
+  }
+  // trailer: CRC-32 and size of the uncompressed data
+  uint8_t trailer[8];
+  int64_t size = inner->size();
+  if ((size < offset + 8) || !inner->seek(size - 8, SEEK_SET) ||
+      (inner->read(trailer, 8) != 8)) {
+    return false;
+  }
+  expectedCrc = le32(trailer);
+  usize = le32(trailer + 4);
+  dataOffset = offset;
+  deflated = true;
+  return true;
+}
+
+bool CompressedFile::openZip(const std::string &select) {
+  // locate the end of central directory record
+  int64_t size = inner->size();
+  uint32_t tailLen = std::min<int64_t>(size, ZIP_EOCD + ZIP_MAXCOMMENT);
+  std::unique_ptr<uint8_t[]> tail(new uint8_t[tailLen]);
+  if (!inner->seek(size - tailLen, SEEK_SET) ||
+      (inner->read(tail.get(), tailLen) != tailLen)) {
+    return false;
+  }
+  const uint8_t *eocd = nullptr;
+  for (int32_t i = tailLen - ZIP_EOCD; i >= 0; i--) {
+    if (memcmp(tail.get() + i, "PK\5\6", 4) == 0) {
+      eocd = tail.get() + i;
+      break;
+    }
+  }
+  if (eocd == nullptr) {
+    return false;
+  }
+  uint16_t numEntries = le16(eocd + 10);
+  uint32_t cdOffset = le32(eocd + 16);
+
+  // choose an entry from the central directory
+  bool found = false;
+  uint32_t localOffset = 0;
+  uint32_t offset = cdOffset;
+  for (uint16_t i = 0; i < numEntries; i++) {
+    uint8_t hdr[ZIP_CENTRALHEADER];
+    if (!inner->seek(offset, SEEK_SET) ||
+        (inner->read(hdr, ZIP_CENTRALHEADER) != ZIP_CENTRALHEADER) ||
+        (memcmp(hdr, "PK\1\2", 4) != 0)) {
+      return false;
+    }
+    uint16_t nameLen = le16(hdr + 28);
+    std::string name(nameLen, '\0');
+    if (inner->read(&name[0], nameLen) != nameLen) {
+      return false;
+    }
+    offset += ZIP_CENTRALHEADER + nameLen + le16(hdr + 30) + le16(hdr + 32);
+    if (name.empty() || (name.back() == '/')) {
+      continue;
+    }
+    bool match;
+    if (!select.empty()) {
+      match = (strcasecmp(name.c_str(), select.c_str()) == 0) ||
+              (strcasecmp(baseName(name).c_str(), select.c_str()) == 0);
+    } else {
+      match = DirIndex::typeFromName(name) != FileType::OTHER;
+    }
+    if (match || (!found && select.empty())) {
+      uint16_t method = le16(hdr + 10);
+      if ((method != 0) && (method != 8)) {
+        PlatformManager::getInstance().log(
+            LOG_WARN, TAG, "%s: unsupported method %d", name.c_str(),
+            (int)method);
+        continue;
+      }
+      found = true;
+      deflated = (method == 8);
+      expectedCrc = le32(hdr + 16);
+      usize = le32(hdr + 24);
+      localOffset = le32(hdr + 42);
+      entryName = baseName(name);
+      if (match) {
+        break;
+      }
+    }
+  }
+  if (!found) {
+    return false;
+  }
+
+  // data follows the local header, its extra field may differ
+  uint8_t local[ZIP_LOCALHEADER];
+  if (!inner->seek(localOffset, SEEK_SET) ||
+      (inner->read(local, ZIP_LOCALHEADER) != ZIP_LOCALHEADER) ||
+      (memcmp(local, "PK\3\4", 4) != 0)) {
+    return false;
+  }
+  dataOffset =
+      localOffset + ZIP_LOCALHEADER + le16(local + 26) + le16(local + 28);
+  return true;
+}
+
+bool CompressedFile::open(const std::string &path, const char *mode) {
+  close();
+  if ((mode[0] != 'r') || strchr(mode, '+')) {
+    return false;
+  }
+  std::string archive = path;
+  std::string select;
+  size_t hash = path.find('#');
+  if ((hash != std::string::npos) && endsWith(path.substr(0, hash), ".zip")) {
+    archive = path.substr(0, hash);
+    select = path.substr(hash + 1);
+  }
+  if (!inner->open(archive, "rb")) {
+    return false;
+  }
+  uint8_t magic[4];
+  bool ok = false;
+  if (inner->read(magic, 4) == 4) {
+    if ((magic[0] == 0x1f) && (magic[1] == 0x8b)) {
+      ok = openGzip(archive);
+    } else if (memcmp(magic, "PK\3\4", 4) == 0) {
+      ok = openZip(select);
+    }
+  }
+  if (!ok) {
+    PlatformManager::getInstance().log(LOG_ERROR, TAG, "cannot read %s",
+                                       path.c_str());
+    inner->close();
+    return false;
+  }
+
+  FileType type = DirIndex::typeFromName(entryName);
+  size_t budget = memoryBudget();
+  if ((type == FileType::ATR) || (type == FileType::CAR) ||
+      (type == FileType::ROM)) {
+    numBlocks = std::min<size_t>(
+        {MAXBLOCKS, (usize + BLOCKSIZE - 1) / BLOCKSIZE, budget / BLOCKSIZE});
+    numBlocks = std::max(numBlocks, STREAMBLOCKS);
+    planRestarts(budget);
+  } else {
+    numBlocks = STREAMBLOCKS;
+  }
+  cache = new uint8_t[numBlocks * BLOCKSIZE];
+  for (uint8_t i = 0; i < numBlocks; i++) {
+    blockIdx[i] = -1;
+    blockLastUse[i] = 0;
+  }
+  useCounter = 0;
+  pos = 0;
+  opened = restart();
+  PlatformManager::getInstance().log(
+      LOG_INFO, TAG, "%s: %s (%u bytes, cache %uK, %u restart points)",
+      path.c_str(), entryName.c_str(), (unsigned)usize,
+      (unsigned)(numBlocks * BLOCKSIZE / 1024), (unsigned)restarts.size());
+  return opened;
+}
+
+bool CompressedFile::restart() {
+  streamPos = 0;
+  streamCrc = 0;
+  crcValid = true;
+  if (!inner->seek(dataOffset, SEEK_SET)) {
+    return false;
+  }
+  if (deflated) {
+    inflate.reset(inner.get());
+  }
+  return true;
+}
+
+bool CompressedFile::position(uint32_t target) {
+  if (!deflated) {
+    // stored data is read in place
+    if (target == 0) {
+      return (streamPos == 0) || restart();
+    }
+    if (streamPos != target) {
+      if (!inner->seek(dataOffset + target, SEEK_SET)) {
+        return false;
+      }
+      streamPos = target;
+      crcValid = false;
+    }
+    return true;
+  }
+  // nearest restart point passed before target
+  size_t k = restartInterval ? std::min<size_t>(target / restartInterval,
+                                                restarts.size())
+                             : 0;
+  while ((k > 0) && !restarts[k - 1]) {
+    k--;
+  }
+  uint32_t from = k * restartInterval;
+  if ((streamPos <= target) && (streamPos >= from)) {
+    return true;
+  }
+  if (k == 0) {
+    return restart();
+  }
+  const RestartPoint &rp = *restarts[k - 1];
+  streamPos = from;
+  streamCrc = rp.crc;
+  crcValid = true;
+  return inflate.restore(inner.get(), rp.inflate);
+}
+
+int CompressedFile::findBlock(uint32_t blk) const {
+  for (uint8_t i = 0; i < numBlocks; i++) {
+    if (blockIdx[i] == static_cast<int32_t>(blk)) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+const uint8_t *CompressedFile::getBlock(uint32_t blk) {
+  int cached = findBlock(blk);
+  if (cached >= 0) {
+    blockLastUse[cached] = ++useCounter;
+    return cache + cached * BLOCKSIZE;
+  }
+  if (!position(blk * BLOCKSIZE)) {
+    return nullptr;
+  }
+  // decompress up to the requested block, keeping the blocks passed
+  while (true) {
+    if (restartInterval && (streamPos % restartInterval == 0) &&
+        (streamPos > 0) && (streamPos / restartInterval <= restarts.size())) {
+      std::unique_ptr<RestartPoint> &rp =
+          restarts[streamPos / restartInterval - 1];
+      if (!rp && crcValid) {
+        rp.reset(new RestartPoint);
+        rp->crc = streamCrc;
+        inflate.save(rp->inflate);
+      }
+    }
+    // a block passed again after a restart is decompressed into its slot
+    int victim = findBlock(streamPos / BLOCKSIZE);
+    if (victim < 0) {
+      victim = 0;
+      for (uint8_t i = 1; i < numBlocks; i++) {
+        if (blockLastUse[i] < blockLastUse[victim]) {
+          victim = i;
+        }
+      }
+    }
+    uint8_t *slot = cache + victim * BLOCKSIZE;
+    uint32_t len = std::min(BLOCKSIZE, usize - streamPos);
+    size_t n = deflated ? inflate.read(slot, len) : inner->read(slot, len);
+    if (n != len) {
+      PlatformManager::getInstance().log(LOG_ERROR, TAG,
+                                         "corrupt data at %u",
+                                         (unsigned)streamPos);
+      blockIdx[victim] = -1;
+      blockLastUse[victim] = 0;
+      return nullptr;
+    }
+    streamCrc = Crc32::update(streamCrc, slot, len);
+    uint32_t cur = streamPos / BLOCKSIZE;
+    streamPos += len;
+    if ((streamPos == usize) && crcValid && (streamCrc != expectedCrc)) {
+      PlatformManager::getInstance().log(LOG_WARN, TAG, "%s: CRC mismatch",
+                                         entryName.c_str());
+    }
+    blockIdx[victim] = cur;
+    blockLastUse[victim] = ++useCounter;
+    if (cur == blk) {
+      return slot;
+    }
+  }
+}
+
+size_t CompressedFile::read(void *buffer, size_t count) {
+  if (!opened) {
+    return 0;
+  }
+  uint8_t *out = static_cast<uint8_t *>(buffer);
+  size_t done = 0;
+  while ((done < count) && (pos < usize)) {
+    uint32_t blk = pos / BLOCKSIZE;
+    const uint8_t *data = getBlock(blk);
+    if (data == nullptr) {
+      break;
+    }
+    uint32_t off = pos % BLOCKSIZE;
+    uint32_t avail = std::min(BLOCKSIZE, usize - blk * BLOCKSIZE) - off;
+    uint32_t len = std::min<size_t>(count - done, avail);
+    memcpy(out + done, data + off, len);
+    pos += len;
+    done += len;
+  }
+  return done;
+}
+
+bool CompressedFile::seek(long offset, int origin) {
+  int64_t newpos;
+  if (origin == SEEK_CUR) {
+    newpos = pos + offset;
+  } else if (origin == SEEK_END) {
+    newpos = usize + offset;
+  } else {
+    newpos = offset;
+  }
+  if (!opened || (newpos < 0) || (newpos > usize)) {
+    return false;
+  }
+  pos = newpos;
+  return true;
+}
+
+void CompressedFile::close() {
+  if (inner) {
+    inner->close();
+  }
+  delete[] cache;
+  cache = nullptr;
+  numBlocks = 0;
+  restarts.clear();
+  restartInterval = 0;
+  opened = false;
+  usize = 0;
+  pos = 0;
+  entryName.clear();
+}
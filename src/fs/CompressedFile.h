@@ -0,0 +1,126 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef COMPRESSEDFILE_H
+#define COMPRESSEDFILE_H
+
+#include "FileDriver.h"
+#include "Inflate.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Read-only FileDriver for gzip files and zip archives
+ *
+ * The compressed file is read through the platform FileDriver and
+ * decompressed while reading, nothing is unpacked onto the card. For zip
+ * archives the entry may be selected by appending "#name" to the path,
+ * otherwise the first Atari image (or the first file) in the archive is
+ * used.
+ *
+ * Decompressed data is kept in a cache of BLOCKSIZE blocks. Disk images and
+ * cartridges get a large cache for random access, other files (XEX, CAS)
+ * are streamed through a small one. The cache and the restart points of a
+ * file use at most a quarter of the free PSRAM.
+ *
+ * If a deflated image does not fit into the cache, the decoder state is
+ * saved at up to MAXRESTARTS evenly spaced restart points (at least
+ * RESTARTINTERVAL apart) while it is decompressed the first time. A block
+ * no longer in the cache is then decompressed from the nearest restart
+ * point before it, otherwise from the beginning of the stream. Stored zip
+ * entries are read directly at the block position.
+ */
+class CompressedFile : public FileDriver {
+private:
+  static constexpr uint32_t BLOCKSIZE = 4096;
+  static constexpr uint8_t MAXBLOCKS = 48;
+  static constexpr uint8_t STREAMBLOCKS = 2;
+  static constexpr uint32_t RESTARTINTERVAL = 64 * 1024;
+  static constexpr uint8_t MAXRESTARTS = 16;
+
+  struct RestartPoint {
+    uint32_t crc; // CRC-32 of the data before the point
+    Inflate::Checkpoint inflate;
+  };
+
+  std::unique_ptr<FileDriver> inner;
+  Inflate inflate;
+  std::string entryName;
+  bool opened;
+  bool deflated;
+  uint32_t dataOffset;
+  uint32_t usize;
+  uint32_t expectedCrc;
+  uint32_t pos;
+
+  // decompression state
+  uint32_t streamPos;
+  uint32_t streamCrc;
+  bool crcValid; // streamCrc covers all data before streamPos
+
+  // restart point k (0-based) at (k + 1) * restartInterval, nullptr until
+  // decompression passed it
+  uint32_t restartInterval;
+  std::vector<std::unique_ptr<RestartPoint>> restarts;
+
+  // block cache
+  uint8_t *cache;
+  uint8_t numBlocks;
+  int32_t blockIdx[MAXBLOCKS];
+  uint32_t blockLastUse[MAXBLOCKS];
+  uint32_t useCounter;
+
+  bool openGzip(const std::string &path);
+  bool openZip(const std::string &select);
+  static size_t memoryBudget();
+  void planRestarts(size_t budget);
+  bool restart();
+  bool position(uint32_t target);
+  int findBlock(uint32_t blk) const;
+  const uint8_t *getBlock(uint32_t blk);
+
+public:
+  CompressedFile();
+  ~CompressedFile() override;
+
+  /**
+   * @brief true if path names a gzip file or zip archive (by extension, not
+   * case sensitive).
+   */
+  static bool isCompressed(const std::string &path);
+
+  /**
+   * @brief Name of the decompressed file (zip entry, gzip original name or
+   * file name without ".gz").
+   */
+  const std::string &getEntryName() const { return entryName; }
+
+  bool init() override;
+  bool open(const std::string &path, const char *mode) override;
+  size_t read(void *buffer, size_t count) override;
+  size_t write(const void * /*buffer*/, size_t /*count*/) override {
+    return 0;
+  }
+  bool seek(long offset, int origin) override;
+  long tell() const override { return pos; }
+  bool eof() override { return pos >= usize; }
+  int64_t size() override { return usize; }
+  void close() override;
+};
+
+#endif // COMPRESSEDFILE_H
@@ -0,0 +1,353 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "DirIndex.h"
+#include "../Config.h"
+#include "../Crc32.h"
+#include "../platform/PlatformManager.h"
+#include "CompressedFile.h"
+#include "FileFactory.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <strings.h>
+#include <unordered_map>
+
+static const char *TAG = "DirIndex";
+
+static const char INDEXMAGIC[4] = {'A', 'D', 'X', '1'};
+
+static std::string toLower(const std::string &s) {
+  std::string l(s);
+  for (char &c : l) {
+    c = tolower(static_cast<unsigned char>(c));
+  }
+  return l;
+}
+
+DirIndex::DirIndex()
+    : stamp(0), sortKey(SortKey::NAME), ready(false), rescanRequested(false),
+      listPos(0) {}
+
+FileType DirIndex::typeFromName(const std::string &name) {
+  size_t dot = name.find_last_of('.');
+  if (dot == std::string::npos) {
+    return FileType::OTHER;
+  }
+  std::string ext = toLower(name.substr(dot + 1));
+  if (ext == "gz") {
+    // type of the compressed file, e.g. GAME.ATR.GZ
+    return typeFromName(name.substr(0, dot));
+  }
+  if (ext == "atr") {
+    return FileType::ATR;
+  }
+  if ((ext == "xex") || (ext == "com") || (ext == "exe")) {
+    return FileType::XEX;
+  }
+  if (ext == "cas") {
+    return FileType::CAS;
+  }
+  if (ext == "car") {
+    return FileType::CAR;
+  }
+  if ((ext == "rom") || (ext == "bin")) {
+    return FileType::ROM;
+  }
+  return FileType::OTHER;
+}
+
+bool DirIndex::readIndexFile(std::vector<Entry> &idx, int64_t &idxstamp) {
+  if (!file->open(std::string(Config::PATH) + INDEXFILE, "rb")) {
+    return false;
+  }
+  char magic[4];
+  uint32_t count;
+  if ((file->read(magic, 4) != 4) || (memcmp(magic, INDEXMAGIC, 4) != 0) ||
+      (file->read(&idxstamp, 8) != 8) || (file->read(&count, 4) != 4)) {
+    file->close();
+    return false;
+  }
+  idx.clear();
+  idx.reserve(count);
+  for (uint32_t i = 0; i < count; i++) {
+    Entry e;
+    uint8_t type;
+    uint8_t namelen;
+    char name[256];
+    if ((file->read(&e.size, 4) != 4) || (file->read(&e.mtime, 8) != 8) ||
+        (file->read(&e.crc32, 4) != 4) || (file->read(&type, 1) != 1) ||
+        (file->read(&namelen, 1) != 1) ||
+        (file->read(name, namelen) != namelen)) {
+      file->close();
+      return false;
+    }
+    e.type = static_cast<FileType>(type);
+    e.name.assign(name, namelen);
+    idx.push_back(e);
+  }
+  file->close();
+  return true;
+}
+
+void DirIndex::writeIndexFile(const std::vector<Entry> &idx,
+                              int64_t idxstamp) {
+  if (!file->open(std::string(Config::PATH) + INDEXFILE, "wb")) {
+    PlatformManager::getInstance().log(LOG_WARN, TAG,
+                                       "cannot write index file");
+    return;
+  }
+  uint32_t count = idx.size();
+  file->write(INDEXMAGIC, 4);
+  file->write(&idxstamp, 8);
+  file->write(&count, 4);
+  for (const Entry &e : idx) {
+    uint8_t type = static_cast<uint8_t>(e.type);
+    uint8_t namelen = e.name.size();
+    file->write(&e.size, 4);
+    file->write(&e.mtime, 8);
+    file->write(&e.crc32, 4);
+    file->write(&type, 1);
+    file->write(&namelen, 1);
+    file->write(e.name.data(), namelen);
+  }
+  file->close();
+}
+
+bool DirIndex::readDirectory(std::vector<DirEntryInfo> &list,
+                             int64_t &dirstamp) {
+  list.clear();
+  DirEntryInfo info;
+  bool start = true;
+  uint32_t signature = 0;
+  while (true) {
+    if (!dir->readnextentry(info, start)) {
+      return false;
+    }
+    start = false;
+    if (info.name.empty()) {
+      break;
+    }
+    // hidden files (index, configuration) and overlong names are ignored
+    if ((info.name[0] == '.') || (info.name.size() > 255)) {
+      continue;
+    }
+    signature = Crc32::update(signature, info.name.data(), info.name.size());
+    signature = Crc32::update(signature, &info.size, sizeof(info.size));
+    signature = Crc32::update(signature, &info.mtime, sizeof(info.mtime));
+    list.push_back(info);
+  }
+  dirstamp = signature;
+  return true;
+}
+
+FileType DirIndex::typeFromArchive(const std::string &name) {
+  CompressedFile archive;
+  if (!archive.open(std::string(Config::PATH) + name, "rb")) {
+    return FileType::OTHER;
+  }
+  FileType type = typeFromName(archive.getEntryName());
+  archive.close();
+  return type;
+}
+
+uint32_t DirIndex::hashFile(const std::string &name) {
+  if (!file->open(std::string(Config::PATH) + name, "rb")) {
+    return 0;
+  }
+  uint8_t buf[512];
+  uint32_t crc = 0;
+  size_t n;
+  while ((n = file->read(buf, sizeof(buf))) > 0) {
+    crc = Crc32::update(crc, buf, n);
+  }
+  file->close();
+  return crc;
+}
+
+void DirIndex::update() {
+  bool forced = rescanRequested.exchange(false);
+  int64_t mtime = dir->dirmtime();
+  if (!forced && ready.load() && (mtime != 0) && (mtime == stamp)) {
+    return;
+  }
+  std::vector<DirEntryInfo> list;
+  int64_t dirstamp;
+  if (!readDirectory(list, dirstamp)) {
+    return;
+  }
+  if (mtime != 0) {
+    dirstamp = mtime;
+  }
+  if (ready.load() && (dirstamp == stamp) && !forced) {
+    return;
+  }
+
+  std::unordered_map<std::string, Entry> old;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const Entry &e : entries) {
+      old[e.name] = e;
+    }
+  }
+  std::vector<Entry> idx;
+  idx.reserve(list.size());
+  uint32_t hashed = 0;
+  for (const DirEntryInfo &info : list) {
+    Entry e;
+    e.name = info.name;
+    e.size = info.size;
+    e.mtime = info.mtime;
+    e.type = info.isDir ? FileType::DIR : typeFromName(info.name);
+    auto it = old.find(info.name);
+    if ((it != old.end()) && (it->second.size == info.size) &&
+        (it->second.mtime == info.mtime)) {
+      e.crc32 = it->second.crc32;
+      e.type = it->second.type;
+    } else {
+      e.crc32 = info.isDir ? 0 : hashFile(info.name);
+      if ((e.type == FileType::OTHER) &&
+          CompressedFile::isCompressed(info.name)) {
+        e.type = typeFromArchive(info.name);
+      }
+      hashed++;
+    }
+    idx.push_back(e);
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.swap(idx);
+    stamp = dirstamp;
+    sortEntries();
+    idx = entries;
+  }
+  ready.store(true);
+  writeIndexFile(idx, dirstamp);
+  if (mtime != 0) {
+    // creating the index file modifies the directory
+    std::lock_guard<std::mutex> lock(mutex);
+    stamp = dir->dirmtime();
+  }
+  PlatformManager::getInstance().log(LOG_INFO, TAG,
+                                     "%d entries, %d files hashed",
+                                     (int)idx.size(), (int)hashed);
+}
+
+void DirIndex::sortEntries() {
+  auto cmpname = [](const Entry &a, const Entry &b) {
+    return strcasecmp(a.name.c_str(), b.name.c_str()) < 0;
+  };
+  switch (sortKey) {
+  case SortKey::SIZE:
+    std::stable_sort(entries.begin(), entries.end(), cmpname);
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const Entry &a, const Entry &b) {
+                       return a.size < b.size;
+                     });
+    break;
+  case SortKey::TYPE:
+    std::stable_sort(entries.begin(), entries.end(), cmpname);
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const Entry &a, const Entry &b) {
+                       return a.type < b.type;
+                     });
+    break;
+  default:
+    std::sort(entries.begin(), entries.end(), cmpname);
+    break;
+  }
+}
+
+void DirIndex::scanTask() {
+  while (true) {
+    update();
+    for (uint32_t t = 0; (t < RESCANINTERVALMS) && !rescanRequested.load();
+         t += 100) {
+      PlatformManager::getInstance().waitMS(100);
+    }
+  }
+}
+
+void DirIndex::start() {
+  file = FileSys::create();
+  dir = FileSys::create();
+  if (!file->init()) {
+    PlatformManager::getInstance().log(LOG_INFO, TAG, "no filesystem");
+    return;
+  }
+  std::vector<Entry> idx;
+  int64_t idxstamp;
+  if (readIndexFile(idx, idxstamp)) {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.swap(idx);
+    stamp = idxstamp;
+    sortEntries();
+    ready.store(true);
+  }
+  PlatformManager::getInstance().startTask(
+      [this](void *) { this->scanTask(); }, 0, 1, "dirindex");
+}
+
+size_t DirIndex::size() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return entries.size();
+}
+
+void DirIndex::sort(SortKey key) {
+  std::lock_guard<std::mutex> lock(mutex);
+  sortKey = key;
+  sortEntries();
+}
+
+bool DirIndex::listnextentry(std::string &name, bool start) {
+  std::lock_guard<std::mutex> lock(mutex);
+  name = "";
+  if (start) {
+    listPos = 0;
+  }
+  if (listPos < entries.size()) {
+    name = entries[listPos++].name;
+  }
+  return true;
+}
+
+std::vector<DirIndex::Entry> DirIndex::find(const std::string &pattern,
+                                            FileType type) {
+  std::string lpattern = toLower(pattern);
+  std::vector<Entry> result;
+  std::lock_guard<std::mutex> lock(mutex);
+  for (const Entry &e : entries) {
+    if ((type != FileType::OTHER) && (e.type != type)) {
+      continue;
+    }
+    if (lpattern.empty() ||
+        (toLower(e.name).find(lpattern) != std::string::npos)) {
+      result.push_back(e);
+    }
+  }
+  return result;
+}
+
+bool DirIndex::lookup(const std::string &name, Entry &entry) {
+  std::lock_guard<std::mutex> lock(mutex);
+  for (const Entry &e : entries) {
+    if (strcasecmp(e.name.c_str(), name.c_str()) == 0) {
+      entry = e;
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,128 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef DIRINDEX_H
+#define DIRINDEX_H
+
+#include "FileDriver.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum class FileType : uint8_t { OTHER, ATR, XEX, CAS, CAR, ROM, DIR };
+
+enum class SortKey : uint8_t { NAME, SIZE, TYPE };
+
+/**
+ * @brief Index of the directory Config::PATH
+ *
+ * The index (names, sizes, types and CRC-32 of the content) is kept in
+ * memory and in the file INDEXFILE on the card. A background task checks
+ * the directory periodically: the directory modification time is used if
+ * the filesystem supports it, otherwise a signature over names, sizes and
+ * modification times. On a change the index is updated incrementally, only
+ * new or modified files are read to compute their hash.
+ *
+ * All public methods may be called from any task.
+ */
+class DirIndex {
+public:
+  struct Entry {
+    std::string name;
+    uint32_t size;
+    int64_t mtime;
+    uint32_t crc32;
+    FileType type;
+  };
+
+  static constexpr const char *INDEXFILE = ".dirindex";
+
+private:
+  static const uint32_t RESCANINTERVALMS = 10000;
+
+  std::unique_ptr<FileDriver> dir;
+  std::unique_ptr<FileDriver> file;
+  std::mutex mutex;
+  std::vector<Entry> entries;
+  int64_t stamp;
+  SortKey sortKey;
+  std::atomic<bool> ready;
+  std::atomic<bool> rescanRequested;
+
+  // listnextentry state
+  size_t listPos;
+
+  bool readIndexFile(std::vector<Entry> &idx, int64_t &idxstamp);
+  void writeIndexFile(const std::vector<Entry> &idx, int64_t idxstamp);
+  bool readDirectory(std::vector<DirEntryInfo> &list, int64_t &dirstamp);
+  uint32_t hashFile(const std::string &name);
+  FileType typeFromArchive(const std::string &name);
+  void update();
+  void sortEntries();
+  void scanTask();
+
+public:
+  DirIndex();
+
+  /**
+   * @brief Loads the index from the card and starts the background task.
+   */
+  void start();
+
+  /**
+   * @brief true after the index has been loaded or built once.
+   */
+  bool isReady() const { return ready.load(); }
+
+  /**
+   * @brief Requests an immediate check of the directory.
+   */
+  void requestRescan() { rescanRequested.store(true); }
+
+  /**
+   * @brief Type by file extension, "name.ext.gz" is typed by ".ext".
+   */
+  static FileType typeFromName(const std::string &name);
+
+  size_t size();
+  void sort(SortKey key);
+
+  /**
+   * @brief Iterates over the index in the current sort order, same
+   * semantics as FileDriver::listnextentry.
+   */
+  bool listnextentry(std::string &name, bool start);
+
+  /**
+   * @brief Returns all entries containing pattern (case insensitive) in
+   * their name. If type is not FileType::OTHER, only entries of this type
+   * are returned.
+   */
+  std::vector<Entry> find(const std::string &pattern,
+                          FileType type = FileType::OTHER);
+
+  /**
+   * @brief Looks up an entry by name.
+   *
+   * @return true if the entry exists.
+   */
+  bool lookup(const std::string &name, Entry &entry);
+};
+
+#endif // DIRINDEX_H
@@ -41,8 +41,40 @@
  * that file handles are correctly initialized, reused, and released as needed.
  */
 
+#include <cstdio>
 #include <string>
 
+/**
+ * @brief Contiguous range of memory, target of FileDriver::readInto and
+ * FileDriver::readv.
+ */
+struct ByteSpan {
+  uint8_t *data;
+  size_t size;
+};
+
+/**
+ * @brief Part of a file made accessible in memory, see
+ * FileDriver::mapRegion.
+ */
+struct MappedRegion {
+  const uint8_t *data = nullptr;
+  size_t size = 0;
+  void *base = nullptr; // start of the mapping or of the heap buffer
+  size_t baseSize = 0;
+  bool mapped = false;  // true: memory mapped, false: heap buffer
+};
+
+/**
+ * @brief Information about a directory entry, see FileDriver::readnextentry.
+ */
+struct DirEntryInfo {
+  std::string name;
+  uint32_t size;
+  int64_t mtime; // modification time (seconds), 0 if unknown
+  bool isDir;
+};
+
 class FileDriver {
 public:
   /**
@@ -97,6 +129,70 @@ public:
    */
   virtual size_t write(const void *buffer, size_t count) = 0;
 
+  /**
+   * @brief Reads into the memory described by dest.
+   *
+   * @return The number of bytes actually read.
+   */
+  virtual size_t readInto(ByteSpan dest) { return read(dest.data, dest.size); }
+
+  /**
+   * @brief Reads consecutive file data into several memory ranges.
+   *
+   * Fills the spans in order, e.g. to move data directly into
+   * non-contiguous emulated memory.
+   *
+   * @param spans Destination ranges.
+   * @param count Number of spans.
+   * @return The total number of bytes read, less than the sum of the span
+   * sizes only at the end of the file or on an error.
+   */
+  virtual size_t readv(const ByteSpan *spans, size_t count) {
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+      size_t n = read(spans[i].data, spans[i].size);
+      total += n;
+      if (n < spans[i].size) {
+        break;
+      }
+    }
+    return total;
+  }
+
+  /**
+   * @brief Makes len bytes at offset of the opened file accessible in
+   * memory.
+   *
+   * Implementations map the file if the platform supports it. The default
+   * implementation reads the region into a heap buffer. The region is valid
+   * until unmapRegion() is called, also after the file has been closed.
+   *
+   * @return true if successful.
+   */
+  virtual bool mapRegion(int64_t offset, size_t len, MappedRegion &region) {
+    uint8_t *buf = new uint8_t[len];
+    if (!seek(offset, SEEK_SET) || (read(buf, len) != len)) {
+      delete[] buf;
+      return false;
+    }
+    region.data = buf;
+    region.size = len;
+    region.base = buf;
+    region.baseSize = len;
+    region.mapped = false;
+    return true;
+  }
+
+  /**
+   * @brief Releases a region returned by mapRegion().
+   */
+  virtual void unmapRegion(MappedRegion &region) {
+    if (!region.mapped) {
+      delete[] static_cast<uint8_t *>(region.base);
+    }
+    region = MappedRegion();
+  }
+
   /**
    * @brief Moves the file position indicator to a new location.
    *
@@ -157,6 +253,38 @@ public:
    */
   virtual bool listnextentry(std::string &name, bool start) { return false; }
 
+  /**
+   * @brief Retrieves the next directory entry including size and
+   * modification time.
+   *
+   * Same iteration semantics as listnextentry(), but each FileDriver
+   * instance keeps its own iteration state, so the directory may be read
+   * concurrently by different instances.
+   *
+   * @param entry Receives the next entry, entry.name is empty if no more
+   * entries are left.
+   * @param start If true, (re)starts from the first entry.
+   * @return true if successful, false if an error occurred.
+   */
+  virtual bool readnextentry(DirEntryInfo &entry, bool start) { return false; }
+
+  /**
+   * @brief Returns the modification time of the directory Config::PATH.
+   *
+   * @return Modification time in seconds, 0 if not supported by the
+   * filesystem.
+   */
+  virtual int64_t dirmtime() { return 0; }
+
+  /**
+   * @brief Deletes a file (not the opened one).
+   *
+   * @param path The path of the file to delete.
+   * @return true if the file was deleted, false if not supported or on an
+   * error.
+   */
+  virtual bool remove(const std::string &path) { return false; }
+
   virtual ~FileDriver() = default;
 };
 
@@ -18,6 +18,7 @@
 #define FILEFACTORY_H
 
 #include "../Config.h"
+#include "CompressedFile.h"
 #include "FileDriver.h"
 #include <memory>
 
@@ -32,7 +33,7 @@
 #endif
 
 namespace FileSys {
-std::unique_ptr<FileDriver> create() {
+inline std::unique_ptr<FileDriver> create() {
 #if defined(USE_SDCARD)
   return std::make_unique<SDMMCFile>();
 #elif defined(USE_LINUXFS)
@@ -41,6 +42,17 @@ std::unique_ptr<FileDriver> create() {
   return std::make_unique<NoFile>();
 #endif
 }
+
+/**
+ * @brief Creates a FileDriver for path: gzip files and zip archives are
+ * decompressed transparently (read only), see CompressedFile.
+ */
+inline std::unique_ptr<FileDriver> createFor(const std::string &path) {
+  if (CompressedFile::isCompressed(path)) {
+    return std::make_unique<CompressedFile>();
+  }
+  return create();
+}
 } // namespace FileSys
 
 #endif // FILEFACTORY_H
@@ -0,0 +1,338 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "Inflate.h"
+#include <cstring>
+
+static const uint16_t LENGTHBASE[29] = {
+    3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+    31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t LENGTHEXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1,
+                                        1, 1, 2, 2, 2, 2, 3, 3, 3, 3,
+                                        4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t DISTBASE[30] = {
+    1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+    33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+    1025, 1537, 2049, 3073, 4097, 6145,  8193,  12289, 16385, 24577};
+static const uint8_t DISTEXTRA[30] = {0, 0, 0, 0, 1, 1, 2,  2,  3,  3,
+                                      4, 4, 5, 5, 6, 6, 7,  7,  8,  8,
+                                      9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+static const uint8_t CLENORDER[19] = {16, 17, 18, 0, 8,  7, 9,  6, 10, 5,
+                                      11, 4,  12, 3, 13, 2, 14, 1, 15};
+
+Inflate::Inflate() : in(nullptr), window(nullptr), state(State::DONE) {}
+
+Inflate::~Inflate() { delete[] window; }
+
+void Inflate::reset(FileDriver *in) {
+  if (!window) {
+    window = new uint8_t[WINDOWSIZE];
+  }
+  this->in = in;
+  inpos = 0;
+  inlen = 0;
+  padbytes = 0;
+  bitbuf = 0;
+  bitcnt = 0;
+  wpos = 0;
+  state = State::HEADER;
+  lastBlock = false;
+  storedRemaining = 0;
+  matchLen = 0;
+  matchDist = 0;
+}
+
+void Inflate::save(Checkpoint &cp) const {
+  cp.inPos = in->tell() - (inlen - inpos);
+  cp.bitbuf = bitbuf;
+  cp.bitcnt = bitcnt;
+  cp.padbytes = padbytes;
+  cp.wpos = wpos;
+  cp.state = state;
+  cp.lastBlock = lastBlock;
+  cp.storedRemaining = storedRemaining;
+  cp.matchLen = matchLen;
+  cp.matchDist = matchDist;
+  cp.lit = lit;
+  cp.dist = dist;
+  memcpy(cp.window, window, WINDOWSIZE);
+}
+
+bool Inflate::restore(FileDriver *in, const Checkpoint &cp) {
+  reset(in);
+  if (!in->seek(cp.inPos, SEEK_SET)) {
+    state = State::ERROR;
+    return false;
+  }
+  bitbuf = cp.bitbuf;
+  bitcnt = cp.bitcnt;
+  padbytes = cp.padbytes;
+  wpos = cp.wpos;
+  state = cp.state;
+  lastBlock = cp.lastBlock;
+  storedRemaining = cp.storedRemaining;
+  matchLen = cp.matchLen;
+  matchDist = cp.matchDist;
+  lit = cp.lit;
+  dist = cp.dist;
+  memcpy(window, cp.window, WINDOWSIZE);
+  return true;
+}
+
+uint8_t Inflate::nextByte() {
+  if (inpos == inlen) {
+    inlen = in->read(inbuf, INBUFSIZE);
+    inpos = 0;
+    if (inlen == 0) {
+      // the decoder may look ahead a few bits beyond the end of the stream
+      padbytes++;
+      return 0;
+    }
+  }
+  return inbuf[inpos++];
+}
+
+void Inflate::need(uint8_t n) {
+  while (bitcnt < n) {
+    bitbuf |= static_cast<uint32_t>(nextByte()) << bitcnt;
+    bitcnt += 8;
+  }
+}
+
+uint32_t Inflate::bits(uint8_t n) {
+  need(n);
+  uint32_t v = bitbuf & ((1u << n) - 1);
+  bitbuf >>= n;
+  bitcnt -= n;
+  return v;
+}
+
+void Inflate::build(Huffman &h, const uint8_t *lengths, uint16_t num) {
+  uint16_t offs[16];
+  memset(h.counts, 0, sizeof(h.counts));
+  for (uint16_t i = 0; i < num; i++) {
+    h.counts[lengths[i]]++;
+  }
+  h.counts[0] = 0;
+  offs[1] = 0;
+  for (uint8_t i = 1; i < 15; i++) {
+    offs[i + 1] = offs[i] + h.counts[i];
+  }
+  for (uint16_t i = 0; i < num; i++) {
+    if (lengths[i]) {
+      h.symbols[offs[lengths[i]]++] = i;
+    }
+  }
+
+  // lookup table for short codes, indexed by the bit reversed code
+  memset(h.fast, 0, sizeof(h.fast));
+  uint16_t code = 0;
+  uint16_t idx = 0;
+  for (uint8_t len = 1; len < 16; len++) {
+    for (uint16_t k = 0; k < h.counts[len]; k++) {
+      uint16_t sym = h.symbols[idx++];
+      if (len <= FASTBITS) {
+        uint16_t rev = 0;
+        for (uint8_t b = 0; b < len; b++) {
+          rev |= ((code >> b) & 1) << (len - 1 - b);
+        }
+        for (uint16_t j = rev; j < (1 << FASTBITS); j += (1 << len)) {
+          h.fast[j] = (sym << 4) | len;
+        }
+      }
+      code++;
+    }
+    code <<= 1;
+  }
+}
+
+int Inflate::decode(const Huffman &h) {
+  need(FASTBITS);
+  uint16_t e = h.fast[bitbuf & ((1 << FASTBITS) - 1)];
+  if (e) {
+    bitbuf >>= (e & 0x0f);
+    bitcnt -= (e & 0x0f);
+    return e >> 4;
+  }
+  // canonical decoding bit by bit for long codes
+  int sum = 0;
+  int cur = 0;
+  uint8_t len = 0;
+  do {
+    cur = 2 * cur + bits(1);
+    if (++len > 15) {
+      return -1;
+    }
+    sum += h.counts[len];
+    cur -= h.counts[len];
+  } while (cur >= 0);
+  return h.symbols[sum + cur];
+}
+
+bool Inflate::readDynamicTables() {
+  uint8_t lengths[288 + 32];
+  uint16_t hlit = bits(5) + 257;
+  uint8_t hdist = bits(5) + 1;
+  uint8_t hclen = bits(4) + 4;
+  if ((hlit > 286) || (hdist > 30)) {
+    return false;
+  }
+  memset(lengths, 0, 19);
+  for (uint8_t i = 0; i < hclen; i++) {
+    lengths[CLENORDER[i]] = bits(3);
+  }
+  build(lit, lengths, 19);
+  uint16_t num = 0;
+  while (num < hlit + hdist) {
+    int sym = decode(lit);
+    if (sym < 0) {
+      return false;
+    }
+    if (sym < 16) {
+      lengths[num++] = sym;
+      continue;
+    }
+    uint8_t len = 0;
+    uint8_t rep;
+    if (sym == 16) {
+      if (num == 0) {
+        return false;
+      }
+      len = lengths[num - 1];
+      rep = bits(2) + 3;
+    } else if (sym == 17) {
+      rep = bits(3) + 3;
+    } else {
+      rep = bits(7) + 11;
+    }
+    if (num + rep > hlit + hdist) {
+      return false;
+    }
+    while (rep--) {
+      lengths[num++] = len;
+    }
+  }
+  build(lit, lengths, hlit);
+  build(dist, lengths + hlit, hdist);
+  return true;
+}
+
+bool Inflate::readBlockHeader() {
+  if (lastBlock) {
+    state = State::DONE;
+    return true;
+  }
+  lastBlock = bits(1);
+  uint8_t type = bits(2);
+  if (type == 0) {
+    // stored block: skip to byte boundary, LEN, NLEN
+    bits(bitcnt & 7);
+    uint16_t len = bits(16);
+    uint16_t nlen = bits(16);
+    if (len != static_cast<uint16_t>(~nlen)) {
+      return false;
+    }
+    storedRemaining = len;
+    state = State::STORED;
+  } else if (type == 1) {
+    uint8_t lengths[288];
+    memset(lengths, 8, 144);
+    memset(lengths + 144, 9, 112);
+    memset(lengths + 256, 7, 24);
+    memset(lengths + 280, 8, 8);
+    build(lit, lengths, 288);
+    memset(lengths, 5, 30);
+    build(dist, lengths, 30);
+    state = State::HUFFMAN;
+  } else if (type == 2) {
+    if (!readDynamicTables()) {
+      return false;
+    }
+    state = State::HUFFMAN;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+size_t Inflate::read(uint8_t *out, size_t count) {
+  size_t o = 0;
+  while (o < count) {
+    if (padbytes > 4) {
+      // input ended before the end of the stream
+      state = State::ERROR;
+    }
+    if (matchLen) {
+      while (matchLen && (o < count)) {
+        uint8_t b = window[(wpos - matchDist) & (WINDOWSIZE - 1)];
+        window[wpos++ & (WINDOWSIZE - 1)] = b;
+        out[o++] = b;
+        matchLen--;
+      }
+      continue;
+    }
+    switch (state) {
+    case State::HEADER:
+      if (!readBlockHeader()) {
+        state = State::ERROR;
+      }
+      break;
+    case State::STORED:
+      if (storedRemaining == 0) {
+        state = State::HEADER;
+        break;
+      }
+      while (storedRemaining && (o < count)) {
+        uint8_t b = bits(8);
+        window[wpos++ & (WINDOWSIZE - 1)] = b;
+        out[o++] = b;
+        storedRemaining--;
+      }
+      break;
+    case State::HUFFMAN: {
+      int sym = decode(lit);
+      if (sym < 0) {
+        state = State::ERROR;
+      } else if (sym < 256) {
+        window[wpos++ & (WINDOWSIZE - 1)] = sym;
+        out[o++] = sym;
+      } else if (sym == 256) {
+        state = State::HEADER;
+      } else if (sym < 286) {
+        sym -= 257;
+        matchLen = LENGTHBASE[sym] + bits(LENGTHEXTRA[sym]);
+        int dsym = decode(dist);
+        if ((dsym < 0) || (dsym >= 30)) {
+          state = State::ERROR;
+          matchLen = 0;
+          break;
+        }
+        matchDist = DISTBASE[dsym] + bits(DISTEXTRA[dsym]);
+        if (matchDist > wpos) {
+          state = State::ERROR;
+          matchLen = 0;
+        }
+      } else {
+        state = State::ERROR;
+      }
+      break;
+    }
+    default:
+      return o;
+    }
+  }
+  return o;
+}
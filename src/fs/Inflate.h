@@ -0,0 +1,123 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef INFLATE_H
+#define INFLATE_H
+
+#include "FileDriver.h"
+#include <cstdint>
+
+/**
+ * @brief Streaming decoder for raw DEFLATE data (RFC 1951)
+ *
+ * The compressed data is read from a FileDriver, positioned at the start
+ * of the DEFLATE stream, through a small input buffer. Decompressed data is
+ * produced on demand by read(), only the 32K history window required by
+ * DEFLATE is kept. It is allocated by the first reset().
+ *
+ * save() takes a checkpoint of the complete decoder state, restore()
+ * continues decoding from it without decoding the data before.
+ */
+class Inflate {
+private:
+  static const uint8_t FASTBITS = 9;
+  static const uint32_t WINDOWSIZE = 32768;
+  static const uint16_t INBUFSIZE = 1024;
+
+  struct Huffman {
+    uint16_t fast[1 << FASTBITS]; // (symbol << 4) | length, 0: slow path
+    uint16_t counts[16];
+    uint16_t symbols[288];
+  };
+
+  enum class State : uint8_t { HEADER, STORED, HUFFMAN, DONE, ERROR };
+
+  FileDriver *in;
+  uint8_t inbuf[INBUFSIZE];
+  uint16_t inpos;
+  uint16_t inlen;
+  uint8_t padbytes;
+  uint32_t bitbuf;
+  uint8_t bitcnt;
+
+  uint8_t *window;
+  uint32_t wpos;
+  State state;
+  bool lastBlock;
+  uint16_t storedRemaining;
+  uint16_t matchLen;
+  uint16_t matchDist;
+  Huffman lit;
+  Huffman dist;
+
+  inline uint8_t nextByte();
+  inline void need(uint8_t n);
+  inline uint32_t bits(uint8_t n);
+  int decode(const Huffman &h);
+  void build(Huffman &h, const uint8_t *lengths, uint16_t num);
+  bool readBlockHeader();
+  bool readDynamicTables();
+
+public:
+  struct Checkpoint {
+    int64_t inPos; // input position of the next byte not yet in bitbuf
+    uint32_t bitbuf;
+    uint8_t bitcnt;
+    uint8_t padbytes;
+    uint32_t wpos;
+    State state;
+    bool lastBlock;
+    uint16_t storedRemaining;
+    uint16_t matchLen;
+    uint16_t matchDist;
+    Huffman lit;
+    Huffman dist;
+    uint8_t window[WINDOWSIZE];
+  };
+
+  Inflate();
+  ~Inflate();
+
+  /**
+   * @brief Starts decoding a new stream read from in.
+   */
+  void reset(FileDriver *in);
+
+  /**
+   * @brief Decompresses up to count bytes.
+   *
+   * @return Number of bytes produced, less than count only at the end of
+   * the stream or on an error.
+   */
+  size_t read(uint8_t *out, size_t count);
+
+  /**
+   * @brief Saves the decoder state (between two calls of read()).
+   */
+  void save(Checkpoint &cp) const;
+
+  /**
+   * @brief Continues decoding at a saved state, in is positioned at the
+   * input of the checkpoint.
+   *
+   * @return false if in cannot be positioned.
+   */
+  bool restore(FileDriver *in, const Checkpoint &cp);
+
+  bool isError() const { return state == State::ERROR; }
+};
+
+#endif // INFLATE_H
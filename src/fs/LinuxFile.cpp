@@ -25,9 +25,19 @@
 #include <dirent.h>
 #include <iostream>
 #include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <vector>
 
-LinuxFile::~LinuxFile() { close(); }
+LinuxFile::~LinuxFile() {
+  close();
+  if (dirStream != nullptr) {
+    closedir(dirStream);
+  }
+}
 
 bool LinuxFile::open(const std::string &path, const char *mode) {
   close();
@@ -43,6 +53,56 @@ size_t LinuxFile::write(const void *buffer, size_t count) {
   return fp ? std::fwrite(buffer, 1, count, fp) : 0;
 }
 
+size_t LinuxFile::readv(const ByteSpan *spans, size_t count) {
+  if (!fp) {
+    return 0;
+  }
+  // read behind the stdio buffer, then move the stream position
+  std::fflush(fp);
+  long pos = std::ftell(fp);
+  std::vector<struct iovec> iov(count);
+  for (size_t i = 0; i < count; i++) {
+    iov[i].iov_base = spans[i].data;
+    iov[i].iov_len = spans[i].size;
+  }
+  ssize_t n = preadv(fileno(fp), iov.data(), count, pos);
+  if (n < 0) {
+    return 0;
+  }
+  std::fseek(fp, pos + n, SEEK_SET);
+  return n;
+}
+
+bool LinuxFile::mapRegion(int64_t offset, size_t len, MappedRegion &region) {
+  if (!fp || (len == 0)) {
+    return false;
+  }
+  // the mapping has to start at a page boundary
+  int64_t pagesize = sysconf(_SC_PAGESIZE);
+  int64_t base = offset & ~(pagesize - 1);
+  size_t baseSize = len + (offset - base);
+  void *addr =
+      mmap(nullptr, baseSize, PROT_READ, MAP_PRIVATE, fileno(fp), base);
+  if (addr == MAP_FAILED) {
+    return FileDriver::mapRegion(offset, len, region);
+  }
+  region.data = static_cast<const uint8_t *>(addr) + (offset - base);
+  region.size = len;
+  region.base = addr;
+  region.baseSize = baseSize;
+  region.mapped = true;
+  return true;
+}
+
+void LinuxFile::unmapRegion(MappedRegion &region) {
+  if (region.mapped) {
+    munmap(region.base, region.baseSize);
+    region = MappedRegion();
+    return;
+  }
+  FileDriver::unmapRegion(region);
+}
+
 bool LinuxFile::seek(long offset, int origin) {
   return fp && std::fseek(fp, offset, origin) == 0;
 }
@@ -52,13 +112,11 @@ long LinuxFile::tell() const { return fp ? std::ftell(fp) : -1; }
 bool LinuxFile::eof() { return fp && std::feof(fp); }
 
 int64_t LinuxFile::size() {
-  if (!fp) {
+  struct stat st;
+  if (!fp || (fstat(fileno(fp), &st) != 0)) {
     return -1;
   }
-  std::fseek(fp, 0, SEEK_END);
-  int64_t filesize = std::ftell(fp);
-  std::fseek(fp, 0, SEEK_SET);
-  return filesize;
+  return st.st_size;
 }
 
 void LinuxFile::close() {
@@ -105,4 +163,51 @@ bool LinuxFile::listnextentry(std::string &name, bool start) {
   return true;
 }
 
+bool LinuxFile::readnextentry(DirEntryInfo &entry, bool start) {
+  entry.name = "";
+  if (start) {
+    if (dirStream != nullptr) {
+      closedir(dirStream);
+    }
+    dirStream = opendir(Config::PATH);
+  }
+  if (dirStream == nullptr) {
+    return false;
+  }
+  struct dirent *dirent;
+  do {
+    errno = 0;
+    dirent = readdir(dirStream);
+  } while ((dirent != nullptr) && ((std::strcmp(dirent->d_name, ".") == 0) ||
+                                   (std::strcmp(dirent->d_name, "..") == 0)));
+  if (dirent == nullptr) {
+    bool ok = (errno == 0);
+    closedir(dirStream);
+    dirStream = nullptr;
+    return ok;
+  }
+  struct stat st;
+  std::string path = std::string(Config::PATH) + dirent->d_name;
+  if (stat(path.c_str(), &st) != 0) {
+    return false;
+  }
+  entry.name = dirent->d_name;
+  entry.size = static_cast<uint32_t>(st.st_size);
+  entry.mtime = st.st_mtime;
+  entry.isDir = S_ISDIR(st.st_mode);
+  return true;
+}
+
+int64_t LinuxFile::dirmtime() {
+  struct stat st;
+  if (stat(Config::PATH, &st) != 0) {
+    return 0;
+  }
+  return st.st_mtime;
+}
+
+bool LinuxFile::remove(const std::string &path) {
+  return std::remove(path.c_str()) == 0;
+}
+
 #endif
@@ -21,22 +21,30 @@
 #ifdef USE_LINUXFS
 #include "FileDriver.h"
 #include <cstdio>
+#include <dirent.h>
 #include <string>
 
 class LinuxFile : public FileDriver {
 private:
   FILE *fp = nullptr;
+  DIR *dirStream = nullptr;
 
 public:
   bool open(const std::string &path, const char *mode) override;
   size_t read(void *buffer, size_t count) override;
   size_t write(const void *buffer, size_t count) override;
+  size_t readv(const ByteSpan *spans, size_t count) override;
+  bool mapRegion(int64_t offset, size_t len, MappedRegion &region) override;
+  void unmapRegion(MappedRegion &region) override;
   bool seek(long offset, int origin) override;
   long tell() const override;
   bool eof() override;
   int64_t size() override;
   void close() override;
   bool listnextentry(std::string &name, bool start) override;
+  bool readnextentry(DirEntryInfo &entry, bool start) override;
+  int64_t dirmtime() override;
+  bool remove(const std::string &path) override;
   ~LinuxFile() override;
 };
 #endif
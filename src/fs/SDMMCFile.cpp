@@ -19,6 +19,7 @@
 #ifdef USE_SDCARD
 #include "../platform/PlatformManager.h"
 #include <SD_MMC.h>
+#include <cstring>
 
 static const char *TAG = "SDMMCFile";
 
@@ -41,6 +42,11 @@ bool SDMMCFile::init() {
 bool SDMMCFile::open(const std::string &path, const char *mode) {
   close();
   const char *m = (mode[0] == 'r') ? FILE_READ : FILE_WRITE;
+  if (mode[0] == 'a') {
+    m = FILE_APPEND;
+  } else if ((mode[0] == 'r') && strchr(mode, '+')) {
+    m = "r+";
+  }
   std::string path1 = '/' + path;
   file = SD_MMC.open(path1.c_str(), m);
   return file;
@@ -113,5 +119,52 @@ bool SDMMCFile::listnextentry(std::string &name, bool start) {
   return true;
 }
 
-SDMMCFile::~SDMMCFile() { close(); }
+bool SDMMCFile::readnextentry(DirEntryInfo &entry, bool start) {
+  entry.name = "";
+  if (!SDMMCFile::initialized) {
+    return false;
+  }
+  if (start) {
+    if (dirRoot) {
+      dirRoot.close();
+    }
+    std::string path = '/' + std::string(Config::PATH);
+    dirRoot = SD_MMC.open(path.c_str());
+    if (!dirRoot || !dirRoot.isDirectory()) {
+      return false;
+    }
+  }
+  if (!dirRoot) {
+    return false;
+  }
+  File next = dirRoot.openNextFile();
+  if (!next) {
+    dirRoot.close();
+    return true;
+  }
+  entry.name = next.name();
+  entry.size = next.size();
+  entry.mtime = next.getLastWrite();
+  entry.isDir = next.isDirectory();
+  next.close();
+  return true;
+}
+
+int64_t SDMMCFile::dirmtime() {
+  // FAT does not update the modification time of directories when files
+  // are added or removed
+  return 0;
+}
+
+bool SDMMCFile::remove(const std::string &path) {
+  std::string path1 = '/' + path;
+  return SD_MMC.remove(path1.c_str());
+}
+
+SDMMCFile::~SDMMCFile() {
+  close();
+  if (dirRoot) {
+    dirRoot.close();
+  }
+}
 #endif
@@ -27,6 +27,7 @@ class SDMMCFile : public FileDriver {
 private:
   static bool initialized;
   File file;
+  File dirRoot;
 
 public:
   bool init() override;
@@ -39,6 +40,9 @@ public:
   int64_t size() override;
   void close() override;
   bool listnextentry(std::string &name, bool start) override;
+  bool readnextentry(DirEntryInfo &entry, bool start) override;
+  int64_t dirmtime() override;
+  bool remove(const std::string &path) override;
   ~SDMMCFile();
 };
 #endif
@@ -0,0 +1,119 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "ADCJoystick.h"
+#include "../Config.h"
+#ifdef USE_ADCJOYSTICK
+#include <driver/gpio.h>
+#include <esp_attr.h>
+#include <soc/gpio_struct.h>
+#include <stdexcept>
+
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#define ADC_OUTPUT_TYPE ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_GET_CHANNEL(p) ((p)->type1.channel)
+#define ADC_GET_DATA(p) ((p)->type1.data)
+#else
+#define ADC_OUTPUT_TYPE ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#define ADC_GET_CHANNEL(p) ((p)->type2.channel)
+#define ADC_GET_DATA(p) ((p)->type2.data)
+#endif
+
+bool IRAM_ATTR ADCJoystick::onConversionDone(
+    adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata,
+    void *userData) {
+  JoystickFilter &filter = static_cast<ADCJoystick *>(userData)->filter;
+  const uint8_t *buf = edata->conv_frame_buffer;
+  for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= edata->size;
+       i += SOC_ADC_DIGI_RESULT_BYTES) {
+    const adc_digi_output_data_t *p =
+        reinterpret_cast<const adc_digi_output_data_t *>(&buf[i]);
+    uint32_t channel = ADC_GET_CHANNEL(p);
+    if (channel == Config::ADC_JOYSTICK_X) {
+      filter.add(JoystickFilter::AXIS_X, ADC_GET_DATA(p));
+    } else if (channel == Config::ADC_JOYSTICK_Y) {
+      filter.add(JoystickFilter::AXIS_Y, ADC_GET_DATA(p));
+    }
+  }
+  filter.endBlock();
+  // no task to wake up
+  return false;
+}
+
+static void check(esp_err_t err) {
+  if (err != ESP_OK) {
+    throw std::runtime_error(esp_err_to_name(err));
+  }
+}
+
+void ADCJoystick::init() {
+  // init adc (x and y axis), continuous mode
+  adc_continuous_handle_cfg_t handleConfig = {
+      .max_store_buf_size = 4 * RESULTSPERFRAME * SOC_ADC_DIGI_RESULT_BYTES,
+      .conv_frame_size = RESULTSPERFRAME * SOC_ADC_DIGI_RESULT_BYTES};
+  check(adc_continuous_new_handle(&handleConfig, &handle));
+
+  adc_digi_pattern_config_t pattern[2];
+  const adc_channel_t channels[2] = {Config::ADC_JOYSTICK_X,
+                                     Config::ADC_JOYSTICK_Y};
+  for (uint8_t i = 0; i < 2; i++) {
+    pattern[i].atten = ADC_ATTEN_DB_12;
+    pattern[i].channel = channels[i];
+    pattern[i].unit = ADC_UNIT_2;
+    pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+  }
+  adc_continuous_config_t adcConfig = {.pattern_num = 2,
+                                       .adc_pattern = pattern,
+                                       .sample_freq_hz = SAMPLEFREQ,
+                                       .conv_mode = ADC_CONV_SINGLE_UNIT_2,
+                                       .format = ADC_OUTPUT_TYPE};
+  check(adc_continuous_config(handle, &adcConfig));
+
+  adc_continuous_evt_cbs_t callbacks = {};
+  callbacks.on_conv_done = onConversionDone;
+  check(adc_continuous_register_event_callbacks(handle, &callbacks, this));
+
+  // init gpio (fire buttons)
+  gpio_config_t io_conf;
+  io_conf.intr_type = GPIO_INTR_DISABLE;
+  io_conf.mode = GPIO_MODE_INPUT;
+  io_conf.pull_down_en = GPIO_PULLDOWN_DISABLE;
+  io_conf.pull_up_en = GPIO_PULLUP_ENABLE;
+  io_conf.pin_bit_mask = (1ULL << Config::JOYSTICK_FIRE_PIN) |
+                         (1ULL << Config::JOYSTICK_FIRE2_PIN);
+  check(gpio_config(&io_conf));
+
+  filter.reset();
+  check(adc_continuous_start(handle));
+}
+
+uint8_t ADCJoystick::getValue() {
+  uint8_t value = 0xe0 | filter.getDirections();
+  if ((GPIO.in >> Config::JOYSTICK_FIRE_PIN) & 0x01) {
+    value |= 0x10;
+  }
+  return value;
+}
+
+bool ADCJoystick::getFire2() {
+  return ((GPIO.in >> Config::JOYSTICK_FIRE2_PIN) & 0x01) == 0;
+}
+
+uint8_t ADCJoystick::getPaddle(uint8_t num) {
+  // x axis is paddle 0, y axis is paddle 1
+  return adcToPaddle(filter.getPosition(num));
+}
+#endif
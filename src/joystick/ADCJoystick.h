@@ -0,0 +1,55 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef ADCJOYSTICK_H
+#define ADCJOYSTICK_H
+
+#include "../Config.h"
+#ifdef USE_ADCJOYSTICK
+#include "JoystickDriver.h"
+#include "JoystickFilter.h"
+#include <cstdint>
+#include <esp_adc/adc_continuous.h>
+
+/**
+ * @brief Analog joystick sampled by the ADC in continuous (DMA) mode
+ *
+ * The ADC converts both axes alternately at SAMPLEFREQ, the conversion done
+ * callback feeds each DMA frame into a JoystickFilter. getValue() only
+ * combines the published directions with the fire button, so polling costs
+ * no conversions.
+ */
+class ADCJoystick : public JoystickDriver {
+private:
+  static const uint32_t SAMPLEFREQ = 2000;     // conversions per second
+  static const uint32_t RESULTSPERFRAME = 8;   // callback every 4 ms
+
+  adc_continuous_handle_t handle;
+  JoystickFilter filter;
+
+  static bool onConversionDone(adc_continuous_handle_t handle,
+                               const adc_continuous_evt_data_t *edata,
+                               void *userData);
+
+public:
+  void init() override;
+  uint8_t getValue() override;
+  bool getFire2() override;
+  uint8_t getPaddle(uint8_t num) override;
+};
+#endif
+
+#endif // ADCJOYSTICK_H
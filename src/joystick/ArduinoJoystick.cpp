@@ -53,6 +53,8 @@ void ArduinoJoystick::init() {
   }
   // init other attributes
   lastjoystickvalue = 0xff;
+  lastValueX = 2048;
+  lastValueY = 2048;
   lastMeasuredTime = PlatformManager::getInstance().getTimeUS();
 }
 
@@ -70,6 +72,8 @@ uint8_t ArduinoJoystick::getValue() {
   adc_oneshot_read(adc2_handle, Config::ADC_JOYSTICK_X, &valueX);
   adc_oneshot_read(adc2_handle, Config::ADC_JOYSTICK_Y, &valueY);
   valueFire = (GPIO.in >> Config::JOYSTICK_FIRE_PIN) & 0x01;
+  lastValueX = valueX;
+  lastValueY = valueY;
   // C64 register value
   uint8_t value = 0xff;
   if (valueX < LEFT_THRESHOLD) {
@@ -92,4 +96,9 @@ uint8_t ArduinoJoystick::getValue() {
 bool ArduinoJoystick::getFire2() {
   return ((GPIO.in >> Config::JOYSTICK_FIRE2_PIN) & 0x01) == 0;
 }
+
+uint8_t ArduinoJoystick::getPaddle(uint8_t num) {
+  // x axis is paddle 0, y axis is paddle 1 (values of the last getValue())
+  return adcToPaddle((num == 0) ? lastValueX : lastValueY);
+}
 #endif
@@ -35,6 +35,8 @@ private:
   // read joystick value only each x rasterlines
   int64_t lastMeasuredTime;
   uint8_t lastjoystickvalue;
+  int lastValueX;
+  int lastValueY;
 
 public:
   static const uint8_t C64JOYUP = 0;
@@ -46,6 +48,7 @@ public:
   void init() override;
   uint8_t getValue() override;
   bool getFire2() override;
+  uint8_t getPaddle(uint8_t num) override;
 };
 #endif
 
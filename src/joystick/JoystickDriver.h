@@ -65,7 +65,38 @@ public:
    */
   virtual bool getFire2() { return false; }
 
+  /**
+   * @brief Returns the position of paddle num (0 or 1).
+   *
+   * Positions use the POT count of the Atari: PADDLE_MAX is the left end
+   * (fully counter-clockwise) and is also read without a paddle, 0 is the
+   * right end.
+   *
+   * @return uint8_t Position 0 - PADDLE_MAX.
+   */
+  virtual uint8_t getPaddle(uint8_t /*num*/) { return PADDLE_MAX; }
+
+  /**
+   * @brief Returns the state of the trigger of paddle num (0 or 1).
+   *
+   * @return true if the trigger is pressed, false otherwise.
+   */
+  virtual bool getPaddleTrigger(uint8_t /*num*/) { return false; }
+
+  static const uint8_t PADDLE_MAX = 228;
+
   virtual ~JoystickDriver() {}
+
+protected:
+  // 12-bit ADC value of an analog axis to a paddle position
+  static uint8_t adcToPaddle(int value) {
+    if (value < 0) {
+      value = 0;
+    } else if (value > 4095) {
+      value = 4095;
+    }
+    return PADDLE_MAX - (value * PADDLE_MAX) / 4095;
+  }
 };
 
 #endif // JOYSTICKDRIVER_H
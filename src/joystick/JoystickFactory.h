@@ -21,6 +21,8 @@
 #include "JoystickDriver.h"
 #if defined(USE_ARDUINOJOYSTICK)
 #include "ArduinoJoystick.h"
+#elif defined(USE_ADCJOYSTICK)
+#include "ADCJoystick.h"
 #elif defined(USE_NOJOYSTICK)
 #include "NoJoystick.h"
 #elif defined(USE_SDLJOYSTICK)
@@ -33,6 +35,8 @@ namespace Joystick {
 JoystickDriver *create() {
 #if defined(USE_ARDUINOJOYSTICK)
   return new ArduinoJoystick();
+#elif defined(USE_ADCJOYSTICK)
+  return new ADCJoystick();
 #elif defined(USE_SDLJOYSTICK)
   return new SDLJoystick();
 #elif defined(USE_NOJOYSTICK)
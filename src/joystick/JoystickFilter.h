@@ -0,0 +1,167 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef JOYSTICKFILTER_H
+#define JOYSTICKFILTER_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Turns raw analog joystick samples into direction bits
+ *
+ * Samples (12 bit) are collected per block, e.g. one DMA frame. At the end
+ * of a block the average of each axis is smoothed by a first order low pass,
+ * classified with hysteresis and the resulting direction has to be stable
+ * for DEBOUNCEBLOCKS blocks before it is published.
+ *
+ * add() and endBlock() are called by one producer (e.g. an ISR callback),
+ * getDirections() and getPosition() may be called from any thread. The
+ * class does not depend on the platform.
+ */
+class JoystickFilter {
+public:
+  static const uint8_t AXIS_X = 0;
+  static const uint8_t AXIS_Y = 1;
+
+  // direction bits as returned by JoystickDriver::getValue() (active low)
+  static const uint8_t JOYUP = 0;
+  static const uint8_t JOYDOWN = 1;
+  static const uint8_t JOYLEFT = 2;
+  static const uint8_t JOYRIGHT = 3;
+
+private:
+  static const uint16_t CENTER = 2048;
+  static const uint16_t LOW_PRESS = 500;
+  static const uint16_t LOW_RELEASE = 800;
+  static const uint16_t HIGH_PRESS = 3500;
+  static const uint16_t HIGH_RELEASE = 3200;
+  static const uint8_t SMOOTHSHIFT = 1; // low pass: new = old + (x - old) / 2
+  static const uint8_t DEBOUNCEBLOCKS = 2;
+
+  enum class Zone : uint8_t { CENTER, LOW, HIGH };
+
+  uint32_t sum[2];
+  uint16_t count[2];
+  int32_t smoothed[2];
+  Zone zone[2];
+  uint8_t candidate;
+  uint8_t stableBlocks;
+  std::atomic<uint8_t> directions;
+  std::atomic<uint16_t> position[2];
+
+  Zone classify(uint8_t axis) {
+    int32_t v = smoothed[axis];
+    switch (zone[axis]) {
+    case Zone::LOW:
+      if (v > HIGH_PRESS) {
+        return Zone::HIGH;
+      }
+      return (v > LOW_RELEASE) ? Zone::CENTER : Zone::LOW;
+    case Zone::HIGH:
+      if (v < LOW_PRESS) {
+        return Zone::LOW;
+      }
+      return (v < HIGH_RELEASE) ? Zone::CENTER : Zone::HIGH;
+    default:
+      if (v < LOW_PRESS) {
+        return Zone::LOW;
+      }
+      return (v > HIGH_PRESS) ? Zone::HIGH : Zone::CENTER;
+    }
+  }
+
+public:
+  JoystickFilter() { reset(); }
+
+  void reset() {
+    for (uint8_t axis = 0; axis < 2; axis++) {
+      sum[axis] = 0;
+      count[axis] = 0;
+      smoothed[axis] = CENTER;
+      zone[axis] = Zone::CENTER;
+      position[axis].store(CENTER, std::memory_order_relaxed);
+    }
+    candidate = 0x0f;
+    stableBlocks = 0;
+    directions.store(0x0f, std::memory_order_relaxed);
+  }
+
+  inline void add(uint8_t axis, uint16_t value) {
+    sum[axis] += value;
+    count[axis]++;
+  }
+
+  /**
+   * @brief Processes the samples of the current block.
+   *
+   * @return true if the published directions changed.
+   */
+  bool endBlock() {
+    for (uint8_t axis = 0; axis < 2; axis++) {
+      if (count[axis]) {
+        int32_t avg = sum[axis] / count[axis];
+        smoothed[axis] += (avg - smoothed[axis]) >> SMOOTHSHIFT;
+        zone[axis] = classify(axis);
+        position[axis].store(smoothed[axis], std::memory_order_relaxed);
+      }
+      sum[axis] = 0;
+      count[axis] = 0;
+    }
+    // same mapping as ArduinoJoystick: low y means down
+    uint8_t value = 0x0f;
+    if (zone[AXIS_X] == Zone::LOW) {
+      value &= ~(1 << JOYLEFT);
+    } else if (zone[AXIS_X] == Zone::HIGH) {
+      value &= ~(1 << JOYRIGHT);
+    }
+    if (zone[AXIS_Y] == Zone::LOW) {
+      value &= ~(1 << JOYDOWN);
+    } else if (zone[AXIS_Y] == Zone::HIGH) {
+      value &= ~(1 << JOYUP);
+    }
+    if (value != candidate) {
+      candidate = value;
+      stableBlocks = 1;
+    } else if (stableBlocks < DEBOUNCEBLOCKS) {
+      stableBlocks++;
+    }
+    if ((stableBlocks >= DEBOUNCEBLOCKS) &&
+        (value != directions.load(std::memory_order_relaxed))) {
+      directions.store(value, std::memory_order_release);
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief Returns the debounced direction bits 0-3 (active low), the upper
+   * bits are 0.
+   */
+  uint8_t getDirections() const {
+    return directions.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Returns the smoothed (not debounced) value of an axis, e.g. to be
+   * used as paddle.
+   */
+  uint16_t getPosition(uint8_t axis) const {
+    return position[axis].load(std::memory_order_relaxed);
+  }
+};
+
+#endif // JOYSTICKFILTER_H
@@ -18,6 +18,7 @@
 #include "../Config.h"
 #ifdef USE_SDLJOYSTICK
 #include <SDL2/SDL.h>
+#include <algorithm>
 #include <cstdint>
 
 uint8_t SDLJoystick::getValue() {
@@ -45,4 +46,31 @@ bool SDLJoystick::getFire2() {
   const uint8_t *state = SDL_GetKeyboardState(NULL);
   return state[SDL_SCANCODE_RCTRL];
 }
+
+uint8_t SDLJoystick::getPaddle(uint8_t num) {
+  // mouse over the window: x is paddle 0, y is paddle 1
+  SDL_Window *window = SDL_GetMouseFocus();
+  if (!window) {
+    return PADDLE_MAX;
+  }
+  int x, y, width, height;
+  SDL_GetMouseState(&x, &y);
+  SDL_GetWindowSize(window, &width, &height);
+  int pos = (num == 0) ? x : y;
+  int size = (num == 0) ? width : height;
+  if (size < 2) {
+    return PADDLE_MAX;
+  }
+  pos = std::min(std::max(pos, 0), size - 1);
+  return PADDLE_MAX - (pos * PADDLE_MAX) / (size - 1);
+}
+
+bool SDLJoystick::getPaddleTrigger(uint8_t num) {
+  // left mouse button: paddle 0, right mouse button: paddle 1
+  if (!SDL_GetMouseFocus()) {
+    return false;
+  }
+  uint32_t buttons = SDL_GetMouseState(NULL, NULL);
+  return buttons & ((num == 0) ? SDL_BUTTON_LMASK : SDL_BUTTON_RMASK);
+}
 #endif
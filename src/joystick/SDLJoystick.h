@@ -26,6 +26,8 @@ class SDLJoystick : public JoystickDriver {
 public:
   uint8_t getValue() override;
   bool getFire2() override;
+  uint8_t getPaddle(uint8_t num) override;
+  bool getPaddleTrigger(uint8_t num) override;
 };
 #endif
 
@@ -0,0 +1,75 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef ATARIKEYQUEUE_H
+#define ATARIKEYQUEUE_H
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief Key event in terms of the Atari keyboard
+ */
+struct AtariKeyEvent {
+  enum class Type : uint8_t {
+    KEY,    // code: KBCODE including ATARI_MOD_SHIFT / ATARI_MOD_CONTROL
+    BREAK,  // code unused
+    CONSOLE // code: ATARI_CONSOLE_START, _SELECT or _OPTION
+  };
+  Type type;
+  uint8_t code;
+  bool pressed;
+  uint32_t time; // arrival in the driver (us, Platform::getTimeUS())
+};
+
+/**
+ * @brief Lock-free queue of key events
+ *
+ * Single producer (the websocket task or the keyboard scan), single
+ * consumer (the emulation thread). If the queue is full, new events are dropped.
+ */
+class AtariKeyQueue {
+private:
+  static const uint8_t SIZE = 32; // power of 2, divides 256
+
+  AtariKeyEvent events[SIZE];
+  std::atomic<uint8_t> head{0}; // advanced by the consumer
+  std::atomic<uint8_t> tail{0}; // advanced by the producer
+
+public:
+  bool push(const AtariKeyEvent &ev) {
+    uint8_t t = tail.load(std::memory_order_relaxed);
+    if (static_cast<uint8_t>(t - head.load(std::memory_order_acquire)) ==
+        SIZE) {
+      return false;
+    }
+    events[t & (SIZE - 1)] = ev;
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(AtariKeyEvent &ev) {
+    uint8_t h = head.load(std::memory_order_relaxed);
+    if (h == tail.load(std::memory_order_acquire)) {
+      return false;
+    }
+    ev = events[h & (SIZE - 1)];
+    head.store(h + 1, std::memory_order_release);
+    return true;
+  }
+};
+
+#endif // ATARIKEYQUEUE_H
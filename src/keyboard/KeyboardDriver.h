@@ -18,6 +18,7 @@
 #define KEYBOARDDRIVER_H
 
 #include "../ExtCmd.h"
+#include "AtariKeyQueue.h"
 #include <cstddef>
 #include <cstdint>
 
@@ -40,13 +41,25 @@ public:
   /**
    * @brief Performs a keyboard scan and updates internal variables.
    *
-   * This method is invoked periodically (every 8 ms) by an external process
-   * or timer rather than the main execution flow. Because of this, all
-   * involved variables that are read or modified within this method should
-   * be declared as atomic to ensure safe concurrent access.
+   * This method is invoked once per frame by the emulation task at the end
+   * of the frame, the driver callbacks and the display loop run on other
+   * threads. Because of this, all involved variables that are shared with
+   * them should be declared as atomic to ensure safe concurrent access.
    */
   virtual void scanKeyboard() = 0;
 
+  /**
+   * @brief Retrieves the next Atari key event.
+   *
+   * Is called by the emulation thread, the events are produced by
+   * scanKeyboard(). POKEY takes a new event only after the previous one was
+   * seen by its keyboard scan.
+   *
+   * @param ev Receives the event.
+   * @return false if no event is pending.
+   */
+  virtual bool pollAtariKeyEvent(AtariKeyEvent & /*ev*/) { return false; }
+
   /**
    * @brief Retrieves the current keyboard code stored in the register dc01.
    *
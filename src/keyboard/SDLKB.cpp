@@ -18,6 +18,7 @@
 #include "../Config.h"
 #ifdef USE_SDL_KEYBOARD
 #include "../ExtCmd.h"
+#include "AtariKeycodes.h"
 #include "SDLKeymap.h"
 #include "platform/PlatformManager.h"
 #include <SDL2/SDL.h>
@@ -43,8 +44,8 @@ void SDLKB::handleKeyEvent(SDL_Keycode key, SDL_Keymod mod, bool pressed) {
     SDL_RenderClear(attachrenderer);
     uint16_t startX = 20;
     uint16_t y = 40;
-    for (uint8_t i = 0; i < strlen(diskname); i++) {
-      uint16_t ch = (unsigned char)diskname[i];
+    for (uint8_t i = 0; i < strlen(cartname); i++) {
+      uint16_t ch = (unsigned char)cartname[i];
       if (ch >= 97 && ch <= 122) {
         ch += 160;
       }
@@ -52,16 +53,16 @@ void SDLKB::handleKeyEvent(SDL_Keycode key, SDL_Keymod mod, bool pressed) {
                CHARPIXSIZE);
     }
     uint16_t cursorX =
-        startX + (uint16_t)strlen(diskname) * (8 * CHARPIXSIZE + 2);
+        startX + (uint16_t)strlen(cartname) * (8 * CHARPIXSIZE + 2);
     SDL_SetRenderDrawColor(attachrenderer, 255, 0, 0, 255);
     SDL_RenderDrawLine(attachrenderer, cursorX, y, cursorX,
                        y + 8 * CHARPIXSIZE);
     SDL_RenderPresent(attachrenderer);
     if (pressed) {
       if (key == SDLK_BACKSPACE) {
-        size_t len = strlen(diskname);
+        size_t len = strlen(cartname);
         if (len > 0) {
-          diskname[len - 1] = '\0';
+          cartname[len - 1] = '\0';
         }
       } else if (key == SDLK_RETURN) {
         if (attachrenderer) {
@@ -72,23 +73,23 @@ void SDLKB::handleKeyEvent(SDL_Keycode key, SDL_Keymod mod, bool pressed) {
         }
         attachwinopen = false;
         openattachwin = false;
-        if (strlen(diskname) == 0) {
+        if (strlen(cartname) == 0) {
           extCmdBuffer[0] = static_cast<std::underlying_type<ExtCmd>::type>(
-              ExtCmd::DETACHD64);
+              ExtCmd::DETACHCART);
         } else {
           extCmdBuffer[0] = static_cast<std::underlying_type<ExtCmd>::type>(
-              ExtCmd::ATTACHD64);
-          std::copy(diskname, diskname + strlen(diskname) + 1,
+              ExtCmd::ATTACHCART);
+          std::copy(cartname, cartname + strlen(cartname) + 1,
                     extCmdBuffer + 3);
         }
         gotExternalCmd = true;
       } else {
-        if (strlen(diskname) < DISKNAMEMAXLEN - 1) {
+        if (strlen(cartname) < CARTNAMEMAXLEN - 1) {
           uint8_t ch = (uint8_t)key;
           if ((ch >= 97 && ch <= 122) || (ch >= 48 && ch <= 57)) {
-            size_t len = strlen(diskname);
-            diskname[len] = key;
-            diskname[len + 1] = '\0';
+            size_t len = strlen(cartname);
+            cartname[len] = key;
+            cartname[len + 1] = '\0';
           }
         }
       }
@@ -109,7 +110,7 @@ void SDLKB::handleKeyEvent(SDL_Keycode key, SDL_Keymod mod, bool pressed) {
                                "        (SEE CONFIG::PATH, README.MD)\r"
                                "RCTRL-S TO SAVE A PROGRAM\r"
                                "RCTRL-T TO LIST PROGRAMS\r"
-                               "RCTRL-A TO ATTACH/DETACH A D64 FILE\r"
+                               "RCTRL-A TO INSERT/REMOVE A CARTRIDGE\r"
                                "RCTRL-R TO RESET THE EMULATOR\r"
                                "RCTRL-, TO DECREMENT SOUND VOLUME\r"
                                "RCTRL-. TO INCREMENT SOUND VOLUME\r"
@@ -120,7 +121,8 @@ void SDLKB::handleKeyEvent(SDL_Keycode key, SDL_Keymod mod, bool pressed) {
                                "        IF A JOYSTICK PORT IS CHOSEN\r"
                                "RCTRL-N SHOW CONTENT OF CPU REGISTERS\r"
                                "RCTRL-D SWITCH TO DEBUG MODE AND BACK\r"
-                               "COMMODORE KEY = LEFT ALT\r\x9a\0";
+                               "F2/F3/F4 = OPTION/SELECT/START\r"
+                               "F1 = HELP, F7 = BREAK\r\x9a\0";
         memcpy(&extCmdBuffer[3], help, sizeof(help));
         gotExternalCmd = true;
       } else if (key == SDLK_q) {
@@ -143,7 +145,7 @@ void SDLKB::handleKeyEvent(SDL_Keycode key, SDL_Keymod mod, bool pressed) {
         if (!attachwinopen && !openattachwin) {
           std::lock_guard<std::mutex> lock(attachWinMutex);
           openattachwin = true;
-          diskname[0] = '\0';
+          cartname[0] = '\0';
         }
       } else if (key == SDLK_n) {
         extCmdBuffer[0] =
@@ -211,41 +213,55 @@ void SDLKB::handleKeyEvent(SDL_Keycode key, SDL_Keymod mod, bool pressed) {
           return;
         }
       }
-      // C64 keys
-      bool found = false;
-      if (!((mod & KMOD_LCTRL) || (mod & KMOD_LALT))) {
-        KeySpec k{key, mod & KMOD_SHIFT, mod & KMOD_RALT};
-        auto it = keyMap.find(k);
-        if (it != keyMap.end()) {
-          auto [b1, b2, b3] = it->second;
-          setCodes(b1, b2, b3);
-          found = true;
-        }
-      }
-      if ((!found) &&
-          ((mod & KMOD_SHIFT) || (mod & KMOD_LCTRL) || (mod & KMOD_LALT))) {
-        // fallback: no mapping found, but modifier shift, (left) ctrl or
-        // commodore (= left alt) pressed?
-        KeySpec k{key, false, false};
-        auto it = keyMap.find(k);
-        if (it != keyMap.end()) {
-          auto [b1, b2, b3] = it->second;
-          if (mod & KMOD_SHIFT) {
-            b3 |= 1;
-          } else if (mod & KMOD_LCTRL) {
-            b3 |= 2;
-          } else if (mod & KMOD_LALT) {
-            b3 |= 4;
-          }
-          setCodes(b1, b2, b3);
-        }
-      }
+      handleAtariKey(key, mod, true);
     }
   } else {
+    handleAtariKey(key, mod, false);
     setCodes(0xff, 0xff, 0x00);
   }
 }
 
+void SDLKB::handleAtariKey(SDL_Keycode key, SDL_Keymod mod, bool pressed) {
+  AtariKeyEvent ev{AtariKeyEvent::Type::KEY, 0, pressed,
+                   static_cast<uint32_t>(
+                       PlatformManager::getInstance().getTimeUS())};
+  switch (key) {
+  case SDLK_F2:
+    ev.type = AtariKeyEvent::Type::CONSOLE;
+    ev.code = ATARI_CONSOLE_OPTION;
+    break;
+  case SDLK_F3:
+    ev.type = AtariKeyEvent::Type::CONSOLE;
+    ev.code = ATARI_CONSOLE_SELECT;
+    break;
+  case SDLK_F4:
+    ev.type = AtariKeyEvent::Type::CONSOLE;
+    ev.code = ATARI_CONSOLE_START;
+    break;
+  case SDLK_F7:
+  case SDLK_PAUSE:
+    ev.type = AtariKeyEvent::Type::BREAK;
+    break;
+  default: {
+    auto it = keyMap.find(key);
+    if (it == keyMap.end()) {
+      return;
+    }
+    ev.code = it->second;
+    if (mod & KMOD_SHIFT) {
+      ev.code |= ATARI_MOD_SHIFT;
+    }
+    if (mod & KMOD_LCTRL) {
+      ev.code |= ATARI_MOD_CONTROL;
+    }
+    break;
+  }
+  }
+  if (!atariKeys.push(ev)) {
+    PlatformManager::getInstance().log(LOG_WARN, TAG, "key event dropped");
+  }
+}
+
 static uint8_t helpbox[] =
     "\x55\x43\x43\x43\x43\x43\x43\x43\x43\x43\x43\x43"
     "\x43\x43\x43\x43\x43\x43\x43\x49"
@@ -271,6 +287,7 @@ void SDLKB::printHelpHint() {
 void SDLKB::init() {
   SDL_InitSubSystem(SDL_INIT_EVENTS);
   specialjoymode = false;
+  setCodes(0xff, 0xff, 0x00);
   printHelpHint();
 }
 
@@ -286,7 +303,7 @@ void SDLKB::syncAndCreateAttachWinSDL() {
     std::lock_guard<std::mutex> lock(attachWinMutex);
     openattachwin = false;
     attachwin =
-        SDL_CreateWindow("attach disk, enter d64 name", SDL_WINDOWPOS_CENTERED,
+        SDL_CreateWindow("insert cartridge, enter name", SDL_WINDOWPOS_CENTERED,
                          SDL_WINDOWPOS_CENTERED, 400, 200, 0);
     if (!attachwin) {
       PlatformManager::getInstance().log(LOG_ERROR, TAG,
@@ -313,6 +330,8 @@ void SDLKB::scanKeyboard() {
   }
 }
 
+bool SDLKB::pollAtariKeyEvent(AtariKeyEvent &ev) { return atariKeys.pop(ev); }
+
 uint8_t SDLKB::getKBCodeDC01() { return kbcode2; }
 
 uint8_t SDLKB::getKBCodeDC00() { return kbcode1; }
@@ -20,6 +20,7 @@
 #include "../Config.h"
 #ifdef USE_SDL_KEYBOARD
 #include "../ExtCmd.h"
+#include "AtariKeyQueue.h"
 #include "KeyboardDriver.h"
 #include <SDL2/SDL.h>
 #include <atomic>
@@ -45,8 +46,8 @@ private:
 
   bool attachwinopen = false;
   bool openattachwin = false;
-  static const uint16_t DISKNAMEMAXLEN = 17;
-  char diskname[DISKNAMEMAXLEN];
+  static const uint16_t CARTNAMEMAXLEN = 17;
+  char cartname[CARTNAMEMAXLEN];
   SDL_Window *attachwin = NULL;
   SDL_Renderer *attachrenderer = NULL;
 
@@ -54,12 +55,15 @@ private:
   std::atomic<uint8_t> kbcode2;
   std::atomic<uint8_t> shiftctrlcode;
 
+  AtariKeyQueue atariKeys;
+
   std::queue<SDL_Event> eventQueue;
   std::mutex eventMutex;
   std::mutex attachWinMutex;
 
   void setCodes(uint8_t code1, uint8_t code2, uint8_t ctrlcode);
   void handleKeyEvent(SDL_Keycode key, SDL_Keymod mod, bool pressed);
+  void handleAtariKey(SDL_Keycode key, SDL_Keymod mod, bool pressed);
   void printHelpHint();
 
 public:
@@ -68,6 +72,7 @@ public:
   void sendExtCmdNotification(uint8_t *data, size_t size) override;
   void syncAndCreateAttachWinSDL() override;
   void scanKeyboard() override;
+  bool pollAtariKeyEvent(AtariKeyEvent &ev) override;
   uint8_t getKBCodeDC01() override;
   uint8_t getKBCodeDC00() override;
   uint8_t getShiftctrlcode() override;
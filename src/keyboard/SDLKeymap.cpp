@@ -1,97 +1,72 @@
 #include "../Config.h"
 #ifdef USE_SDL_KEYBOARD
 #include "SDLKeymap.h"
+#include "AtariKeycodes.h"
 
-// definitions for a swiss german keyboard
-// -> adapt for your keyboard
-// allowed modifiers: shift, right alt (alt gr)
-const std::map<KeySpec, CodeTripleS> keyMap = {
-    // unmodified
-    {{SDLK_ESCAPE, false, false}, C64_KEYCODE_BREAK},
-    {{SDLK_RETURN, false, false}, C64_KEYCODE_RETURN},
-    {{SDLK_BACKSPACE, false, false}, C64_KEYCODE_BACKSPACE},
-    {{SDLK_SPACE, false, false}, C64_KEYCODE_SPACE},
-    {{SDLK_0, false, false}, C64_KEYCODE_0},
-    {{SDLK_1, false, false}, C64_KEYCODE_1},
-    {{SDLK_2, false, false}, C64_KEYCODE_2},
-    {{SDLK_3, false, false}, C64_KEYCODE_3},
-    {{SDLK_4, false, false}, C64_KEYCODE_4},
-    {{SDLK_5, false, false}, C64_KEYCODE_5},
-    {{SDLK_6, false, false}, C64_KEYCODE_6},
-    {{SDLK_7, false, false}, C64_KEYCODE_7},
-    {{SDLK_8, false, false}, C64_KEYCODE_8},
-    {{SDLK_9, false, false}, C64_KEYCODE_9},
-    {{SDLK_w, false, false}, C64_KEYCODE_W},
-    {{SDLK_a, false, false}, C64_KEYCODE_A},
-    {{SDLK_z, false, false}, C64_KEYCODE_Z},
-    {{SDLK_s, false, false}, C64_KEYCODE_S},
-    {{SDLK_e, false, false}, C64_KEYCODE_E},
-    {{SDLK_r, false, false}, C64_KEYCODE_R},
-    {{SDLK_d, false, false}, C64_KEYCODE_D},
-    {{SDLK_c, false, false}, C64_KEYCODE_C},
-    {{SDLK_f, false, false}, C64_KEYCODE_F},
-    {{SDLK_t, false, false}, C64_KEYCODE_T},
-    {{SDLK_x, false, false}, C64_KEYCODE_X},
-    {{SDLK_y, false, false}, C64_KEYCODE_Y},
-    {{SDLK_g, false, false}, C64_KEYCODE_G},
-    {{SDLK_b, false, false}, C64_KEYCODE_B},
-    {{SDLK_h, false, false}, C64_KEYCODE_H},
-    {{SDLK_u, false, false}, C64_KEYCODE_U},
-    {{SDLK_v, false, false}, C64_KEYCODE_V},
-    {{SDLK_i, false, false}, C64_KEYCODE_I},
-    {{SDLK_j, false, false}, C64_KEYCODE_J},
-    {{SDLK_m, false, false}, C64_KEYCODE_M},
-    {{SDLK_k, false, false}, C64_KEYCODE_K},
-    {{SDLK_o, false, false}, C64_KEYCODE_O},
-    {{SDLK_n, false, false}, C64_KEYCODE_N},
-    {{SDLK_p, false, false}, C64_KEYCODE_P},
-    {{SDLK_l, false, false}, C64_KEYCODE_L},
-    {{SDLK_q, false, false}, C64_KEYCODE_Q},
-    {{SDLK_MINUS, false, false}, C64_KEYCODE_MINUS},
-    {{SDLK_PERIOD, false, false}, C64_KEYCODE_PERIOD},
-    {{SDLK_COMMA, false, false}, C64_KEYCODE_COMMA},
-    {{SDLK_DOLLAR, false, false}, C64_KEYCODE_DOLLAR},
-    {{SDLK_LESS, false, false}, C64_KEYCODE_LESS},
-    {{SDLK_RIGHT, false, false}, C64_KEYCODE_RIGHT},
-    {{SDLK_LEFT, false, false}, C64_KEYCODE_LEFT},
-    {{SDLK_DOWN, false, false}, C64_KEYCODE_DOWN},
-    {{SDLK_UP, false, false}, C64_KEYCODE_UP},
-    {{SDLK_F1, false, false}, C64_KEYCODE_F1},
-    {{SDLK_F3, false, false}, C64_KEYCODE_F3},
-    {{SDLK_F5, false, false}, C64_KEYCODE_F5},
-    {{SDLK_F7, false, false}, C64_KEYCODE_F7},
-    {{SDLK_QUOTE, false, false}, C64_KEYCODE_QUOTE},
-    {{SDLK_HOME, false, false}, C64_KEYCODE_HOME},
-    {{SDLK_DELETE, false, false}, C64_KEYCODE_DEL},
-    {{228, false, false}, C64_KEYCODE_LEFTARROW}, // 228 = ä
-    {{252, false, false}, C64_KEYCODE_LEFTBRACKET},
-    {{1073741824, false, false}, C64_KEYCODE_RIGHTBRACKET},
-    // right alt
-    {{SDLK_2, false, true}, C64_KEYCODE_AT},
-    {{SDLK_3, false, true}, C64_KEYCODE_HASH},
-    // shift
-    {{SDLK_2, true, false}, C64_KEYCODE_QUOTEDBL},
-    {{SDLK_5, true, false}, C64_KEYCODE_PERCENT},
-    {{SDLK_6, true, false}, C64_KEYCODE_AMPERSAND},
-    {{SDLK_8, true, false}, C64_KEYCODE_LEFTPAREN},
-    {{SDLK_9, true, false}, C64_KEYCODE_RIGHTPAREN},
-    {{SDLK_LESS, true, false}, C64_KEYCODE_GREATER},
-    {{SDLK_QUOTE, true, false}, C64_KEYCODE_QUESTION},
-    {{SDLK_1, true, false}, C64_KEYCODE_PLUS},
-    {{SDLK_3, true, false}, C64_KEYCODE_ASTERISK},
-    {{SDLK_7, true, false}, C64_KEYCODE_SLASH},
-    {{SDLK_0, true, false}, C64_KEYCODE_EQUALS},
-    {{SDLK_PERIOD, true, false}, C64_KEYCODE_COLON},
-    {{SDLK_COMMA, true, false}, C64_KEYCODE_SEMICOLON},
-    {{SDLK_DOLLAR, true, false}, C64_KEYCODE_POUND},
-    {{SDLK_DELETE, true, false}, C64_KEYCODE_INS},
-    {{SDLK_HOME, true, false}, C64_KEYCODE_CLR},
-    {{1073741824, true, false}, C64_KEYCODE_EXCLAIM},
-    {{228, true, false}, C64_KEYCODE_UPARROW},
-    // modifier keys
-    {{SDLK_LALT, false, false}, C64_KEYCODE_COMMODORE},
-    {{SDLK_LSHIFT, false, false}, C64_KEYCODE_SHIFTLEFT},
-    {{SDLK_RSHIFT, false, false}, C64_KEYCODE_SHIFTRIGHT},
-    {{SDLK_LCTRL, false, false}, C64_KEYCODE_CTRL},
+// positional mapping of a PC keyboard, shift and (left) ctrl are passed
+// through as Atari SHIFT and CONTROL
+const std::map<SDL_Keycode, uint8_t> keyMap = {
+    {SDLK_a, ATARI_KEY_A},
+    {SDLK_b, ATARI_KEY_B},
+    {SDLK_c, ATARI_KEY_C},
+    {SDLK_d, ATARI_KEY_D},
+    {SDLK_e, ATARI_KEY_E},
+    {SDLK_f, ATARI_KEY_F},
+    {SDLK_g, ATARI_KEY_G},
+    {SDLK_h, ATARI_KEY_H},
+    {SDLK_i, ATARI_KEY_I},
+    {SDLK_j, ATARI_KEY_J},
+    {SDLK_k, ATARI_KEY_K},
+    {SDLK_l, ATARI_KEY_L},
+    {SDLK_m, ATARI_KEY_M},
+    {SDLK_n, ATARI_KEY_N},
+    {SDLK_o, ATARI_KEY_O},
+    {SDLK_p, ATARI_KEY_P},
+    {SDLK_q, ATARI_KEY_Q},
+    {SDLK_r, ATARI_KEY_R},
+    {SDLK_s, ATARI_KEY_S},
+    {SDLK_t, ATARI_KEY_T},
+    {SDLK_u, ATARI_KEY_U},
+    {SDLK_v, ATARI_KEY_V},
+    {SDLK_w, ATARI_KEY_W},
+    {SDLK_x, ATARI_KEY_X},
+    {SDLK_y, ATARI_KEY_Y},
+    {SDLK_z, ATARI_KEY_Z},
+    {SDLK_0, ATARI_KEY_0},
+    {SDLK_1, ATARI_KEY_1},
+    {SDLK_2, ATARI_KEY_2},
+    {SDLK_3, ATARI_KEY_3},
+    {SDLK_4, ATARI_KEY_4},
+    {SDLK_5, ATARI_KEY_5},
+    {SDLK_6, ATARI_KEY_6},
+    {SDLK_7, ATARI_KEY_7},
+    {SDLK_8, ATARI_KEY_8},
+    {SDLK_9, ATARI_KEY_9},
+    {SDLK_SPACE, ATARI_KEY_SPACE},
+    {SDLK_RETURN, ATARI_KEY_RETURN},
+    {SDLK_ESCAPE, ATARI_KEY_ESC},
+    {SDLK_TAB, ATARI_KEY_TAB},
+    {SDLK_BACKSPACE, ATARI_KEY_BACKSPACE},
+    {SDLK_CAPSLOCK, ATARI_KEY_CAPS},
+    {SDLK_BACKQUOTE, ATARI_KEY_INVERSE},
+    {SDLK_F1, ATARI_KEY_HELP},
+    {SDLK_COMMA, ATARI_KEY_COMMA},
+    {SDLK_PERIOD, ATARI_KEY_PERIOD},
+    {SDLK_SLASH, ATARI_KEY_SLASH},
+    {SDLK_SEMICOLON, ATARI_KEY_SEMICOLON},
+    {SDLK_MINUS, ATARI_KEY_MINUS},
+    {SDLK_EQUALS, ATARI_KEY_EQUALS},
+    {SDLK_LEFTBRACKET, ATARI_KEY_PLUS},
+    {SDLK_RIGHTBRACKET, ATARI_KEY_ASTERISK},
+    {SDLK_LESS, ATARI_KEY_LESS},
+    {SDLK_QUOTE, ATARI_KEY_GREATER},
+    // cursor keys: control + - = + *
+    {SDLK_UP, ATARI_KEY_MINUS | ATARI_MOD_CONTROL},
+    {SDLK_DOWN, ATARI_KEY_EQUALS | ATARI_MOD_CONTROL},
+    {SDLK_LEFT, ATARI_KEY_PLUS | ATARI_MOD_CONTROL},
+    {SDLK_RIGHT, ATARI_KEY_ASTERISK | ATARI_MOD_CONTROL},
+    {SDLK_DELETE, ATARI_KEY_BACKSPACE | ATARI_MOD_CONTROL},
+    {SDLK_INSERT, ATARI_KEY_GREATER | ATARI_MOD_CONTROL},
+    {SDLK_HOME, ATARI_KEY_LESS | ATARI_MOD_SHIFT},
 };
 #endif
@@ -19,15 +19,12 @@
 
 #include "../Config.h"
 #ifdef USE_SDL_KEYBOARD
-#include "C64Keycodes.h"
-#include "CodeTripleDef.h"
 #include <SDL2/SDL.h>
 #include <map>
-#include <tuple>
 
-using KeySpec = std::tuple<SDL_Keycode, bool, bool>; // key, shift, ralt
-
-extern const std::map<KeySpec, CodeTripleS> keyMap;
+// Atari KBCODE of a host key, ATARI_MOD_SHIFT / ATARI_MOD_CONTROL set for
+// keys which need a modifier on the Atari keyboard (e.g. cursor keys)
+extern const std::map<SDL_Keycode, uint8_t> keyMap;
 #endif
 
 #endif // SDLKEYMAP_H
@@ -445,9 +445,9 @@ void WebKB::init() {
     startCaptivePortal();
   }
 
-  // start with joystickmode 2 at startup
+  // start with the joystick in port 1 (the port used by Atari games)
   extCmdBuffer[0] =
-      static_cast<std::underlying_type<ExtCmd>::type>(ExtCmd::JOYSTICKMODE2);
+      static_cast<std::underlying_type<ExtCmd>::type>(ExtCmd::JOYSTICKMODE1);
   gotExternalCmd = true;
 }
 
@@ -576,6 +576,23 @@ void WebKB::startWebServer() {
 // ----------------------------------------------------
 void WebKB::handleWebsocketMessage(void *arg, uint8_t *data, size_t len) {
   AwsFrameInfo *info = (AwsFrameInfo *)arg;
+
+  // binary key frames (see WebKBProtocol.h), only unfragmented messages
+  if (info->opcode == WS_BINARY) {
+    if (!info->final || (info->index != 0) || (info->len != len)) {
+      return;
+    }
+    WebKeyFrame frame;
+    for (size_t i = 0; i + WebKeyFrame::SIZE <= len;
+         i += WebKeyFrame::SIZE) {
+      if (WebKeyFrame::parse(data + i, frame)) {
+        handleKeyFrame(frame);
+      }
+    }
+    return;
+  }
+
+  // text messages (JSON) of older clients
   if (info->opcode != WS_TEXT)
     return;
 
@@ -619,6 +636,40 @@ void WebKB::handleWebsocketMessage(void *arg, uint8_t *data, size_t len) {
   }
 }
 
+void WebKB::handleKeyFrame(const WebKeyFrame &frame) {
+  AtariKeyEvent ev;
+  if (frame.toKeyEvent(ev)) {
+    ev.time = static_cast<uint32_t>(PlatformManager::getInstance().getTimeUS());
+    if (!atariKeys.push(ev)) {
+      PlatformManager::getInstance().log(LOG_WARN, TAG, "key event dropped");
+    }
+    return;
+  }
+
+  // commands, only on key-down and only those of the keyboard page
+  if (!frame.isPressed() || gotExternalCmd) {
+    return;
+  }
+  ExtCmd cmd = static_cast<ExtCmd>(frame.code);
+  switch (cmd) {
+  case ExtCmd::LOAD:
+  case ExtCmd::SAVE:
+  case ExtCmd::LIST:
+  case ExtCmd::RESET:
+  case ExtCmd::RESTORE:
+  case ExtCmd::INCVOLUME:
+  case ExtCmd::DECVOLUME:
+  case ExtCmd::JOYSTICKMODE1:
+  case ExtCmd::JOYSTICKMODE2:
+    extCmdBuffer[0] = frame.code;
+    extCmdBuffer[1] = frame.param;
+    gotExternalCmd = true;
+    break;
+  default:
+    break;
+  }
+}
+
 void WebKB::processSingleKey(const char *type, const char *keyId, bool shift,
                              bool ctrl, bool comm) {
   // return, if there's no char or keycode
@@ -740,7 +791,7 @@ void WebKB::scanKeyboard() {
     currentKey.holdTicks--;
   }
 
-  // if the key is not active for at least 24 ms, do nothing (3*8ms)
+  // if the key is not active for at least 2 frames, do nothing
   if (currentKey.active && currentKey.holdTicks > 0) {
     return;
   }
@@ -767,7 +818,7 @@ void WebKB::scanKeyboard() {
       currentKey.dc1 = _dc1;
       currentKey.dc0 = _dc0;
       currentKey.shift = _shift;
-      currentKey.holdTicks = 3; // 3×8ms = 24ms
+      currentKey.holdTicks = 2; // 2 frames = 33-40 ms
       currentKey.active = true;
     }
   }
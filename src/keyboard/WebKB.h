@@ -20,7 +20,9 @@
 #include "../Config.h"
 #ifdef USE_WEB_KEYBOARD
 
+#include "AtariKeyQueue.h"
 #include "KeyboardDriver.h"
+#include "WebKBProtocol.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include <Arduino.h>
@@ -62,6 +64,10 @@ public:
     return joyvalue.load(std::memory_order_acquire);
   }
 
+  bool pollAtariKeyEvent(AtariKeyEvent &ev) override {
+    return atariKeys.pop(ev);
+  }
+
   uint8_t *getExtCmdData() override;
   void sendExtCmdNotification(uint8_t *data, size_t size) override;
 
@@ -71,6 +77,7 @@ public:
 private:
   void startWebServer();
   void handleWebsocketMessage(void *arg, uint8_t *data, size_t len);
+  void handleKeyFrame(const WebKeyFrame &frame);
   void processSingleKey(const char *type, const char *keyId, bool shift,
                         bool ctrl, bool comm);
   void printIPAddress();
@@ -96,6 +103,7 @@ private:
   uint8_t extCmdBuffer[1024];
   bool shiftlock = false;
   std::queue<CodeTriple> eventQueue;
+  AtariKeyQueue atariKeys; // binary frames, produced by the websocket task
   SemaphoreHandle_t queueSem;
   ActiveKey currentKey;
 };
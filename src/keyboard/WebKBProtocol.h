@@ -0,0 +1,112 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef WEBKBPROTOCOL_H
+#define WEBKBPROTOCOL_H
+
+#include "AtariKeyQueue.h"
+#include "AtariKeycodes.h"
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Binary key frame sent by the web keyboard
+ *
+ * A websocket message contains one or more frames of 8 bytes:
+ * - 0: type (Type)
+ * - 1: flags (FLAG_PRESSED, FLAG_SHIFT, FLAG_CONTROL)
+ * - 2: code: KBCODE 0-63 (KEY), ATARI_CONSOLE_* (CONSOLE), ExtCmd (COMMAND)
+ * - 3: parameter of a command
+ * - 4-7: timestamp of the client in ms (little endian)
+ *
+ * Parsing uses fixed offsets and does not depend on the platform, so it
+ * can be built and fuzzed on Linux.
+ */
+struct WebKeyFrame {
+  enum class Type : uint8_t { KEY, CONSOLE, BREAK, COMMAND };
+
+  static const size_t SIZE = 8;
+  static const uint8_t FLAG_PRESSED = 0x01;
+  static const uint8_t FLAG_SHIFT = 0x02;
+  static const uint8_t FLAG_CONTROL = 0x04;
+
+  Type type;
+  uint8_t flags;
+  uint8_t code;
+  uint8_t param;
+  uint32_t timestamp;
+
+  /**
+   * @brief Parses the frame at data, which must hold at least SIZE bytes.
+   *
+   * @return false if the frame is invalid.
+   */
+  static bool parse(const uint8_t *data, WebKeyFrame &frame) {
+    if ((data[0] > static_cast<uint8_t>(Type::COMMAND)) ||
+        (data[1] & ~(FLAG_PRESSED | FLAG_SHIFT | FLAG_CONTROL))) {
+      return false;
+    }
+    frame.type = static_cast<Type>(data[0]);
+    frame.flags = data[1];
+    frame.code = data[2];
+    frame.param = data[3];
+    frame.timestamp = data[4] | (data[5] << 8) | (data[6] << 16) |
+                      (static_cast<uint32_t>(data[7]) << 24);
+    switch (frame.type) {
+    case Type::KEY:
+      return frame.code < 64;
+    case Type::CONSOLE:
+      return (frame.code == ATARI_CONSOLE_START) ||
+             (frame.code == ATARI_CONSOLE_SELECT) ||
+             (frame.code == ATARI_CONSOLE_OPTION);
+    default:
+      return true;
+    }
+  }
+
+  bool isPressed() const { return flags & FLAG_PRESSED; }
+
+  /**
+   * @brief Converts a KEY, CONSOLE or BREAK frame to a key event.
+   *
+   * @return false for COMMAND frames.
+   */
+  bool toKeyEvent(AtariKeyEvent &ev) const {
+    ev.pressed = isPressed();
+    ev.code = code;
+    switch (type) {
+    case Type::KEY:
+      ev.type = AtariKeyEvent::Type::KEY;
+      if (flags & FLAG_SHIFT) {
+        ev.code |= ATARI_MOD_SHIFT;
+      }
+      if (flags & FLAG_CONTROL) {
+        ev.code |= ATARI_MOD_CONTROL;
+      }
+      return true;
+    case Type::CONSOLE:
+      ev.type = AtariKeyEvent::Type::CONSOLE;
+      return true;
+    case Type::BREAK:
+      ev.type = AtariKeyEvent::Type::BREAK;
+      return true;
+    default:
+      return false;
+    }
+  }
+};
+
+#endif // WEBKBPROTOCOL_H
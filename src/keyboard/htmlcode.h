@@ -1146,432 +1146,694 @@ const unsigned char HTMLCSSKB_html[] = {
     0x76, 0x3e, 0x0a, 0x09, 0x09, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x0a,
     0x09, 0x3c, 0x2f, 0x64, 0x69, 0x76, 0x3e, 0x20, 0x48, 0x65, 0x6c, 0x70,
     0x3a, 0x20, 0x3c, 0x62, 0x72, 0x3e, 0x0a, 0x09, 0x3c, 0x75, 0x6c, 0x3e,
-    0x0a, 0x09, 0x09, 0x3c, 0x6c, 0x69, 0x3e, 0x52, 0x45, 0x53, 0x54, 0x4f,
-    0x52, 0x45, 0x20, 0x3d, 0x20, 0x50, 0x61, 0x67, 0x65, 0x55, 0x70, 0x3c,
-    0x2f, 0x6c, 0x69, 0x3e, 0x0a, 0x09, 0x09, 0x3c, 0x6c, 0x69, 0x3e, 0x43,
-    0x4c, 0x52, 0x20, 0x3d, 0x20, 0x46, 0x31, 0x32, 0x3c, 0x2f, 0x6c, 0x69,
-    0x3e, 0x0a, 0x09, 0x09, 0x3c, 0x6c, 0x69, 0x3e, 0x52, 0x55, 0x4e, 0x2f,
-    0x53, 0x54, 0x4f, 0x50, 0x20, 0x3d, 0x20, 0x45, 0x73, 0x63, 0x61, 0x70,
-    0x65, 0x3c, 0x2f, 0x6c, 0x69, 0x3e, 0x0a, 0x09, 0x09, 0x3c, 0x6c, 0x69,
-    0x3e, 0x41, 0x52, 0x52, 0x4f, 0x57, 0x55, 0x50, 0x20, 0x3d, 0x20, 0xc2,
-    0xb0, 0x3c, 0x2f, 0x6c, 0x69, 0x3e, 0x0a, 0x09, 0x09, 0x3c, 0x6c, 0x69,
-    0x3e, 0x43, 0x4f, 0x4d, 0x4d, 0x4f, 0x44, 0x4f, 0x52, 0x45, 0x20, 0x3d,
-    0x20, 0x41, 0x6c, 0x74, 0x20, 0x6f, 0x72, 0x20, 0x41, 0x6c, 0x74, 0x47,
-    0x72, 0x61, 0x70, 0x68, 0x3c, 0x2f, 0x6c, 0x69, 0x3e, 0x0a, 0x09, 0x3c,
-    0x2f, 0x75, 0x6c, 0x3e, 0x0a, 0x09, 0x3c, 0x73, 0x63, 0x72, 0x69, 0x70,
-    0x74, 0x3e, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x69, 0x6e, 0x69, 0x74, 0x20,
-    0x77, 0x65, 0x62, 0x73, 0x6f, 0x63, 0x6b, 0x65, 0x74, 0x0a, 0x09, 0x63,
-    0x6f, 0x6e, 0x73, 0x74, 0x20, 0x77, 0x73, 0x20, 0x3d, 0x20, 0x6e, 0x65,
-    0x77, 0x20, 0x57, 0x65, 0x62, 0x53, 0x6f, 0x63, 0x6b, 0x65, 0x74, 0x28,
-    0x22, 0x77, 0x73, 0x3a, 0x2f, 0x2f, 0x22, 0x20, 0x2b, 0x20, 0x6c, 0x6f,
-    0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x68, 0x6f, 0x73, 0x74, 0x20,
-    0x2b, 0x20, 0x22, 0x2f, 0x77, 0x73, 0x22, 0x29, 0x3b, 0x0a, 0x09, 0x2f,
-    0x2f, 0x20, 0x63, 0x68, 0x65, 0x63, 0x6b, 0x20, 0x66, 0x6f, 0x72, 0x20,
-    0x6c, 0x65, 0x74, 0x74, 0x65, 0x72, 0x0a, 0x09, 0x66, 0x75, 0x6e, 0x63,
-    0x74, 0x69, 0x6f, 0x6e, 0x20, 0x69, 0x73, 0x4c, 0x65, 0x74, 0x74, 0x65,
-    0x72, 0x28, 0x63, 0x68, 0x61, 0x72, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09,
-    0x69, 0x66, 0x28, 0x21, 0x63, 0x68, 0x61, 0x72, 0x20, 0x7c, 0x7c, 0x20,
-    0x63, 0x68, 0x61, 0x72, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x20,
-    0x21, 0x3d, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72,
-    0x6e, 0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3b, 0x0a, 0x09, 0x09, 0x63,
-    0x6f, 0x6e, 0x73, 0x74, 0x20, 0x63, 0x20, 0x3d, 0x20, 0x63, 0x68, 0x61,
-    0x72, 0x2e, 0x74, 0x6f, 0x4c, 0x6f, 0x77, 0x65, 0x72, 0x43, 0x61, 0x73,
-    0x65, 0x28, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72,
-    0x6e, 0x20, 0x63, 0x20, 0x3e, 0x3d, 0x20, 0x27, 0x61, 0x27, 0x20, 0x26,
-    0x26, 0x20, 0x63, 0x20, 0x3c, 0x3d, 0x20, 0x27, 0x7a, 0x27, 0x3b, 0x0a,
-    0x09, 0x7d, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74,
-    0x69, 0x6f, 0x6e, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x73, 0x65, 0x6e, 0x64,
-    0x69, 0x6e, 0x67, 0x20, 0x6b, 0x65, 0x79, 0x20, 0x65, 0x76, 0x65, 0x6e,
-    0x74, 0x73, 0x09, 0x0a, 0x09, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
+    0x0a, 0x09, 0x09, 0x3c, 0x6c, 0x69, 0x3e, 0x42, 0x52, 0x45, 0x41, 0x4b,
+    0x20, 0x3d, 0x20, 0x46, 0x37, 0x20, 0x6f, 0x72, 0x20, 0x50, 0x61, 0x75,
+    0x73, 0x65, 0x3c, 0x2f, 0x6c, 0x69, 0x3e, 0x0a, 0x09, 0x09, 0x3c, 0x6c,
+    0x69, 0x3e, 0x4f, 0x50, 0x54, 0x49, 0x4f, 0x4e, 0x20, 0x2f, 0x20, 0x53,
+    0x45, 0x4c, 0x45, 0x43, 0x54, 0x20, 0x2f, 0x20, 0x53, 0x54, 0x41, 0x52,
+    0x54, 0x20, 0x3d, 0x20, 0x46, 0x32, 0x20, 0x2f, 0x20, 0x46, 0x33, 0x20,
+    0x2f, 0x20, 0x46, 0x34, 0x3c, 0x2f, 0x6c, 0x69, 0x3e, 0x0a, 0x09, 0x09,
+    0x3c, 0x6c, 0x69, 0x3e, 0x48, 0x45, 0x4c, 0x50, 0x20, 0x3d, 0x20, 0x46,
+    0x31, 0x3c, 0x2f, 0x6c, 0x69, 0x3e, 0x0a, 0x09, 0x09, 0x3c, 0x6c, 0x69,
+    0x3e, 0x43, 0x4c, 0x45, 0x41, 0x52, 0x20, 0x3d, 0x20, 0x46, 0x31, 0x32,
+    0x20, 0x6f, 0x72, 0x20, 0x48, 0x6f, 0x6d, 0x65, 0x3c, 0x2f, 0x6c, 0x69,
+    0x3e, 0x0a, 0x09, 0x09, 0x3c, 0x6c, 0x69, 0x3e, 0x41, 0x54, 0x41, 0x52,
+    0x49, 0x20, 0x28, 0x49, 0x4e, 0x56, 0x45, 0x52, 0x53, 0x45, 0x29, 0x20,
+    0x3d, 0x20, 0x41, 0x6c, 0x74, 0x3c, 0x2f, 0x6c, 0x69, 0x3e, 0x0a, 0x09,
+    0x3c, 0x2f, 0x75, 0x6c, 0x3e, 0x0a, 0x09, 0x3c, 0x73, 0x63, 0x72, 0x69,
+    0x70, 0x74, 0x3e, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x69, 0x6e, 0x69, 0x74,
+    0x20, 0x77, 0x65, 0x62, 0x73, 0x6f, 0x63, 0x6b, 0x65, 0x74, 0x0a, 0x09,
+    0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x77, 0x73, 0x20, 0x3d, 0x20, 0x6e,
+    0x65, 0x77, 0x20, 0x57, 0x65, 0x62, 0x53, 0x6f, 0x63, 0x6b, 0x65, 0x74,
+    0x28, 0x22, 0x77, 0x73, 0x3a, 0x2f, 0x2f, 0x22, 0x20, 0x2b, 0x20, 0x6c,
+    0x6f, 0x63, 0x61, 0x74, 0x69, 0x6f, 0x6e, 0x2e, 0x68, 0x6f, 0x73, 0x74,
+    0x20, 0x2b, 0x20, 0x22, 0x2f, 0x77, 0x73, 0x22, 0x29, 0x3b, 0x0a, 0x09,
+    0x2f, 0x2f, 0x20, 0x63, 0x68, 0x65, 0x63, 0x6b, 0x20, 0x66, 0x6f, 0x72,
+    0x20, 0x6c, 0x65, 0x74, 0x74, 0x65, 0x72, 0x0a, 0x09, 0x66, 0x75, 0x6e,
+    0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x69, 0x73, 0x4c, 0x65, 0x74, 0x74,
+    0x65, 0x72, 0x28, 0x63, 0x68, 0x61, 0x72, 0x29, 0x20, 0x7b, 0x0a, 0x09,
+    0x09, 0x69, 0x66, 0x28, 0x21, 0x63, 0x68, 0x61, 0x72, 0x20, 0x7c, 0x7c,
+    0x20, 0x63, 0x68, 0x61, 0x72, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68,
+    0x20, 0x21, 0x3d, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x72, 0x65, 0x74, 0x75,
+    0x72, 0x6e, 0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3b, 0x0a, 0x09, 0x09,
+    0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x63, 0x20, 0x3d, 0x20, 0x63, 0x68,
+    0x61, 0x72, 0x2e, 0x74, 0x6f, 0x4c, 0x6f, 0x77, 0x65, 0x72, 0x43, 0x61,
+    0x73, 0x65, 0x28, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75,
+    0x72, 0x6e, 0x20, 0x63, 0x20, 0x3e, 0x3d, 0x20, 0x27, 0x61, 0x27, 0x20,
+    0x26, 0x26, 0x20, 0x63, 0x20, 0x3c, 0x3d, 0x20, 0x27, 0x7a, 0x27, 0x3b,
+    0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x62, 0x69, 0x6e, 0x61,
+    0x72, 0x79, 0x20, 0x6b, 0x65, 0x79, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65,
+    0x73, 0x20, 0x6f, 0x66, 0x20, 0x38, 0x20, 0x62, 0x79, 0x74, 0x65, 0x73,
+    0x2c, 0x20, 0x73, 0x65, 0x65, 0x20, 0x57, 0x65, 0x62, 0x4b, 0x42, 0x50,
+    0x72, 0x6f, 0x74, 0x6f, 0x63, 0x6f, 0x6c, 0x2e, 0x68, 0x3a, 0x0a, 0x09,
+    0x2f, 0x2f, 0x20, 0x74, 0x79, 0x70, 0x65, 0x2c, 0x20, 0x66, 0x6c, 0x61,
+    0x67, 0x73, 0x20, 0x28, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x2c,
+    0x20, 0x73, 0x68, 0x69, 0x66, 0x74, 0x2c, 0x20, 0x63, 0x6f, 0x6e, 0x74,
+    0x72, 0x6f, 0x6c, 0x29, 0x2c, 0x20, 0x63, 0x6f, 0x64, 0x65, 0x2c, 0x20,
+    0x70, 0x61, 0x72, 0x61, 0x6d, 0x65, 0x74, 0x65, 0x72, 0x2c, 0x20, 0x74,
+    0x69, 0x6d, 0x65, 0x73, 0x74, 0x61, 0x6d, 0x70, 0x20, 0x28, 0x6d, 0x73,
+    0x29, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x46, 0x52, 0x41,
+    0x4d, 0x45, 0x5f, 0x4b, 0x45, 0x59, 0x20, 0x3d, 0x20, 0x30, 0x2c, 0x20,
+    0x46, 0x52, 0x41, 0x4d, 0x45, 0x5f, 0x43, 0x4f, 0x4e, 0x53, 0x4f, 0x4c,
+    0x45, 0x20, 0x3d, 0x20, 0x31, 0x2c, 0x20, 0x46, 0x52, 0x41, 0x4d, 0x45,
+    0x5f, 0x42, 0x52, 0x45, 0x41, 0x4b, 0x20, 0x3d, 0x20, 0x32, 0x2c, 0x20,
+    0x46, 0x52, 0x41, 0x4d, 0x45, 0x5f, 0x43, 0x4f, 0x4d, 0x4d, 0x41, 0x4e,
+    0x44, 0x20, 0x3d, 0x20, 0x33, 0x3b, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73,
+    0x74, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48, 0x49, 0x46, 0x54, 0x20,
+    0x3d, 0x20, 0x31, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x43, 0x54, 0x52,
+    0x4c, 0x20, 0x3d, 0x20, 0x32, 0x3b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x41,
+    0x74, 0x61, 0x72, 0x69, 0x20, 0x6b, 0x65, 0x79, 0x20, 0x63, 0x6f, 0x64,
+    0x65, 0x20, 0x28, 0x4b, 0x42, 0x43, 0x4f, 0x44, 0x45, 0x29, 0x20, 0x61,
+    0x6e, 0x64, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6d, 0x6f, 0x64, 0x69, 0x66,
+    0x69, 0x65, 0x72, 0x20, 0x6e, 0x65, 0x65, 0x64, 0x65, 0x64, 0x20, 0x66,
+    0x6f, 0x72, 0x20, 0x61, 0x20, 0x6b, 0x65, 0x79, 0x20, 0x6e, 0x61, 0x6d,
+    0x65, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x41, 0x54, 0x41,
+    0x52, 0x49, 0x4b, 0x45, 0x59, 0x53, 0x20, 0x3d, 0x20, 0x7b, 0x0a, 0x09,
+    0x09, 0x27, 0x6c, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x30, 0x30, 0x2c,
+    0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x6a, 0x27, 0x3a, 0x20, 0x5b, 0x30,
+    0x78, 0x30, 0x31, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x3b, 0x27,
+    0x3a, 0x20, 0x5b, 0x30, 0x78, 0x30, 0x32, 0x2c, 0x20, 0x30, 0x5d, 0x2c,
+    0x20, 0x27, 0x3a, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x30, 0x32, 0x2c,
+    0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48, 0x49, 0x46, 0x54, 0x5d, 0x2c,
+    0x0a, 0x09, 0x09, 0x27, 0x6b, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x30,
+    0x35, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x2b, 0x27, 0x3a, 0x20,
+    0x5b, 0x30, 0x78, 0x30, 0x36, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27,
+    0x5c, 0x5c, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x30, 0x36, 0x2c, 0x20,
+    0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48, 0x49, 0x46, 0x54, 0x5d, 0x2c, 0x20,
+    0x27, 0x2a, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x30, 0x37, 0x2c, 0x20,
+    0x30, 0x5d, 0x2c, 0x0a, 0x09, 0x09, 0x27, 0x5e, 0x27, 0x3a, 0x20, 0x5b,
+    0x30, 0x78, 0x30, 0x37, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48,
+    0x49, 0x46, 0x54, 0x5d, 0x2c, 0x20, 0x27, 0x6f, 0x27, 0x3a, 0x20, 0x5b,
+    0x30, 0x78, 0x30, 0x38, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x70,
+    0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x30, 0x61, 0x2c, 0x20, 0x30, 0x5d,
+    0x2c, 0x20, 0x27, 0x75, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x30, 0x62,
+    0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x0a, 0x09, 0x09, 0x27, 0x45, 0x6e, 0x74,
+    0x65, 0x72, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x30, 0x63, 0x2c, 0x20,
+    0x30, 0x5d, 0x2c, 0x20, 0x27, 0x69, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78,
+    0x30, 0x64, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x2d, 0x27, 0x3a,
+    0x20, 0x5b, 0x30, 0x78, 0x30, 0x65, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20,
+    0x27, 0x5f, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x30, 0x65, 0x2c, 0x20,
+    0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48, 0x49, 0x46, 0x54, 0x5d, 0x2c, 0x0a,
+    0x09, 0x09, 0x27, 0x3d, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x30, 0x66,
+    0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x7c, 0x27, 0x3a, 0x20, 0x5b,
+    0x30, 0x78, 0x30, 0x66, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48,
+    0x49, 0x46, 0x54, 0x5d, 0x2c, 0x20, 0x27, 0x76, 0x27, 0x3a, 0x20, 0x5b,
+    0x30, 0x78, 0x31, 0x30, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x46,
+    0x31, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x31, 0x31, 0x2c, 0x20, 0x30,
+    0x5d, 0x2c, 0x0a, 0x09, 0x09, 0x27, 0x63, 0x27, 0x3a, 0x20, 0x5b, 0x30,
+    0x78, 0x31, 0x32, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x62, 0x27,
+    0x3a, 0x20, 0x5b, 0x30, 0x78, 0x31, 0x35, 0x2c, 0x20, 0x30, 0x5d, 0x2c,
+    0x20, 0x27, 0x78, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x31, 0x36, 0x2c,
+    0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x7a, 0x27, 0x3a, 0x20, 0x5b, 0x30,
+    0x78, 0x31, 0x37, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x0a, 0x09, 0x09, 0x27,
+    0x34, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x31, 0x38, 0x2c, 0x20, 0x30,
+    0x5d, 0x2c, 0x20, 0x27, 0x24, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x31,
+    0x38, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48, 0x49, 0x46, 0x54,
+    0x5d, 0x2c, 0x20, 0x27, 0x33, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x31,
+    0x61, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x23, 0x27, 0x3a, 0x20,
+    0x5b, 0x30, 0x78, 0x31, 0x61, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x53,
+    0x48, 0x49, 0x46, 0x54, 0x5d, 0x2c, 0x0a, 0x09, 0x09, 0x27, 0x36, 0x27,
+    0x3a, 0x20, 0x5b, 0x30, 0x78, 0x31, 0x62, 0x2c, 0x20, 0x30, 0x5d, 0x2c,
+    0x20, 0x27, 0x26, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x31, 0x62, 0x2c,
+    0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48, 0x49, 0x46, 0x54, 0x5d, 0x2c,
+    0x20, 0x27, 0x45, 0x73, 0x63, 0x61, 0x70, 0x65, 0x27, 0x3a, 0x20, 0x5b,
+    0x30, 0x78, 0x31, 0x63, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x35,
+    0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x31, 0x64, 0x2c, 0x20, 0x30, 0x5d,
+    0x2c, 0x0a, 0x09, 0x09, 0x27, 0x25, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78,
+    0x31, 0x64, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48, 0x49, 0x46,
+    0x54, 0x5d, 0x2c, 0x20, 0x27, 0x32, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78,
+    0x31, 0x65, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x22, 0x27, 0x3a,
+    0x20, 0x5b, 0x30, 0x78, 0x31, 0x65, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f,
+    0x53, 0x48, 0x49, 0x46, 0x54, 0x5d, 0x2c, 0x20, 0x27, 0x31, 0x27, 0x3a,
+    0x20, 0x5b, 0x30, 0x78, 0x31, 0x66, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x0a,
+    0x09, 0x09, 0x27, 0x21, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x31, 0x66,
+    0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48, 0x49, 0x46, 0x54, 0x5d,
+    0x2c, 0x20, 0x27, 0x2c, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x32, 0x30,
+    0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x5b, 0x27, 0x3a, 0x20, 0x5b,
+    0x30, 0x78, 0x32, 0x30, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48,
+    0x49, 0x46, 0x54, 0x5d, 0x2c, 0x20, 0x27, 0x20, 0x27, 0x3a, 0x20, 0x5b,
+    0x30, 0x78, 0x32, 0x31, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x0a, 0x09, 0x09,
+    0x27, 0x2e, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x32, 0x32, 0x2c, 0x20,
+    0x30, 0x5d, 0x2c, 0x20, 0x27, 0x5d, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78,
+    0x32, 0x32, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48, 0x49, 0x46,
+    0x54, 0x5d, 0x2c, 0x20, 0x27, 0x6e, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78,
+    0x32, 0x33, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x6d, 0x27, 0x3a,
+    0x20, 0x5b, 0x30, 0x78, 0x32, 0x35, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x0a,
+    0x09, 0x09, 0x27, 0x2f, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x32, 0x36,
+    0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x3f, 0x27, 0x3a, 0x20, 0x5b,
+    0x30, 0x78, 0x32, 0x36, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48,
+    0x49, 0x46, 0x54, 0x5d, 0x2c, 0x20, 0x27, 0x41, 0x6c, 0x74, 0x27, 0x3a,
+    0x20, 0x5b, 0x30, 0x78, 0x32, 0x37, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20,
+    0x27, 0x72, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x32, 0x38, 0x2c, 0x20,
+    0x30, 0x5d, 0x2c, 0x0a, 0x09, 0x09, 0x27, 0x65, 0x27, 0x3a, 0x20, 0x5b,
+    0x30, 0x78, 0x32, 0x61, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x79,
+    0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x32, 0x62, 0x2c, 0x20, 0x30, 0x5d,
+    0x2c, 0x20, 0x27, 0x54, 0x61, 0x62, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78,
+    0x32, 0x63, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x74, 0x27, 0x3a,
+    0x20, 0x5b, 0x30, 0x78, 0x32, 0x64, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x0a,
+    0x09, 0x09, 0x27, 0x77, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x32, 0x65,
+    0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x71, 0x27, 0x3a, 0x20, 0x5b,
+    0x30, 0x78, 0x32, 0x66, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x39,
+    0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x33, 0x30, 0x2c, 0x20, 0x30, 0x5d,
+    0x2c, 0x20, 0x27, 0x28, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x33, 0x30,
+    0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48, 0x49, 0x46, 0x54, 0x5d,
+    0x2c, 0x0a, 0x09, 0x09, 0x27, 0x30, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78,
+    0x33, 0x32, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x29, 0x27, 0x3a,
+    0x20, 0x5b, 0x30, 0x78, 0x33, 0x32, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f,
+    0x53, 0x48, 0x49, 0x46, 0x54, 0x5d, 0x2c, 0x20, 0x27, 0x37, 0x27, 0x3a,
+    0x20, 0x5b, 0x30, 0x78, 0x33, 0x33, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20,
+    0x22, 0x27, 0x22, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x33, 0x33, 0x2c, 0x20,
+    0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48, 0x49, 0x46, 0x54, 0x5d, 0x2c, 0x0a,
+    0x09, 0x09, 0x27, 0x42, 0x61, 0x63, 0x6b, 0x73, 0x70, 0x61, 0x63, 0x65,
+    0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x33, 0x34, 0x2c, 0x20, 0x30, 0x5d,
+    0x2c, 0x20, 0x27, 0x44, 0x65, 0x6c, 0x65, 0x74, 0x65, 0x27, 0x3a, 0x20,
+    0x5b, 0x30, 0x78, 0x33, 0x34, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x43,
+    0x54, 0x52, 0x4c, 0x5d, 0x2c, 0x20, 0x27, 0x38, 0x27, 0x3a, 0x20, 0x5b,
+    0x30, 0x78, 0x33, 0x35, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x0a, 0x09, 0x09,
+    0x27, 0x40, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x33, 0x35, 0x2c, 0x20,
+    0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48, 0x49, 0x46, 0x54, 0x5d, 0x2c, 0x20,
+    0x27, 0x3c, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x33, 0x36, 0x2c, 0x20,
+    0x30, 0x5d, 0x2c, 0x20, 0x27, 0x48, 0x6f, 0x6d, 0x65, 0x27, 0x3a, 0x20,
+    0x5b, 0x30, 0x78, 0x33, 0x36, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x53,
+    0x48, 0x49, 0x46, 0x54, 0x5d, 0x2c, 0x0a, 0x09, 0x09, 0x27, 0x46, 0x31,
+    0x32, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x33, 0x36, 0x2c, 0x20, 0x4d,
+    0x4f, 0x44, 0x5f, 0x53, 0x48, 0x49, 0x46, 0x54, 0x5d, 0x2c, 0x20, 0x27,
+    0x3e, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x33, 0x37, 0x2c, 0x20, 0x30,
+    0x5d, 0x2c, 0x20, 0x27, 0x49, 0x6e, 0x73, 0x65, 0x72, 0x74, 0x27, 0x3a,
+    0x20, 0x5b, 0x30, 0x78, 0x33, 0x37, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f,
+    0x43, 0x54, 0x52, 0x4c, 0x5d, 0x2c, 0x0a, 0x09, 0x09, 0x27, 0x66, 0x27,
+    0x3a, 0x20, 0x5b, 0x30, 0x78, 0x33, 0x38, 0x2c, 0x20, 0x30, 0x5d, 0x2c,
+    0x20, 0x27, 0x68, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x33, 0x39, 0x2c,
+    0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x64, 0x27, 0x3a, 0x20, 0x5b, 0x30,
+    0x78, 0x33, 0x61, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x43, 0x61,
+    0x70, 0x73, 0x6c, 0x6f, 0x63, 0x6b, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78,
+    0x33, 0x63, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x0a, 0x09, 0x09, 0x27, 0x43,
+    0x61, 0x70, 0x73, 0x4c, 0x6f, 0x63, 0x6b, 0x27, 0x3a, 0x20, 0x5b, 0x30,
+    0x78, 0x33, 0x63, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x67, 0x27,
+    0x3a, 0x20, 0x5b, 0x30, 0x78, 0x33, 0x64, 0x2c, 0x20, 0x30, 0x5d, 0x2c,
+    0x20, 0x27, 0x73, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x33, 0x65, 0x2c,
+    0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x61, 0x27, 0x3a, 0x20, 0x5b, 0x30,
+    0x78, 0x33, 0x66, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x0a, 0x09, 0x09, 0x27,
+    0x41, 0x72, 0x72, 0x6f, 0x77, 0x55, 0x70, 0x27, 0x3a, 0x20, 0x5b, 0x30,
+    0x78, 0x30, 0x65, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x43, 0x54, 0x52,
+    0x4c, 0x5d, 0x2c, 0x20, 0x27, 0x41, 0x72, 0x72, 0x6f, 0x77, 0x44, 0x6f,
+    0x77, 0x6e, 0x27, 0x3a, 0x20, 0x5b, 0x30, 0x78, 0x30, 0x66, 0x2c, 0x20,
+    0x4d, 0x4f, 0x44, 0x5f, 0x43, 0x54, 0x52, 0x4c, 0x5d, 0x2c, 0x0a, 0x09,
+    0x09, 0x27, 0x41, 0x72, 0x72, 0x6f, 0x77, 0x4c, 0x65, 0x66, 0x74, 0x27,
+    0x3a, 0x20, 0x5b, 0x30, 0x78, 0x30, 0x36, 0x2c, 0x20, 0x4d, 0x4f, 0x44,
+    0x5f, 0x43, 0x54, 0x52, 0x4c, 0x5d, 0x2c, 0x20, 0x27, 0x41, 0x72, 0x72,
+    0x6f, 0x77, 0x52, 0x69, 0x67, 0x68, 0x74, 0x27, 0x3a, 0x20, 0x5b, 0x30,
+    0x78, 0x30, 0x37, 0x2c, 0x20, 0x4d, 0x4f, 0x44, 0x5f, 0x43, 0x54, 0x52,
+    0x4c, 0x5d, 0x0a, 0x09, 0x7d, 0x3b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x63,
+    0x6f, 0x6e, 0x73, 0x6f, 0x6c, 0x65, 0x20, 0x6b, 0x65, 0x79, 0x73, 0x3a,
+    0x20, 0x4f, 0x50, 0x54, 0x49, 0x4f, 0x4e, 0x2c, 0x20, 0x53, 0x45, 0x4c,
+    0x45, 0x43, 0x54, 0x2c, 0x20, 0x53, 0x54, 0x41, 0x52, 0x54, 0x0a, 0x09,
+    0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x43, 0x4f, 0x4e, 0x53, 0x4f, 0x4c,
+    0x45, 0x4b, 0x45, 0x59, 0x53, 0x20, 0x3d, 0x20, 0x7b, 0x20, 0x27, 0x46,
+    0x32, 0x27, 0x3a, 0x20, 0x34, 0x2c, 0x20, 0x27, 0x46, 0x33, 0x27, 0x3a,
+    0x20, 0x32, 0x2c, 0x20, 0x27, 0x46, 0x34, 0x27, 0x3a, 0x20, 0x31, 0x20,
+    0x7d, 0x3b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x65, 0x78, 0x74, 0x65, 0x72,
+    0x6e, 0x61, 0x6c, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x61, 0x6e, 0x64, 0x73,
+    0x20, 0x28, 0x45, 0x78, 0x74, 0x43, 0x6d, 0x64, 0x29, 0x20, 0x61, 0x6e,
+    0x64, 0x20, 0x74, 0x68, 0x65, 0x69, 0x72, 0x20, 0x70, 0x61, 0x72, 0x61,
+    0x6d, 0x65, 0x74, 0x65, 0x72, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74,
+    0x20, 0x43, 0x4f, 0x4d, 0x4d, 0x41, 0x4e, 0x44, 0x53, 0x20, 0x3d, 0x20,
+    0x7b, 0x0a, 0x09, 0x09, 0x27, 0x4c, 0x4f, 0x41, 0x44, 0x27, 0x3a, 0x20,
+    0x5b, 0x31, 0x31, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x53, 0x41,
+    0x56, 0x45, 0x27, 0x3a, 0x20, 0x5b, 0x33, 0x31, 0x2c, 0x20, 0x30, 0x5d,
+    0x2c, 0x20, 0x27, 0x4c, 0x49, 0x53, 0x54, 0x27, 0x3a, 0x20, 0x5b, 0x33,
+    0x32, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x52, 0x45, 0x53, 0x45,
+    0x54, 0x27, 0x3a, 0x20, 0x5b, 0x32, 0x30, 0x2c, 0x20, 0x30, 0x5d, 0x2c,
+    0x0a, 0x09, 0x09, 0x27, 0x50, 0x61, 0x67, 0x65, 0x55, 0x70, 0x27, 0x3a,
+    0x20, 0x5b, 0x31, 0x35, 0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x49,
+    0x4e, 0x43, 0x56, 0x4f, 0x4c, 0x55, 0x4d, 0x45, 0x27, 0x3a, 0x20, 0x5b,
+    0x33, 0x34, 0x2c, 0x20, 0x31, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x44, 0x45,
+    0x43, 0x56, 0x4f, 0x4c, 0x55, 0x4d, 0x45, 0x27, 0x3a, 0x20, 0x5b, 0x33,
+    0x35, 0x2c, 0x20, 0x31, 0x30, 0x5d, 0x2c, 0x0a, 0x09, 0x09, 0x27, 0x4a,
+    0x4f, 0x59, 0x4d, 0x4f, 0x44, 0x45, 0x31, 0x27, 0x3a, 0x20, 0x5b, 0x31,
+    0x2c, 0x20, 0x30, 0x5d, 0x2c, 0x20, 0x27, 0x4a, 0x4f, 0x59, 0x4d, 0x4f,
+    0x44, 0x45, 0x32, 0x27, 0x3a, 0x20, 0x5b, 0x32, 0x2c, 0x20, 0x30, 0x5d,
+    0x0a, 0x09, 0x7d, 0x3b, 0x0a, 0x09, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69,
+    0x6f, 0x6e, 0x20, 0x73, 0x65, 0x6e, 0x64, 0x46, 0x72, 0x61, 0x6d, 0x65,
+    0x28, 0x74, 0x79, 0x70, 0x65, 0x2c, 0x20, 0x66, 0x6c, 0x61, 0x67, 0x73,
+    0x2c, 0x20, 0x63, 0x6f, 0x64, 0x65, 0x2c, 0x20, 0x70, 0x61, 0x72, 0x61,
+    0x6d, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x28, 0x21, 0x77,
+    0x73, 0x20, 0x7c, 0x7c, 0x20, 0x77, 0x73, 0x2e, 0x72, 0x65, 0x61, 0x64,
+    0x79, 0x53, 0x74, 0x61, 0x74, 0x65, 0x20, 0x21, 0x3d, 0x3d, 0x20, 0x57,
+    0x65, 0x62, 0x53, 0x6f, 0x63, 0x6b, 0x65, 0x74, 0x2e, 0x4f, 0x50, 0x45,
+    0x4e, 0x29, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x09,
+    0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x66, 0x72, 0x61, 0x6d, 0x65,
+    0x20, 0x3d, 0x20, 0x6e, 0x65, 0x77, 0x20, 0x44, 0x61, 0x74, 0x61, 0x56,
+    0x69, 0x65, 0x77, 0x28, 0x6e, 0x65, 0x77, 0x20, 0x41, 0x72, 0x72, 0x61,
+    0x79, 0x42, 0x75, 0x66, 0x66, 0x65, 0x72, 0x28, 0x38, 0x29, 0x29, 0x3b,
+    0x0a, 0x09, 0x09, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x2e, 0x73, 0x65, 0x74,
+    0x55, 0x69, 0x6e, 0x74, 0x38, 0x28, 0x30, 0x2c, 0x20, 0x74, 0x79, 0x70,
+    0x65, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x2e,
+    0x73, 0x65, 0x74, 0x55, 0x69, 0x6e, 0x74, 0x38, 0x28, 0x31, 0x2c, 0x20,
+    0x66, 0x6c, 0x61, 0x67, 0x73, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x66, 0x72,
+    0x61, 0x6d, 0x65, 0x2e, 0x73, 0x65, 0x74, 0x55, 0x69, 0x6e, 0x74, 0x38,
+    0x28, 0x32, 0x2c, 0x20, 0x63, 0x6f, 0x64, 0x65, 0x29, 0x3b, 0x0a, 0x09,
+    0x09, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x2e, 0x73, 0x65, 0x74, 0x55, 0x69,
+    0x6e, 0x74, 0x38, 0x28, 0x33, 0x2c, 0x20, 0x70, 0x61, 0x72, 0x61, 0x6d,
+    0x29, 0x3b, 0x0a, 0x09, 0x09, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x2e, 0x73,
+    0x65, 0x74, 0x55, 0x69, 0x6e, 0x74, 0x33, 0x32, 0x28, 0x34, 0x2c, 0x20,
+    0x4d, 0x61, 0x74, 0x68, 0x2e, 0x66, 0x6c, 0x6f, 0x6f, 0x72, 0x28, 0x70,
+    0x65, 0x72, 0x66, 0x6f, 0x72, 0x6d, 0x61, 0x6e, 0x63, 0x65, 0x2e, 0x6e,
+    0x6f, 0x77, 0x28, 0x29, 0x29, 0x20, 0x3e, 0x3e, 0x3e, 0x20, 0x30, 0x2c,
+    0x20, 0x74, 0x72, 0x75, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x77, 0x73,
+    0x2e, 0x73, 0x65, 0x6e, 0x64, 0x28, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x2e,
+    0x62, 0x75, 0x66, 0x66, 0x65, 0x72, 0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x0a,
+    0x09, 0x2f, 0x2f, 0x20, 0x73, 0x65, 0x6e, 0x64, 0x20, 0x74, 0x68, 0x65,
+    0x20, 0x66, 0x72, 0x61, 0x6d, 0x65, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x61,
+    0x20, 0x6b, 0x65, 0x79, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x20, 0x28, 0x4b,
+    0x65, 0x79, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74,
+    0x2e, 0x6b, 0x65, 0x79, 0x20, 0x6f, 0x72, 0x20, 0x64, 0x61, 0x74, 0x61,
+    0x2d, 0x63, 0x68, 0x61, 0x72, 0x29, 0x0a, 0x09, 0x66, 0x75, 0x6e, 0x63,
+    0x74, 0x69, 0x6f, 0x6e, 0x20, 0x73, 0x65, 0x6e, 0x64, 0x4b, 0x65, 0x79,
+    0x28, 0x74, 0x79, 0x70, 0x65, 0x2c, 0x20, 0x6e, 0x61, 0x6d, 0x65, 0x2c,
+    0x20, 0x73, 0x68, 0x69, 0x66, 0x74, 0x2c, 0x20, 0x63, 0x74, 0x72, 0x6c,
+    0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20,
+    0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x20, 0x3d, 0x20, 0x28, 0x74,
+    0x79, 0x70, 0x65, 0x20, 0x3d, 0x3d, 0x3d, 0x20, 0x27, 0x6b, 0x65, 0x79,
+    0x2d, 0x64, 0x6f, 0x77, 0x6e, 0x27, 0x29, 0x20, 0x3f, 0x20, 0x31, 0x20,
+    0x3a, 0x20, 0x30, 0x3b, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x28, 0x6e, 0x61,
+    0x6d, 0x65, 0x20, 0x69, 0x6e, 0x20, 0x43, 0x4f, 0x4d, 0x4d, 0x41, 0x4e,
+    0x44, 0x53, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x66, 0x28,
+    0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x29, 0x20, 0x73, 0x65, 0x6e,
+    0x64, 0x46, 0x72, 0x61, 0x6d, 0x65, 0x28, 0x46, 0x52, 0x41, 0x4d, 0x45,
+    0x5f, 0x43, 0x4f, 0x4d, 0x4d, 0x41, 0x4e, 0x44, 0x2c, 0x20, 0x31, 0x2c,
+    0x20, 0x43, 0x4f, 0x4d, 0x4d, 0x41, 0x4e, 0x44, 0x53, 0x5b, 0x6e, 0x61,
+    0x6d, 0x65, 0x5d, 0x5b, 0x30, 0x5d, 0x2c, 0x20, 0x43, 0x4f, 0x4d, 0x4d,
+    0x41, 0x4e, 0x44, 0x53, 0x5b, 0x6e, 0x61, 0x6d, 0x65, 0x5d, 0x5b, 0x31,
+    0x5d, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72,
+    0x6e, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x28,
+    0x6e, 0x61, 0x6d, 0x65, 0x20, 0x69, 0x6e, 0x20, 0x43, 0x4f, 0x4e, 0x53,
+    0x4f, 0x4c, 0x45, 0x4b, 0x45, 0x59, 0x53, 0x29, 0x20, 0x7b, 0x0a, 0x09,
+    0x09, 0x09, 0x73, 0x65, 0x6e, 0x64, 0x46, 0x72, 0x61, 0x6d, 0x65, 0x28,
+    0x46, 0x52, 0x41, 0x4d, 0x45, 0x5f, 0x43, 0x4f, 0x4e, 0x53, 0x4f, 0x4c,
+    0x45, 0x2c, 0x20, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x2c, 0x20,
+    0x43, 0x4f, 0x4e, 0x53, 0x4f, 0x4c, 0x45, 0x4b, 0x45, 0x59, 0x53, 0x5b,
+    0x6e, 0x61, 0x6d, 0x65, 0x5d, 0x2c, 0x20, 0x30, 0x29, 0x3b, 0x0a, 0x09,
+    0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x09, 0x09,
+    0x7d, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x28, 0x6e, 0x61, 0x6d, 0x65, 0x20,
+    0x3d, 0x3d, 0x3d, 0x20, 0x27, 0x46, 0x37, 0x27, 0x20, 0x7c, 0x7c, 0x20,
+    0x6e, 0x61, 0x6d, 0x65, 0x20, 0x3d, 0x3d, 0x3d, 0x20, 0x27, 0x50, 0x61,
+    0x75, 0x73, 0x65, 0x27, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x73,
+    0x65, 0x6e, 0x64, 0x46, 0x72, 0x61, 0x6d, 0x65, 0x28, 0x46, 0x52, 0x41,
+    0x4d, 0x45, 0x5f, 0x42, 0x52, 0x45, 0x41, 0x4b, 0x2c, 0x20, 0x70, 0x72,
+    0x65, 0x73, 0x73, 0x65, 0x64, 0x2c, 0x20, 0x30, 0x2c, 0x20, 0x30, 0x29,
+    0x3b, 0x0a, 0x09, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b,
+    0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74,
+    0x20, 0x6c, 0x65, 0x74, 0x74, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x69, 0x73,
+    0x4c, 0x65, 0x74, 0x74, 0x65, 0x72, 0x28, 0x6e, 0x61, 0x6d, 0x65, 0x29,
+    0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6b, 0x65,
+    0x79, 0x20, 0x3d, 0x20, 0x41, 0x54, 0x41, 0x52, 0x49, 0x4b, 0x45, 0x59,
+    0x53, 0x5b, 0x6c, 0x65, 0x74, 0x74, 0x65, 0x72, 0x20, 0x3f, 0x20, 0x6e,
+    0x61, 0x6d, 0x65, 0x2e, 0x74, 0x6f, 0x4c, 0x6f, 0x77, 0x65, 0x72, 0x43,
+    0x61, 0x73, 0x65, 0x28, 0x29, 0x20, 0x3a, 0x20, 0x6e, 0x61, 0x6d, 0x65,
+    0x5d, 0x3b, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x28, 0x21, 0x6b, 0x65, 0x79,
+    0x29, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x09, 0x09,
+    0x6c, 0x65, 0x74, 0x20, 0x66, 0x6c, 0x61, 0x67, 0x73, 0x20, 0x3d, 0x20,
+    0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x3b, 0x0a, 0x09, 0x09, 0x69,
+    0x66, 0x28, 0x28, 0x6b, 0x65, 0x79, 0x5b, 0x31, 0x5d, 0x20, 0x26, 0x20,
+    0x4d, 0x4f, 0x44, 0x5f, 0x53, 0x48, 0x49, 0x46, 0x54, 0x29, 0x20, 0x7c,
+    0x7c, 0x20, 0x28, 0x73, 0x68, 0x69, 0x66, 0x74, 0x20, 0x26, 0x26, 0x20,
+    0x6c, 0x65, 0x74, 0x74, 0x65, 0x72, 0x29, 0x29, 0x20, 0x66, 0x6c, 0x61,
+    0x67, 0x73, 0x20, 0x7c, 0x3d, 0x20, 0x32, 0x3b, 0x0a, 0x09, 0x09, 0x69,
+    0x66, 0x28, 0x28, 0x6b, 0x65, 0x79, 0x5b, 0x31, 0x5d, 0x20, 0x26, 0x20,
+    0x4d, 0x4f, 0x44, 0x5f, 0x43, 0x54, 0x52, 0x4c, 0x29, 0x20, 0x7c, 0x7c,
+    0x20, 0x63, 0x74, 0x72, 0x6c, 0x29, 0x20, 0x66, 0x6c, 0x61, 0x67, 0x73,
+    0x20, 0x7c, 0x3d, 0x20, 0x34, 0x3b, 0x0a, 0x09, 0x09, 0x73, 0x65, 0x6e,
+    0x64, 0x46, 0x72, 0x61, 0x6d, 0x65, 0x28, 0x46, 0x52, 0x41, 0x4d, 0x45,
+    0x5f, 0x4b, 0x45, 0x59, 0x2c, 0x20, 0x66, 0x6c, 0x61, 0x67, 0x73, 0x2c,
+    0x20, 0x6b, 0x65, 0x79, 0x5b, 0x30, 0x5d, 0x2c, 0x20, 0x30, 0x29, 0x3b,
+    0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x66, 0x75, 0x6e, 0x63,
+    0x74, 0x69, 0x6f, 0x6e, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x73, 0x65, 0x6e,
+    0x64, 0x69, 0x6e, 0x67, 0x20, 0x6b, 0x65, 0x79, 0x20, 0x65, 0x76, 0x65,
+    0x6e, 0x74, 0x73, 0x0a, 0x09, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
     0x6e, 0x20, 0x73, 0x65, 0x6e, 0x64, 0x4b, 0x65, 0x79, 0x54, 0x6f, 0x57,
     0x53, 0x28, 0x74, 0x79, 0x70, 0x65, 0x2c, 0x20, 0x65, 0x29, 0x20, 0x7b,
-    0x0a, 0x09, 0x09, 0x69, 0x66, 0x28, 0x21, 0x77, 0x73, 0x20, 0x7c, 0x7c,
-    0x20, 0x77, 0x73, 0x2e, 0x72, 0x65, 0x61, 0x64, 0x79, 0x53, 0x74, 0x61,
-    0x74, 0x65, 0x20, 0x21, 0x3d, 0x3d, 0x20, 0x57, 0x65, 0x62, 0x53, 0x6f,
-    0x63, 0x6b, 0x65, 0x74, 0x2e, 0x4f, 0x50, 0x45, 0x4e, 0x29, 0x20, 0x72,
-    0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x09, 0x09, 0x6c, 0x65, 0x74,
-    0x20, 0x73, 0x68, 0x69, 0x66, 0x74, 0x20, 0x3d, 0x20, 0x65, 0x2e, 0x73,
-    0x68, 0x69, 0x66, 0x74, 0x4b, 0x65, 0x79, 0x20, 0x7c, 0x7c, 0x20, 0x66,
-    0x61, 0x6c, 0x73, 0x65, 0x3b, 0x0a, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x69,
-    0x66, 0x20, 0x69, 0x74, 0x20, 0x6e, 0x6f, 0x74, 0x20, 0x61, 0x20, 0x6c,
-    0x65, 0x74, 0x74, 0x65, 0x72, 0x2c, 0x20, 0x74, 0x68, 0x61, 0x6e, 0x20,
-    0x69, 0x67, 0x6e, 0x6f, 0x72, 0x65, 0x20, 0x73, 0x68, 0x69, 0x66, 0x74,
-    0x0a, 0x09, 0x09, 0x69, 0x66, 0x28, 0x21, 0x69, 0x73, 0x4c, 0x65, 0x74,
-    0x74, 0x65, 0x72, 0x28, 0x65, 0x2e, 0x6b, 0x65, 0x79, 0x29, 0x29, 0x20,
-    0x73, 0x68, 0x69, 0x66, 0x74, 0x20, 0x3d, 0x20, 0x66, 0x61, 0x6c, 0x73,
-    0x65, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x70,
-    0x61, 0x79, 0x6c, 0x6f, 0x61, 0x64, 0x20, 0x3d, 0x20, 0x7b, 0x0a, 0x09,
-    0x09, 0x09, 0x63, 0x68, 0x61, 0x72, 0x73, 0x3a, 0x20, 0x65, 0x2e, 0x6b,
-    0x65, 0x79, 0x2c, 0x0a, 0x09, 0x09, 0x09, 0x6d, 0x6f, 0x64, 0x69, 0x66,
-    0x69, 0x65, 0x72, 0x73, 0x3a, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09,
-    0x73, 0x68, 0x69, 0x66, 0x74, 0x3a, 0x20, 0x73, 0x68, 0x69, 0x66, 0x74,
-    0x2c, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x63, 0x74, 0x72, 0x6c, 0x3a, 0x20,
-    0x65, 0x2e, 0x63, 0x74, 0x72, 0x6c, 0x4b, 0x65, 0x79, 0x20, 0x7c, 0x7c,
-    0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x2c, 0x0a, 0x09, 0x09, 0x09, 0x09,
-    0x63, 0x6f, 0x6d, 0x6d, 0x6f, 0x64, 0x6f, 0x72, 0x65, 0x3a, 0x20, 0x65,
-    0x2e, 0x6d, 0x65, 0x74, 0x61, 0x4b, 0x65, 0x79, 0x20, 0x7c, 0x7c, 0x20,
-    0x66, 0x61, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09,
-    0x09, 0x7d, 0x3b, 0x0a, 0x09, 0x09, 0x77, 0x73, 0x2e, 0x73, 0x65, 0x6e,
-    0x64, 0x28, 0x4a, 0x53, 0x4f, 0x4e, 0x2e, 0x73, 0x74, 0x72, 0x69, 0x6e,
-    0x67, 0x69, 0x66, 0x79, 0x28, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x74, 0x79,
-    0x70, 0x65, 0x3a, 0x20, 0x74, 0x79, 0x70, 0x65, 0x2c, 0x0a, 0x09, 0x09,
-    0x09, 0x6b, 0x65, 0x79, 0x73, 0x3a, 0x20, 0x70, 0x61, 0x79, 0x6c, 0x6f,
-    0x61, 0x64, 0x0a, 0x09, 0x09, 0x7d, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x7d,
-    0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
-    0x6e, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x73, 0x65, 0x6e, 0x64, 0x69, 0x6e,
-    0x67, 0x20, 0x6d, 0x6f, 0x75, 0x73, 0x65, 0x20, 0x65, 0x76, 0x65, 0x6e,
-    0x74, 0x73, 0x0a, 0x09, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e,
-    0x20, 0x73, 0x65, 0x6e, 0x64, 0x4d, 0x6f, 0x75, 0x73, 0x65, 0x4b, 0x65,
-    0x79, 0x54, 0x6f, 0x57, 0x53, 0x28, 0x6f, 0x62, 0x6a, 0x29, 0x20, 0x7b,
-    0x0a, 0x09, 0x09, 0x69, 0x66, 0x28, 0x21, 0x77, 0x73, 0x20, 0x7c, 0x7c,
-    0x20, 0x77, 0x73, 0x2e, 0x72, 0x65, 0x61, 0x64, 0x79, 0x53, 0x74, 0x61,
-    0x74, 0x65, 0x20, 0x21, 0x3d, 0x3d, 0x20, 0x57, 0x65, 0x62, 0x53, 0x6f,
-    0x63, 0x6b, 0x65, 0x74, 0x2e, 0x4f, 0x50, 0x45, 0x4e, 0x29, 0x20, 0x72,
-    0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x09, 0x09, 0x77, 0x73, 0x2e,
-    0x73, 0x65, 0x6e, 0x64, 0x28, 0x4a, 0x53, 0x4f, 0x4e, 0x2e, 0x73, 0x74,
-    0x72, 0x69, 0x6e, 0x67, 0x69, 0x66, 0x79, 0x28, 0x6f, 0x62, 0x6a, 0x29,
-    0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x73, 0x70,
-    0x6c, 0x69, 0x74, 0x20, 0x69, 0x74, 0x65, 0x6d, 0x73, 0x20, 0x69, 0x6e,
-    0x74, 0x6f, 0x20, 0x61, 0x20, 0x6c, 0x69, 0x73, 0x74, 0x20, 0x28, 0x73,
-    0x65, 0x70, 0x61, 0x74, 0x6f, 0x72, 0x3a, 0x20, 0x70, 0x69, 0x70, 0x65,
-    0x29, 0x0a, 0x09, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20,
-    0x61, 0x74, 0x74, 0x72, 0x4c, 0x69, 0x73, 0x74, 0x28, 0x65, 0x6c, 0x2c,
-    0x20, 0x61, 0x74, 0x74, 0x72, 0x4e, 0x61, 0x6d, 0x65, 0x29, 0x20, 0x7b,
-    0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x20, 0x3d,
-    0x20, 0x65, 0x6c, 0x2e, 0x67, 0x65, 0x74, 0x41, 0x74, 0x74, 0x72, 0x69,
-    0x62, 0x75, 0x74, 0x65, 0x28, 0x61, 0x74, 0x74, 0x72, 0x4e, 0x61, 0x6d,
-    0x65, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x28, 0x21, 0x76, 0x29,
-    0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x5b, 0x5d, 0x3b, 0x0a,
-    0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x2e, 0x73,
-    0x70, 0x6c, 0x69, 0x74, 0x28, 0x27, 0x7c, 0x27, 0x29, 0x20, 0x2f, 0x2f,
-    0x20, 0x6d, 0x75, 0x6c, 0x74, 0x69, 0x70, 0x6c, 0x65, 0x20, 0x76, 0x61,
-    0x6c, 0x75, 0x65, 0x73, 0x0a, 0x09, 0x09, 0x09, 0x2e, 0x66, 0x69, 0x6c,
-    0x74, 0x65, 0x72, 0x28, 0x73, 0x20, 0x3d, 0x3e, 0x20, 0x73, 0x2e, 0x6c,
-    0x65, 0x6e, 0x67, 0x74, 0x68, 0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09,
-    0x2f, 0x2f, 0x20, 0x66, 0x69, 0x6e, 0x64, 0x20, 0x6b, 0x65, 0x79, 0x20,
-    0x62, 0x79, 0x20, 0x63, 0x68, 0x61, 0x72, 0x20, 0x64, 0x65, 0x73, 0x63,
-    0x72, 0x69, 0x70, 0x74, 0x69, 0x6f, 0x6e, 0x0a, 0x09, 0x66, 0x75, 0x6e,
-    0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x66, 0x69, 0x6e, 0x64, 0x4b, 0x65,
-    0x79, 0x73, 0x42, 0x79, 0x43, 0x68, 0x61, 0x72, 0x28, 0x63, 0x68, 0x29,
-    0x20, 0x7b, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x28, 0x21, 0x63, 0x68, 0x29,
-    0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x5b, 0x5d, 0x3b, 0x0a,
-    0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x61, 0x6c, 0x6c, 0x20,
-    0x3d, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x71,
-    0x75, 0x65, 0x72, 0x79, 0x53, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72,
-    0x41, 0x6c, 0x6c, 0x28, 0x27, 0x5b, 0x64, 0x61, 0x74, 0x61, 0x2d, 0x63,
-    0x68, 0x61, 0x72, 0x5d, 0x27, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f,
-    0x6e, 0x73, 0x74, 0x20, 0x63, 0x55, 0x70, 0x70, 0x65, 0x72, 0x20, 0x3d,
-    0x20, 0x63, 0x68, 0x2e, 0x74, 0x6f, 0x55, 0x70, 0x70, 0x65, 0x72, 0x43,
-    0x61, 0x73, 0x65, 0x28, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e,
-    0x73, 0x74, 0x20, 0x72, 0x65, 0x73, 0x20, 0x3d, 0x20, 0x5b, 0x5d, 0x3b,
-    0x0a, 0x09, 0x09, 0x66, 0x6f, 0x72, 0x28, 0x63, 0x6f, 0x6e, 0x73, 0x74,
-    0x20, 0x65, 0x6c, 0x20, 0x6f, 0x66, 0x20, 0x61, 0x6c, 0x6c, 0x29, 0x20,
-    0x7b, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6c,
-    0x69, 0x73, 0x74, 0x20, 0x3d, 0x20, 0x61, 0x74, 0x74, 0x72, 0x4c, 0x69,
-    0x73, 0x74, 0x28, 0x65, 0x6c, 0x2c, 0x20, 0x27, 0x64, 0x61, 0x74, 0x61,
-    0x2d, 0x63, 0x68, 0x61, 0x72, 0x27, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09,
-    0x66, 0x6f, 0x72, 0x28, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x65, 0x6e,
-    0x74, 0x72, 0x79, 0x20, 0x6f, 0x66, 0x20, 0x6c, 0x69, 0x73, 0x74, 0x29,
-    0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x69, 0x66, 0x28, 0x65, 0x6e,
-    0x74, 0x72, 0x79, 0x2e, 0x74, 0x6f, 0x55, 0x70, 0x70, 0x65, 0x72, 0x43,
-    0x61, 0x73, 0x65, 0x28, 0x29, 0x20, 0x3d, 0x3d, 0x3d, 0x20, 0x63, 0x55,
-    0x70, 0x70, 0x65, 0x72, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09,
-    0x09, 0x72, 0x65, 0x73, 0x2e, 0x70, 0x75, 0x73, 0x68, 0x28, 0x65, 0x6c,
-    0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x09, 0x62, 0x72, 0x65, 0x61,
-    0x6b, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x09,
-    0x7d, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75,
-    0x72, 0x6e, 0x20, 0x72, 0x65, 0x73, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09,
-    0x2f, 0x2f, 0x20, 0x6d, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x20, 0x63,
-    0x6f, 0x6d, 0x70, 0x6f, 0x73, 0x69, 0x74, 0x6f, 0x72, 0x20, 0x66, 0x6f,
-    0x72, 0x20, 0x6d, 0x6f, 0x75, 0x73, 0x65, 0x20, 0x63, 0x6c, 0x69, 0x63,
-    0x6b, 0x73, 0x3a, 0x20, 0x63, 0x68, 0x65, 0x63, 0x6b, 0x20, 0x77, 0x68,
-    0x69, 0x63, 0x68, 0x20, 0x63, 0x68, 0x61, 0x72, 0x61, 0x63, 0x74, 0x65,
-    0x72, 0x20, 0x69, 0x73, 0x20, 0x73, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x65,
-    0x64, 0x0a, 0x09, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20,
-    0x62, 0x75, 0x69, 0x6c, 0x64, 0x4b, 0x65, 0x79, 0x4d, 0x65, 0x73, 0x73,
-    0x61, 0x67, 0x65, 0x46, 0x72, 0x6f, 0x6d, 0x45, 0x6c, 0x65, 0x6d, 0x65,
-    0x6e, 0x74, 0x28, 0x65, 0x6c, 0x2c, 0x20, 0x74, 0x79, 0x70, 0x65, 0x2c,
-    0x20, 0x65, 0x76, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x6c, 0x65, 0x74,
-    0x20, 0x73, 0x68, 0x69, 0x66, 0x74, 0x20, 0x3d, 0x20, 0x65, 0x76, 0x2e,
-    0x73, 0x68, 0x69, 0x66, 0x74, 0x4b, 0x65, 0x79, 0x3b, 0x0a, 0x09, 0x09,
-    0x6c, 0x65, 0x74, 0x20, 0x63, 0x68, 0x61, 0x72, 0x20, 0x3d, 0x20, 0x22,
-    0x22, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x65,
-    0x6c, 0x69, 0x73, 0x74, 0x20, 0x3d, 0x20, 0x61, 0x74, 0x74, 0x72, 0x4c,
-    0x69, 0x73, 0x74, 0x28, 0x65, 0x6c, 0x2c, 0x20, 0x27, 0x64, 0x61, 0x74,
-    0x61, 0x2d, 0x63, 0x68, 0x61, 0x72, 0x27, 0x29, 0x3b, 0x0a, 0x09, 0x09,
-    0x69, 0x66, 0x28, 0x65, 0x6c, 0x69, 0x73, 0x74, 0x2e, 0x6c, 0x65, 0x6e,
-    0x67, 0x74, 0x68, 0x20, 0x3d, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x63, 0x68,
-    0x61, 0x72, 0x20, 0x3d, 0x20, 0x65, 0x6c, 0x69, 0x73, 0x74, 0x5b, 0x30,
-    0x5d, 0x3b, 0x0a, 0x09, 0x09, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x69, 0x66,
-    0x28, 0x65, 0x6c, 0x69, 0x73, 0x74, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74,
-    0x68, 0x20, 0x3e, 0x20, 0x31, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09,
-    0x2f, 0x2f, 0x20, 0x69, 0x66, 0x20, 0x73, 0x68, 0x69, 0x66, 0x74, 0x20,
-    0x69, 0x73, 0x20, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x2c, 0x20,
-    0x74, 0x61, 0x6b, 0x65, 0x20, 0x74, 0x68, 0x65, 0x20, 0x66, 0x69, 0x72,
-    0x73, 0x74, 0x20, 0x63, 0x68, 0x61, 0x72, 0x20, 0x61, 0x6e, 0x64, 0x20,
-    0x63, 0x6c, 0x65, 0x61, 0x72, 0x20, 0x73, 0x68, 0x69, 0x66, 0x74, 0x0a,
-    0x09, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x69, 0x66, 0x20, 0x6e, 0x6f, 0x74,
-    0x2c, 0x20, 0x74, 0x61, 0x6b, 0x65, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73,
-    0x65, 0x63, 0x6f, 0x6e, 0x64, 0x20, 0x63, 0x68, 0x61, 0x72, 0x0a, 0x09,
-    0x09, 0x09, 0x69, 0x66, 0x28, 0x65, 0x76, 0x2e, 0x73, 0x68, 0x69, 0x66,
-    0x74, 0x4b, 0x65, 0x79, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09,
-    0x63, 0x68, 0x61, 0x72, 0x20, 0x3d, 0x20, 0x65, 0x6c, 0x69, 0x73, 0x74,
-    0x5b, 0x30, 0x5d, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x73, 0x68, 0x69,
-    0x66, 0x74, 0x20, 0x3d, 0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3b, 0x0a,
-    0x09, 0x09, 0x09, 0x7d, 0x20, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x63, 0x68,
-    0x61, 0x72, 0x20, 0x3d, 0x20, 0x65, 0x6c, 0x69, 0x73, 0x74, 0x5b, 0x31,
-    0x5d, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e,
-    0x73, 0x74, 0x20, 0x63, 0x74, 0x72, 0x6c, 0x20, 0x3d, 0x20, 0x65, 0x76,
-    0x2e, 0x63, 0x74, 0x72, 0x6c, 0x4b, 0x65, 0x79, 0x3b, 0x0a, 0x09, 0x09,
-    0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x6f, 0x64,
-    0x6f, 0x72, 0x65, 0x20, 0x3d, 0x20, 0x65, 0x76, 0x2e, 0x61, 0x6c, 0x74,
-    0x4b, 0x65, 0x79, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74,
-    0x20, 0x6b, 0x65, 0x79, 0x4f, 0x62, 0x6a, 0x20, 0x3d, 0x20, 0x7b, 0x0a,
-    0x09, 0x09, 0x09, 0x63, 0x68, 0x61, 0x72, 0x73, 0x3a, 0x20, 0x63, 0x68,
-    0x61, 0x72, 0x2c, 0x0a, 0x09, 0x09, 0x09, 0x6d, 0x6f, 0x64, 0x69, 0x66,
-    0x69, 0x65, 0x72, 0x73, 0x3a, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09,
-    0x73, 0x68, 0x69, 0x66, 0x74, 0x3a, 0x20, 0x73, 0x68, 0x69, 0x66, 0x74,
-    0x2c, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x63, 0x74, 0x72, 0x6c, 0x3a, 0x20,
-    0x63, 0x74, 0x72, 0x6c, 0x2c, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x63, 0x6f,
-    0x6d, 0x6d, 0x6f, 0x64, 0x6f, 0x72, 0x65, 0x3a, 0x20, 0x63, 0x6f, 0x6d,
-    0x6d, 0x6f, 0x64, 0x6f, 0x72, 0x65, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a,
-    0x09, 0x09, 0x7d, 0x3b, 0x0a, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72,
-    0x6e, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x74, 0x79, 0x70, 0x65, 0x2c,
-    0x0a, 0x09, 0x09, 0x09, 0x6b, 0x65, 0x79, 0x73, 0x3a, 0x20, 0x6b, 0x65,
-    0x79, 0x4f, 0x62, 0x6a, 0x0a, 0x09, 0x09, 0x7d, 0x3b, 0x0a, 0x09, 0x7d,
-    0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x76, 0x69, 0x73, 0x75, 0x61, 0x6c, 0x69,
-    0x7a, 0x65, 0x20, 0x6b, 0x65, 0x79, 0x20, 0x73, 0x74, 0x61, 0x74, 0x65,
-    0x20, 0x28, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x20, 0x6f, 0x72,
-    0x20, 0x72, 0x65, 0x6c, 0x65, 0x61, 0x73, 0x65, 0x64, 0x29, 0x0a, 0x09,
-    0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x70, 0x72, 0x65,
-    0x73, 0x73, 0x56, 0x69, 0x73, 0x75, 0x61, 0x6c, 0x4b, 0x65, 0x79, 0x73,
+    0x0a, 0x09, 0x09, 0x73, 0x65, 0x6e, 0x64, 0x4b, 0x65, 0x79, 0x28, 0x74,
+    0x79, 0x70, 0x65, 0x2c, 0x20, 0x65, 0x2e, 0x6b, 0x65, 0x79, 0x2c, 0x20,
+    0x65, 0x2e, 0x73, 0x68, 0x69, 0x66, 0x74, 0x4b, 0x65, 0x79, 0x20, 0x7c,
+    0x7c, 0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x2c, 0x20, 0x65, 0x2e, 0x63,
+    0x74, 0x72, 0x6c, 0x4b, 0x65, 0x79, 0x20, 0x7c, 0x7c, 0x20, 0x66, 0x61,
+    0x6c, 0x73, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x2f, 0x2f,
+    0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x66, 0x6f,
+    0x72, 0x20, 0x73, 0x65, 0x6e, 0x64, 0x69, 0x6e, 0x67, 0x20, 0x6d, 0x6f,
+    0x75, 0x73, 0x65, 0x20, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x73, 0x0a, 0x09,
+    0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x73, 0x65, 0x6e,
+    0x64, 0x4d, 0x6f, 0x75, 0x73, 0x65, 0x4b, 0x65, 0x79, 0x54, 0x6f, 0x57,
+    0x53, 0x28, 0x6f, 0x62, 0x6a, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x63,
+    0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6d, 0x20, 0x3d, 0x20, 0x6f, 0x62, 0x6a,
+    0x2e, 0x6b, 0x65, 0x79, 0x73, 0x2e, 0x6d, 0x6f, 0x64, 0x69, 0x66, 0x69,
+    0x65, 0x72, 0x73, 0x3b, 0x0a, 0x09, 0x09, 0x73, 0x65, 0x6e, 0x64, 0x4b,
+    0x65, 0x79, 0x28, 0x6f, 0x62, 0x6a, 0x2e, 0x74, 0x79, 0x70, 0x65, 0x2c,
+    0x20, 0x6f, 0x62, 0x6a, 0x2e, 0x6b, 0x65, 0x79, 0x73, 0x2e, 0x63, 0x68,
+    0x61, 0x72, 0x73, 0x2c, 0x20, 0x6d, 0x2e, 0x73, 0x68, 0x69, 0x66, 0x74,
+    0x2c, 0x20, 0x6d, 0x2e, 0x63, 0x74, 0x72, 0x6c, 0x29, 0x3b, 0x0a, 0x09,
+    0x7d, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x73, 0x70, 0x6c, 0x69, 0x74, 0x20,
+    0x69, 0x74, 0x65, 0x6d, 0x73, 0x20, 0x69, 0x6e, 0x74, 0x6f, 0x20, 0x61,
+    0x20, 0x6c, 0x69, 0x73, 0x74, 0x20, 0x28, 0x73, 0x65, 0x70, 0x61, 0x74,
+    0x6f, 0x72, 0x3a, 0x20, 0x70, 0x69, 0x70, 0x65, 0x29, 0x0a, 0x09, 0x66,
+    0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x61, 0x74, 0x74, 0x72,
+    0x4c, 0x69, 0x73, 0x74, 0x28, 0x65, 0x6c, 0x2c, 0x20, 0x61, 0x74, 0x74,
+    0x72, 0x4e, 0x61, 0x6d, 0x65, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x63,
+    0x6f, 0x6e, 0x73, 0x74, 0x20, 0x76, 0x20, 0x3d, 0x20, 0x65, 0x6c, 0x2e,
+    0x67, 0x65, 0x74, 0x41, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65,
+    0x28, 0x61, 0x74, 0x74, 0x72, 0x4e, 0x61, 0x6d, 0x65, 0x29, 0x3b, 0x0a,
+    0x09, 0x09, 0x69, 0x66, 0x28, 0x21, 0x76, 0x29, 0x20, 0x72, 0x65, 0x74,
+    0x75, 0x72, 0x6e, 0x20, 0x5b, 0x5d, 0x3b, 0x0a, 0x09, 0x09, 0x72, 0x65,
+    0x74, 0x75, 0x72, 0x6e, 0x20, 0x76, 0x2e, 0x73, 0x70, 0x6c, 0x69, 0x74,
+    0x28, 0x27, 0x7c, 0x27, 0x29, 0x20, 0x2f, 0x2f, 0x20, 0x6d, 0x75, 0x6c,
+    0x74, 0x69, 0x70, 0x6c, 0x65, 0x20, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x73,
+    0x0a, 0x09, 0x09, 0x09, 0x2e, 0x66, 0x69, 0x6c, 0x74, 0x65, 0x72, 0x28,
+    0x73, 0x20, 0x3d, 0x3e, 0x20, 0x73, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74,
+    0x68, 0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x66,
+    0x69, 0x6e, 0x64, 0x20, 0x6b, 0x65, 0x79, 0x20, 0x62, 0x79, 0x20, 0x63,
+    0x68, 0x61, 0x72, 0x20, 0x64, 0x65, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74,
+    0x69, 0x6f, 0x6e, 0x0a, 0x09, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
+    0x6e, 0x20, 0x66, 0x69, 0x6e, 0x64, 0x4b, 0x65, 0x79, 0x73, 0x42, 0x79,
+    0x43, 0x68, 0x61, 0x72, 0x28, 0x63, 0x68, 0x29, 0x20, 0x7b, 0x0a, 0x09,
+    0x09, 0x69, 0x66, 0x28, 0x21, 0x63, 0x68, 0x29, 0x20, 0x72, 0x65, 0x74,
+    0x75, 0x72, 0x6e, 0x20, 0x5b, 0x5d, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f,
+    0x6e, 0x73, 0x74, 0x20, 0x61, 0x6c, 0x6c, 0x20, 0x3d, 0x20, 0x64, 0x6f,
+    0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x71, 0x75, 0x65, 0x72, 0x79,
+    0x53, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x41, 0x6c, 0x6c, 0x28,
+    0x27, 0x5b, 0x64, 0x61, 0x74, 0x61, 0x2d, 0x63, 0x68, 0x61, 0x72, 0x5d,
+    0x27, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20,
+    0x63, 0x55, 0x70, 0x70, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x63, 0x68, 0x2e,
+    0x74, 0x6f, 0x55, 0x70, 0x70, 0x65, 0x72, 0x43, 0x61, 0x73, 0x65, 0x28,
+    0x29, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x72,
+    0x65, 0x73, 0x20, 0x3d, 0x20, 0x5b, 0x5d, 0x3b, 0x0a, 0x09, 0x09, 0x66,
+    0x6f, 0x72, 0x28, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x65, 0x6c, 0x20,
+    0x6f, 0x66, 0x20, 0x61, 0x6c, 0x6c, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09,
+    0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6c, 0x69, 0x73, 0x74, 0x20,
+    0x3d, 0x20, 0x61, 0x74, 0x74, 0x72, 0x4c, 0x69, 0x73, 0x74, 0x28, 0x65,
+    0x6c, 0x2c, 0x20, 0x27, 0x64, 0x61, 0x74, 0x61, 0x2d, 0x63, 0x68, 0x61,
+    0x72, 0x27, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x66, 0x6f, 0x72, 0x28,
+    0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x65, 0x6e, 0x74, 0x72, 0x79, 0x20,
+    0x6f, 0x66, 0x20, 0x6c, 0x69, 0x73, 0x74, 0x29, 0x20, 0x7b, 0x0a, 0x09,
+    0x09, 0x09, 0x09, 0x69, 0x66, 0x28, 0x65, 0x6e, 0x74, 0x72, 0x79, 0x2e,
+    0x74, 0x6f, 0x55, 0x70, 0x70, 0x65, 0x72, 0x43, 0x61, 0x73, 0x65, 0x28,
+    0x29, 0x20, 0x3d, 0x3d, 0x3d, 0x20, 0x63, 0x55, 0x70, 0x70, 0x65, 0x72,
+    0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x09, 0x72, 0x65, 0x73,
+    0x2e, 0x70, 0x75, 0x73, 0x68, 0x28, 0x65, 0x6c, 0x29, 0x3b, 0x0a, 0x09,
+    0x09, 0x09, 0x09, 0x09, 0x62, 0x72, 0x65, 0x61, 0x6b, 0x3b, 0x0a, 0x09,
+    0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09,
+    0x7d, 0x0a, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x72,
+    0x65, 0x73, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x6d,
+    0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x20, 0x63, 0x6f, 0x6d, 0x70, 0x6f,
+    0x73, 0x69, 0x74, 0x6f, 0x72, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x6d, 0x6f,
+    0x75, 0x73, 0x65, 0x20, 0x63, 0x6c, 0x69, 0x63, 0x6b, 0x73, 0x3a, 0x20,
+    0x63, 0x68, 0x65, 0x63, 0x6b, 0x20, 0x77, 0x68, 0x69, 0x63, 0x68, 0x20,
+    0x63, 0x68, 0x61, 0x72, 0x61, 0x63, 0x74, 0x65, 0x72, 0x20, 0x69, 0x73,
+    0x20, 0x73, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x65, 0x64, 0x0a, 0x09, 0x66,
+    0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x62, 0x75, 0x69, 0x6c,
+    0x64, 0x4b, 0x65, 0x79, 0x4d, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x46,
+    0x72, 0x6f, 0x6d, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x28, 0x65,
+    0x6c, 0x2c, 0x20, 0x74, 0x79, 0x70, 0x65, 0x2c, 0x20, 0x65, 0x76, 0x29,
+    0x20, 0x7b, 0x0a, 0x09, 0x09, 0x6c, 0x65, 0x74, 0x20, 0x73, 0x68, 0x69,
+    0x66, 0x74, 0x20, 0x3d, 0x20, 0x65, 0x76, 0x2e, 0x73, 0x68, 0x69, 0x66,
+    0x74, 0x4b, 0x65, 0x79, 0x3b, 0x0a, 0x09, 0x09, 0x6c, 0x65, 0x74, 0x20,
+    0x63, 0x68, 0x61, 0x72, 0x20, 0x3d, 0x20, 0x22, 0x22, 0x3b, 0x0a, 0x09,
+    0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x65, 0x6c, 0x69, 0x73, 0x74,
+    0x20, 0x3d, 0x20, 0x61, 0x74, 0x74, 0x72, 0x4c, 0x69, 0x73, 0x74, 0x28,
+    0x65, 0x6c, 0x2c, 0x20, 0x27, 0x64, 0x61, 0x74, 0x61, 0x2d, 0x63, 0x68,
+    0x61, 0x72, 0x27, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x28, 0x65,
+    0x6c, 0x69, 0x73, 0x74, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x20,
+    0x3d, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x63, 0x68, 0x61, 0x72, 0x20, 0x3d,
+    0x20, 0x65, 0x6c, 0x69, 0x73, 0x74, 0x5b, 0x30, 0x5d, 0x3b, 0x0a, 0x09,
+    0x09, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x69, 0x66, 0x28, 0x65, 0x6c, 0x69,
+    0x73, 0x74, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x20, 0x3e, 0x20,
+    0x31, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x69,
+    0x66, 0x20, 0x73, 0x68, 0x69, 0x66, 0x74, 0x20, 0x69, 0x73, 0x20, 0x70,
+    0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x2c, 0x20, 0x74, 0x61, 0x6b, 0x65,
+    0x20, 0x74, 0x68, 0x65, 0x20, 0x66, 0x69, 0x72, 0x73, 0x74, 0x20, 0x63,
+    0x68, 0x61, 0x72, 0x20, 0x61, 0x6e, 0x64, 0x20, 0x63, 0x6c, 0x65, 0x61,
+    0x72, 0x20, 0x73, 0x68, 0x69, 0x66, 0x74, 0x0a, 0x09, 0x09, 0x09, 0x2f,
+    0x2f, 0x20, 0x69, 0x66, 0x20, 0x6e, 0x6f, 0x74, 0x2c, 0x20, 0x74, 0x61,
+    0x6b, 0x65, 0x20, 0x74, 0x68, 0x65, 0x20, 0x73, 0x65, 0x63, 0x6f, 0x6e,
+    0x64, 0x20, 0x63, 0x68, 0x61, 0x72, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x66,
+    0x28, 0x65, 0x76, 0x2e, 0x73, 0x68, 0x69, 0x66, 0x74, 0x4b, 0x65, 0x79,
+    0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x63, 0x68, 0x61, 0x72,
+    0x20, 0x3d, 0x20, 0x65, 0x6c, 0x69, 0x73, 0x74, 0x5b, 0x30, 0x5d, 0x3b,
+    0x0a, 0x09, 0x09, 0x09, 0x09, 0x73, 0x68, 0x69, 0x66, 0x74, 0x20, 0x3d,
+    0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d,
+    0x20, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x63, 0x68, 0x61, 0x72, 0x20, 0x3d,
+    0x20, 0x65, 0x6c, 0x69, 0x73, 0x74, 0x5b, 0x31, 0x5d, 0x3b, 0x0a, 0x09,
+    0x09, 0x7d, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x63,
+    0x74, 0x72, 0x6c, 0x20, 0x3d, 0x20, 0x65, 0x76, 0x2e, 0x63, 0x74, 0x72,
+    0x6c, 0x4b, 0x65, 0x79, 0x3b, 0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73,
+    0x74, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x6f, 0x64, 0x6f, 0x72, 0x65, 0x20,
+    0x3d, 0x20, 0x65, 0x76, 0x2e, 0x61, 0x6c, 0x74, 0x4b, 0x65, 0x79, 0x3b,
+    0x0a, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6b, 0x65, 0x79,
+    0x4f, 0x62, 0x6a, 0x20, 0x3d, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x63,
+    0x68, 0x61, 0x72, 0x73, 0x3a, 0x20, 0x63, 0x68, 0x61, 0x72, 0x2c, 0x0a,
+    0x09, 0x09, 0x09, 0x6d, 0x6f, 0x64, 0x69, 0x66, 0x69, 0x65, 0x72, 0x73,
+    0x3a, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x73, 0x68, 0x69, 0x66,
+    0x74, 0x3a, 0x20, 0x73, 0x68, 0x69, 0x66, 0x74, 0x2c, 0x0a, 0x09, 0x09,
+    0x09, 0x09, 0x63, 0x74, 0x72, 0x6c, 0x3a, 0x20, 0x63, 0x74, 0x72, 0x6c,
+    0x2c, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6d, 0x6d, 0x6f, 0x64,
+    0x6f, 0x72, 0x65, 0x3a, 0x20, 0x63, 0x6f, 0x6d, 0x6d, 0x6f, 0x64, 0x6f,
+    0x72, 0x65, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x7d, 0x3b,
+    0x0a, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x20, 0x7b, 0x0a,
+    0x09, 0x09, 0x09, 0x74, 0x79, 0x70, 0x65, 0x2c, 0x0a, 0x09, 0x09, 0x09,
+    0x6b, 0x65, 0x79, 0x73, 0x3a, 0x20, 0x6b, 0x65, 0x79, 0x4f, 0x62, 0x6a,
+    0x0a, 0x09, 0x09, 0x7d, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x2f, 0x2f,
+    0x20, 0x76, 0x69, 0x73, 0x75, 0x61, 0x6c, 0x69, 0x7a, 0x65, 0x20, 0x6b,
+    0x65, 0x79, 0x20, 0x73, 0x74, 0x61, 0x74, 0x65, 0x20, 0x28, 0x70, 0x72,
+    0x65, 0x73, 0x73, 0x65, 0x64, 0x20, 0x6f, 0x72, 0x20, 0x72, 0x65, 0x6c,
+    0x65, 0x61, 0x73, 0x65, 0x64, 0x29, 0x0a, 0x09, 0x66, 0x75, 0x6e, 0x63,
+    0x74, 0x69, 0x6f, 0x6e, 0x20, 0x70, 0x72, 0x65, 0x73, 0x73, 0x56, 0x69,
+    0x73, 0x75, 0x61, 0x6c, 0x4b, 0x65, 0x79, 0x73, 0x28, 0x6b, 0x65, 0x79,
+    0x73, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x6b, 0x65, 0x79, 0x73, 0x2e,
+    0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28, 0x6b, 0x20, 0x3d, 0x3e,
+    0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x6b, 0x2e, 0x73, 0x65, 0x74, 0x41,
+    0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x28, 0x27, 0x64, 0x61,
+    0x74, 0x61, 0x2d, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x27, 0x2c,
+    0x20, 0x27, 0x6f, 0x6e, 0x27, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x63,
+    0x6f, 0x6e, 0x73, 0x74, 0x20, 0x73, 0x76, 0x67, 0x49, 0x6d, 0x67, 0x20,
+    0x3d, 0x20, 0x6b, 0x2e, 0x71, 0x75, 0x65, 0x72, 0x79, 0x53, 0x65, 0x6c,
+    0x65, 0x63, 0x74, 0x6f, 0x72, 0x28, 0x27, 0x69, 0x6d, 0x67, 0x2e, 0x6b,
+    0x65, 0x79, 0x2d, 0x2d, 0x63, 0x6f, 0x6d, 0x6d, 0x6f, 0x64, 0x6f, 0x72,
+    0x65, 0x27, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x66, 0x28, 0x73,
+    0x76, 0x67, 0x49, 0x6d, 0x67, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09,
+    0x09, 0x73, 0x76, 0x67, 0x49, 0x6d, 0x67, 0x2e, 0x73, 0x74, 0x79, 0x6c,
+    0x65, 0x2e, 0x66, 0x69, 0x6c, 0x74, 0x65, 0x72, 0x20, 0x3d, 0x20, 0x27,
+    0x62, 0x72, 0x69, 0x67, 0x68, 0x74, 0x6e, 0x65, 0x73, 0x73, 0x28, 0x35,
+    0x30, 0x25, 0x29, 0x27, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09,
+    0x09, 0x7d, 0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x0a, 0x09, 0x66, 0x75,
+    0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x72, 0x65, 0x6c, 0x65, 0x61,
+    0x73, 0x65, 0x56, 0x69, 0x73, 0x75, 0x61, 0x6c, 0x4b, 0x65, 0x79, 0x73,
     0x28, 0x6b, 0x65, 0x79, 0x73, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x6b,
     0x65, 0x79, 0x73, 0x2e, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28,
     0x6b, 0x20, 0x3d, 0x3e, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x6b, 0x2e,
-    0x73, 0x65, 0x74, 0x41, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65,
-    0x28, 0x27, 0x64, 0x61, 0x74, 0x61, 0x2d, 0x70, 0x72, 0x65, 0x73, 0x73,
-    0x65, 0x64, 0x27, 0x2c, 0x20, 0x27, 0x6f, 0x6e, 0x27, 0x29, 0x3b, 0x0a,
-    0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x73, 0x76, 0x67,
-    0x49, 0x6d, 0x67, 0x20, 0x3d, 0x20, 0x6b, 0x2e, 0x71, 0x75, 0x65, 0x72,
-    0x79, 0x53, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x28, 0x27, 0x69,
-    0x6d, 0x67, 0x2e, 0x6b, 0x65, 0x79, 0x2d, 0x2d, 0x63, 0x6f, 0x6d, 0x6d,
-    0x6f, 0x64, 0x6f, 0x72, 0x65, 0x27, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09,
-    0x69, 0x66, 0x28, 0x73, 0x76, 0x67, 0x49, 0x6d, 0x67, 0x29, 0x20, 0x7b,
-    0x0a, 0x09, 0x09, 0x09, 0x09, 0x73, 0x76, 0x67, 0x49, 0x6d, 0x67, 0x2e,
-    0x73, 0x74, 0x79, 0x6c, 0x65, 0x2e, 0x66, 0x69, 0x6c, 0x74, 0x65, 0x72,
-    0x20, 0x3d, 0x20, 0x27, 0x62, 0x72, 0x69, 0x67, 0x68, 0x74, 0x6e, 0x65,
-    0x73, 0x73, 0x28, 0x35, 0x30, 0x25, 0x29, 0x27, 0x3b, 0x0a, 0x09, 0x09,
-    0x09, 0x7d, 0x0a, 0x09, 0x09, 0x7d, 0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x0a,
-    0x0a, 0x09, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x20, 0x72,
-    0x65, 0x6c, 0x65, 0x61, 0x73, 0x65, 0x56, 0x69, 0x73, 0x75, 0x61, 0x6c,
-    0x4b, 0x65, 0x79, 0x73, 0x28, 0x6b, 0x65, 0x79, 0x73, 0x29, 0x20, 0x7b,
-    0x0a, 0x09, 0x09, 0x6b, 0x65, 0x79, 0x73, 0x2e, 0x66, 0x6f, 0x72, 0x45,
-    0x61, 0x63, 0x68, 0x28, 0x6b, 0x20, 0x3d, 0x3e, 0x20, 0x7b, 0x0a, 0x09,
-    0x09, 0x09, 0x6b, 0x2e, 0x72, 0x65, 0x6d, 0x6f, 0x76, 0x65, 0x41, 0x74,
-    0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x28, 0x27, 0x64, 0x61, 0x74,
-    0x61, 0x2d, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x27, 0x29, 0x3b,
-    0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x73, 0x76,
-    0x67, 0x49, 0x6d, 0x67, 0x20, 0x3d, 0x20, 0x6b, 0x2e, 0x71, 0x75, 0x65,
-    0x72, 0x79, 0x53, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x28, 0x27,
-    0x69, 0x6d, 0x67, 0x2e, 0x6b, 0x65, 0x79, 0x2d, 0x2d, 0x63, 0x6f, 0x6d,
-    0x6d, 0x6f, 0x64, 0x6f, 0x72, 0x65, 0x27, 0x29, 0x3b, 0x0a, 0x09, 0x09,
-    0x09, 0x69, 0x66, 0x28, 0x73, 0x76, 0x67, 0x49, 0x6d, 0x67, 0x29, 0x20,
-    0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x73, 0x76, 0x67, 0x49, 0x6d, 0x67,
-    0x2e, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x2e, 0x66, 0x69, 0x6c, 0x74, 0x65,
-    0x72, 0x20, 0x3d, 0x20, 0x27, 0x27, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d,
-    0x0a, 0x09, 0x09, 0x7d, 0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x63,
-    0x6f, 0x6e, 0x73, 0x74, 0x20, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64,
-    0x4d, 0x61, 0x70, 0x20, 0x3d, 0x20, 0x6e, 0x65, 0x77, 0x20, 0x4d, 0x61,
-    0x70, 0x28, 0x29, 0x3b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x6b, 0x65, 0x79,
-    0x64, 0x6f, 0x77, 0x6e, 0x20, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x20, 0x6c,
-    0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x0a, 0x09, 0x64, 0x6f, 0x63,
-    0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65,
-    0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x28, 0x27,
-    0x6b, 0x65, 0x79, 0x64, 0x6f, 0x77, 0x6e, 0x27, 0x2c, 0x20, 0x66, 0x75,
-    0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x65, 0x29, 0x20, 0x7b, 0x0a,
-    0x09, 0x09, 0x2f, 0x2f, 0x20, 0x73, 0x65, 0x61, 0x72, 0x63, 0x68, 0x20,
-    0x66, 0x6f, 0x72, 0x20, 0x6b, 0x65, 0x79, 0x0a, 0x09, 0x09, 0x6c, 0x65,
-    0x74, 0x20, 0x6b, 0x65, 0x79, 0x73, 0x20, 0x3d, 0x20, 0x66, 0x69, 0x6e,
-    0x64, 0x4b, 0x65, 0x79, 0x73, 0x42, 0x79, 0x43, 0x68, 0x61, 0x72, 0x28,
-    0x65, 0x2e, 0x6b, 0x65, 0x79, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x69, 0x66,
-    0x28, 0x6b, 0x65, 0x79, 0x73, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68,
-    0x20, 0x3e, 0x20, 0x30, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x6c,
-    0x65, 0x74, 0x20, 0x6b, 0x65, 0x79, 0x53, 0x74, 0x72, 0x20, 0x3d, 0x20,
-    0x6b, 0x65, 0x79, 0x73, 0x2e, 0x6a, 0x6f, 0x69, 0x6e, 0x28, 0x22, 0x7e,
-    0x22, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x69, 0x66,
-    0x20, 0x61, 0x6c, 0x72, 0x65, 0x61, 0x64, 0x79, 0x20, 0x70, 0x72, 0x65,
-    0x73, 0x73, 0x65, 0x64, 0x20, 0x2d, 0x3e, 0x20, 0x72, 0x65, 0x74, 0x75,
-    0x72, 0x6e, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x66, 0x28, 0x70, 0x72, 0x65,
+    0x72, 0x65, 0x6d, 0x6f, 0x76, 0x65, 0x41, 0x74, 0x74, 0x72, 0x69, 0x62,
+    0x75, 0x74, 0x65, 0x28, 0x27, 0x64, 0x61, 0x74, 0x61, 0x2d, 0x70, 0x72,
+    0x65, 0x73, 0x73, 0x65, 0x64, 0x27, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09,
+    0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x73, 0x76, 0x67, 0x49, 0x6d, 0x67,
+    0x20, 0x3d, 0x20, 0x6b, 0x2e, 0x71, 0x75, 0x65, 0x72, 0x79, 0x53, 0x65,
+    0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x28, 0x27, 0x69, 0x6d, 0x67, 0x2e,
+    0x6b, 0x65, 0x79, 0x2d, 0x2d, 0x63, 0x6f, 0x6d, 0x6d, 0x6f, 0x64, 0x6f,
+    0x72, 0x65, 0x27, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x66, 0x28,
+    0x73, 0x76, 0x67, 0x49, 0x6d, 0x67, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09,
+    0x09, 0x09, 0x73, 0x76, 0x67, 0x49, 0x6d, 0x67, 0x2e, 0x73, 0x74, 0x79,
+    0x6c, 0x65, 0x2e, 0x66, 0x69, 0x6c, 0x74, 0x65, 0x72, 0x20, 0x3d, 0x20,
+    0x27, 0x27, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x7d,
+    0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74,
+    0x20, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x4d, 0x61, 0x70, 0x20,
+    0x3d, 0x20, 0x6e, 0x65, 0x77, 0x20, 0x4d, 0x61, 0x70, 0x28, 0x29, 0x3b,
+    0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x6b, 0x65, 0x79, 0x64, 0x6f, 0x77, 0x6e,
+    0x20, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x20, 0x6c, 0x69, 0x73, 0x74, 0x65,
+    0x6e, 0x65, 0x72, 0x0a, 0x09, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e,
+    0x74, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x4c, 0x69,
+    0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x28, 0x27, 0x6b, 0x65, 0x79, 0x64,
+    0x6f, 0x77, 0x6e, 0x27, 0x2c, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69,
+    0x6f, 0x6e, 0x28, 0x65, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x2f, 0x2f,
+    0x20, 0x73, 0x65, 0x61, 0x72, 0x63, 0x68, 0x20, 0x66, 0x6f, 0x72, 0x20,
+    0x6b, 0x65, 0x79, 0x0a, 0x09, 0x09, 0x6c, 0x65, 0x74, 0x20, 0x6b, 0x65,
+    0x79, 0x73, 0x20, 0x3d, 0x20, 0x66, 0x69, 0x6e, 0x64, 0x4b, 0x65, 0x79,
+    0x73, 0x42, 0x79, 0x43, 0x68, 0x61, 0x72, 0x28, 0x65, 0x2e, 0x6b, 0x65,
+    0x79, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x28, 0x6b, 0x65, 0x79,
+    0x73, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x20, 0x3e, 0x20, 0x30,
+    0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x6c, 0x65, 0x74, 0x20, 0x6b,
+    0x65, 0x79, 0x53, 0x74, 0x72, 0x20, 0x3d, 0x20, 0x6b, 0x65, 0x79, 0x73,
+    0x2e, 0x6a, 0x6f, 0x69, 0x6e, 0x28, 0x22, 0x7e, 0x22, 0x29, 0x3b, 0x0a,
+    0x09, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x69, 0x66, 0x20, 0x61, 0x6c, 0x72,
+    0x65, 0x61, 0x64, 0x79, 0x20, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64,
+    0x20, 0x2d, 0x3e, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x0a, 0x09,
+    0x09, 0x09, 0x69, 0x66, 0x28, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64,
+    0x4d, 0x61, 0x70, 0x2e, 0x68, 0x61, 0x73, 0x28, 0x6b, 0x65, 0x79, 0x53,
+    0x74, 0x72, 0x29, 0x29, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b,
+    0x0a, 0x09, 0x09, 0x09, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x4d,
+    0x61, 0x70, 0x2e, 0x73, 0x65, 0x74, 0x28, 0x6b, 0x65, 0x79, 0x53, 0x74,
+    0x72, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x70, 0x72, 0x65, 0x73, 0x73,
+    0x56, 0x69, 0x73, 0x75, 0x61, 0x6c, 0x4b, 0x65, 0x79, 0x73, 0x28, 0x6b,
+    0x65, 0x79, 0x73, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x2f, 0x2f, 0x20,
+    0x73, 0x65, 0x6e, 0x64, 0x20, 0x6b, 0x65, 0x79, 0x2d, 0x64, 0x6f, 0x77,
+    0x6e, 0x20, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x20, 0x74, 0x6f, 0x20, 0x77,
+    0x65, 0x62, 0x73, 0x6f, 0x63, 0x6b, 0x65, 0x74, 0x0a, 0x09, 0x09, 0x09,
+    0x73, 0x65, 0x6e, 0x64, 0x4b, 0x65, 0x79, 0x54, 0x6f, 0x57, 0x53, 0x28,
+    0x27, 0x6b, 0x65, 0x79, 0x2d, 0x64, 0x6f, 0x77, 0x6e, 0x27, 0x2c, 0x20,
+    0x65, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x73, 0x65,
+    0x6e, 0x64, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6b, 0x65, 0x79, 0x2d, 0x75,
+    0x70, 0x20, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x20, 0x74, 0x6f, 0x6f, 0x2c,
+    0x20, 0x74, 0x6f, 0x20, 0x70, 0x72, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x20,
+    0x6b, 0x65, 0x79, 0x73, 0x20, 0x67, 0x65, 0x74, 0x74, 0x69, 0x6e, 0x67,
+    0x20, 0x73, 0x74, 0x75, 0x63, 0x6b, 0x0a, 0x09, 0x09, 0x09, 0x73, 0x65,
+    0x6e, 0x64, 0x4b, 0x65, 0x79, 0x54, 0x6f, 0x57, 0x53, 0x28, 0x27, 0x6b,
+    0x65, 0x79, 0x2d, 0x75, 0x70, 0x27, 0x2c, 0x20, 0x65, 0x29, 0x3b, 0x0a,
+    0x09, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x74, 0x69, 0x6d, 0x65, 0x72, 0x20,
+    0x66, 0x6f, 0x72, 0x20, 0x61, 0x75, 0x74, 0x6f, 0x6d, 0x61, 0x74, 0x69,
+    0x63, 0x20, 0x6b, 0x65, 0x79, 0x20, 0x72, 0x65, 0x6c, 0x65, 0x61, 0x73,
+    0x65, 0x0a, 0x09, 0x09, 0x09, 0x73, 0x65, 0x74, 0x54, 0x69, 0x6d, 0x65,
+    0x6f, 0x75, 0x74, 0x28, 0x28, 0x29, 0x20, 0x3d, 0x3e, 0x20, 0x7b, 0x0a,
+    0x09, 0x09, 0x09, 0x09, 0x69, 0x66, 0x28, 0x70, 0x72, 0x65, 0x73, 0x73,
+    0x65, 0x64, 0x4d, 0x61, 0x70, 0x2e, 0x68, 0x61, 0x73, 0x28, 0x6b, 0x65,
+    0x79, 0x53, 0x74, 0x72, 0x29, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09,
+    0x09, 0x09, 0x72, 0x65, 0x6c, 0x65, 0x61, 0x73, 0x65, 0x56, 0x69, 0x73,
+    0x75, 0x61, 0x6c, 0x4b, 0x65, 0x79, 0x73, 0x28, 0x6b, 0x65, 0x79, 0x73,
+    0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x09, 0x70, 0x72, 0x65, 0x73,
+    0x73, 0x65, 0x64, 0x4d, 0x61, 0x70, 0x2e, 0x64, 0x65, 0x6c, 0x65, 0x74,
+    0x65, 0x28, 0x6b, 0x65, 0x79, 0x53, 0x74, 0x72, 0x29, 0x3b, 0x0a, 0x09,
+    0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x2c, 0x20, 0x31,
+    0x30, 0x30, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x65, 0x2e, 0x70,
+    0x72, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x44, 0x65, 0x66, 0x61, 0x75, 0x6c,
+    0x74, 0x28, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75,
+    0x72, 0x6e, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x7d, 0x2c, 0x20,
+    0x7b, 0x0a, 0x09, 0x09, 0x70, 0x61, 0x73, 0x73, 0x69, 0x76, 0x65, 0x3a,
+    0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x0a, 0x09, 0x7d, 0x29, 0x3b, 0x0a,
+    0x09, 0x2f, 0x2f, 0x20, 0x6b, 0x65, 0x79, 0x75, 0x70, 0x20, 0x65, 0x76,
+    0x65, 0x6e, 0x74, 0x20, 0x6c, 0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72,
+    0x2c, 0x20, 0x6a, 0x75, 0x73, 0x74, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x72,
+    0x65, 0x6c, 0x65, 0x61, 0x73, 0x69, 0x6e, 0x67, 0x20, 0x74, 0x68, 0x65,
+    0x20, 0x76, 0x69, 0x73, 0x75, 0x61, 0x6c, 0x20, 0x6b, 0x65, 0x79, 0x73,
+    0x0a, 0x09, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x61,
+    0x64, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74, 0x65,
+    0x6e, 0x65, 0x72, 0x28, 0x27, 0x6b, 0x65, 0x79, 0x75, 0x70, 0x27, 0x2c,
+    0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28, 0x65, 0x29,
+    0x20, 0x7b, 0x0a, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x63, 0x68, 0x61, 0x72,
+    0x61, 0x63, 0x74, 0x65, 0x72, 0x73, 0x0a, 0x09, 0x09, 0x69, 0x66, 0x28,
+    0x65, 0x2e, 0x6b, 0x65, 0x79, 0x20, 0x26, 0x26, 0x20, 0x65, 0x2e, 0x6b,
+    0x65, 0x79, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74, 0x68, 0x20, 0x3e, 0x3d,
+    0x20, 0x31, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x6c, 0x65, 0x74,
+    0x20, 0x6b, 0x65, 0x79, 0x73, 0x20, 0x3d, 0x20, 0x66, 0x69, 0x6e, 0x64,
+    0x4b, 0x65, 0x79, 0x73, 0x42, 0x79, 0x43, 0x68, 0x61, 0x72, 0x28, 0x65,
+    0x2e, 0x6b, 0x65, 0x79, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x6c, 0x65,
+    0x74, 0x20, 0x6b, 0x65, 0x79, 0x53, 0x74, 0x72, 0x20, 0x3d, 0x20, 0x6b,
+    0x65, 0x79, 0x73, 0x2e, 0x6a, 0x6f, 0x69, 0x6e, 0x28, 0x22, 0x7e, 0x22,
+    0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x66, 0x28, 0x70, 0x72, 0x65,
     0x73, 0x73, 0x65, 0x64, 0x4d, 0x61, 0x70, 0x2e, 0x68, 0x61, 0x73, 0x28,
-    0x6b, 0x65, 0x79, 0x53, 0x74, 0x72, 0x29, 0x29, 0x20, 0x72, 0x65, 0x74,
-    0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x70, 0x72, 0x65, 0x73,
-    0x73, 0x65, 0x64, 0x4d, 0x61, 0x70, 0x2e, 0x73, 0x65, 0x74, 0x28, 0x6b,
-    0x65, 0x79, 0x53, 0x74, 0x72, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x70,
+    0x6b, 0x65, 0x79, 0x53, 0x74, 0x72, 0x29, 0x29, 0x20, 0x7b, 0x0a, 0x09,
+    0x09, 0x09, 0x09, 0x72, 0x65, 0x6c, 0x65, 0x61, 0x73, 0x65, 0x56, 0x69,
+    0x73, 0x75, 0x61, 0x6c, 0x4b, 0x65, 0x79, 0x73, 0x28, 0x6b, 0x65, 0x79,
+    0x73, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x70, 0x72, 0x65, 0x73,
+    0x73, 0x65, 0x64, 0x4d, 0x61, 0x70, 0x2e, 0x64, 0x65, 0x6c, 0x65, 0x74,
+    0x65, 0x28, 0x6b, 0x65, 0x79, 0x53, 0x74, 0x72, 0x29, 0x3b, 0x0a, 0x09,
+    0x09, 0x09, 0x09, 0x65, 0x2e, 0x70, 0x72, 0x65, 0x76, 0x65, 0x6e, 0x74,
+    0x44, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x28, 0x29, 0x3b, 0x0a, 0x09,
+    0x09, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x09,
+    0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x7d, 0x29, 0x3b,
+    0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x6d, 0x6f, 0x75, 0x73, 0x65, 0x20, 0x65,
+    0x76, 0x65, 0x6e, 0x74, 0x20, 0x6c, 0x69, 0x73, 0x74, 0x65, 0x6e, 0x65,
+    0x72, 0x0a, 0x09, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e,
+    0x71, 0x75, 0x65, 0x72, 0x79, 0x53, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x6f,
+    0x72, 0x41, 0x6c, 0x6c, 0x28, 0x27, 0x5b, 0x63, 0x6c, 0x61, 0x73, 0x73,
+    0x2a, 0x3d, 0x22, 0x6b, 0x65, 0x79, 0x2d, 0x2d, 0x22, 0x5d, 0x27, 0x29,
+    0x2e, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28, 0x6b, 0x20, 0x3d,
+    0x3e, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x6b, 0x2e, 0x61, 0x64, 0x64, 0x45,
+    0x76, 0x65, 0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72,
+    0x28, 0x27, 0x6d, 0x6f, 0x75, 0x73, 0x65, 0x64, 0x6f, 0x77, 0x6e, 0x27,
+    0x2c, 0x20, 0x28, 0x65, 0x76, 0x29, 0x20, 0x3d, 0x3e, 0x20, 0x7b, 0x0a,
+    0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x63, 0x68, 0x61,
+    0x72, 0x53, 0x74, 0x72, 0x20, 0x3d, 0x20, 0x6b, 0x2e, 0x67, 0x65, 0x74,
+    0x41, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x28, 0x22, 0x64,
+    0x61, 0x74, 0x61, 0x2d, 0x63, 0x68, 0x61, 0x72, 0x22, 0x29, 0x3b, 0x0a,
+    0x09, 0x09, 0x09, 0x69, 0x66, 0x28, 0x21, 0x63, 0x68, 0x61, 0x72, 0x53,
+    0x74, 0x72, 0x29, 0x20, 0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x0a,
+    0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x73, 0x70, 0x61,
+    0x6e, 0x20, 0x3d, 0x20, 0x6b, 0x2e, 0x71, 0x75, 0x65, 0x72, 0x79, 0x53,
+    0x65, 0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x28, 0x22, 0x73, 0x70, 0x61,
+    0x6e, 0x22, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x74,
+    0x6f, 0x67, 0x67, 0x6c, 0x65, 0x20, 0x6a, 0x6f, 0x79, 0x73, 0x74, 0x69,
+    0x63, 0x6b, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x0a, 0x09, 0x09, 0x09, 0x69,
+    0x66, 0x28, 0x63, 0x68, 0x61, 0x72, 0x53, 0x74, 0x72, 0x2e, 0x65, 0x6e,
+    0x64, 0x73, 0x57, 0x69, 0x74, 0x68, 0x28, 0x22, 0x4a, 0x4f, 0x59, 0x4d,
+    0x4f, 0x44, 0x45, 0x32, 0x22, 0x29, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09,
+    0x09, 0x09, 0x6b, 0x2e, 0x73, 0x65, 0x74, 0x41, 0x74, 0x74, 0x72, 0x69,
+    0x62, 0x75, 0x74, 0x65, 0x28, 0x22, 0x64, 0x61, 0x74, 0x61, 0x2d, 0x63,
+    0x68, 0x61, 0x72, 0x22, 0x2c, 0x20, 0x22, 0x4a, 0x4f, 0x59, 0x4d, 0x4f,
+    0x44, 0x45, 0x31, 0x22, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x73,
+    0x70, 0x61, 0x6e, 0x2e, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x48, 0x54, 0x4d,
+    0x4c, 0x20, 0x3d, 0x20, 0x22, 0x4a, 0x4f, 0x59, 0x53, 0x54, 0x49, 0x43,
+    0x4b, 0x4d, 0x4f, 0x44, 0x45, 0x3c, 0x62, 0x72, 0x3e, 0x31, 0x20, 0x41,
+    0x43, 0x54, 0x49, 0x56, 0x45, 0x22, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d,
+    0x20, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x69, 0x66, 0x28, 0x63, 0x68, 0x61,
+    0x72, 0x53, 0x74, 0x72, 0x2e, 0x65, 0x6e, 0x64, 0x73, 0x57, 0x69, 0x74,
+    0x68, 0x28, 0x22, 0x4a, 0x4f, 0x59, 0x4d, 0x4f, 0x44, 0x45, 0x31, 0x22,
+    0x29, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x6b, 0x2e, 0x73,
+    0x65, 0x74, 0x41, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x28,
+    0x22, 0x64, 0x61, 0x74, 0x61, 0x2d, 0x63, 0x68, 0x61, 0x72, 0x22, 0x2c,
+    0x20, 0x22, 0x4a, 0x4f, 0x59, 0x4d, 0x4f, 0x44, 0x45, 0x32, 0x22, 0x29,
+    0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x73, 0x70, 0x61, 0x6e, 0x2e, 0x69,
+    0x6e, 0x6e, 0x65, 0x72, 0x48, 0x54, 0x4d, 0x4c, 0x20, 0x3d, 0x20, 0x22,
+    0x4a, 0x4f, 0x59, 0x53, 0x54, 0x49, 0x43, 0x4b, 0x4d, 0x4f, 0x44, 0x45,
+    0x3c, 0x62, 0x72, 0x3e, 0x32, 0x20, 0x41, 0x43, 0x54, 0x49, 0x56, 0x45,
+    0x22, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x09, 0x70,
     0x72, 0x65, 0x73, 0x73, 0x56, 0x69, 0x73, 0x75, 0x61, 0x6c, 0x4b, 0x65,
-    0x79, 0x73, 0x28, 0x6b, 0x65, 0x79, 0x73, 0x29, 0x3b, 0x0a, 0x09, 0x09,
-    0x09, 0x2f, 0x2f, 0x20, 0x73, 0x65, 0x6e, 0x64, 0x20, 0x6b, 0x65, 0x79,
-    0x2d, 0x64, 0x6f, 0x77, 0x6e, 0x20, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x20,
-    0x74, 0x6f, 0x20, 0x77, 0x65, 0x62, 0x73, 0x6f, 0x63, 0x6b, 0x65, 0x74,
-    0x0a, 0x09, 0x09, 0x09, 0x73, 0x65, 0x6e, 0x64, 0x4b, 0x65, 0x79, 0x54,
-    0x6f, 0x57, 0x53, 0x28, 0x27, 0x6b, 0x65, 0x79, 0x2d, 0x64, 0x6f, 0x77,
-    0x6e, 0x27, 0x2c, 0x20, 0x65, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x2f,
-    0x2f, 0x20, 0x73, 0x65, 0x6e, 0x64, 0x20, 0x74, 0x68, 0x65, 0x20, 0x6b,
-    0x65, 0x79, 0x2d, 0x75, 0x70, 0x20, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x20,
-    0x74, 0x6f, 0x6f, 0x2c, 0x20, 0x74, 0x6f, 0x20, 0x70, 0x72, 0x65, 0x76,
-    0x65, 0x6e, 0x74, 0x20, 0x6b, 0x65, 0x79, 0x73, 0x20, 0x67, 0x65, 0x74,
-    0x74, 0x69, 0x6e, 0x67, 0x20, 0x73, 0x74, 0x75, 0x63, 0x6b, 0x0a, 0x09,
-    0x09, 0x09, 0x73, 0x65, 0x6e, 0x64, 0x4b, 0x65, 0x79, 0x54, 0x6f, 0x57,
-    0x53, 0x28, 0x27, 0x6b, 0x65, 0x79, 0x2d, 0x75, 0x70, 0x27, 0x2c, 0x20,
-    0x65, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x2f, 0x2f, 0x20, 0x74, 0x69,
-    0x6d, 0x65, 0x72, 0x20, 0x66, 0x6f, 0x72, 0x20, 0x61, 0x75, 0x74, 0x6f,
-    0x6d, 0x61, 0x74, 0x69, 0x63, 0x20, 0x6b, 0x65, 0x79, 0x20, 0x72, 0x65,
-    0x6c, 0x65, 0x61, 0x73, 0x65, 0x0a, 0x09, 0x09, 0x09, 0x73, 0x65, 0x74,
-    0x54, 0x69, 0x6d, 0x65, 0x6f, 0x75, 0x74, 0x28, 0x28, 0x29, 0x20, 0x3d,
-    0x3e, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x69, 0x66, 0x28, 0x70,
-    0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x4d, 0x61, 0x70, 0x2e, 0x68, 0x61,
-    0x73, 0x28, 0x6b, 0x65, 0x79, 0x53, 0x74, 0x72, 0x29, 0x29, 0x20, 0x7b,
-    0x0a, 0x09, 0x09, 0x09, 0x09, 0x09, 0x72, 0x65, 0x6c, 0x65, 0x61, 0x73,
-    0x65, 0x56, 0x69, 0x73, 0x75, 0x61, 0x6c, 0x4b, 0x65, 0x79, 0x73, 0x28,
-    0x6b, 0x65, 0x79, 0x73, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x09,
-    0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x4d, 0x61, 0x70, 0x2e, 0x64,
-    0x65, 0x6c, 0x65, 0x74, 0x65, 0x28, 0x6b, 0x65, 0x79, 0x53, 0x74, 0x72,
-    0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x09,
-    0x7d, 0x2c, 0x20, 0x31, 0x30, 0x30, 0x30, 0x29, 0x3b, 0x0a, 0x09, 0x09,
-    0x09, 0x65, 0x2e, 0x70, 0x72, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x44, 0x65,
-    0x66, 0x61, 0x75, 0x6c, 0x74, 0x28, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09,
-    0x72, 0x65, 0x74, 0x75, 0x72, 0x6e, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x0a,
-    0x09, 0x7d, 0x2c, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x70, 0x61, 0x73, 0x73,
-    0x69, 0x76, 0x65, 0x3a, 0x20, 0x66, 0x61, 0x6c, 0x73, 0x65, 0x0a, 0x09,
-    0x7d, 0x29, 0x3b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x6b, 0x65, 0x79, 0x75,
-    0x70, 0x20, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x20, 0x6c, 0x69, 0x73, 0x74,
-    0x65, 0x6e, 0x65, 0x72, 0x2c, 0x20, 0x6a, 0x75, 0x73, 0x74, 0x20, 0x66,
-    0x6f, 0x72, 0x20, 0x72, 0x65, 0x6c, 0x65, 0x61, 0x73, 0x69, 0x6e, 0x67,
-    0x20, 0x74, 0x68, 0x65, 0x20, 0x76, 0x69, 0x73, 0x75, 0x61, 0x6c, 0x20,
-    0x6b, 0x65, 0x79, 0x73, 0x0a, 0x09, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65,
-    0x6e, 0x74, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x4c,
-    0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x28, 0x27, 0x6b, 0x65, 0x79,
-    0x75, 0x70, 0x27, 0x2c, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f,
-    0x6e, 0x28, 0x65, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x2f, 0x2f, 0x20,
-    0x63, 0x68, 0x61, 0x72, 0x61, 0x63, 0x74, 0x65, 0x72, 0x73, 0x0a, 0x09,
-    0x09, 0x69, 0x66, 0x28, 0x65, 0x2e, 0x6b, 0x65, 0x79, 0x20, 0x26, 0x26,
-    0x20, 0x65, 0x2e, 0x6b, 0x65, 0x79, 0x2e, 0x6c, 0x65, 0x6e, 0x67, 0x74,
-    0x68, 0x20, 0x3e, 0x3d, 0x20, 0x31, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09,
-    0x09, 0x6c, 0x65, 0x74, 0x20, 0x6b, 0x65, 0x79, 0x73, 0x20, 0x3d, 0x20,
-    0x66, 0x69, 0x6e, 0x64, 0x4b, 0x65, 0x79, 0x73, 0x42, 0x79, 0x43, 0x68,
-    0x61, 0x72, 0x28, 0x65, 0x2e, 0x6b, 0x65, 0x79, 0x29, 0x3b, 0x0a, 0x09,
-    0x09, 0x09, 0x6c, 0x65, 0x74, 0x20, 0x6b, 0x65, 0x79, 0x53, 0x74, 0x72,
-    0x20, 0x3d, 0x20, 0x6b, 0x65, 0x79, 0x73, 0x2e, 0x6a, 0x6f, 0x69, 0x6e,
-    0x28, 0x22, 0x7e, 0x22, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x66,
-    0x28, 0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x4d, 0x61, 0x70, 0x2e,
-    0x68, 0x61, 0x73, 0x28, 0x6b, 0x65, 0x79, 0x53, 0x74, 0x72, 0x29, 0x29,
-    0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x72, 0x65, 0x6c, 0x65, 0x61,
-    0x73, 0x65, 0x56, 0x69, 0x73, 0x75, 0x61, 0x6c, 0x4b, 0x65, 0x79, 0x73,
-    0x28, 0x6b, 0x65, 0x79, 0x73, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09,
-    0x70, 0x72, 0x65, 0x73, 0x73, 0x65, 0x64, 0x4d, 0x61, 0x70, 0x2e, 0x64,
-    0x65, 0x6c, 0x65, 0x74, 0x65, 0x28, 0x6b, 0x65, 0x79, 0x53, 0x74, 0x72,
-    0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x65, 0x2e, 0x70, 0x72, 0x65,
-    0x76, 0x65, 0x6e, 0x74, 0x44, 0x65, 0x66, 0x61, 0x75, 0x6c, 0x74, 0x28,
-    0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x72, 0x65, 0x74, 0x75, 0x72,
-    0x6e, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a, 0x09, 0x09, 0x7d, 0x0a,
-    0x09, 0x7d, 0x29, 0x3b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x6d, 0x6f, 0x75,
-    0x73, 0x65, 0x20, 0x65, 0x76, 0x65, 0x6e, 0x74, 0x20, 0x6c, 0x69, 0x73,
-    0x74, 0x65, 0x6e, 0x65, 0x72, 0x0a, 0x09, 0x64, 0x6f, 0x63, 0x75, 0x6d,
-    0x65, 0x6e, 0x74, 0x2e, 0x71, 0x75, 0x65, 0x72, 0x79, 0x53, 0x65, 0x6c,
-    0x65, 0x63, 0x74, 0x6f, 0x72, 0x41, 0x6c, 0x6c, 0x28, 0x27, 0x5b, 0x63,
-    0x6c, 0x61, 0x73, 0x73, 0x2a, 0x3d, 0x22, 0x6b, 0x65, 0x79, 0x2d, 0x2d,
-    0x22, 0x5d, 0x27, 0x29, 0x2e, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68,
-    0x28, 0x6b, 0x20, 0x3d, 0x3e, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x6b, 0x2e,
+    0x79, 0x73, 0x28, 0x5b, 0x6b, 0x5d, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09,
+    0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6d, 0x73, 0x67, 0x20, 0x3d, 0x20,
+    0x62, 0x75, 0x69, 0x6c, 0x64, 0x4b, 0x65, 0x79, 0x4d, 0x65, 0x73, 0x73,
+    0x61, 0x67, 0x65, 0x46, 0x72, 0x6f, 0x6d, 0x45, 0x6c, 0x65, 0x6d, 0x65,
+    0x6e, 0x74, 0x28, 0x6b, 0x2c, 0x20, 0x22, 0x6b, 0x65, 0x79, 0x2d, 0x64,
+    0x6f, 0x77, 0x6e, 0x22, 0x2c, 0x20, 0x65, 0x76, 0x29, 0x3b, 0x0a, 0x09,
+    0x09, 0x09, 0x73, 0x65, 0x6e, 0x64, 0x4d, 0x6f, 0x75, 0x73, 0x65, 0x4b,
+    0x65, 0x79, 0x54, 0x6f, 0x57, 0x53, 0x28, 0x6d, 0x73, 0x67, 0x29, 0x3b,
+    0x0a, 0x09, 0x09, 0x7d, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x6b, 0x2e, 0x61,
+    0x64, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74, 0x65,
+    0x6e, 0x65, 0x72, 0x28, 0x27, 0x6d, 0x6f, 0x75, 0x73, 0x65, 0x75, 0x70,
+    0x27, 0x2c, 0x20, 0x28, 0x65, 0x76, 0x29, 0x20, 0x3d, 0x3e, 0x20, 0x7b,
+    0x0a, 0x09, 0x09, 0x09, 0x72, 0x65, 0x6c, 0x65, 0x61, 0x73, 0x65, 0x56,
+    0x69, 0x73, 0x75, 0x61, 0x6c, 0x4b, 0x65, 0x79, 0x73, 0x28, 0x5b, 0x6b,
+    0x5d, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74,
+    0x20, 0x6d, 0x73, 0x67, 0x20, 0x3d, 0x20, 0x62, 0x75, 0x69, 0x6c, 0x64,
+    0x4b, 0x65, 0x79, 0x4d, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x46, 0x72,
+    0x6f, 0x6d, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x28, 0x6b, 0x2c,
+    0x20, 0x22, 0x6b, 0x65, 0x79, 0x2d, 0x75, 0x70, 0x22, 0x2c, 0x20, 0x65,
+    0x76, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x73, 0x65, 0x6e, 0x64, 0x4d,
+    0x6f, 0x75, 0x73, 0x65, 0x4b, 0x65, 0x79, 0x54, 0x6f, 0x57, 0x53, 0x28,
+    0x6d, 0x73, 0x67, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x29, 0x3b, 0x0a,
+    0x09, 0x7d, 0x29, 0x3b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x6b, 0x65, 0x79,
+    0x62, 0x6f, 0x61, 0x72, 0x64, 0x20, 0x72, 0x65, 0x73, 0x69, 0x7a, 0x69,
+    0x6e, 0x67, 0x0a, 0x09, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e,
+    0x20, 0x72, 0x65, 0x73, 0x69, 0x7a, 0x65, 0x28, 0x6b, 0x65, 0x79, 0x62,
+    0x6f, 0x61, 0x72, 0x64, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x76, 0x61,
+    0x72, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x20, 0x3d, 0x20, 0x6b, 0x65, 0x79,
+    0x62, 0x6f, 0x61, 0x72, 0x64, 0x2e, 0x70, 0x61, 0x72, 0x65, 0x6e, 0x74,
+    0x4e, 0x6f, 0x64, 0x65, 0x2e, 0x63, 0x6c, 0x69, 0x65, 0x6e, 0x74, 0x57,
+    0x69, 0x64, 0x74, 0x68, 0x20, 0x2f, 0x20, 0x39, 0x30, 0x3b, 0x0a, 0x09,
+    0x09, 0x6b, 0x65, 0x79, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x2e, 0x73, 0x74,
+    0x79, 0x6c, 0x65, 0x2e, 0x66, 0x6f, 0x6e, 0x74, 0x53, 0x69, 0x7a, 0x65,
+    0x20, 0x3d, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x20, 0x2b, 0x20, 0x27, 0x70,
+    0x78, 0x27, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09, 0x76, 0x61, 0x72, 0x20,
+    0x6b, 0x65, 0x79, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x73, 0x20, 0x3d, 0x20,
+    0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74, 0x2e, 0x71, 0x75, 0x65,
+    0x72, 0x79, 0x53, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x41, 0x6c,
+    0x6c, 0x28, 0x27, 0x2e, 0x6b, 0x65, 0x79, 0x62, 0x6f, 0x61, 0x72, 0x64,
+    0x27, 0x29, 0x3b, 0x0a, 0x09, 0x77, 0x69, 0x6e, 0x64, 0x6f, 0x77, 0x2e,
     0x61, 0x64, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x4c, 0x69, 0x73, 0x74,
-    0x65, 0x6e, 0x65, 0x72, 0x28, 0x27, 0x6d, 0x6f, 0x75, 0x73, 0x65, 0x64,
-    0x6f, 0x77, 0x6e, 0x27, 0x2c, 0x20, 0x28, 0x65, 0x76, 0x29, 0x20, 0x3d,
-    0x3e, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74,
-    0x20, 0x63, 0x68, 0x61, 0x72, 0x53, 0x74, 0x72, 0x20, 0x3d, 0x20, 0x6b,
-    0x2e, 0x67, 0x65, 0x74, 0x41, 0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74,
-    0x65, 0x28, 0x22, 0x64, 0x61, 0x74, 0x61, 0x2d, 0x63, 0x68, 0x61, 0x72,
-    0x22, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x69, 0x66, 0x28, 0x21, 0x63,
-    0x68, 0x61, 0x72, 0x53, 0x74, 0x72, 0x29, 0x20, 0x72, 0x65, 0x74, 0x75,
-    0x72, 0x6e, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74,
-    0x20, 0x73, 0x70, 0x61, 0x6e, 0x20, 0x3d, 0x20, 0x6b, 0x2e, 0x71, 0x75,
-    0x65, 0x72, 0x79, 0x53, 0x65, 0x6c, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x28,
-    0x22, 0x73, 0x70, 0x61, 0x6e, 0x22, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09,
-    0x2f, 0x2f, 0x20, 0x74, 0x6f, 0x67, 0x67, 0x6c, 0x65, 0x20, 0x6a, 0x6f,
-    0x79, 0x73, 0x74, 0x69, 0x63, 0x6b, 0x20, 0x6d, 0x6f, 0x64, 0x65, 0x0a,
-    0x09, 0x09, 0x09, 0x69, 0x66, 0x28, 0x63, 0x68, 0x61, 0x72, 0x53, 0x74,
-    0x72, 0x2e, 0x65, 0x6e, 0x64, 0x73, 0x57, 0x69, 0x74, 0x68, 0x28, 0x22,
-    0x4a, 0x4f, 0x59, 0x4d, 0x4f, 0x44, 0x45, 0x32, 0x22, 0x29, 0x29, 0x20,
-    0x7b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x6b, 0x2e, 0x73, 0x65, 0x74, 0x41,
-    0x74, 0x74, 0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x28, 0x22, 0x64, 0x61,
-    0x74, 0x61, 0x2d, 0x63, 0x68, 0x61, 0x72, 0x22, 0x2c, 0x20, 0x22, 0x4a,
-    0x4f, 0x59, 0x4d, 0x4f, 0x44, 0x45, 0x31, 0x22, 0x29, 0x3b, 0x0a, 0x09,
-    0x09, 0x09, 0x09, 0x73, 0x70, 0x61, 0x6e, 0x2e, 0x69, 0x6e, 0x6e, 0x65,
-    0x72, 0x48, 0x54, 0x4d, 0x4c, 0x20, 0x3d, 0x20, 0x22, 0x4a, 0x4f, 0x59,
-    0x53, 0x54, 0x49, 0x43, 0x4b, 0x4d, 0x4f, 0x44, 0x45, 0x3c, 0x62, 0x72,
-    0x3e, 0x31, 0x20, 0x41, 0x43, 0x54, 0x49, 0x56, 0x45, 0x22, 0x3b, 0x0a,
-    0x09, 0x09, 0x09, 0x7d, 0x20, 0x65, 0x6c, 0x73, 0x65, 0x20, 0x69, 0x66,
-    0x28, 0x63, 0x68, 0x61, 0x72, 0x53, 0x74, 0x72, 0x2e, 0x65, 0x6e, 0x64,
-    0x73, 0x57, 0x69, 0x74, 0x68, 0x28, 0x22, 0x4a, 0x4f, 0x59, 0x4d, 0x4f,
-    0x44, 0x45, 0x31, 0x22, 0x29, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09,
-    0x09, 0x6b, 0x2e, 0x73, 0x65, 0x74, 0x41, 0x74, 0x74, 0x72, 0x69, 0x62,
-    0x75, 0x74, 0x65, 0x28, 0x22, 0x64, 0x61, 0x74, 0x61, 0x2d, 0x63, 0x68,
-    0x61, 0x72, 0x22, 0x2c, 0x20, 0x22, 0x4a, 0x4f, 0x59, 0x4d, 0x4f, 0x44,
-    0x45, 0x32, 0x22, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x09, 0x73, 0x70,
-    0x61, 0x6e, 0x2e, 0x69, 0x6e, 0x6e, 0x65, 0x72, 0x48, 0x54, 0x4d, 0x4c,
-    0x20, 0x3d, 0x20, 0x22, 0x4a, 0x4f, 0x59, 0x53, 0x54, 0x49, 0x43, 0x4b,
-    0x4d, 0x4f, 0x44, 0x45, 0x3c, 0x62, 0x72, 0x3e, 0x32, 0x20, 0x41, 0x43,
-    0x54, 0x49, 0x56, 0x45, 0x22, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x7d, 0x0a,
-    0x09, 0x09, 0x09, 0x70, 0x72, 0x65, 0x73, 0x73, 0x56, 0x69, 0x73, 0x75,
-    0x61, 0x6c, 0x4b, 0x65, 0x79, 0x73, 0x28, 0x5b, 0x6b, 0x5d, 0x29, 0x3b,
-    0x0a, 0x09, 0x09, 0x09, 0x63, 0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6d, 0x73,
-    0x67, 0x20, 0x3d, 0x20, 0x62, 0x75, 0x69, 0x6c, 0x64, 0x4b, 0x65, 0x79,
-    0x4d, 0x65, 0x73, 0x73, 0x61, 0x67, 0x65, 0x46, 0x72, 0x6f, 0x6d, 0x45,
-    0x6c, 0x65, 0x6d, 0x65, 0x6e, 0x74, 0x28, 0x6b, 0x2c, 0x20, 0x22, 0x6b,
-    0x65, 0x79, 0x2d, 0x64, 0x6f, 0x77, 0x6e, 0x22, 0x2c, 0x20, 0x65, 0x76,
-    0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x73, 0x65, 0x6e, 0x64, 0x4d, 0x6f,
-    0x75, 0x73, 0x65, 0x4b, 0x65, 0x79, 0x54, 0x6f, 0x57, 0x53, 0x28, 0x6d,
-    0x73, 0x67, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x7d, 0x29, 0x3b, 0x0a, 0x09,
-    0x09, 0x6b, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74, 0x4c,
-    0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x28, 0x27, 0x6d, 0x6f, 0x75,
-    0x73, 0x65, 0x75, 0x70, 0x27, 0x2c, 0x20, 0x28, 0x65, 0x76, 0x29, 0x20,
-    0x3d, 0x3e, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x09, 0x72, 0x65, 0x6c, 0x65,
-    0x61, 0x73, 0x65, 0x56, 0x69, 0x73, 0x75, 0x61, 0x6c, 0x4b, 0x65, 0x79,
-    0x73, 0x28, 0x5b, 0x6b, 0x5d, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x63,
-    0x6f, 0x6e, 0x73, 0x74, 0x20, 0x6d, 0x73, 0x67, 0x20, 0x3d, 0x20, 0x62,
-    0x75, 0x69, 0x6c, 0x64, 0x4b, 0x65, 0x79, 0x4d, 0x65, 0x73, 0x73, 0x61,
-    0x67, 0x65, 0x46, 0x72, 0x6f, 0x6d, 0x45, 0x6c, 0x65, 0x6d, 0x65, 0x6e,
-    0x74, 0x28, 0x6b, 0x2c, 0x20, 0x22, 0x6b, 0x65, 0x79, 0x2d, 0x75, 0x70,
-    0x22, 0x2c, 0x20, 0x65, 0x76, 0x29, 0x3b, 0x0a, 0x09, 0x09, 0x09, 0x73,
-    0x65, 0x6e, 0x64, 0x4d, 0x6f, 0x75, 0x73, 0x65, 0x4b, 0x65, 0x79, 0x54,
-    0x6f, 0x57, 0x53, 0x28, 0x6d, 0x73, 0x67, 0x29, 0x3b, 0x0a, 0x09, 0x09,
-    0x7d, 0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x29, 0x3b, 0x0a, 0x09, 0x2f, 0x2f,
-    0x20, 0x6b, 0x65, 0x79, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x20, 0x72, 0x65,
-    0x73, 0x69, 0x7a, 0x69, 0x6e, 0x67, 0x0a, 0x09, 0x66, 0x75, 0x6e, 0x63,
-    0x74, 0x69, 0x6f, 0x6e, 0x20, 0x72, 0x65, 0x73, 0x69, 0x7a, 0x65, 0x28,
-    0x6b, 0x65, 0x79, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x29, 0x20, 0x7b, 0x0a,
-    0x09, 0x09, 0x76, 0x61, 0x72, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x20, 0x3d,
-    0x20, 0x6b, 0x65, 0x79, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x2e, 0x70, 0x61,
-    0x72, 0x65, 0x6e, 0x74, 0x4e, 0x6f, 0x64, 0x65, 0x2e, 0x63, 0x6c, 0x69,
-    0x65, 0x6e, 0x74, 0x57, 0x69, 0x64, 0x74, 0x68, 0x20, 0x2f, 0x20, 0x39,
-    0x30, 0x3b, 0x0a, 0x09, 0x09, 0x6b, 0x65, 0x79, 0x62, 0x6f, 0x61, 0x72,
-    0x64, 0x2e, 0x73, 0x74, 0x79, 0x6c, 0x65, 0x2e, 0x66, 0x6f, 0x6e, 0x74,
-    0x53, 0x69, 0x7a, 0x65, 0x20, 0x3d, 0x20, 0x73, 0x69, 0x7a, 0x65, 0x20,
-    0x2b, 0x20, 0x27, 0x70, 0x78, 0x27, 0x3b, 0x0a, 0x09, 0x7d, 0x0a, 0x09,
-    0x76, 0x61, 0x72, 0x20, 0x6b, 0x65, 0x79, 0x62, 0x6f, 0x61, 0x72, 0x64,
-    0x73, 0x20, 0x3d, 0x20, 0x64, 0x6f, 0x63, 0x75, 0x6d, 0x65, 0x6e, 0x74,
-    0x2e, 0x71, 0x75, 0x65, 0x72, 0x79, 0x53, 0x65, 0x6c, 0x65, 0x63, 0x74,
-    0x6f, 0x72, 0x41, 0x6c, 0x6c, 0x28, 0x27, 0x2e, 0x6b, 0x65, 0x79, 0x62,
-    0x6f, 0x61, 0x72, 0x64, 0x27, 0x29, 0x3b, 0x0a, 0x09, 0x77, 0x69, 0x6e,
-    0x64, 0x6f, 0x77, 0x2e, 0x61, 0x64, 0x64, 0x45, 0x76, 0x65, 0x6e, 0x74,
-    0x4c, 0x69, 0x73, 0x74, 0x65, 0x6e, 0x65, 0x72, 0x28, 0x27, 0x72, 0x65,
-    0x73, 0x69, 0x7a, 0x65, 0x27, 0x2c, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74,
-    0x69, 0x6f, 0x6e, 0x28, 0x65, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x6b,
-    0x65, 0x79, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x73, 0x2e, 0x66, 0x6f, 0x72,
-    0x45, 0x61, 0x63, 0x68, 0x28, 0x6b, 0x62, 0x20, 0x3d, 0x3e, 0x20, 0x72,
-    0x65, 0x73, 0x69, 0x7a, 0x65, 0x28, 0x6b, 0x62, 0x29, 0x29, 0x3b, 0x0a,
-    0x09, 0x7d, 0x29, 0x3b, 0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x72, 0x65, 0x73,
-    0x69, 0x7a, 0x65, 0x0a, 0x09, 0x6b, 0x65, 0x79, 0x62, 0x6f, 0x61, 0x72,
-    0x64, 0x73, 0x2e, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28, 0x6b,
-    0x62, 0x20, 0x3d, 0x3e, 0x20, 0x72, 0x65, 0x73, 0x69, 0x7a, 0x65, 0x28,
-    0x6b, 0x62, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x3c, 0x2f, 0x73, 0x63, 0x72,
-    0x69, 0x70, 0x74, 0x3e, 0x0a, 0x3c, 0x2f, 0x62, 0x6f, 0x64, 0x79, 0x3e,
-    0x0a, 0x0a, 0x3c, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3e};
-unsigned int HTMLCSSKB_html_len = 18897;
+    0x65, 0x6e, 0x65, 0x72, 0x28, 0x27, 0x72, 0x65, 0x73, 0x69, 0x7a, 0x65,
+    0x27, 0x2c, 0x20, 0x66, 0x75, 0x6e, 0x63, 0x74, 0x69, 0x6f, 0x6e, 0x28,
+    0x65, 0x29, 0x20, 0x7b, 0x0a, 0x09, 0x09, 0x6b, 0x65, 0x79, 0x62, 0x6f,
+    0x61, 0x72, 0x64, 0x73, 0x2e, 0x66, 0x6f, 0x72, 0x45, 0x61, 0x63, 0x68,
+    0x28, 0x6b, 0x62, 0x20, 0x3d, 0x3e, 0x20, 0x72, 0x65, 0x73, 0x69, 0x7a,
+    0x65, 0x28, 0x6b, 0x62, 0x29, 0x29, 0x3b, 0x0a, 0x09, 0x7d, 0x29, 0x3b,
+    0x0a, 0x09, 0x2f, 0x2f, 0x20, 0x72, 0x65, 0x73, 0x69, 0x7a, 0x65, 0x0a,
+    0x09, 0x6b, 0x65, 0x79, 0x62, 0x6f, 0x61, 0x72, 0x64, 0x73, 0x2e, 0x66,
+    0x6f, 0x72, 0x45, 0x61, 0x63, 0x68, 0x28, 0x6b, 0x62, 0x20, 0x3d, 0x3e,
+    0x20, 0x72, 0x65, 0x73, 0x69, 0x7a, 0x65, 0x28, 0x6b, 0x62, 0x29, 0x29,
+    0x3b, 0x0a, 0x09, 0x3c, 0x2f, 0x73, 0x63, 0x72, 0x69, 0x70, 0x74, 0x3e,
+    0x0a, 0x3c, 0x2f, 0x62, 0x6f, 0x64, 0x79, 0x3e, 0x0a, 0x0a, 0x3c, 0x2f,
+    0x68, 0x74, 0x6d, 0x6c, 0x3e};
+unsigned int HTMLCSSKB_html_len = 22037;
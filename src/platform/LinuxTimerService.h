@@ -0,0 +1,238 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef LINUXTIMERSERVICE_H
+#define LINUXTIMERSERVICE_H
+
+#ifdef PLATFORM_LINUX
+#include "Platform.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <poll.h>
+#include <queue>
+#include <stdexcept>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <thread>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+/**
+ * @brief Periodic timers served by a single thread
+ *
+ * Deadlines are absolute (CLOCK_MONOTONIC): the next deadline of a timer is
+ * its last deadline plus the interval, so the period does not drift by the
+ * run time of the callback. The thread waits on a timerfd armed with the
+ * earliest deadline of a min-heap, an eventfd wakes it up when timers are
+ * added or cancelled. Missed periods are skipped and counted.
+ *
+ * Callbacks run on the timer thread one after the other. A callback may
+ * still be running when cancel() returns.
+ */
+class LinuxTimerService {
+public:
+  using TimerId = uint32_t;
+  using Stats = TimerStats;
+
+private:
+  struct Timer {
+    std::shared_ptr<std::function<void()>> fn; // kept alive while running
+    uint64_t intervalNS;
+    uint64_t deadlineNS;
+    Stats stats;
+  };
+
+  struct Deadline {
+    uint64_t timeNS;
+    TimerId id;
+    bool operator>(const Deadline &other) const {
+      return timeNS > other.timeNS;
+    }
+  };
+
+  std::mutex mutex;
+  std::map<TimerId, Timer> timers;
+  std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>>
+      heap; // may hold entries of cancelled timers
+  TimerId nextId = 1;
+  int timerFd = -1;
+  int wakeFd = -1;
+  bool running = false;
+  std::thread thread;
+
+  static uint64_t nowNS() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+  }
+
+  void wake() {
+    uint64_t one = 1;
+    if (write(wakeFd, &one, sizeof(one)) < 0) {
+      // counter overflow only, the thread is woken up anyway
+    }
+  }
+
+  // arms the timerfd with the earliest valid deadline, mutex must be held
+  void arm() {
+    while (!heap.empty()) {
+      auto it = timers.find(heap.top().id);
+      if ((it != timers.end()) && (it->second.deadlineNS == heap.top().timeNS)) {
+        break;
+      }
+      heap.pop();
+    }
+    struct itimerspec spec = {};
+    if (!heap.empty()) {
+      uint64_t t = heap.top().timeNS;
+      spec.it_value.tv_sec = t / 1000000000ULL;
+      spec.it_value.tv_nsec = t % 1000000000ULL;
+    }
+    timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+  }
+
+  void run() {
+    struct pollfd fds[2] = {{timerFd, POLLIN, 0}, {wakeFd, POLLIN, 0}};
+    std::vector<TimerId> due;
+    while (true) {
+      if (poll(fds, 2, -1) < 0) {
+        continue;
+      }
+      uint64_t count;
+      if ((fds[0].revents & POLLIN) &&
+          (read(timerFd, &count, sizeof(count)) < 0)) {
+        // EAGAIN after a re-arm, the deadlines are checked below anyway
+      }
+      if ((fds[1].revents & POLLIN) &&
+          (read(wakeFd, &count, sizeof(count)) < 0)) {
+        // already reset by another wake-up
+      }
+      std::unique_lock<std::mutex> lock(mutex);
+      if (!running) {
+        return;
+      }
+      uint64_t now = nowNS();
+      while (!heap.empty() && (heap.top().timeNS <= now)) {
+        Deadline d = heap.top();
+        heap.pop();
+        auto it = timers.find(d.id);
+        if ((it == timers.end()) || (it->second.deadlineNS != d.timeNS)) {
+          continue; // cancelled
+        }
+        Timer &timer = it->second;
+        uint64_t late = (now - d.timeNS) / 1000;
+        timer.stats.ticks++;
+        timer.stats.lateSumUS += late;
+        if (late > timer.stats.lateMaxUS) {
+          timer.stats.lateMaxUS = late;
+        }
+        uint64_t next = d.timeNS + timer.intervalNS;
+        if (next <= now) {
+          uint64_t missed = (now - d.timeNS) / timer.intervalNS;
+          timer.stats.skipped += missed;
+          next = d.timeNS + (missed + 1) * timer.intervalNS;
+        }
+        timer.deadlineNS = next;
+        heap.push({next, d.id});
+        due.push_back(d.id);
+      }
+      // callbacks without the lock, a timer cancelled by an earlier
+      // callback of this round is skipped
+      for (TimerId id : due) {
+        auto it = timers.find(id);
+        if (it == timers.end()) {
+          continue;
+        }
+        std::shared_ptr<std::function<void()>> fn = it->second.fn;
+        lock.unlock();
+        (*fn)();
+        lock.lock();
+      }
+      due.clear();
+      arm();
+    }
+  }
+
+public:
+  LinuxTimerService() = default;
+  LinuxTimerService(const LinuxTimerService &) = delete;
+  LinuxTimerService &operator=(const LinuxTimerService &) = delete;
+
+  /**
+   * @brief Adds a periodic timer, the first call is after one interval.
+   *
+   * @return id used by cancel() and getStats().
+   */
+  TimerId add(std::function<void()> fn, uint64_t intervalUS) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!running) {
+      timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK);
+      wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+      if ((timerFd < 0) || (wakeFd < 0)) {
+        throw std::runtime_error("timer service: timerfd/eventfd failed");
+      }
+      running = true;
+      thread = std::thread([this]() { run(); });
+    }
+    TimerId id = nextId++;
+    uint64_t intervalNS = (intervalUS ? intervalUS : 1) * 1000;
+    uint64_t deadline = nowNS() + intervalNS;
+    timers[id] =
+        Timer{std::make_shared<std::function<void()>>(std::move(fn)),
+              intervalNS, deadline, Stats{}};
+    heap.push({deadline, id});
+    wake();
+    return id;
+  }
+
+  void cancel(TimerId id) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (timers.erase(id) && running) {
+      wake();
+    }
+  }
+
+  bool getStats(TimerId id, Stats &stats) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = timers.find(id);
+    if (it == timers.end()) {
+      return false;
+    }
+    stats = it->second.stats;
+    return true;
+  }
+
+  ~LinuxTimerService() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!running) {
+        return;
+      }
+      running = false;
+      wake();
+    }
+    thread.join();
+    close(timerFd);
+    close(wakeFd);
+  }
+};
+#endif
+
+#endif // LINUXTIMERSERVICE_H
@@ -31,6 +31,16 @@
  */
 enum LogLevel { LOG_ERROR, LOG_WARN, LOG_INFO, LOG_DEBUG, LOG_VERBOSE };
 
+/**
+ * @brief Schedule statistics of an interval timer.
+ */
+struct TimerStats {
+  uint64_t ticks;      // callbacks run
+  uint64_t lateSumUS;  // sum of the delays behind the deadline
+  uint32_t lateMaxUS;  // largest delay
+  uint32_t skipped;    // periods skipped because of overruns
+};
+
 /**
  * @brief Interface for platform-dependent functionality.
  *
@@ -92,9 +102,19 @@ public:
    *
    * @param fn Callback function to be called periodically.
    * @param interval_us Timer interval in microseconds.
+   * @return Id for getTimerStats(), 0 if the platform has no statistics.
+   */
+  virtual uint32_t startIntervalTimer(std::function<void()> fn,
+                                      uint64_t interval_us) = 0;
+
+  /**
+   * @brief Returns the schedule statistics of an interval timer.
+   *
+   * @return false if there are none for id.
    */
-  virtual void startIntervalTimer(std::function<void()> fn,
-                                  uint64_t interval_us) = 0;
+  virtual bool getTimerStats(uint32_t /*id*/, TimerStats & /*stats*/) {
+    return false;
+  }
 
   /**
    * @brief Starts a new task on a specified CPU core with given priority.
@@ -102,9 +122,18 @@ public:
    * @param fn Task entry function.
    * @param core CPU core number (e.g., 0 or 1 on ESP32).
    * @param prio Task priority.
+   * @param name Task name (shown by debuggers and profilers).
    */
   virtual void startTask(std::function<void(void *)> fn, uint8_t core,
-                         uint8_t prio) = 0;
+                         uint8_t prio, const char *name) = 0;
+
+  /**
+   * @brief Allows the system to enter light sleep while all tasks are
+   * blocked (e.g. between two frames).
+   *
+   * @param enable true to allow light sleep.
+   */
+  virtual void setPowerSave(bool enable) = 0;
 
   virtual ~Platform(){};
 };
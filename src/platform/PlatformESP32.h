@@ -26,6 +26,9 @@
 #include <esp_cpu.h>
 #include <esp_random.h>
 #include <esp_timer.h>
+#ifdef CONFIG_PM_ENABLE
+#include <esp_pm.h>
+#endif
 #include <freertos/FreeRTOS.h>
 #include <memory>
 #include <mutex>
@@ -114,8 +117,8 @@ public:
 
   void feedWDT() override { vTaskDelay(1); }
 
-  void startIntervalTimer(std::function<void()> timerFunction,
-                          uint64_t interval_us) override {
+  uint32_t startIntervalTimer(std::function<void()> timerFunction,
+                              uint64_t interval_us) override {
     auto *ctx = new TimerContext{timerFunction};
     esp_timer_create_args_t timerArgs = {.callback = &genericCallback,
                                          .arg = ctx,
@@ -125,13 +128,32 @@ public:
     esp_timer_handle_t handle;
     ESP_ERROR_CHECK(esp_timer_create(&timerArgs, &handle));
     ESP_ERROR_CHECK(esp_timer_start_periodic(handle, interval_us));
+    return 0;
   }
 
   void startTask(std::function<void(void *)> taskFunction, uint8_t core,
-                 uint8_t prio) override {
+                 uint8_t prio, const char *name) override {
     auto *ctx = new TaskContext{std::move(taskFunction)};
-    xTaskCreatePinnedToCore(taskEntryPoint, "genericTask", 10000, ctx, prio,
-                            nullptr, core);
+    xTaskCreatePinnedToCore(taskEntryPoint, name, 10000, ctx, prio, nullptr,
+                            core);
+  }
+
+  void setPowerSave(bool enable) override {
+#ifdef CONFIG_PM_ENABLE
+    // keep the CPU frequency, only allow automatic light sleep
+    esp_pm_config_t config = {
+        .max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+        .min_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+        .light_sleep_enable = enable};
+    esp_err_t err = esp_pm_configure(&config);
+    if (err != ESP_OK) {
+      log(LOG_WARN, "PlatformESP32", "cannot configure light sleep: %s",
+          esp_err_to_name(err));
+    }
+#else
+    // power management not enabled in the SDK configuration
+    (void)enable;
+#endif
   }
 };
 #endif
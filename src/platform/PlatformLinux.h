@@ -18,18 +18,87 @@
 #define PLATFORMLINUX_H
 
 #ifdef PLATFORM_LINUX
+#include "../Config.h"
+#include "LinuxTimerService.h"
 #include "Platform.h"
+#include <algorithm>
+#include <cerrno>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <functional>
 #include <mutex>
+#include <pthread.h>
 #include <random>
+#include <sched.h>
+#include <string>
+#include <sys/resource.h>
+#include <sys/syscall.h>
 #include <thread>
 #include <time.h>
 #include <unistd.h>
 
 class PlatformLinux : public Platform {
+private:
+  LinuxTimerService timerService;
+
+  static constexpr const char *TAG = "PlatformLinux";
+
+  // nice value of a task: the CPU task (5) gets -4, background tasks (1, 2)
+  // get 4 and 2
+  static int niceFromPrio(uint8_t prio) { return (3 - prio) * 2; }
+
+  // Applies name, affinity and priority of a task to the calling thread.
+  // Whatever is not permitted is logged and left at the default.
+  void configureThread(const char *name, uint8_t core, uint8_t prio) {
+    char shortName[16]; // limit of the kernel incl. terminating 0
+    std::snprintf(shortName, sizeof(shortName), "%s", name);
+    pthread_setname_np(pthread_self(), shortName);
+
+    // core n is the n-th CPU the process may run on
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+      int count = CPU_COUNT(&allowed);
+      if (count > 1) {
+        int n = core % count;
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+          if (CPU_ISSET(cpu, &allowed) && (n-- == 0)) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            int err = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+            if (err) {
+              log(LOG_WARN, TAG, "%s: cannot pin to cpu %d: %s", name, cpu,
+                  std::strerror(err));
+            }
+            break;
+          }
+        }
+      }
+    }
+
+#ifdef LINUX_SCHED_FIFO
+    struct sched_param param = {};
+    param.sched_priority =
+        std::min(std::max<int>(prio, sched_get_priority_min(SCHED_FIFO)),
+                 sched_get_priority_max(SCHED_FIFO));
+    int err = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (err == 0) {
+      return;
+    }
+    log(LOG_WARN, TAG, "%s: SCHED_FIFO not permitted (%s), using nice", name,
+        std::strerror(err));
+#endif
+    // per thread on Linux, raising the priority needs CAP_SYS_NICE
+    pid_t tid = static_cast<pid_t>(syscall(SYS_gettid));
+    int niceValue = niceFromPrio(prio);
+    if (setpriority(PRIO_PROCESS, tid, niceValue) != 0) {
+      log(LOG_WARN, TAG, "%s: cannot set nice %d: %s", name, niceValue,
+          std::strerror(errno));
+    }
+  }
+
 public:
   PlatformLinux() = default;
 
@@ -66,21 +135,29 @@ public:
     // not needed on Linux
   }
 
-  void startIntervalTimer(std::function<void()> fn,
-                          uint64_t interval_us) override {
-    std::thread([fn, interval_us]() {
-      while (true) {
-        std::this_thread::sleep_for(std::chrono::microseconds(interval_us));
-        fn();
-      }
-    }).detach();
+  uint32_t startIntervalTimer(std::function<void()> fn,
+                              uint64_t interval_us) override {
+    return timerService.add(std::move(fn), interval_us);
+  }
+
+  bool getTimerStats(uint32_t id, TimerStats &stats) override {
+    return timerService.getStats(id, stats);
   }
 
-  void startTask(std::function<void(void *)> fn, uint8_t /*core*/,
-                 uint8_t /*prio*/) override {
-    std::thread([fn]() { fn(nullptr); }).detach();
+  LinuxTimerService &getTimerService() { return timerService; }
+
+  void startTask(std::function<void(void *)> fn, uint8_t core, uint8_t prio,
+                 const char *name) override {
+    std::string taskName(name);
+    std::thread([this, fn, core, prio, taskName]() {
+      configureThread(taskName.c_str(), core, prio);
+      fn(nullptr);
+    }).detach();
   }
 
+  // the host OS manages its idle states
+  void setPowerSave(bool /*enable*/) override {}
+
   ~PlatformLinux() override = default;
 };
 #endif
@@ -73,21 +73,24 @@ public:
     // not needed on Windows
   }
 
-  void startIntervalTimer(std::function<void()> fn,
-                          uint64_t interval_us) override {
+  uint32_t startIntervalTimer(std::function<void()> fn,
+                              uint64_t interval_us) override {
     std::thread([fn, interval_us]() {
       while (true) {
         std::this_thread::sleep_for(std::chrono::microseconds(interval_us));
         fn();
       }
     }).detach();
+    return 0;
   }
 
   void startTask(std::function<void(void *)> fn, uint8_t /*core*/,
-                 uint8_t /*prio*/) override {
+                 uint8_t /*prio*/, const char * /*name*/) override {
     std::thread([fn]() { fn(nullptr); }).detach();
   }
 
+  void setPowerSave(bool /*enable*/) override {}
+
   ~PlatformWindows() { timeEndPeriod(1); }
 };
 #endif
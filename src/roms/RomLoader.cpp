@@ -0,0 +1,214 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "RomLoader.h"
+#include "../Config.h"
+#include "../Crc32.h"
+#include "../fs/FileFactory.h"
+#include "../platform/PlatformManager.h"
+#include "atari_basic.h"
+#include "atarixl_os.h"
+#include <string>
+
+#if defined(ESP_PLATFORM) && !defined(USE_LINUXFS)
+#include <esp_partition.h>
+#endif
+
+static const char *TAG = "RomLoader";
+
+static const char *OSROMFILES[] = {"atarixl.rom", "ATARIXL.ROM",
+                                   "altirraos.rom", nullptr};
+static const char *BASICROMFILES[] = {"atbasic.rom", "ATBASIC.ROM",
+                                      "ataribas.rom", nullptr};
+
+struct KnownRom {
+  uint32_t crc32;
+  RomKind kind;
+  const char *name;
+};
+
+static const KnownRom KNOWNROMS[] = {
+    {0x1f9cd270, RomKind::OS, "Atari XL/XE OS Rev. 2"},
+    {0x29f133f7, RomKind::OS, "Atari XL/XE OS Rev. 3"},
+    {0x4bec4de2, RomKind::BASIC, "Atari BASIC Rev. A"},
+    {0xf0202fb3, RomKind::BASIC, "Atari BASIC Rev. B"},
+    {0x7d684184, RomKind::BASIC, "Atari BASIC Rev. C"},
+};
+
+#if defined(ESP_PLATFORM) && !defined(USE_LINUXFS)
+// Layout of the optional "roms" data partition
+static const char *ROMPARTITION = "roms";
+static const uint32_t PARTITIONOFFSET_OS = 0x0000;
+static const uint32_t PARTITIONOFFSET_BASIC = 0x4000;
+#endif
+
+static uint32_t romSize(RomKind kind) {
+  return (kind == RomKind::OS) ? ATARIXL_OS_SIZE : ATARI_BASIC_SIZE;
+}
+
+RomLoader::RomLoader() {
+  for (Mapping &m : mapping) {
+    m = {nullptr, 0, 0, false, MappedRegion()};
+  }
+}
+
+RomLoader::~RomLoader() {
+  release(RomKind::OS);
+  release(RomKind::BASIC);
+}
+
+void RomLoader::identify(RomKind kind, RomDescriptor &rom) {
+  rom.crc32 = Crc32::update(0, rom.data, rom.size);
+  rom.name = "unknown ROM";
+  for (const KnownRom &known : KNOWNROMS) {
+    if ((known.kind == kind) && (known.crc32 == rom.crc32)) {
+      rom.name = known.name;
+      break;
+    }
+  }
+}
+
+bool RomLoader::mapFile(RomKind kind, const char *file, RomDescriptor &rom) {
+  Mapping &m = mapping[static_cast<uint8_t>(kind)];
+  uint32_t size = romSize(kind);
+  std::string path = std::string(Config::PATH) + file;
+#if defined(USE_LINUXFS)
+  std::unique_ptr<FileDriver> fd = FileSys::create();
+  MappedRegion region;
+  if (!fd->init() || !fd->open(path, "rb") || (fd->size() != size) ||
+      !fd->mapRegion(0, size, region)) {
+    return false;
+  }
+  m = {region.data, size, 0, false, region};
+#elif defined(ESP_PLATFORM)
+  const esp_partition_t *part = esp_partition_find_first(
+      ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, ROMPARTITION);
+  uint32_t offset = (kind == RomKind::OS) ? PARTITIONOFFSET_OS
+                                          : PARTITIONOFFSET_BASIC;
+  if ((part == nullptr) || (part->size < offset + size)) {
+    return false;
+  }
+  std::unique_ptr<FileDriver> fd = FileSys::create();
+  if (!fd->init() || !fd->open(path, "rb") || (fd->size() != size)) {
+    return false;
+  }
+  uint8_t buf[1024];
+  uint32_t filecrc = 0;
+  for (uint32_t pos = 0; pos < size; pos += sizeof(buf)) {
+    if (fd->read(buf, sizeof(buf)) != sizeof(buf)) {
+      return false;
+    }
+    filecrc = Crc32::update(filecrc, buf, sizeof(buf));
+  }
+  const void *addr;
+  esp_partition_mmap_handle_t handle;
+  if (esp_partition_mmap(part, offset, size, ESP_PARTITION_MMAP_DATA, &addr,
+                         &handle) != ESP_OK) {
+    return false;
+  }
+  if (Crc32::update(0, addr, size) != filecrc) {
+    // partition content is outdated, copy ROM file into flash
+    PlatformManager::getInstance().log(LOG_INFO, TAG,
+                                       "writing %s to flash", file);
+    esp_partition_munmap(handle);
+    fd->seek(0, SEEK_SET);
+    if (esp_partition_erase_range(part, offset, size) != ESP_OK) {
+      return false;
+    }
+    for (uint32_t pos = 0; pos < size; pos += sizeof(buf)) {
+      if ((fd->read(buf, sizeof(buf)) != sizeof(buf)) ||
+          (esp_partition_write(part, offset + pos, buf, sizeof(buf)) !=
+           ESP_OK)) {
+        return false;
+      }
+    }
+    if (esp_partition_mmap(part, offset, size, ESP_PARTITION_MMAP_DATA,
+                           &addr, &handle) != ESP_OK) {
+      return false;
+    }
+  }
+  m = {addr, size, handle, false, MappedRegion()};
+#else
+  return false;
+#endif
+  rom.data = static_cast<const uint8_t *>(m.addr);
+  rom.size = size;
+  rom.source = RomSource::MAPPED;
+  return true;
+}
+
+bool RomLoader::loadFile(RomKind kind, const char *file, RomDescriptor &rom) {
+  Mapping &m = mapping[static_cast<uint8_t>(kind)];
+  uint32_t size = romSize(kind);
+  std::unique_ptr<FileDriver> fd = FileSys::create();
+  if (!fd->init() || !fd->open(std::string(Config::PATH) + file, "rb") ||
+      (fd->size() != size)) {
+    return false;
+  }
+  uint8_t *data = new uint8_t[size];
+  if (fd->read(data, size) != size) {
+    delete[] data;
+    return false;
+  }
+  m = {data, size, 0, true, MappedRegion()};
+  rom.data = data;
+  rom.size = size;
+  rom.source = RomSource::LOADED;
+  return true;
+}
+
+bool RomLoader::load(RomKind kind, RomDescriptor &rom) {
+  release(kind);
+  rom = RomDescriptor();
+  const char **files = (kind == RomKind::OS) ? OSROMFILES : BASICROMFILES;
+  bool found = false;
+  for (uint8_t i = 0; !found && files[i]; i++) {
+    found = mapFile(kind, files[i], rom);
+  }
+  for (uint8_t i = 0; !found && files[i]; i++) {
+    found = loadFile(kind, files[i], rom);
+  }
+  if (!found) {
+    rom.data = (kind == RomKind::OS) ? getAtariOSRom() : getAtariBasicRom();
+    rom.size = romSize(kind);
+    rom.source = RomSource::BUILTIN;
+  }
+  identify(kind, rom);
+  if (rom.source == RomSource::BUILTIN) {
+    rom.name = "built-in test ROM";
+  }
+  PlatformManager::getInstance().log(LOG_INFO, TAG, "%s: %s (crc %08x)",
+                                     (kind == RomKind::OS) ? "OS" : "BASIC",
+                                     rom.name, (unsigned)rom.crc32);
+  return rom.data != nullptr;
+}
+
+void RomLoader::release(RomKind kind) {
+  Mapping &m = mapping[static_cast<uint8_t>(kind)];
+  if (m.addr == nullptr) {
+    return;
+  }
+  if (m.heap) {
+    delete[] static_cast<const uint8_t *>(m.addr);
+  } else {
+#if defined(USE_LINUXFS)
+    FileSys::create()->unmapRegion(m.region);
+#elif defined(ESP_PLATFORM)
+    esp_partition_munmap(m.handle);
+#endif
+  }
+  m = {nullptr, 0, 0, false, MappedRegion()};
+}
@@ -0,0 +1,92 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef ROMLOADER_H
+#define ROMLOADER_H
+
+#include "../fs/FileDriver.h"
+#include <cstdint>
+
+enum class RomKind : uint8_t { OS, BASIC };
+
+enum class RomSource : uint8_t {
+  NONE,    // no ROM available
+  BUILTIN, // compiled-in test ROM
+  MAPPED,  // memory mapped file (Linux) or flash partition (ESP32)
+  LOADED   // read from the filesystem into the heap
+};
+
+/**
+ * @brief Describes a ROM image used by Atari800Sys.
+ *
+ * The memory referenced by data is owned by the RomLoader which created the
+ * descriptor.
+ */
+struct RomDescriptor {
+  const uint8_t *data = nullptr;
+  uint32_t size = 0;
+  uint32_t crc32 = 0;
+  const char *name = "none";
+  RomSource source = RomSource::NONE;
+};
+
+/**
+ * @brief Loads the OS and BASIC ROMs at runtime.
+ *
+ * The ROM files are searched in Config::PATH (see OSROMFILES and
+ * BASICROMFILES in RomLoader.cpp) and identified by their CRC-32.
+ * - Linux: the file is memory mapped, no copy is made.
+ * - ESP32: if a data partition labelled "roms" exists, the ROM files are
+ *   copied into it (only if its content differs) and the partition is
+ *   memory mapped, so ROMs do not occupy RAM. Without such a partition the
+ *   file is read into the heap.
+ * If no ROM file is found, the compiled-in test ROMs are used.
+ */
+class RomLoader {
+private:
+  struct Mapping {
+    const void *addr;
+    uint32_t size;
+    uint32_t handle;
+    bool heap;
+    MappedRegion region; // Linux: region mapped by the FileDriver
+  };
+  Mapping mapping[2];
+
+  bool mapFile(RomKind kind, const char *file, RomDescriptor &rom);
+  bool loadFile(RomKind kind, const char *file, RomDescriptor &rom);
+  static void identify(RomKind kind, RomDescriptor &rom);
+
+public:
+  RomLoader();
+  ~RomLoader();
+
+  /**
+   * @brief Loads the ROM of the given kind.
+   *
+   * @param kind OS or BASIC ROM.
+   * @param rom Receives the descriptor of the ROM.
+   * @return false if no ROM is available (only possible for BASIC).
+   */
+  bool load(RomKind kind, RomDescriptor &rom);
+
+  /**
+   * @brief Releases the ROM of the given kind.
+   */
+  void release(RomKind kind);
+};
+
+#endif // ROMLOADER_H
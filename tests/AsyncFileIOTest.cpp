@@ -0,0 +1,207 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "TestCheck.h"
+#include "fs/AsyncFileIO.h"
+#include "platform/PlatformLinux.h"
+#include "platform/PlatformManager.h"
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <thread>
+#include <vector>
+
+/**
+ * Host test of AsyncFileIO: requests complete in submission order, reads
+ * see earlier writes, results and callbacks, synchronous execution before
+ * start(). Measures the time per request through the I/O task.
+ */
+
+// file in memory
+class MemFile : public FileDriver {
+private:
+  std::vector<uint8_t> data;
+  size_t pos = 0;
+
+public:
+  bool open(const std::string & /*path*/, const char * /*mode*/) override {
+    pos = 0;
+    return true;
+  }
+  size_t read(void *buffer, size_t count) override {
+    size_t n = (pos < data.size()) ? std::min(count, data.size() - pos) : 0;
+    memcpy(buffer, data.data() + pos, n);
+    pos += n;
+    return n;
+  }
+  size_t write(const void *buffer, size_t count) override {
+    if (data.size() < pos + count) {
+      data.resize(pos + count);
+    }
+    memcpy(data.data() + pos, buffer, count);
+    pos += count;
+    return count;
+  }
+  bool seek(long offset, int origin) override {
+    if (origin != SEEK_SET) {
+      return false;
+    }
+    pos = offset;
+    return true;
+  }
+  long tell() const override { return pos; }
+  bool eof() override { return pos >= data.size(); }
+  int64_t size() override { return data.size(); }
+  void close() override {}
+};
+
+static void testBeforeStart() {
+  AsyncFileIO io;
+  MemFile file;
+  std::thread::id caller = std::this_thread::get_id();
+  std::thread::id executor;
+  const char text[] = "atari";
+  AsyncFileIO::Ticket t = io.write(
+      &file, 0, text, sizeof(text),
+      [&executor](AsyncFileIO::Request &) {
+        executor = std::this_thread::get_id();
+      });
+  // executed by the calling task
+  CHECK(AsyncFileIO::isDone(t));
+  CHECK(t->ok && (t->result == sizeof(text)));
+  CHECK(executor == caller);
+  char buf[sizeof(text)] = {};
+  t = io.read(&file, 0, buf, sizeof(buf));
+  CHECK(AsyncFileIO::isDone(t) && t->ok && (strcmp(buf, text) == 0));
+  CHECK(io.pending() == 0);
+}
+
+static void testOrder(AsyncFileIO &io) {
+  MemFile file;
+
+  // block the I/O task until all requests are queued
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  AsyncFileIO::Ticket gate = io.call([released]() {
+    released.wait();
+    return true;
+  });
+
+  const int n = 300;
+  std::vector<int> order;
+  std::vector<AsyncFileIO::Ticket> tickets;
+  std::vector<uint32_t> values(n);
+  std::vector<uint32_t> readBack(n, 0xffffffff);
+  std::thread::id caller = std::this_thread::get_id();
+  bool onCaller = false;
+  for (int i = 0; i < n; i++) {
+    auto record = [&order, &onCaller, caller, i](AsyncFileIO::Request &) {
+      order.push_back(i);
+      onCaller |= (std::this_thread::get_id() == caller);
+    };
+    values[i] = i * 2654435761u;
+    int slot = i / 3;
+    switch (i % 3) {
+    case 0:
+      // overwritten by later writes to the same slot
+      tickets.push_back(io.write(&file, slot * 4, &values[i], 4, record));
+      break;
+    case 1:
+      // reads the write just before
+      tickets.push_back(io.read(&file, slot * 4, &readBack[i], 4, record));
+      break;
+    default:
+      tickets.push_back(
+          io.call([i]() { return (i % 2) == 0; }, record));
+      break;
+    }
+  }
+  CHECK(!AsyncFileIO::isDone(tickets.back()));
+  // the gate itself may not have been taken yet
+  CHECK((io.pending() == (size_t)n) || (io.pending() == (size_t)n + 1));
+  release.set_value();
+  io.wait(tickets.back());
+  CHECK(io.pending() == 0);
+
+  // completion in submission order, on the I/O task
+  bool inOrder = (order.size() == (size_t)n);
+  for (int i = 0; inOrder && (i < n); i++) {
+    inOrder = (order[i] == i);
+  }
+  CHECK(inOrder);
+  CHECK(!onCaller);
+  CHECK(AsyncFileIO::isDone(gate) && gate->ok);
+  int wrong = 0;
+  for (int i = 0; i < n; i++) {
+    const AsyncFileIO::Request &r = *tickets[i];
+    wrong += !AsyncFileIO::isDone(tickets[i]);
+    switch (i % 3) {
+    case 0:
+      wrong += !r.ok || (r.result != 4);
+      break;
+    case 1:
+      wrong += !r.ok || (readBack[i] != values[i - 1]);
+      break;
+    default:
+      wrong += (r.ok != ((i % 2) == 0));
+      break;
+    }
+  }
+  CHECK(wrong == 0);
+
+  // reading past the end completes with the bytes read
+  uint8_t buf[16];
+  AsyncFileIO::Ticket t = io.read(&file, file.size() - 2, buf, sizeof(buf));
+  io.wait(t);
+  CHECK(!t->ok && (t->result == 2));
+}
+
+static void bench(AsyncFileIO &io) {
+  MemFile file;
+  uint8_t block[512] = {};
+  const int n = 20000;
+  AsyncFileIO::Ticket last;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < n; i++) {
+    last = io.write(&file, (i % 64) * sizeof(block), block, sizeof(block));
+  }
+  io.wait(last);
+  auto queued = std::chrono::steady_clock::now();
+  for (int i = 0; i < 2000; i++) {
+    io.wait(io.read(&file, (i % 64) * sizeof(block), block, sizeof(block)));
+  }
+  auto stop = std::chrono::steady_clock::now();
+  printf("AsyncFileIO: %.2f us per queued 512 byte write, %.2f us per "
+         "waited read\n",
+         std::chrono::duration<double, std::micro>(queued - start).count() / n,
+         std::chrono::duration<double, std::micro>(stop - queued).count() /
+             2000);
+}
+
+int main() {
+  PlatformManager::initialize(new PlatformLinux());
+  testBeforeStart();
+  // the I/O task runs until the program ends, like in the emulator, so the
+  // service is never destroyed
+  AsyncFileIO *io = new AsyncFileIO();
+  io->start();
+  testOrder(*io);
+  if (testResult("AsyncFileIOTest")) {
+    return 1;
+  }
+  bench(*io);
+  return 0;
+}
@@ -0,0 +1,190 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "FramePacer.h"
+#include "TestCheck.h"
+#include "platform/PlatformLinux.h"
+#include "platform/PlatformManager.h"
+#include <cstdarg>
+#include <string>
+#include <vector>
+
+/**
+ * Host test of FramePacer with a simulated clock: the published
+ * percentiles, maximum, histogram and shares for steady, jittering and
+ * stalled emulation, dropped frames, other frame rates and power save.
+ * Measures the pacing of the host clock at 250 Hz.
+ */
+
+// simulated clock, each reading takes 1 us (ends the spin loop), waitMS
+// sleeps exactly, captures the log
+class TestPlatform : public PlatformLinux {
+public:
+  int64_t timeUS = 1000000;
+  std::vector<std::string> lines;
+
+  void log(LogLevel /*level*/, const char * /*tag*/, const char *format,
+           ...) override {
+    char buf[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    lines.push_back(buf);
+  }
+
+  int64_t getTimeUS() override { return timeUS++; }
+
+  void waitMS(uint32_t ms) override { timeUS += ms * 1000; }
+};
+
+static TestPlatform *platform;
+
+// emulates frames taking workUS each, true if the last one published
+static bool run(FramePacer &pacer, int frames, uint32_t workUS) {
+  bool published = false;
+  for (int i = 0; i < frames; i++) {
+    platform->timeUS += workUS;
+    published = pacer.wait();
+  }
+  return published;
+}
+
+static bool near(uint32_t value, uint32_t expected, uint32_t tolerance) {
+  return (value + tolerance >= expected) && (value <= expected + tolerance);
+}
+
+static void testSteady() {
+  FramePacer pacer;
+  pacer.reset();
+  // published with the last frame of a window only
+  CHECK(!run(pacer, FramePacer::WINDOWFRAMES - 1, 5000));
+  CHECK(pacer.intervalP50US == 0);
+  CHECK(run(pacer, 1, 5000));
+  CHECK(pacer.intervalP50US == 20000);
+  CHECK(pacer.intervalP99US == 20000);
+  CHECK(near(pacer.intervalMaxUS, 20000, 10));
+  CHECK(pacer.intervalHistogram[FramePacer::CENTERBUCKET] ==
+        FramePacer::WINDOWFRAMES);
+  // 5 ms emulation, 14 ms sleep, 1 ms spin per 20 ms frame
+  CHECK(near(pacer.loadPercent, 25, 1));
+  CHECK(near(pacer.sleepPercent, 70, 1));
+  CHECK(near(pacer.spinPercent, 5, 1));
+  CHECK(pacer.droppedFrames == 0);
+  CHECK(!run(pacer, FramePacer::WINDOWFRAMES - 1, 5000));
+  CHECK(run(pacer, 1, 5000));
+}
+
+static void testJitter() {
+  FramePacer pacer;
+  pacer.reset();
+  // every 50th frame is 3 ms late, the next one catches up
+  for (int i = 0; i < FramePacer::WINDOWFRAMES; i++) {
+    run(pacer, 1, (i % 50 == 10) ? 23000 : 5000);
+  }
+  CHECK(pacer.intervalP50US == 20000);
+  CHECK(pacer.intervalP99US == 23000);
+  CHECK(near(pacer.intervalMaxUS, 23000, 10));
+  CHECK(pacer.intervalHistogram[FramePacer::CENTERBUCKET] ==
+        FramePacer::WINDOWFRAMES - 10);
+  CHECK(pacer.intervalHistogram[FramePacer::CENTERBUCKET + 12] == 5);
+  CHECK(pacer.intervalHistogram[FramePacer::CENTERBUCKET - 12] == 5);
+  CHECK(pacer.droppedFrames == 0);
+}
+
+static void testStall() {
+  FramePacer pacer;
+  pacer.reset();
+  // 60 ms behind: caught up within the next frames, 200 ms behind: the
+  // schedule restarts and drops 9 frames
+  run(pacer, 100, 5000);
+  run(pacer, 1, 80000);
+  run(pacer, 100, 5000);
+  run(pacer, 1, 200000);
+  CHECK(run(pacer, 48, 5000));
+  CHECK(pacer.droppedFrames == 9);
+  CHECK(near(pacer.intervalMaxUS, 200000, 10));
+  // both stalls beyond the last bucket, four frames at 5 ms catch up
+  // after the first one, less than 1% of the intervals are off
+  CHECK(pacer.intervalHistogram[FramePacer::NUMBUCKETS - 1] == 2);
+  CHECK(pacer.intervalHistogram[0] == 4);
+  CHECK(pacer.intervalP50US == 20000);
+  CHECK(pacer.intervalP99US == 20000);
+}
+
+static void testFrameRate() {
+  FramePacer pacer;
+  pacer.setFrameRate(60);
+  CHECK(run(pacer, FramePacer::WINDOWFRAMES, 5000));
+  CHECK(pacer.intervalP50US == 16666);
+  CHECK(pacer.intervalP99US == 16666);
+  CHECK(pacer.intervalHistogram[FramePacer::CENTERBUCKET] ==
+        FramePacer::WINDOWFRAMES);
+}
+
+static void testPowerSave() {
+  FramePacer pacer;
+  pacer.setPowerSave(true);
+  pacer.reset();
+  CHECK(run(pacer, FramePacer::WINDOWFRAMES, 5000));
+  CHECK(pacer.spinPercent == 0);
+  CHECK(near(pacer.sleepPercent, 75, 1));
+  CHECK(pacer.intervalP50US == 20000);
+}
+
+static void testLog() {
+  FramePacer pacer;
+  pacer.reset();
+  run(pacer, FramePacer::WINDOWFRAMES, 5000);
+  platform->lines.clear();
+  pacer.log();
+  CHECK(platform->lines.size() == 2);
+  CHECK(platform->lines[0] ==
+        "frame interval p50=20000 p99=20000 max=20001 [us], dropped=0, "
+        "load/sleep/spin=25/70/4%");
+  CHECK(platform->lines[1] ==
+        "histogram (250 us buckets from 16000 us): 0 0 0 0 0 0 0 0 0 0 0 0 0 "
+        "0 0 0 250 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0 0");
+}
+
+static void bench() {
+  PlatformManager::initialize(new PlatformLinux());
+  FramePacer pacer;
+  pacer.setFrameRate(250);
+  while (!pacer.wait()) {
+  }
+  printf("FramePacer: 250 Hz on the host clock, interval p50=%u p99=%u "
+         "max=%u us, sleep/spin=%u/%u%%\n",
+         (unsigned)pacer.intervalP50US, (unsigned)pacer.intervalP99US,
+         (unsigned)pacer.intervalMaxUS, (unsigned)pacer.sleepPercent,
+         (unsigned)pacer.spinPercent);
+}
+
+int main() {
+  platform = new TestPlatform();
+  PlatformManager::initialize(platform);
+  testSteady();
+  testJitter();
+  testStall();
+  testFrameRate();
+  testPowerSave();
+  testLog();
+  if (testResult("FramePacerTest")) {
+    return 1;
+  }
+  bench();
+  return 0;
+}
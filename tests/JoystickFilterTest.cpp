@@ -0,0 +1,164 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "TestCheck.h"
+#include "joystick/JoystickFilter.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * Host test and benchmark of JoystickFilter (noise, hysteresis, glitch
+ * rejection, time per block). A block has 4 samples per axis, like one DMA
+ * frame of ADCJoystick.
+ */
+
+static const uint8_t CENTERED = 0x0f;
+static const uint8_t RIGHT = 0x0f & ~(1 << JoystickFilter::JOYRIGHT);
+static const uint8_t DOWN = 0x0f & ~(1 << JoystickFilter::JOYDOWN);
+static const int SAMPLESPERBLOCK = 4;
+
+static uint16_t noisy(int value, int noise) {
+  if (noise) {
+    value += rand() % (2 * noise + 1) - noise;
+  }
+  return (value < 0) ? 0 : ((value > 4095) ? 4095 : value);
+}
+
+static bool block(JoystickFilter &filter, int x, int y, int noise = 0) {
+  for (int i = 0; i < SAMPLESPERBLOCK; i++) {
+    filter.add(JoystickFilter::AXIS_X, noisy(x, noise));
+    filter.add(JoystickFilter::AXIS_Y, noisy(y, noise));
+  }
+  return filter.endBlock();
+}
+
+// blocks needed until the published directions equal expected
+static int blocksUntil(JoystickFilter &filter, int x, int y, int noise,
+                       uint8_t expected) {
+  for (int n = 1; n <= 100; n++) {
+    block(filter, x, y, noise);
+    if (filter.getDirections() == expected) {
+      return n;
+    }
+  }
+  return -1;
+}
+
+static void testNoise() {
+  JoystickFilter filter;
+  srand(1);
+  // noise of a cheap stick around the center never publishes a direction
+  int changes = 0;
+  for (int i = 0; i < 10000; i++) {
+    changes += block(filter, 2048, 2048, 600);
+  }
+  CHECK(changes == 0);
+  CHECK(filter.getDirections() == CENTERED);
+  // a noisy deflection is published after a few blocks and then stays
+  int n = blocksUntil(filter, 4000, 2048, 300, RIGHT);
+  CHECK((n > 0) && (n <= 4));
+  changes = 0;
+  for (int i = 0; i < 10000; i++) {
+    changes += block(filter, 4000, 2048, 300);
+  }
+  CHECK(changes == 0);
+  CHECK(filter.getDirections() == RIGHT);
+  // low y means down
+  n = blocksUntil(filter, 2048, 100, 300, DOWN);
+  CHECK((n > 0) && (n <= 6));
+}
+
+static void testHysteresis() {
+  JoystickFilter filter;
+  // between release (3200) and press (3500) threshold: keeps the state
+  for (int i = 0; i < 20; i++) {
+    block(filter, 3350, 2048);
+  }
+  CHECK(filter.getDirections() == CENTERED);
+  CHECK(blocksUntil(filter, 4095, 2048, 0, RIGHT) > 0);
+  for (int i = 0; i < 20; i++) {
+    block(filter, 3350, 2048);
+  }
+  CHECK(filter.getDirections() == RIGHT);
+  // below the release threshold the stick is centered again
+  CHECK(blocksUntil(filter, 3000, 2048, 0, CENTERED) > 0);
+  // noise around the press threshold does not toggle once pressed
+  CHECK(blocksUntil(filter, 4095, 2048, 0, RIGHT) > 0);
+  srand(2);
+  int changes = 0;
+  for (int i = 0; i < 10000; i++) {
+    changes += block(filter, 3500, 2048, 150);
+  }
+  CHECK(changes == 0);
+  CHECK(filter.getDirections() == RIGHT);
+}
+
+static void testGlitch() {
+  JoystickFilter filter;
+  // a single full scale block is absorbed by the low pass
+  CHECK(!block(filter, 4095, 2048));
+  CHECK(!block(filter, 2048, 2048));
+  for (int i = 0; i < 10; i++) {
+    block(filter, 2048, 2048);
+  }
+  // two full scale blocks cross the threshold for one block only, which is
+  // rejected by the debounce
+  bool changed = block(filter, 4095, 2048);
+  changed |= block(filter, 4095, 2048);
+  changed |= block(filter, 2048, 2048);
+  for (int i = 0; i < 10; i++) {
+    changed |= block(filter, 2048, 2048);
+  }
+  CHECK(!changed);
+  CHECK(filter.getDirections() == CENTERED);
+  // a block without samples keeps the state
+  CHECK(blocksUntil(filter, 4095, 2048, 0, RIGHT) > 0);
+  CHECK(!filter.endBlock());
+  CHECK(filter.getDirections() == RIGHT);
+  CHECK(filter.getPosition(JoystickFilter::AXIS_X) > 3500);
+}
+
+static void bench() {
+  const int blocks = 2000000;
+  JoystickFilter filter;
+  uint32_t changes = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < blocks; i++) {
+    // full swing every 256 blocks
+    int x = (i & 0x80) ? 4000 : 100;
+    for (int k = 0; k < SAMPLESPERBLOCK; k++) {
+      filter.add(JoystickFilter::AXIS_X, x + (k << 3));
+      filter.add(JoystickFilter::AXIS_Y, 2048 - (k << 3));
+    }
+    changes += filter.endBlock();
+  }
+  auto stop = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+  printf("JoystickFilter: %.1f ns per block of %d samples (%u changes)\n",
+         ns / blocks, 2 * SAMPLESPERBLOCK, changes);
+}
+
+int main() {
+  testNoise();
+  testHysteresis();
+  testGlitch();
+  if (testResult("JoystickFilterTest")) {
+    return 1;
+  }
+  bench();
+  return 0;
+}
@@ -0,0 +1,278 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "LatencyTrace.h"
+#include "TestCheck.h"
+#include "keyboard/AtariKeycodes.h"
+#include "platform/PlatformLinux.h"
+#include "platform/PlatformManager.h"
+#include <chrono>
+#include <cstdarg>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * Host test of the input latency instrumentation: the stage transitions of
+ * a traced event, register matching, skipped events, timeouts, the sample
+ * ring and the reported percentiles. The host time is simulated, the
+ * reports are captured from the log. Measures ioRead and frameEnd, which
+ * run on the CPU task.
+ */
+
+// simulated clock, captures the log
+class TestPlatform : public PlatformLinux {
+public:
+  int64_t timeUS = 0;
+  std::vector<std::string> lines;
+
+  void log(LogLevel /*level*/, const char * /*tag*/, const char *format,
+           ...) override {
+    char buf[256];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    lines.push_back(buf);
+  }
+
+  int64_t getTimeUS() override { return timeUS; }
+};
+
+static TestPlatform *platform;
+
+// a frame of the size of the emulator bitmap
+static uint16_t bitmap[320 * 192];
+
+static void frame(LatencyTrace &trace, bool changed) {
+  if (changed) {
+    bitmap[0]++;
+  }
+  trace.frameEnd(reinterpret_cast<uint8_t *>(bitmap), sizeof(bitmap));
+}
+
+// runs frames without changes up to the next report
+static void toReport(LatencyTrace &trace) {
+  platform->lines.clear();
+  do {
+    frame(trace, false);
+  } while (trace.getFrame() % 500 != 0);
+}
+
+// last reported line starting with prefix
+static std::string reported(const char *prefix) {
+  std::string line;
+  for (const std::string &l : platform->lines) {
+    if (l.compare(0, strlen(prefix), prefix) == 0) {
+      line = l;
+    }
+  }
+  return line;
+}
+
+// one keyboard event through all stages: arrival at t, applied at cycle,
+// read after readCycles and readUS, displayed displayUS after the read
+static void keyEvent(LatencyTrace &trace, uint64_t cycle, uint32_t readCycles,
+                     uint32_t readUS, uint32_t displayUS) {
+  uint32_t arrival = platform->timeUS;
+  trace.applied(LatencyTrace::Source::KEYBOARD,
+                LatencyTrace::Register::KBCODE, arrival, cycle);
+  platform->timeUS += readUS;
+  trace.ioRead(0xd209, cycle + readCycles);
+  frame(trace, true);
+  uint32_t request = trace.takeDisplayRequest();
+  CHECK(request == trace.getFrame());
+  CHECK(trace.takeDisplayRequest() == 0);
+  platform->timeUS += displayUS;
+  trace.framePushed(request);
+  frame(trace, false);
+  platform->timeUS += 1000;
+}
+
+static void testEvent() {
+  LatencyTrace trace;
+  platform->timeUS = 1000;
+  keyEvent(trace, 100, 250, 500, 2500);
+  toReport(trace);
+  CHECK(reported("keyboard apply->read [cycles]: ") ==
+        "keyboard apply->read [cycles]: n=1 min=250 p50=250 p90=250 max=250");
+  CHECK(reported("keyboard arrival->read [us]: ") ==
+        "keyboard arrival->read [us]: n=1 min=500 p50=500 p90=500 max=500");
+  CHECK(reported("keyboard read->display [us]: ") ==
+        "keyboard read->display [us]: n=1 min=2500 p50=2500 p90=2500 "
+        "max=2500");
+  CHECK(reported("keyboard arrival->display [us]: ") ==
+        "keyboard arrival->display [us]: n=1 min=3000 p50=3000 p90=3000 "
+        "max=3000");
+  CHECK(reported("joystick").empty());
+  CHECK(reported("keyboard: ").empty());
+}
+
+static void testPercentiles() {
+  LatencyTrace trace;
+  // read latencies 100, 200, ..., 1000 cycles in shuffled order
+  const uint32_t order[] = {7, 2, 10, 1, 5, 9, 3, 8, 4, 6};
+  for (uint32_t n : order) {
+    keyEvent(trace, 1000 * n, 100 * n, 10, 10);
+  }
+  toReport(trace);
+  CHECK(reported("keyboard apply->read") ==
+        "keyboard apply->read [cycles]: n=10 min=100 p50=600 p90=1000 "
+        "max=1000");
+
+  // the ring keeps the last 256 samples: 300 events with 1..300 cycles
+  // leave 45..300
+  LatencyTrace ring;
+  for (uint32_t n = 1; n <= 300; n++) {
+    keyEvent(ring, 0, n, 10, 10);
+  }
+  toReport(ring);
+  CHECK(reported("keyboard apply->read") ==
+        "keyboard apply->read [cycles]: n=256 min=45 p50=173 p90=275 "
+        "max=300");
+}
+
+static void testRegisters() {
+  LatencyTrace trace;
+  trace.applied(LatencyTrace::Source::JOYSTICK, LatencyTrace::Register::PORTA,
+                0, 0);
+  // other registers, PORTB and the PIA control registers don't complete it
+  trace.ioRead(0xd209, 10);
+  trace.ioRead(0xd010, 10);
+  trace.ioRead(0xd01f, 10);
+  trace.ioRead(0xd301, 10);
+  trace.ioRead(0xd302, 10);
+  // a mirror of PORTA does
+  trace.ioRead(0xd304, 20);
+  trace.ioRead(0xd300, 30);
+  toReport(trace);
+  CHECK(reported("joystick apply->read") ==
+        "joystick apply->read [cycles]: n=1 min=20 p50=20 p90=20 max=20");
+
+  // TRIG0-3 and the mirrors of CONSOL
+  LatencyTrace trig;
+  trig.applied(LatencyTrace::Source::JOYSTICK, LatencyTrace::Register::TRIG,
+               0, 0);
+  trig.applied(LatencyTrace::Source::KEYBOARD, LatencyTrace::Register::CONSOL,
+               0, 0);
+  trig.ioRead(0xd014, 5);
+  trig.ioRead(0xd013, 7);
+  trig.ioRead(0xd03f, 9);
+  toReport(trig);
+  CHECK(reported("joystick apply->read") ==
+        "joystick apply->read [cycles]: n=1 min=7 p50=7 p90=7 max=7");
+  CHECK(reported("keyboard apply->read") ==
+        "keyboard apply->read [cycles]: n=1 min=9 p50=9 p90=9 max=9");
+}
+
+static void testJoystick() {
+  LatencyTrace trace;
+  platform->timeUS = 5000;
+  // an unchanged poll keeps the arrival time
+  trace.joystickPolled(0xff);
+  platform->timeUS = 6000;
+  trace.joystickPolled(0xf7);
+  platform->timeUS = 7000;
+  trace.joystickPolled(0xf7);
+  // a stick direction is traced at PORTA
+  trace.joystickLatched(0xf7, 100);
+  platform->timeUS = 8000;
+  trace.ioRead(0xd300, 400);
+  // the trigger at TRIG
+  trace.joystickLatched(0xf7 & 0xef, 500);
+  toReport(trace);
+  CHECK(reported("joystick apply->read") ==
+        "joystick apply->read [cycles]: n=1 min=300 p50=300 p90=300 max=300");
+  CHECK(reported("joystick arrival->read") ==
+        "joystick arrival->read [us]: n=1 min=2000 p50=2000 p90=2000 "
+        "max=2000");
+  CHECK(reported("joystick: ") == "joystick: 1 skipped, 1 timeouts");
+}
+
+static void testSkippedAndTimeouts() {
+  LatencyTrace trace;
+  trace.applied(LatencyTrace::Source::KEYBOARD, LatencyTrace::Register::KBCODE,
+                0, 0);
+  trace.applied(LatencyTrace::Source::KEYBOARD, LatencyTrace::Register::KBCODE,
+                0, 10);
+  trace.applied(LatencyTrace::Source::KEYBOARD, LatencyTrace::Register::CONSOL,
+                0, 20);
+  // never read: given up after 50 frames
+  for (int i = 0; i < 51; i++) {
+    frame(trace, true);
+  }
+  // a read after the timeout is not counted
+  trace.ioRead(0xd209, 100);
+  // read but without a visible change
+  trace.applied(LatencyTrace::Source::KEYBOARD, LatencyTrace::Register::KBCODE,
+                0, 200);
+  trace.ioRead(0xd209, 300);
+  toReport(trace);
+  CHECK(reported("keyboard apply->read") ==
+        "keyboard apply->read [cycles]: n=1 min=100 p50=100 p90=100 max=100");
+  CHECK(reported("keyboard read->display").empty());
+  CHECK(reported("keyboard: ") == "keyboard: 2 skipped, 2 timeouts");
+  // no event reached a changed frame
+  CHECK(trace.takeDisplayRequest() == 0);
+}
+
+static void testScript() {
+  AtariKeyEvent ev;
+  CHECK(LatencyTrace::scriptKey(200, ev) && ev.pressed &&
+        (ev.code == ATARI_KEY_A));
+  CHECK(!LatencyTrace::scriptKey(205, ev));
+  CHECK(LatencyTrace::scriptKey(210, ev) && !ev.pressed);
+  CHECK(LatencyTrace::scriptJoystick(249) == 0xff);
+  CHECK(LatencyTrace::scriptJoystick(250) == 0xf7);
+  CHECK(LatencyTrace::scriptJoystick(259) == 0xf7);
+  CHECK(LatencyTrace::scriptJoystick(260) == 0xff);
+}
+
+static void bench() {
+  LatencyTrace trace;
+  const int reads = 10000000;
+  uint32_t addr = 0xd000;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < reads; i++) {
+    trace.ioRead(addr + (i & 0x3ff), i);
+  }
+  auto mid = std::chrono::steady_clock::now();
+  const int frames = 1000;
+  for (int i = 0; i < frames; i++) {
+    frame(trace, true);
+  }
+  auto stop = std::chrono::steady_clock::now();
+  printf("LatencyTrace: ioRead %.2f ns, frameEnd %.0f us\n",
+         std::chrono::duration<double, std::nano>(mid - start).count() / reads,
+         std::chrono::duration<double, std::micro>(stop - mid).count() /
+             frames);
+}
+
+int main() {
+  platform = new TestPlatform();
+  PlatformManager::initialize(platform);
+  testEvent();
+  testPercentiles();
+  testRegisters();
+  testJoystick();
+  testSkippedAndTimeouts();
+  testScript();
+  if (testResult("LatencyTraceTest")) {
+    return 1;
+  }
+  bench();
+  return 0;
+}
@@ -0,0 +1,174 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "TestCheck.h"
+#include "platform/LinuxTimerService.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+/**
+ * Host test of LinuxTimerService: absolute deadlines without drift, skip
+ * counting of overrunning callbacks, several timers, cancel from outside
+ * and from the callback and shutdown with running timers. The limits
+ * leave room for a loaded host. Measures the lateness of a 1 ms timer.
+ */
+
+using Clock = std::chrono::steady_clock;
+
+static int64_t elapsedUS(Clock::time_point since) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                               since)
+      .count();
+}
+
+static void sleepMS(int ms) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+static void testDeadlines() {
+  LinuxTimerService service;
+  const int64_t interval = 2000;
+  std::vector<int64_t> calls;
+  calls.reserve(1000);
+  Clock::time_point start = Clock::now();
+  LinuxTimerService::TimerId id =
+      service.add([&]() { calls.push_back(elapsedUS(start)); }, interval);
+  sleepMS(300);
+  service.cancel(id);
+  sleepMS(10);
+  LinuxTimerService::Stats stats;
+  CHECK(!service.getStats(id, stats));
+  CHECK(calls.size() > 100);
+  // each call is at or after its deadline start + n * interval, the
+  // periods between the first and the last call add up exactly
+  size_t n = calls.size();
+  CHECK(calls[0] >= interval);
+  int64_t periods = (calls[n - 1] - calls[0] + interval / 2) / interval;
+  CHECK(periods >= (int64_t)n - 1);
+  CHECK(std::abs(calls[n - 1] - calls[0] - periods * interval) < interval);
+}
+
+static void testSkipped() {
+  LinuxTimerService service;
+  const int64_t interval = 2000;
+  std::atomic<int> calls(0);
+  Clock::time_point start = Clock::now();
+  // every call takes two and a half periods
+  LinuxTimerService::TimerId id = service.add(
+      [&]() {
+        calls++;
+        std::this_thread::sleep_for(std::chrono::microseconds(5000));
+      },
+      interval);
+  sleepMS(200);
+  LinuxTimerService::Stats stats;
+  CHECK(service.getStats(id, stats));
+  int64_t elapsed = elapsedUS(start);
+  service.cancel(id);
+  CHECK((stats.ticks == (uint64_t)calls) ||
+        (stats.ticks == (uint64_t)calls + 1));
+  CHECK(stats.skipped >= stats.ticks);
+  // no period is lost or counted twice
+  int64_t periods = stats.ticks + stats.skipped;
+  CHECK((periods <= elapsed / interval) &&
+        (periods >= elapsed / interval - 4));
+  CHECK(stats.lateMaxUS >= 1000);
+  CHECK(stats.lateSumUS >= stats.lateMaxUS);
+}
+
+static void testTimers() {
+  LinuxTimerService service;
+  std::atomic<int> fast(0);
+  std::atomic<int> slow(0);
+  std::atomic<int> once(0);
+  LinuxTimerService::TimerId fastId = service.add([&]() { fast++; }, 1000);
+  LinuxTimerService::TimerId slowId = service.add([&]() { slow++; }, 10000);
+  LinuxTimerService::TimerId onceId = 0;
+  std::atomic<bool> added(false);
+  onceId = service.add(
+      [&]() {
+        once++;
+        while (!added) {
+          std::this_thread::yield();
+        }
+        service.cancel(onceId);
+      },
+      3000);
+  added = true;
+  sleepMS(200);
+  LinuxTimerService::Stats fastStats;
+  LinuxTimerService::Stats slowStats;
+  CHECK(service.getStats(fastId, fastStats));
+  CHECK(service.getStats(slowId, slowStats));
+  CHECK((slowStats.ticks >= 15) && (slowStats.ticks <= 20));
+  CHECK(fastStats.ticks + fastStats.skipped >= 9 * slowStats.ticks);
+  CHECK(once == 1);
+  CHECK(!service.getStats(onceId, fastStats));
+  // cancelled: no calls after the one that may be running
+  service.cancel(fastId);
+  sleepMS(5);
+  int calls = fast;
+  sleepMS(20);
+  CHECK(fast == calls);
+  CHECK(slow > 0);
+  CHECK(!service.getStats(12345, fastStats));
+  // the destructor stops the slow timer
+}
+
+static void testShutdown() {
+  std::atomic<int> calls(0);
+  for (int i = 0; i < 20; i++) {
+    LinuxTimerService service;
+    for (int j = 0; j < 4; j++) {
+      service.add([&]() { calls++; }, 100);
+    }
+    sleepMS(1);
+  }
+  int after = calls;
+  sleepMS(10);
+  CHECK(calls == after);
+  // never started
+  LinuxTimerService idle;
+  idle.cancel(1);
+}
+
+static void bench() {
+  LinuxTimerService service;
+  LinuxTimerService::TimerId id = service.add([]() {}, 1000);
+  sleepMS(1000);
+  LinuxTimerService::Stats stats;
+  service.getStats(id, stats);
+  printf("LinuxTimerService: 1 ms timer, %u ticks, late avg %.0f us, "
+         "max %u us, %u skipped\n",
+         (unsigned)stats.ticks,
+         stats.ticks ? (double)stats.lateSumUS / stats.ticks : 0.0,
+         (unsigned)stats.lateMaxUS, (unsigned)stats.skipped);
+}
+
+int main() {
+  testDeadlines();
+  testSkipped();
+  testTimers();
+  testShutdown();
+  if (testResult("LinuxTimerServiceTest")) {
+    return 1;
+  }
+  bench();
+  return 0;
+}
@@ -0,0 +1,202 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "LogRing.h"
+#include "TestCheck.h"
+#include "platform/PlatformLinux.h"
+#include "platform/PlatformManager.h"
+#include <chrono>
+#include <climits>
+#include <cstdarg>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Host test of LogRing: the formatting of the stored arguments for all
+ * supported conversions, missing arguments and truncation, per thread
+ * order, full rings and threads without a ring. The messages are captured
+ * from the log task. Measures the cost of a message for the writer.
+ */
+
+static const char *TAG = "test";
+
+struct Line {
+  LogLevel level;
+  std::string tag;
+  std::string text;
+};
+
+// captures the log, may be called from the log task
+class TestPlatform : public PlatformLinux {
+public:
+  std::mutex mutex;
+  std::vector<Line> lines;
+
+  void log(LogLevel level, const char *tag, const char *format,
+           ...) override {
+    char buf[512];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(buf, sizeof(buf), format, args);
+    va_end(args);
+    std::lock_guard<std::mutex> lock(mutex);
+    lines.push_back({level, tag, buf});
+  }
+
+  size_t count() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return lines.size();
+  }
+};
+
+static TestPlatform *platform;
+
+// waits until the log task passed n lines
+static bool waitLines(size_t n) {
+  for (int i = 0; i < 5000; i++) {
+    if (platform->count() >= n) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return false;
+}
+
+// message text of a ring entry without the time stamp ("%10u ")
+static std::string text(const Line &line) {
+  return (line.text.size() > 11) ? line.text.substr(11) : "";
+}
+
+static const char LONG[] =
+    "0123456789012345678901234567890123456789012345678901234567890123456789"
+    "0123456789012345678901234567890123456789012345678901234567890123456789"
+    "0123456789012345678901234567890123456789012345678901234567890123456789"
+    "0123456789012345678901234567890123456789012345678901234567890123456789";
+
+// formatted messages of writeCases()
+static const std::string expected[] = {
+    "line 12: write d40a=22",
+    "-5 7 +3 -1",
+    "255 ffff 0x1f 017",
+    "-9223372036854775808 18446744073709551615 123456789abcdef",
+    "-70000 4000000000 12345 -2",
+    "3.14 1.500000e+00 0.1 -2.5",
+    "abc|xy    |0x1234|(null)",
+    "A|  B|%",
+    "100% done, 1 <?> <?>",
+    "trailing",
+    "length",
+    std::string(LONG, 255),
+};
+
+static void writeCases() {
+  RINGLOG(LOG_INFO, TAG, "line %d: write %04x=%02x", 12, (uint16_t)0xd40a,
+          (uint8_t)0x22);
+  RINGLOG(LOG_INFO, TAG, "%d %i %+d %d", -5, 7, 3, (int8_t)-1);
+  RINGLOG(LOG_INFO, TAG, "%u %hx %#x %#o", (uint8_t)255, (uint16_t)0xffff, 31,
+          15);
+  RINGLOG(LOG_INFO, TAG, "%lld %llu %llx", LLONG_MIN, ULLONG_MAX,
+          0x0123456789abcdefULL);
+  RINGLOG(LOG_INFO, TAG, "%ld %lu %zu %jd", -70000L, 4000000000UL,
+          (size_t)12345, (intmax_t)-2);
+  RINGLOG(LOG_INFO, TAG, "%.2f %e %g %.1f", 3.14159, 1.5f, 0.1, -2.5);
+  RINGLOG(LOG_INFO, TAG, "%s|%-6s|%p|%s", "abc", "xy",
+          reinterpret_cast<void *>(0x1234),
+          static_cast<const char *>(nullptr));
+  RINGLOG(LOG_INFO, TAG, "%c|%3c|%%", 'A', 'B');
+  RINGLOG(LOG_INFO, TAG, "100%% done, %d %d %s", 1);
+  RINGLOG(LOG_INFO, TAG, "trailing%");
+  RINGLOG(LOG_INFO, TAG, "length%lll");
+  RINGLOG(LOG_INFO, TAG, "%s", LONG);
+  // above LOGRING_LEVEL, compiled out
+  RINGLOG(LOG_DEBUG, TAG, "debug %d", 1);
+}
+
+static void testRings() {
+  const size_t numCases = sizeof(expected) / sizeof(expected[0]);
+  // before the log task runs: fill the ring of the main thread and drop
+  // the last 76 messages
+  writeCases();
+  for (uint32_t i = numCases; i < LogRing::RINGSIZE + 76; i++) {
+    RINGLOG(LOG_WARN, "fill", "%u", i);
+  }
+  // the other rings, the fifth thread has none left
+  for (int i = 1; i <= LogRing::MAXRINGS; i++) {
+    std::thread([i]() { RINGLOG(LOG_ERROR, "thread", "%d", i); }).join();
+  }
+  LogRing::start();
+  CHECK(waitLines(LogRing::RINGSIZE + LogRing::MAXRINGS));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  std::lock_guard<std::mutex> lock(platform->mutex);
+  std::vector<Line> &lines = platform->lines;
+  CHECK(lines.size() == LogRing::RINGSIZE + LogRing::MAXRINGS);
+  if (lines.size() != LogRing::RINGSIZE + LogRing::MAXRINGS) {
+    return;
+  }
+  // the main thread's ring in order, then the three other threads
+  for (size_t i = 0; i < numCases; i++) {
+    CHECK((lines[i].level == LOG_INFO) && (lines[i].tag == TAG));
+    if (text(lines[i]) != expected[i]) {
+      printf("got \"%s\", expected \"%s\"\n", text(lines[i]).c_str(),
+             expected[i].c_str());
+      CHECK(false);
+    }
+  }
+  for (size_t i = numCases; i < LogRing::RINGSIZE; i++) {
+    CHECK((lines[i].level == LOG_WARN) && (lines[i].tag == "fill") &&
+          (text(lines[i]) == std::to_string(i)));
+  }
+  for (int i = 1; i < LogRing::MAXRINGS; i++) {
+    const Line &line = lines[LogRing::RINGSIZE + i - 1];
+    CHECK((line.level == LOG_ERROR) && (line.tag == "thread") &&
+          (text(line) == std::to_string(i)));
+  }
+  // 76 of the full ring and 1 without a ring
+  CHECK(lines.back().text == "77 messages dropped");
+  lines.clear();
+}
+
+static void bench() {
+  // batches fitting into the ring, waiting for the log task in between
+  const int batches = 100;
+  double us = 0;
+  for (int b = 0; b < batches; b++) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 500; i++) {
+      RINGLOG(LOG_INFO, TAG, "line %d: write %04x=%02x", i, 0xd40a, b);
+    }
+    us += std::chrono::duration<double, std::micro>(
+              std::chrono::steady_clock::now() - start)
+              .count();
+    waitLines((b + 1) * 500);
+  }
+  printf("LogRing: %.0f ns per message, %u formatted\n",
+         us * 1000 / (batches * 500), (unsigned)platform->count());
+}
+
+int main() {
+  platform = new TestPlatform();
+  PlatformManager::initialize(platform);
+  testRings();
+  if (testResult("LogRingTest")) {
+    return 1;
+  }
+  bench();
+  return 0;
+}
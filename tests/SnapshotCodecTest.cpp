@@ -0,0 +1,164 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "SnapshotCodec.h"
+#include "TestCheck.h"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Host test of the snapshot compressor: round trip of zeros, runs, random
+ * data, long matches and RAM-like content, and rejection of truncated and
+ * corrupt input. Measures ratio and speed on a RAM-like 64K block.
+ */
+
+static uint32_t rng = 1;
+
+static uint8_t nextRandom() {
+  rng = rng * 1103515245 + 12345;
+  return rng >> 16;
+}
+
+// zero page, screen memory, tables, code and empty areas like in a booted
+// 64K Atari RAM
+static std::vector<uint8_t> ramLike() {
+  std::vector<uint8_t> ram(0x10000, 0);
+  for (int i = 0; i < 0x100; i++) {
+    ram[i] = nextRandom();
+  }
+  for (int i = 0; i < 960; i++) {
+    ram[0xbc40 + i] = (i % 40 < 20) ? 0x21 + (i % 20) : 0;
+  }
+  for (int i = 0; i < 0x800; i++) {
+    ram[0x2000 + i] = i & 0xff;
+  }
+  for (int i = 0; i < 0x1000; i++) {
+    ram[0x3000 + i] = ((i >= 16) && (nextRandom() & 0x0f))
+                          ? ram[0x3000 + i - 16]
+                          : nextRandom();
+  }
+  return ram;
+}
+
+static bool roundTrip(const std::vector<uint8_t> &raw) {
+  std::vector<uint8_t> packed;
+  SnapshotCodec::compress(raw.data(), raw.size(), packed);
+  std::vector<uint8_t> unpacked;
+  return SnapshotCodec::decompress(packed.data(), packed.size(), unpacked,
+                                   raw.size()) &&
+         (unpacked == raw);
+}
+
+static void testRoundTrip() {
+  CHECK(roundTrip({}));
+  CHECK(roundTrip({0x42}));
+  CHECK(roundTrip({0, 0}));
+  CHECK(roundTrip(std::vector<uint8_t>(0x10000, 0)));
+  CHECK(roundTrip(std::vector<uint8_t>(0x10000, 0xaa)));
+  // zero runs of every token length around the thresholds
+  for (size_t n : {2, 3, 65, 66, 67, 1000, 0xffff, 0x10000, 0x20000}) {
+    std::vector<uint8_t> raw(n + 2, 0);
+    raw.front() = 1;
+    raw.back() = 2;
+    CHECK(roundTrip(raw));
+  }
+  // literals of every length around the 64 byte token limit
+  for (size_t n : {1, 63, 64, 65, 128, 1000}) {
+    std::vector<uint8_t> raw(n);
+    for (auto &b : raw) {
+      b = nextRandom() | 1;
+    }
+    CHECK(roundTrip(raw));
+  }
+  // matches at the length and offset limits
+  for (size_t len : {3, 4, 9, 10, 11, 265, 266, 1000}) {
+    for (size_t dist : {1, 2, 4, 4095, 4096, 4097}) {
+      std::vector<uint8_t> raw(dist);
+      for (auto &b : raw) {
+        b = nextRandom() | 1;
+      }
+      for (size_t i = 0; i < len; i++) {
+        raw.push_back(raw[raw.size() - dist]);
+      }
+      CHECK(roundTrip(raw));
+    }
+  }
+  CHECK(roundTrip(ramLike()));
+}
+
+static void testCorrupt() {
+  std::vector<uint8_t> raw = ramLike();
+  std::vector<uint8_t> packed;
+  SnapshotCodec::compress(raw.data(), raw.size(), packed);
+  std::vector<uint8_t> out;
+  // every truncation must fail, not read or write out of bounds
+  for (size_t len = 0; len < packed.size(); len++) {
+    CHECK(!SnapshotCodec::decompress(packed.data(), len, out, raw.size()));
+  }
+  // wrong raw sizes
+  CHECK(!SnapshotCodec::decompress(packed.data(), packed.size(), out,
+                                   raw.size() - 1));
+  CHECK(!SnapshotCodec::decompress(packed.data(), packed.size(), out,
+                                   raw.size() + 1));
+  // a match before the start of the output
+  const uint8_t badOffset[] = {0x00, 0x11, 0x80, 0x01};
+  CHECK(!SnapshotCodec::decompress(badOffset, sizeof(badOffset), out, 4));
+  // a zero run beyond the raw size
+  const uint8_t longRun[] = {0x7f, 0x00, 0x01};
+  CHECK(!SnapshotCodec::decompress(longRun, sizeof(longRun), out, 0xff));
+  // random garbage must never crash
+  for (int i = 0; i < 10000; i++) {
+    std::vector<uint8_t> garbage(1 + nextRandom() % 64);
+    for (auto &b : garbage) {
+      b = nextRandom();
+    }
+    SnapshotCodec::decompress(garbage.data(), garbage.size(), out, 256);
+  }
+}
+
+static void bench() {
+  std::vector<uint8_t> raw = ramLike();
+  std::vector<uint8_t> packed;
+  std::vector<uint8_t> out;
+  const int rounds = 200;
+  double packUS = 0;
+  double unpackUS = 0;
+  for (int i = 0; i < rounds; i++) {
+    packed.clear();
+    auto start = std::chrono::steady_clock::now();
+    SnapshotCodec::compress(raw.data(), raw.size(), packed);
+    auto mid = std::chrono::steady_clock::now();
+    SnapshotCodec::decompress(packed.data(), packed.size(), out, raw.size());
+    auto stop = std::chrono::steady_clock::now();
+    packUS += std::chrono::duration<double, std::micro>(mid - start).count();
+    unpackUS += std::chrono::duration<double, std::micro>(stop - mid).count();
+  }
+  printf("SnapshotCodec: 64K RAM to %u bytes (%.1f%%), compress %.0f us, "
+         "decompress %.0f us\n",
+         (unsigned)packed.size(), 100.0 * packed.size() / raw.size(),
+         packUS / rounds, unpackUS / rounds);
+}
+
+int main() {
+  testRoundTrip();
+  testCorrupt();
+  if (testResult("SnapshotCodecTest")) {
+    return 1;
+  }
+  bench();
+  return 0;
+}
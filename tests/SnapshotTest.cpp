@@ -0,0 +1,177 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "PIA.h"
+#include "Snapshot.h"
+#include "TestCheck.h"
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+/**
+ * Host test of the boot snapshot state format: SnapshotWriter and
+ * SnapshotReader round trip, truncated states and the PIA state as an
+ * example of a chip. Measures the time to write and read a state of the
+ * size of the emulator state.
+ */
+
+struct Regs {
+  uint16_t pc;
+  uint8_t a, x, y, sp, sr;
+};
+
+static void write(std::vector<uint8_t> &data) {
+  SnapshotWriter w(data);
+  w.put<uint8_t>(0xa5);
+  w.put<uint16_t>(0x1234);
+  w.put<uint32_t>(0xdeadbeef);
+  w.put<uint64_t>(0x0123456789abcdefULL);
+  w.put(true);
+  w.put(Regs{0xe477, 1, 2, 3, 0xff, 0x34});
+  uint8_t ram[300];
+  for (int i = 0; i < 300; i++) {
+    ram[i] = i * 7;
+  }
+  w.putBytes(ram, sizeof(ram));
+}
+
+// reads the state of write(), false at the first failed value
+static bool read(SnapshotReader &r) {
+  uint8_t b = 0;
+  uint16_t w = 0;
+  uint32_t d = 0;
+  uint64_t q = 0;
+  bool flag = false;
+  Regs regs = {};
+  uint8_t ram[300] = {};
+  r.get(b);
+  r.get(w);
+  r.get(d);
+  r.get(q);
+  r.get(flag);
+  r.get(regs);
+  r.getBytes(ram, sizeof(ram));
+  if (!r.isOk()) {
+    return false;
+  }
+  bool same = (b == 0xa5) && (w == 0x1234) && (d == 0xdeadbeef) &&
+              (q == 0x0123456789abcdefULL) && flag && (regs.pc == 0xe477) &&
+              (regs.a == 1) && (regs.x == 2) && (regs.y == 3) &&
+              (regs.sp == 0xff) && (regs.sr == 0x34);
+  for (int i = 0; i < 300; i++) {
+    same &= (ram[i] == (uint8_t)(i * 7));
+  }
+  CHECK(same);
+  return true;
+}
+
+static void testRoundTrip() {
+  std::vector<uint8_t> data;
+  write(data);
+  CHECK(data.size() == 1 + 2 + 4 + 8 + 1 + sizeof(Regs) + 300);
+  SnapshotReader r(data.data(), data.size());
+  CHECK(read(r));
+  CHECK(r.atEnd());
+
+  // a longer state is read but not at its end
+  data.push_back(0);
+  SnapshotReader longer(data.data(), data.size());
+  CHECK(read(longer) && !longer.atEnd());
+}
+
+static void testTruncated() {
+  std::vector<uint8_t> data;
+  write(data);
+  int accepted = 0;
+  for (size_t len = 0; len < data.size(); len++) {
+    SnapshotReader r(data.data(), len);
+    accepted += read(r);
+  }
+  CHECK(accepted == 0);
+
+  // a failed read leaves the value unchanged and the reader failed
+  uint8_t two[2] = {1, 2};
+  SnapshotReader r(two, sizeof(two));
+  uint32_t d = 0x55555555;
+  r.get(d);
+  CHECK(!r.isOk() && (d == 0x55555555));
+  uint8_t b = 0;
+  r.get(b);
+  CHECK(!r.isOk() && (b == 0));
+}
+
+static void testPIA() {
+  PIA pia;
+  pia.write(PACTL, 0x00);
+  pia.write(PORTA, 0x0f); // DDR: low nibble output
+  pia.write(PACTL, 0x04);
+  pia.write(PORTA, 0x05);
+  pia.write(PBCTL, 0x00);
+  pia.write(PORTB, 0xff);
+  pia.write(PBCTL, 0x04);
+  pia.write(PORTB, 0xfd); // BASIC enabled
+  pia.setSticks(0xe7);
+  std::vector<uint8_t> data;
+  SnapshotWriter w(data);
+  pia.saveState(w);
+
+  PIA restored;
+  SnapshotReader r(data.data(), data.size());
+  restored.loadState(r);
+  CHECK(r.isOk() && r.atEnd());
+  for (uint8_t addr = 0; addr < 4; addr++) {
+    CHECK(restored.read(addr) == pia.read(addr));
+  }
+  CHECK(restored.read(PORTA) == 0xe5);
+  CHECK((restored.getPortB() == 0xfd) && restored.isBASICEnabled());
+}
+
+static void bench() {
+  // about the size of the emulator state (64K RAM and the chips)
+  std::vector<uint8_t> ram(66 * 1024, 0x5a);
+  std::vector<uint8_t> data;
+  data.reserve(ram.size() + 16);
+  const int rounds = 2000;
+  uint32_t sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < rounds; i++) {
+    data.clear();
+    SnapshotWriter w(data);
+    w.put(i);
+    w.putBytes(ram.data(), ram.size());
+    SnapshotReader r(data.data(), data.size());
+    int v = 0;
+    r.get(v);
+    r.getBytes(ram.data(), ram.size());
+    sum += v + ram[i % ram.size()];
+  }
+  auto stop = std::chrono::steady_clock::now();
+  printf("Snapshot: %.1f us to write and read a %uK state (%u)\n",
+         std::chrono::duration<double, std::micro>(stop - start).count() /
+             rounds,
+         (unsigned)(ram.size() / 1024), sum);
+}
+
+int main() {
+  testRoundTrip();
+  testTruncated();
+  testPIA();
+  if (testResult("SnapshotTest")) {
+    return 1;
+  }
+  bench();
+  return 0;
+}
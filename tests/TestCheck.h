@@ -0,0 +1,46 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef TESTCHECK_H
+#define TESTCHECK_H
+
+#include <cstdio>
+
+/**
+ * Minimal checks of the host tests: a failed CHECK is printed and counted,
+ * testResult() prints the summary and returns the exit code of the test.
+ */
+
+inline int failures = 0;
+
+#define CHECK(cond)                                                            \
+  do {                                                                         \
+    if (!(cond)) {                                                             \
+      printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);                   \
+      failures++;                                                              \
+    }                                                                          \
+  } while (0)
+
+inline int testResult(const char *name) {
+  if (failures) {
+    printf("%s: %d failures\n", name, failures);
+    return 1;
+  }
+  printf("%s: passed\n", name);
+  return 0;
+}
+
+#endif // TESTCHECK_H
@@ -0,0 +1,175 @@
+/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#include "keyboard/WebKBProtocol.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+/**
+ * Fuzz driver of WebKeyFrame::parse. The input is split into frames like a
+ * websocket message in WebKB::handleWebsocketMessage and each result is
+ * checked against the protocol description.
+ *
+ * Built with -DLIBFUZZER and -fsanitize=fuzzer the file is a libFuzzer
+ * target, otherwise main() replays the files given as arguments or runs
+ * an exhaustive and a random test followed by a timing loop.
+ */
+
+static bool expectValid(const uint8_t *data) {
+  if ((data[0] > 3) || (data[1] & 0xf8)) {
+    return false;
+  }
+  if (data[0] == 0) {
+    return data[2] < 64;
+  }
+  if (data[0] == 1) {
+    return (data[2] == ATARI_CONSOLE_START) ||
+           (data[2] == ATARI_CONSOLE_SELECT) ||
+           (data[2] == ATARI_CONSOLE_OPTION);
+  }
+  return true;
+}
+
+static void checkFrame(const uint8_t *data) {
+  WebKeyFrame frame;
+  bool valid = WebKeyFrame::parse(data, frame);
+  if (valid != expectValid(data)) {
+    abort();
+  }
+  if (!valid) {
+    return;
+  }
+  uint32_t timestamp = data[4] | (data[5] << 8) | (data[6] << 16) |
+                       (static_cast<uint32_t>(data[7]) << 24);
+  if ((static_cast<uint8_t>(frame.type) != data[0]) ||
+      (frame.flags != data[1]) || (frame.code != data[2]) ||
+      (frame.param != data[3]) || (frame.timestamp != timestamp)) {
+    abort();
+  }
+  AtariKeyEvent ev;
+  bool isEvent = frame.toKeyEvent(ev);
+  if (isEvent != (frame.type != WebKeyFrame::Type::COMMAND)) {
+    abort();
+  }
+  if (isEvent && (ev.pressed != ((data[1] & WebKeyFrame::FLAG_PRESSED) != 0))) {
+    abort();
+  }
+  if (isEvent && (frame.type == WebKeyFrame::Type::KEY)) {
+    uint8_t code = data[2];
+    if (data[1] & WebKeyFrame::FLAG_SHIFT) {
+      code |= ATARI_MOD_SHIFT;
+    }
+    if (data[1] & WebKeyFrame::FLAG_CONTROL) {
+      code |= ATARI_MOD_CONTROL;
+    }
+    if ((ev.type != AtariKeyEvent::Type::KEY) || (ev.code != code)) {
+      abort();
+    }
+  }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  for (size_t i = 0; i + WebKeyFrame::SIZE <= size; i += WebKeyFrame::SIZE) {
+    checkFrame(data + i);
+  }
+  return 0;
+}
+
+#ifndef LIBFUZZER
+static int replay(const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    printf("cannot open %s\n", path);
+    return 1;
+  }
+  std::vector<uint8_t> data;
+  uint8_t buf[4096];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+    data.insert(data.end(), buf, buf + n);
+  }
+  fclose(f);
+  LLVMFuzzerTestOneInput(data.data(), data.size());
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1) {
+    for (int i = 1; i < argc; i++) {
+      if (replay(argv[i])) {
+        return 1;
+      }
+    }
+    printf("WebKBProtocolFuzz: %d inputs passed\n", argc - 1);
+    return 0;
+  }
+
+  // all combinations of type, flags and code
+  uint8_t frame[WebKeyFrame::SIZE] = {0, 0, 0, 0x5a, 0x78, 0x56, 0x34, 0x12};
+  uint32_t valid = 0;
+  for (uint32_t v = 0; v < 0x1000000; v++) {
+    frame[0] = v >> 16;
+    frame[1] = v >> 8;
+    frame[2] = v;
+    checkFrame(frame);
+    valid += expectValid(frame);
+  }
+
+  // random messages, including lengths which are not a multiple of SIZE
+  srand(1);
+  std::vector<uint8_t> msg;
+  for (int i = 0; i < 200000; i++) {
+    msg.resize(rand() % 65);
+    for (uint8_t &b : msg) {
+      // mostly small values to reach the valid frames
+      b = (rand() & 1) ? rand() % 8 : rand();
+    }
+    LLVMFuzzerTestOneInput(msg.data(), msg.size());
+  }
+  printf("WebKBProtocolFuzz: passed (%u valid frames of 16M)\n", valid);
+
+  // timing: a message of valid key frames
+  const size_t frames = 512;
+  std::vector<uint8_t> keys(frames * WebKeyFrame::SIZE);
+  for (size_t i = 0; i < frames; i++) {
+    uint8_t *f = &keys[i * WebKeyFrame::SIZE];
+    f[0] = static_cast<uint8_t>(WebKeyFrame::Type::KEY);
+    f[1] = WebKeyFrame::FLAG_PRESSED | (i & WebKeyFrame::FLAG_SHIFT);
+    f[2] = i & 63;
+    f[4] = i;
+  }
+  const int rounds = 20000;
+  uint32_t sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    keys[4] = r; // new timestamp, the loop cannot be hoisted
+    WebKeyFrame parsed;
+    AtariKeyEvent ev;
+    for (size_t i = 0; i < keys.size(); i += WebKeyFrame::SIZE) {
+      if (WebKeyFrame::parse(&keys[i], parsed) && parsed.toKeyEvent(ev)) {
+        sum += ev.code + parsed.timestamp;
+      }
+    }
+  }
+  auto stop = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+  printf("WebKeyFrame::parse: %.2f ns per frame (checksum %u)\n",
+         ns / (static_cast<double>(rounds) * frames), sum);
+  return 0;
+}
+#endif
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+#
+# Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+#
+# This program is free software; you can redistribute it and/or modify it
+# under the terms of the GNU General Public License as published by the
+# Free Software Foundation; either version 3 of the License, or (at your
+# option) any later version.
+#
+# This program is distributed in the hope that it will be useful, but
+# WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+# or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+# for more details.
+#
+# For the complete text of the GNU General Public License see
+# http://www.gnu.org/licenses/.
+"""Generates src/HotOpcodes.h (IRAM placement of the opcode handlers).
+
+Usage:
+  tools/hotopcodes.py [--coverage 0.99] [--max 96] [log ...]
+
+The logs are serial/console captures of a build with USE_OPCODE_PROFILE,
+all lines "opprofile op=count ..." are summed up. The handlers executing
+the most instructions are marked hot until --coverage of all executed
+instructions or --max handlers are reached. Without logs the documented
+6502 opcodes are marked hot.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+ROOT = os.path.normpath(
+    os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+CPUHEADER = os.path.join(ROOT, "src", "CPU6502.h")
+OUTPUT = os.path.join(ROOT, "src", "HotOpcodes.h")
+
+DOCUMENTED = {
+    "adc", "and", "asl", "bcc", "bcs", "beq", "bit", "bmi", "bne", "bpl",
+    "brk", "bvc", "bvs", "clc", "cld", "cli", "clv", "cmp", "cpx", "cpy",
+    "dec", "dex", "dey", "eor", "inc", "inx", "iny", "jmp", "jsr", "lda",
+    "ldx", "ldy", "lsr", "nop", "ora", "pha", "php", "pla", "plp", "rol",
+    "ror", "rti", "rts", "sbc", "sec", "sed", "sei", "sta", "stx", "sty",
+    "tax", "tay", "tsx", "txa", "txs", "tya",
+}
+
+
+def documented(handler):
+    # the undocumented NOPs have handlers of their own (nopZeropage, nop1a...)
+    mnemonic = handler[7:10]
+    if mnemonic == "nop":
+        return handler == "cmd6502nop"
+    return mnemonic in DOCUMENTED
+
+
+HEADER = """/*
+ Copyright (C) 2024-2025 retroelec <retroelec42@gmail.com>
+
+ This program is free software; you can redistribute it and/or modify it
+ under the terms of the GNU General Public License as published by the
+ Free Software Foundation; either version 3 of the License, or (at your
+ option) any later version.
+
+ This program is distributed in the hope that it will be useful, but
+ WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY
+ or FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License
+ for more details.
+
+ For the complete text of the GNU General Public License see
+ http://www.gnu.org/licenses/.
+*/
+#ifndef HOTOPCODES_H
+#define HOTOPCODES_H
+
+// generated by tools/hotopcodes.py, do not edit
+// {source}
+
+"""
+
+
+def read_handlers():
+    """Returns the handler name of each opcode (table of CPU6502.h)."""
+    with open(CPUHEADER) as f:
+        text = f.read()
+    table = text[text.index("cmdarr6502[256]"):]
+    table = table[:table.index("};")]
+    handlers = re.findall(r"&CPU6502::(cmd6502\w+)", table)
+    if len(handlers) != 256:
+        sys.exit("cannot parse the opcode table of CPU6502.h")
+    return handlers
+
+
+def read_profile(logs):
+    counts = [0] * 256
+    for name in logs:
+        with open(name, errors="replace") as f:
+            for line in f:
+                pos = line.find("opprofile ")
+                if pos < 0:
+                    continue
+                for op, count in re.findall(r"([0-9a-f]{2})=(\d+)",
+                                            line[pos:]):
+                    counts[int(op, 16)] += int(count)
+    return counts
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--coverage", type=float, default=0.99)
+    parser.add_argument("--max", type=int, default=96)
+    parser.add_argument("logs", nargs="*")
+    args = parser.parse_args()
+
+    handlers = read_handlers()
+    unique = list(dict.fromkeys(handlers))
+    hot = set()
+    if args.logs:
+        counts = read_profile(args.logs)
+        total = sum(counts)
+        if total == 0:
+            sys.exit("no opprofile lines found")
+        perhandler = {}
+        for op, count in enumerate(counts):
+            perhandler[handlers[op]] = perhandler.get(handlers[op], 0) + count
+        covered = 0
+        for handler, count in sorted(perhandler.items(),
+                                     key=lambda item: -item[1]):
+            if (covered >= args.coverage * total) or (len(hot) >= args.max) \
+                    or (count == 0):
+                break
+            hot.add(handler)
+            covered += count
+        source = "profile: %d instructions, %d handlers cover %.1f%%" % (
+            total, len(hot), 100.0 * covered / total)
+    else:
+        hot = {h for h in unique if documented(h)}
+        source = "no profile: the documented opcodes are hot"
+
+    with open(OUTPUT, "w") as f:
+        f.write(HEADER.format(source=source))
+        for handler in unique:
+            attr = " HOT_CODE" if handler in hot else ""
+            f.write("#define HOTOP_%s%s\n" % (handler, attr))
+        f.write("\n#endif // HOTOPCODES_H\n")
+    print("%s: %d of %d handlers hot (%s)" % (OUTPUT, len(hot), len(unique),
+                                              source))
+
+
+if __name__ == "__main__":
+    main()